@@ -0,0 +1,289 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#include "IMU_engn.h"
+
+// engine internal (synchronous) processing function
+int IMU_engn_process(uint16_t id, IMU_datum*);
+
+// define constants
+static const int      num_samp    = 600000;   // sensor samples per instance
+static const uint32_t tick        = 100;      // 1kHz per sensor (10usec)
+static const float    imu_rate    = 3000.0;   // samples/sec of a 1kHz IMU
+static const int      max_inst    = 64;       // sweep limit (IMU_MAX_INST)
+static const int      max_thrd    = 8;        // sweep limit (producers)
+static const int      num_type    = 5;
+static const char*    type_list[] = {"core_only", "rect_core", "calb_pnts",
+                                     "calb_stat", "calb_full"};
+
+// input/threading modes
+typedef enum {
+  mode_datum_sync         = 0,                // IMU_engn_process (caller)
+  mode_data3_sync         = 1,                // IMU_engn_data3 (caller)
+  mode_datum_queue        = 2                 // IMU_engn_datum (worker)
+} bench_mode;
+static const int      num_mode    = 3;
+static const char*    mode_list[] = {"datum", "data3", "queue"};
+
+// producer thread arguments
+typedef struct {
+  pthread_t           thrd;
+  bench_mode          mode;
+  uint16_t            *id;
+  int                 numInst;
+  int                 stride;
+  int                 dropped;
+} bench_thrd;
+
+// shared inputs
+static IMU_datum      *datum;
+static IMU_data3      *data3;
+
+// internal functions
+static void   stream    (void);
+static int    child     (IMU_engn_type type, bench_mode mode, int numInst,
+                         int numThrd);
+static void*  produce   (void *pntr);
+static double now       (void);
+
+
+/******************************************************************************
+* main function - engine throughput per pipeline, instance, and thread count
+* (each configuration runs in its own process, engines are static instances,
+* queue depth and instance limit are set when libIMU is built, see sweep)
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  int               type, mode, numInst, numThrd, status;
+  pid_t             pid;
+
+  // print table header
+  printf("starting bench_engn...\n");
+  datum             = malloc(num_samp * sizeof(IMU_datum));
+  data3             = malloc(num_samp / 3 * sizeof(IMU_data3));
+  stream();
+  printf("host cpus: %ld\n", sysconf(_SC_NPROCESSORS_ONLN));
+  printf("%-10s %-6s %5s %5s %6s %14s %10s %8s\n", "engine", "input",
+         "inst", "thrd", "depth", "samples/sec", "IMUs@1kHz", "drop");
+
+  // sweep engine type, input mode, instances, and producer threads
+  for (type=0; type<num_type; type++) {
+    for (mode=0; mode<num_mode; mode++) {
+      for (numInst=1; numInst<=max_inst; numInst*=2) {
+        for (numThrd=1; numThrd<=numInst && numThrd<=max_thrd; numThrd*=2) {
+          fflush(stdout);
+          pid       = fork();
+          if (pid == 0)
+            exit(child((IMU_engn_type)type, (bench_mode)mode, numInst,
+                       numThrd));
+          waitpid(pid, &status, 0);
+          if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            break;
+        }
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+          break;
+      }
+    }
+  }
+
+  // exit program
+  free(datum);
+  free(data3);
+  printf("pass: bench_engn\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* generate interleaved gyro/accl/magn stream and synchronized copy
+* (level and north w/ slow oscillation and a few counts of noise)
+******************************************************************************/
+
+void stream(void)
+{
+  // define local variables
+  double            t, w;
+  int               i, j;
+
+  // main loop (one data3 for every three datum)
+  srand(1);
+  for (i=0; i<num_samp/3; i++) {
+    t               = (double)i * tick * 0.00001;
+    w               = 200.0 * sin(2.0 * M_PI * 0.5 * t);
+    data3[i].t      = (i + 1) * tick;
+    for (j=0; j<3; j++) {
+      data3[i].g[j] = (IMU_TYPE)((j == 0 ? w : 0.0) + rand() % 5 - 2);
+      data3[i].a[j] = (IMU_TYPE)((j == 2 ? 255 : 0) + rand() % 5 - 2);
+      data3[i].m[j] = (IMU_TYPE)((j == 0 ? 255 : 0) + rand() % 5 - 2);
+    }
+    for (j=0; j<3; j++) {
+      datum[3*i+j].t    = data3[i].t;
+      datum[3*i+j].type = (IMU_sensor)(IMU_gyro + j);
+    }
+    memcpy(datum[3*i].val,   data3[i].g, sizeof(datum[0].val));
+    memcpy(datum[3*i+1].val, data3[i].a, sizeof(datum[0].val));
+    memcpy(datum[3*i+2].val, data3[i].m, sizeof(datum[0].val));
+  }
+}
+
+
+/******************************************************************************
+* run one configuration (child process), returns nonzero when the instance
+* count exceeds the library capacity
+******************************************************************************/
+
+int child(
+  IMU_engn_type     type,
+  bench_mode        mode,
+  int               numInst,
+  int               numThrd)
+{
+  // define local variables
+  uint16_t          id[numInst];
+  bench_thrd        thrd[numThrd];
+  IMU_union_config  config;
+  IMU_union_state   state;
+  IMU_datum         probe = datum[0];
+  double            t_start, t_stop;
+  unsigned int      count = 0;
+  int               depth = 0, dropped = 0, status, i;
+
+  // create engines (pnts thresholds as in bench_gate)
+  for (i=0; i<numInst; i++) {
+    if (IMU_engn_init(type, &id[i]) < 0)
+      return 1;
+    if (type == IMU_engn_calb_pnts || type == IMU_engn_calb_full) {
+      IMU_engn_getConfig(id[i], IMU_engn_pnts, &config);
+      config.pnts->enable   = 1;
+      config.pnts->gThresh  = 20.0 * 20.0;
+      config.pnts->aThresh  = 30.0 * 30.0;
+      config.pnts->mThresh  = 40.0 * 40.0;
+    }
+  }
+
+  // queue depth (datum accepted before overflow, zero is pass through)
+  while ((status = IMU_engn_datum(id[0], &probe)) > depth)
+    depth           = status;
+  if (mode == mode_datum_queue && depth == 0)
+    return 0;
+
+  // start worker (queued) or reset instances (caller processes)
+  if (mode == mode_datum_queue)
+    IMU_engn_start();
+  else
+    for (i=0; i<numInst; i++)
+      IMU_engn_reset(id[i]);
+  for (i=0; i<numInst; i++) {
+    IMU_engn_getState(id[i], IMU_engn_self, &state);
+    count          -= state.engn->datumCount;
+  }
+
+  // producers own interleaved subsets of the instances
+  t_start           = now();
+  for (i=0; i<numThrd; i++) {
+    thrd[i].mode    = mode;
+    thrd[i].id      = &id[i];
+    thrd[i].numInst = (numInst - i + numThrd - 1) / numThrd;
+    thrd[i].stride  = numThrd;
+    pthread_create(&thrd[i].thrd, NULL, produce, &thrd[i]);
+  }
+  for (i=0; i<numThrd; i++) {
+    pthread_join(thrd[i].thrd, NULL);
+    dropped        += thrd[i].dropped;
+  }
+  t_stop            = now();
+
+  // processed samples (data3 counts as three sensor samples)
+  for (i=0; i<numInst; i++) {
+    IMU_engn_getState(id[i], IMU_engn_self, &state);
+    count          += state.engn->datumCount;
+  }
+  if (mode == mode_data3_sync)
+    count          *= 3;
+  double rate       = count / (t_stop - t_start);
+  printf("%-10s %-6s %5d %5d %6d %14.0f %10.1f %7.1f%%\n", type_list[type],
+         mode_list[mode], numInst, numThrd, depth, rate, rate / imu_rate,
+         100.0 * dropped / ((double)num_samp * numInst));
+  fflush(stdout);
+
+  // worker is not stopped (it may be waiting on an empty queue), process
+  // exit releases it
+  return 0;
+}
+
+
+/******************************************************************************
+* producer thread - feeds every sample to each owned instance
+******************************************************************************/
+
+void* produce(
+  void              *pntr)
+{
+  // define local variables
+  bench_thrd        *thrd   = (bench_thrd*)pntr;
+  int               stride  = thrd->stride;
+  IMU_datum         d;
+  IMU_data3         d3;
+  int               i, j;
+
+  // main loop (instances interleaved per sample, as with live sensors)
+  thrd->dropped     = 0;
+  if (thrd->mode == mode_data3_sync) {
+    for (i=0; i<num_samp/3; i++) {
+      for (j=0; j<thrd->numInst; j++) {
+        d3          = data3[i];
+        IMU_engn_data3(thrd->id[j*stride], &d3);
+      }
+    }
+  } else {
+    for (i=0; i<num_samp; i++) {
+      for (j=0; j<thrd->numInst; j++) {
+        d           = datum[i];
+        if (thrd->mode == mode_datum_sync)
+          IMU_engn_process(thrd->id[j*stride], &d);
+        else if (IMU_engn_datum(thrd->id[j*stride], &d) < 0)
+          thrd->dropped++;
+      }
+    }
+  }
+  return NULL;
+}
+
+
+/******************************************************************************
+* monotonic wall clock (seconds)
+******************************************************************************/
+
+double now(void)
+{
+  struct timespec   ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
@@ -0,0 +1,137 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "IMU_math.h"
+#include "IMU_simd.h"
+
+// define constants
+#define               num_samp      4096      // working set (fits in L2)
+static const int      num_loop    = 1000;     // passes over working set
+static const int      num_rep     = 5;        // timing passes (best kept)
+static const char*    isa_name[]  = {"scalar", "sse2", "avx2", "avx512"};
+
+// define globals (structure of arrays)
+float                 qa[4][num_samp], Ea[3][num_samp];
+
+// internal functions
+static double run       (int mode);
+static double now       (void);
+
+
+/******************************************************************************
+* main function - quaternion to Euler conversion cost (libm vs polynomial)
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  IMU_simd_isa      isa;
+  float             a[4];
+  double            ns_ref, ns;
+  int               i, j;
+
+  // random unit quaternions
+  printf("starting bench_euler...\n");
+  srand(1);
+  for (i=0; i<num_samp; i++) {
+    for (j=0; j<4; j++)
+      a[j]          = (float)(rand() % 2001 - 1000) / 1000.0f;
+    IMU_math_norm4(a);
+    for (j=0; j<4; j++)
+      qa[j][i]      = a[j];
+  }
+
+  // print table header
+  printf("%-18s %10s %10s\n", "conversion", "ns/quat", "speedup");
+
+  // per-sample scalar conversions (engine output path)
+  ns_ref            = run(-2);
+  printf("%-18s %10.2f %10.2f\n", "libm", ns_ref, 1.0);
+  ns                = run(-1);
+  printf("%-18s %10.2f %10.2f\n", "polynomial", ns, ns_ref / ns);
+
+  // batched conversion (offline export)
+  for (isa=IMU_simd_scalar; isa<=IMU_simd_bestIsa(); isa++) {
+    IMU_simd_setIsa(isa);
+    ns              = run(isa);
+    printf("batched %-10s %10.2f %10.2f\n", isa_name[isa], ns, ns_ref / ns);
+  }
+
+  // exit program
+  printf("pass: bench_euler\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* convert working set repeatedly (-2 libm, -1 polynomial, else batched),
+* returns best ns per quaternion
+******************************************************************************/
+
+double run(
+  int               mode)
+{
+  // define local variables
+  IMU_simd_quat     q = {{qa[0], qa[1], qa[2], qa[3]}};
+  IMU_simd_vect     E = {{Ea[0], Ea[1], Ea[2]}};
+  volatile float    sink = 0.0f;
+  double            t_start, ns, ns_min = 0.0;
+  float             a[4], e[3];
+  int               i, j, k;
+
+  // main timing loop
+  for (k=0; k<num_rep; k++) {
+    t_start         = now();
+    for (j=0; j<num_loop; j++) {
+      if (mode >= 0) {
+        IMU_simd_quatToEuler(&q, &E, num_samp);
+        sink       += Ea[0][0];
+        continue;
+      }
+      for (i=0; i<num_samp; i++) {
+        a[0] = qa[0][i]; a[1] = qa[1][i]; a[2] = qa[2][i]; a[3] = qa[3][i];
+        if (mode == -2)
+          IMU_math_quatToEuler(a, e);
+        else
+          IMU_math_quatToEulerFast(a, e);
+        sink       += e[0];
+      }
+    }
+    ns              = 1e9 * (now() - t_start) / ((double)num_loop * num_samp);
+    if (k == 0 || ns < ns_min)
+      ns_min        = ns;
+  }
+  return ns_min;
+}
+
+
+/******************************************************************************
+* monotonic wall clock (seconds)
+******************************************************************************/
+
+double now(void)
+{
+  struct timespec   ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
@@ -0,0 +1,263 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "IMU_engn.h"
+
+// engine internal (synchronous) processing function
+int IMU_engn_process(uint16_t id, IMU_datum*);
+
+// define constants
+static const int      num_samp    = 30000;    // 300 sec (100Hz data3)
+static const int      num_settle  = 2000;     // excluded from error (20 sec)
+static const uint32_t tick        = 1000;     // 100Hz (10usec ticks)
+static const float    gScale      = 0.001;    // rad/sec per count
+static const float    gBias[3]    = {0.02, -0.01, 0.015};   // rad/sec
+static const int      noise       = 5;        // uniform noise (+/- counts)
+static const float    dip         = 0.5;      // magnetic dip (rad)
+static const int      num_rep     = 5;        // timing passes (best kept)
+
+// filter configurations
+typedef struct {
+  const char*         name;
+  uint8_t             filter;
+  float               weight;
+  float               iWeight;
+} filter_mode;
+static const int      num_mode    = 5;
+static const filter_mode mode_list[] = {
+  {"madgwick", IMU_engn_madgwick, 0.005, 0.0},
+  {"madgwick", IMU_engn_madgwick, 0.020, 0.0},
+  {"mahony",   IMU_engn_mahony,   0.005, 0.0},
+  {"mahony",   IMU_engn_mahony,   0.020, 0.0},
+  {"mahony",   IMU_engn_mahony,   0.020, 0.5}};
+
+// internal functions
+static void   stream    (IMU_data3 *data, float *truth);
+static void   run       (uint16_t id, IMU_data3 *data, float *truth,
+                         int isData3, float *rms, float *max);
+static float  error     (float *q1, float *q2);
+static double now       (void);
+
+
+/******************************************************************************
+* main function - cost and accuracy of the madgwick and mahony backends
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  uint16_t          id;
+  IMU_union_config  config;
+  IMU_data3         *data  = malloc(num_samp * sizeof(IMU_data3));
+  float             *truth = malloc(4 * num_samp * sizeof(float));
+  double            t_start, t_stop, ns, ns_min;
+  float             rms, max, unused;
+  int               isData3, i, j;
+
+  // core only engine (cost is dominated by the filter)
+  printf("starting bench_filter...\n");
+  IMU_engn_init(IMU_engn_core_only, &id);
+  IMU_engn_getConfig(id, IMU_engn_core, &config);
+  config.core->gScale = gScale;
+  stream(data, truth);
+
+  // print table header
+  printf("%-8s %-9s %7s %7s %10s %10s %10s\n", "input", "filter",
+         "weight", "iWeight", "ns/datum", "rms (deg)", "max (deg)");
+
+  // process async datum and synchronized data3 for each filter
+  for (isData3=0; isData3<=1; isData3++) {
+    for (i=0; i<num_mode; i++) {
+      IMU_engn_getConfig(id, IMU_engn_core, &config);
+      config.core->aWeight  = mode_list[i].weight;
+      config.core->mWeight  = mode_list[i].weight;
+      config.core->iWeight  = mode_list[i].iWeight;
+      IMU_engn_getConfig(id, IMU_engn_self, &config);
+      config.engn->filter   = mode_list[i].filter;
+
+      // measure accuracy, then cost (no per-datum estimate)
+      run(id, data, truth, isData3, &rms, &max);
+      ns_min   = 0.0;
+      for (j=0; j<num_rep; j++) {
+        t_start  = now();
+        run(id, data, NULL, isData3, &unused, &unused);
+        t_stop   = now();
+        ns       = 1e9 * (t_stop - t_start) / (num_samp * (isData3 ? 1 : 3));
+        if (j == 0 || ns < ns_min)
+          ns_min = ns;
+      }
+      printf("%-8s %-9s %7.3f %7.2f %10.2f %10.3f %10.3f\n",
+             isData3 ? "data3" : "datum", mode_list[i].name,
+             mode_list[i].weight, mode_list[i].iWeight, ns_min, rms, max);
+    }
+  }
+
+  // exit program
+  free(data);
+  free(truth);
+  printf("pass: bench_filter\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* generate tumbling trajectory (biased, noisy gyro w/ matching accl/magn)
+******************************************************************************/
+
+void stream(
+  IMU_data3         *data,
+  float             *truth)
+{
+  // define local variables
+  double            q[4] = {1.0, 0.0, 0.0, 0.0};
+  double            w[3], dq[4], p[4], v[3], f[3], n, t;
+  int               i, j;
+
+  // main loop (truth propagated w/ exact rotation of body rates)
+  srand(1);
+  for (i=0; i<num_samp; i++) {
+    t               = (double)i * tick * 0.00001;
+    w[0]            = 0.8 * sin(2.0 * M_PI * 0.11 * t);
+    w[1]            = 0.6 * sin(2.0 * M_PI * 0.07 * t + 1.0);
+    w[2]            = 1.0 * sin(2.0 * M_PI * 0.05 * t + 2.0);
+
+    // rotate truth by the body rate over one sample
+    n               = sqrt(w[0]*w[0] + w[1]*w[1] + w[2]*w[2]);
+    dq[0]           = cos(0.5 * n * tick * 0.00001);
+    for (j=0; j<3; j++)
+      dq[j+1]       = (n > 0.0) ? w[j] / n * sin(0.5 * n * tick * 0.00001)
+                                : 0.0;
+    p[0]            = q[0]*dq[0] - q[1]*dq[1] - q[2]*dq[2] - q[3]*dq[3];
+    p[1]            = q[0]*dq[1] + q[1]*dq[0] + q[2]*dq[3] - q[3]*dq[2];
+    p[2]            = q[0]*dq[2] - q[1]*dq[3] + q[2]*dq[0] + q[3]*dq[1];
+    p[3]            = q[0]*dq[3] + q[1]*dq[2] - q[2]*dq[1] + q[3]*dq[0];
+    memcpy(q, p, sizeof(q));
+    for (j=0; j<4; j++)
+      truth[4*i+j]  = (float)q[j];
+
+    // up and forward vectors in the body frame (estimator model)
+    v[0]            = 2.0 * (q[1]*q[3] - q[0]*q[2]);
+    v[1]            = 2.0 * (q[0]*q[1] + q[2]*q[3]);
+    v[2]            = 1.0 - 2.0 * (q[1]*q[1] + q[2]*q[2]);
+    f[0]            = 1.0 - 2.0 * (q[2]*q[2] + q[3]*q[3]);
+    f[1]            = 2.0 * (q[1]*q[2] - q[0]*q[3]);
+    f[2]            = 2.0 * (q[0]*q[2] + q[1]*q[3]);
+
+    // sensor counts
+    data[i].t       = (i + 1) * tick;
+    for (j=0; j<3; j++) {
+      data[i].g[j]  = (IMU_TYPE)lround((w[j] + gBias[j]) / gScale +
+                                       rand() % (2*noise+1) - noise);
+      data[i].a[j]  = (IMU_TYPE)lround(255.0 * v[j] +
+                                       rand() % (2*noise+1) - noise);
+      data[i].m[j]  = (IMU_TYPE)lround(255.0 * (cos(dip)*f[j] -
+                                       sin(dip)*v[j]) +
+                                       rand() % (2*noise+1) - noise);
+    }
+  }
+}
+
+
+/******************************************************************************
+* feed stream (as async datum or data3), error computed when truth is given
+******************************************************************************/
+
+void run(
+  uint16_t          id,
+  IMU_data3         *data,
+  float             *truth,
+  int               isData3,
+  float             *rms,
+  float             *max)
+{
+  // define local variables
+  IMU_datum         datum;
+  IMU_data3         data3;
+  IMU_engn_estm     estm;
+  double            sum = 0.0;
+  float             err;
+  int               i;
+
+  // main processing loop (engine modifies datum in place)
+  IMU_engn_reset(id);
+  *max              = 0.0f;
+  for (i=0; i<num_samp; i++) {
+    if (isData3) {
+      data3         = data[i];
+      IMU_engn_data3(id, &data3);
+    } else {
+      datum.t       = data[i].t;
+      datum.type    = IMU_gyro;
+      memcpy(datum.val, data[i].g, sizeof(datum.val));
+      IMU_engn_process(id, &datum);
+      datum.type    = IMU_accl;
+      memcpy(datum.val, data[i].a, sizeof(datum.val));
+      IMU_engn_process(id, &datum);
+      datum.type    = IMU_magn;
+      memcpy(datum.val, data[i].m, sizeof(datum.val));
+      IMU_engn_process(id, &datum);
+    }
+
+    // orientation error (after settling period)
+    if (truth != NULL && i >= num_settle) {
+      IMU_engn_getEstm(id, 0, &estm);
+      err           = error(estm.qOrg, &truth[4*i]);
+      sum          += err * err;
+      if (err > *max)
+        *max        = err;
+    }
+  }
+  *rms              = (float)sqrt(sum / (num_samp - num_settle));
+}
+
+
+/******************************************************************************
+* angle between two orientations (degrees)
+******************************************************************************/
+
+float error(
+  float             *q1,
+  float             *q2)
+{
+  double n1  = sqrt(q1[0]*q1[0] + q1[1]*q1[1] + q1[2]*q1[2] + q1[3]*q1[3]);
+  double n2  = sqrt(q2[0]*q2[0] + q2[1]*q2[1] + q2[2]*q2[2] + q2[3]*q2[3]);
+  double dot = fabs(q1[0]*q2[0] + q1[1]*q2[1] + q1[2]*q2[2] + q1[3]*q2[3]);
+  dot        = dot / (n1 * n2);
+  if (dot > 1.0)
+    dot      = 1.0;
+  return (float)(2.0 * acos(dot) * 180.0 / M_PI);
+}
+
+
+/******************************************************************************
+* monotonic wall clock (seconds)
+******************************************************************************/
+
+double now(void)
+{
+  struct timespec   ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
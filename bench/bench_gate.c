@@ -0,0 +1,194 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "IMU_engn.h"
+
+// engine internal (synchronous) processing function
+int IMU_engn_process(uint16_t id, IMU_datum*);
+
+// define constants
+static const int      num_samp    = 400000;   // 200 sec (gyro/accl at 1kHz)
+static const uint32_t tick        = 50;       // 2kHz datum (10usec ticks)
+static const int      period      = 20000;    // 10 sec motion cycle (datum)
+static const int      num_duty    = 4;
+static const float    duty_list[] = {1.0, 0.5, 0.1, 0.0};
+
+// internal functions
+static void   stream    (IMU_datum *data, float duty);
+static double run       (uint16_t id, IMU_datum *data, float *q,
+                         unsigned int *gated);
+static float  error     (float *q1, float *q2);
+static double now       (void);
+
+
+/******************************************************************************
+* main function - engine cost per datum w/ and w/o motion gating
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  uint16_t          id;
+  IMU_union_config  config;
+  IMU_datum         *data = malloc(num_samp * sizeof(IMU_datum));
+  float             q_ref[4], q[4];
+  double            ns, ns_ref;
+  unsigned int      gated;
+  int               i;
+
+  // full pipeline (rect, pnts, stat, calb, core)
+  printf("starting bench_gate...\n");
+  IMU_engn_init(IMU_engn_calb_full, &id);
+  IMU_engn_getConfig(id, IMU_engn_self, &config);
+  config.engn->isFOM          = 1;
+  IMU_engn_getConfig(id, IMU_engn_pnts, &config);
+  config.pnts->enable         = 1;
+  config.pnts->gThresh        = 20.0 * 20.0;
+  config.pnts->aThresh        = 30.0 * 30.0;
+  config.pnts->mThresh        = 40.0 * 40.0;
+
+  // print table header
+  printf("%-8s %10s %10s %10s %10s %12s\n", "motion", "gated",
+         "ns/datum", "ns (gate)", "speedup", "err (deg)");
+
+  // process each motion duty cycle w/ and w/o gating
+  for (i=0; i<num_duty; i++) {
+    stream(data, duty_list[i]);
+    IMU_engn_getConfig(id, IMU_engn_self, &config);
+    config.engn->isGate       = 0;
+    ns_ref = run(id, data, q_ref, &gated);
+    config.engn->isGate       = 1;
+    ns     = run(id, data, q, &gated);
+    printf("%7.0f%% %9.1f%% %10.2f %10.2f %10.2f %12.6f\n",
+           100.0 * duty_list[i], 100.0 * gated / num_samp, ns_ref, ns,
+           ns_ref / ns, error(q, q_ref));
+  }
+
+  // exit program
+  free(data);
+  printf("pass: bench_gate\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* generate interleaved gyro/accl stream (motion for duty fraction of cycle)
+******************************************************************************/
+
+void stream(
+  IMU_datum         *data,
+  float             duty)
+{
+  // define local variables
+  double            t, w;
+  int               i, isMove;
+
+  // main loop (sensor noise of a few counts on every axis)
+  srand(1);
+  for (i=0; i<num_samp; i++) {
+    t               = (double)i * tick * 0.00001;
+    isMove          = (i % period) < (int)(duty * period);
+    w               = isMove ? 200.0 * sin(2.0 * M_PI * 0.5 * t) : 0.0;
+    data[i].t       = i * tick;
+    if (i % 2 == 0) {
+      data[i].type    = IMU_gyro;
+      data[i].val[0]  = (IMU_TYPE)(w + rand() % 5 - 2);
+      data[i].val[1]  = (IMU_TYPE)(rand() % 5 - 2);
+      data[i].val[2]  = (IMU_TYPE)(rand() % 5 - 2);
+    } else {
+      data[i].type    = IMU_accl;
+      data[i].val[0]  = (IMU_TYPE)(rand() % 5 - 2);
+      data[i].val[1]  = (IMU_TYPE)(rand() % 5 - 2);
+      data[i].val[2]  = (IMU_TYPE)(255 + rand() % 5 - 2);
+    }
+  }
+}
+
+
+/******************************************************************************
+* feed stream, returns ns per datum, final quaternion, and gated count
+******************************************************************************/
+
+double run(
+  uint16_t          id,
+  IMU_datum         *data,
+  float             *q,
+  unsigned int      *gated)
+{
+  // define local variables
+  IMU_datum         datum;
+  IMU_engn_estm     estm;
+  IMU_union_state   engn;
+  unsigned int      gateStart;
+  double            t_start, t_stop;
+  int               i;
+
+  // main processing loop (engine modifies datum in place)
+  IMU_engn_reset(id);
+  IMU_engn_getState(id, IMU_engn_self, &engn);
+  gateStart         = engn.engn->gateCount;
+  t_start           = now();
+  for (i=0; i<num_samp; i++) {
+    datum           = data[i];
+    IMU_engn_process(id, &datum);
+  }
+  t_stop            = now();
+
+  // return estimate, gated count, and cost
+  IMU_engn_getEstm(id, 0, &estm);
+  memcpy(q, estm.qOrg, sizeof(estm.qOrg));
+  *gated            = engn.engn->gateCount - gateStart;
+  return 1e9 * (t_stop - t_start) / num_samp;
+}
+
+
+/******************************************************************************
+* angle between two orientations (degrees)
+******************************************************************************/
+
+float error(
+  float             *q1,
+  float             *q2)
+{
+  double n1  = sqrt(q1[0]*q1[0] + q1[1]*q1[1] + q1[2]*q1[2] + q1[3]*q1[3]);
+  double n2  = sqrt(q2[0]*q2[0] + q2[1]*q2[1] + q2[2]*q2[2] + q2[3]*q2[3]);
+  double dot = fabs(q1[0]*q2[0] + q1[1]*q2[1] + q1[2]*q2[2] + q1[3]*q2[3]);
+  dot        = dot / (n1 * n2);
+  if (dot > 1.0)
+    dot      = 1.0;
+  return (float)(2.0 * acos(dot) * 180.0 / M_PI);
+}
+
+
+/******************************************************************************
+* monotonic wall clock (seconds)
+******************************************************************************/
+
+double now(void)
+{
+  struct timespec   ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
@@ -0,0 +1,220 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "IMU_math.h"
+#include "IMU_core.h"
+
+// define constants
+static const double duration   = 3.6;      // applyGyroTest.csv length (sec)
+static const double truth_dt   = 0.000001;  // reference integration step
+static const int   num_rep     = 2000;     // timing repetitions
+static const int   num_dt      = 5;
+static const float dt_list[5]  = {0.0025, 0.005, 0.01, 0.02, 0.04};
+static const char* name_list[] = {"euler", "exp", "rk4"};
+
+// trajectory definitions
+typedef enum {
+  traj_constant     = 0,                   // applyGyroTest.csv (roll)
+  traj_coning       = 1                    // coning w/ yaw rate
+} traj_type;
+static const char* traj_name[] = {"constant", "coning"};
+
+// internal functions
+static void   rate      (traj_type traj, double t, double *g);
+static void   truth     (traj_type traj, float *q);
+static int    integrate (traj_type traj, IMU_core_gyro mode, float dt,
+                         float *q);
+static float  error     (float *q1, float *q2);
+static double now       (void);
+
+
+/******************************************************************************
+* main function - error vs cost of each gyroscope integrator
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  float             q_ref[4], q[4];
+  double            t_start, t_stop;
+  int               num_step, traj, mode, i, j;
+
+  // print table header
+  printf("starting bench_gyro...\n");
+  printf("%-9s %-6s %8s %12s %10s\n",
+         "traj", "method", "dt", "err (deg)", "ns/step");
+
+  // process each trajectory, integrator, and time step
+  for (traj=traj_constant; traj<=traj_coning; traj++) {
+    truth((traj_type)traj, q_ref);
+    for (i=0; i<num_dt; i++) {
+      for (mode=IMU_core_gyro_euler; mode<=IMU_core_gyro_rk4; mode++) {
+
+        // measure accuracy (single pass)
+        num_step = integrate((traj_type)traj, (IMU_core_gyro)mode,
+                             dt_list[i], q);
+        float err = error(q, q_ref);
+
+        // measure cost (repeated passes)
+        t_start  = now();
+        for (j=0; j<num_rep; j++)
+          integrate((traj_type)traj, (IMU_core_gyro)mode, dt_list[i], q);
+        t_stop   = now();
+        double ns = 1e9 * (t_stop - t_start) / ((double)num_rep * num_step);
+
+        // print results
+        printf("%-9s %-6s %8.4f %12.6f %10.2f\n", traj_name[traj],
+               name_list[mode], dt_list[i], err, ns);
+      }
+    }
+  }
+
+  // exit program
+  printf("pass: bench_gyro\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* gyroscope rates (rad/sec) at time t
+******************************************************************************/
+
+void rate(
+  traj_type         traj,
+  double            t,
+  double            *g)
+{
+  if (traj == traj_constant) {
+    g[0]            = 262 * 0.001;
+    g[1]            = 0.0;
+    g[2]            = 0.0;
+  } else {
+    g[0]            = 1.5 * sin(2.0 * M_PI * 2.0 * t);
+    g[1]            = 1.5 * cos(2.0 * M_PI * 2.0 * t);
+    g[2]            = 0.3;
+  }
+}
+
+
+/******************************************************************************
+* reference orientation (double precision, fine step exponential map)
+******************************************************************************/
+
+void truth(
+  traj_type         traj,
+  float             *q_out)
+{
+  // define local variables
+  int               num_step = (int)(duration / truth_dt + 0.5);
+  double            q[4]     = {1.0, 0.0, 0.0, 0.0};
+  double            g[3], dq[4], tmp[4], norm, theta, s;
+  int               i;
+
+  // main processing loop (midpoint rate over each fine step)
+  for (i=0; i<num_step; i++) {
+    rate(traj, ((double)i + 0.5) * truth_dt, g);
+    norm            = sqrt(g[0]*g[0] + g[1]*g[1] + g[2]*g[2]);
+    theta           = 0.5 * truth_dt * norm;
+    s               = (norm > 0.0) ? sin(theta) / norm : 0.0;
+    dq[0]           = cos(theta);
+    dq[1]           = s * g[0];
+    dq[2]           = s * g[1];
+    dq[3]           = s * g[2];
+    tmp[0]          = q[0]*dq[0] - q[1]*dq[1] - q[2]*dq[2] - q[3]*dq[3];
+    tmp[1]          = q[0]*dq[1] + q[1]*dq[0] + q[2]*dq[3] - q[3]*dq[2];
+    tmp[2]          = q[0]*dq[2] - q[1]*dq[3] + q[2]*dq[0] + q[3]*dq[1];
+    tmp[3]          = q[0]*dq[3] + q[1]*dq[2] - q[2]*dq[1] + q[3]*dq[0];
+    memcpy(q, tmp, sizeof(q));
+  }
+  for (i=0; i<4; i++)
+    q_out[i]        = (float)q[i];
+}
+
+
+/******************************************************************************
+* integrate sampled gyroscope trajectory with specified method
+******************************************************************************/
+
+int integrate(
+  traj_type         traj,
+  IMU_core_gyro     mode,
+  float             dt,
+  float             *q)
+{
+  // define local variables
+  int               num_step = (int)(duration / dt + 0.5f);
+  double            g[3];
+  float             g0[3], g1[3];
+  int               i;
+
+  // main processing loop (sensor reports rate at end of interval)
+  q[0] = 1.0f; q[1] = 0.0f; q[2] = 0.0f; q[3] = 0.0f;
+  rate(traj, 0.0, g);
+  for (i=0; i<3; i++)
+    g0[i]           = (float)g[i];
+  for (i=1; i<=num_step; i++) {
+    rate(traj, (double)i * dt, g);
+    g1[0]           = (float)g[0];
+    g1[1]           = (float)g[1];
+    g1[2]           = (float)g[2];
+    if      (mode == IMU_core_gyro_exp)
+      IMU_math_estmGyroExp(q, g1, dt);
+    else if (mode == IMU_core_gyro_rk4)
+      IMU_math_estmGyroRK4(q, g0, g1, dt);
+    else
+      IMU_math_estmGyro(q, g1, dt);
+    memcpy(g0, g1, sizeof(g0));
+  }
+  return num_step;
+}
+
+
+/******************************************************************************
+* angle between two orientations (degrees)
+******************************************************************************/
+
+float error(
+  float             *q1,
+  float             *q2)
+{
+  double norm = sqrt(q1[0]*q1[0] + q1[1]*q1[1] + q1[2]*q1[2] + q1[3]*q1[3]);
+  double dot  = fabs(q1[0]*q2[0] + q1[1]*q2[1] + q1[2]*q2[2] + q1[3]*q2[3]);
+  dot         = dot / norm;
+  if (dot > 1.0)
+    dot       = 1.0;
+  return (float)(2.0 * acos(dot) * 180.0 / M_PI);
+}
+
+
+/******************************************************************************
+* monotonic wall clock (seconds)
+******************************************************************************/
+
+double now(void)
+{
+  struct timespec   ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
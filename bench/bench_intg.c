@@ -0,0 +1,159 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "IMU_engn.h"
+
+// engine internal (synchronous) processing function
+int IMU_engn_process(uint16_t id, IMU_datum*);
+
+// define constants
+static const int      num_samp    = 400000;   // 50 sec at 8kHz
+static const uint32_t tick        = 12;       // ~8kHz gyro (10usec ticks)
+static const int      num_decm    = 5;
+static const int      decm_list[] = {1, 2, 4, 8, 16};
+
+// internal functions
+static double run       (uint16_t id, IMU_datum *data, float *q);
+static float  error     (float *q1, float *q2);
+static double now       (void);
+
+
+/******************************************************************************
+* main function - engine cost per gyro datum w/ and w/o pre-integration
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  uint16_t          id;
+  IMU_union_config  config;
+  float             q_ref[4], q[4];
+  double            ns, ns_ref, t;
+  int               i;
+
+  // generate gyroscope stream (0.5 rad/sec cone at 5Hz w/ 0.1 rad/sec yaw)
+  IMU_datum         *data = malloc(num_samp * sizeof(IMU_datum));
+  for (i=0; i<num_samp; i++) {
+    t               = (double)i * tick * 0.00001;
+    data[i].type    = IMU_gyro;
+    data[i].t       = i * tick;
+    data[i].val[0]  = (IMU_TYPE)(500.0 * sin(2.0 * M_PI * 5.0 * t));
+    data[i].val[1]  = (IMU_TYPE)(500.0 * cos(2.0 * M_PI * 5.0 * t));
+    data[i].val[2]  = 100;
+  }
+
+  // full pipeline (rect, pnts, stat, calb, core, sensor struct)
+  printf("starting bench_intg...\n");
+  IMU_engn_init(IMU_engn_calb_full, &id);
+  IMU_engn_getConfig(id, IMU_engn_self, &config);
+  config.engn->isFOM          = 1;
+  config.engn->isSensorStruct = 1;
+  IMU_engn_getConfig(id, IMU_engn_pnts, &config);
+  config.pnts->enable         = 1;
+
+  // reference run (every datum through the pipeline)
+  ns_ref = run(id, data, q_ref);
+  printf("%-10s %8s %10s %10s %12s\n",
+         "mode", "numSamp", "ns/datum", "speedup", "err (deg)");
+  printf("%-10s %8d %10.2f %10.2f %12.6f\n",
+         "per-datum", 1, ns_ref, 1.0, 0.0);
+
+  // pre-integrated runs
+  IMU_engn_getConfig(id, IMU_engn_self, &config);
+  config.engn->isIntg         = 1;
+  IMU_engn_getConfig(id, IMU_engn_intg, &config);
+  for (i=0; i<num_decm; i++) {
+    config.intg->numSamp      = decm_list[i];
+    ns = run(id, data, q);
+    printf("%-10s %8d %10.2f %10.2f %12.6f\n", "intg",
+           decm_list[i], ns, ns_ref / ns, error(q, q_ref));
+  }
+
+  // exit program
+  free(data);
+  printf("pass: bench_intg\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* feed gyroscope stream, returns ns per datum and final quaternion
+******************************************************************************/
+
+double run(
+  uint16_t          id,
+  IMU_datum         *data,
+  float             *q)
+{
+  // define local variables
+  IMU_datum         datum;
+  IMU_engn_estm     estm;
+  double            t_start, t_stop;
+  int               i;
+
+  // main processing loop (engine modifies datum in place)
+  IMU_engn_reset(id);
+  t_start           = now();
+  for (i=0; i<num_samp; i++) {
+    datum           = data[i];
+    IMU_engn_process(id, &datum);
+  }
+  t_stop            = now();
+
+  // return estimate and cost
+  IMU_engn_getEstm(id, 0, &estm);
+  memcpy(q, estm.qOrg, sizeof(estm.qOrg));
+  return 1e9 * (t_stop - t_start) / num_samp;
+}
+
+
+/******************************************************************************
+* angle between two orientations (degrees)
+******************************************************************************/
+
+float error(
+  float             *q1,
+  float             *q2)
+{
+  double n1  = sqrt(q1[0]*q1[0] + q1[1]*q1[1] + q1[2]*q1[2] + q1[3]*q1[3]);
+  double n2  = sqrt(q2[0]*q2[0] + q2[1]*q2[1] + q2[2]*q2[2] + q2[3]*q2[3]);
+  double dot = fabs(q1[0]*q2[0] + q1[1]*q2[1] + q1[2]*q2[2] + q1[3]*q2[3]);
+  dot        = dot / (n1 * n2);
+  if (dot > 1.0)
+    dot      = 1.0;
+  return (float)(2.0 * acos(dot) * 180.0 / M_PI);
+}
+
+
+/******************************************************************************
+* monotonic wall clock (seconds)
+******************************************************************************/
+
+double now(void)
+{
+  struct timespec   ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
@@ -0,0 +1,697 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <unistd.h>
+#include "IMU_math.h"
+#include "IMU_rect.h"
+#include "IMU_pnts.h"
+#include "IMU_core.h"
+#include "IMU_engn.h"
+#include "bench_perf.h"
+
+// engine internal (synchronous) processing function
+int IMU_engn_process(uint16_t id, IMU_datum*);
+
+// define constants
+static const int      num_op      = 65536;    // operations per timing pass
+static const int      num_warm    = 3;        // untimed warm-up passes
+static const int      num_rep     = 15;       // timed passes (median kept)
+static const uint32_t tick        = 100;      // 1kHz per sensor (10usec)
+#define BENCH_STR(x)  #x
+#define BENCH_XSTR(x) BENCH_STR(x)
+
+// benchmark case definition (init is untimed, run executes num_op ops)
+typedef struct {
+  const char*         group;
+  const char*         name;
+  void                (*init)(void);
+  void                (*run)(void);
+} kern_case;
+
+// benchmark result
+typedef struct {
+  double              ns_min;
+  double              ns_med;
+  double              ns_max;
+  double              perf[BENCH_PERF_NUM];   // counts per op (-1 missing)
+} kern_result;
+
+// shared inputs (unit vectors/quaternions and sensor stream)
+static float          *vect;
+static float          *quat;
+static IMU_datum      *datum;
+static IMU_data3      *data3;
+static float          q_state[4];
+static volatile float sink;
+static uint16_t       idRect, idPnts, idCore, idEngn;
+
+// internal functions
+static void   stream    (void);
+static void   measure   (const kern_case *kern, kern_result *result);
+static void   count     (const kern_case *kern, kern_result *result,
+                         bench_perf *perf);
+static void   print_perf(const kern_case *kern, kern_result *result);
+static void   write_json(FILE *file, kern_result *result, int isPerf);
+static int    compare   (const void *a, const void *b);
+static double now       (void);
+
+
+/******************************************************************************
+* IMU_math primitives (independent inputs, results summed into sink)
+******************************************************************************/
+
+static void math_rsqrt(void)
+{
+  float s = 0.0f;
+  for (int i=0; i<num_op; i++)
+    s += IMU_math_rsqrt(1.0f + vect[4*i]*vect[4*i]);
+  sink = s;
+}
+
+static void math_norm3(void)
+{
+  float v[3], s = 0.0f;
+  for (int i=0; i<num_op; i++) {
+    memcpy(v, &vect[4*i], sizeof(v));
+    s += IMU_math_norm3(v) + v[0];
+  }
+  sink = s;
+}
+
+static void math_norm4(void)
+{
+  float q[4], s = 0.0f;
+  for (int i=0; i<num_op; i++) {
+    memcpy(q, &quat[4*i], sizeof(q));
+    s += IMU_math_norm4(q) + q[0];
+  }
+  sink = s;
+}
+
+static void math_quatMult(void)
+{
+  float out[4], s = 0.0f;
+  for (int i=1; i<num_op; i++)
+    s += IMU_math_quatMult(&quat[4*i], &quat[4*i-4], out)[0];
+  sink = s;
+}
+
+static void math_rotateForward(void)
+{
+  float out[3], s = 0.0f;
+  for (int i=0; i<num_op; i++)
+    s += IMU_math_rotateForward(&vect[4*i], &quat[4*i], out)[0];
+  sink = s;
+}
+
+static void math_quatToDCM(void)
+{
+  float R[9], s = 0.0f;
+  for (int i=0; i<num_op; i++)
+    s += IMU_math_quatToDCM(&quat[4*i], R)[4];
+  sink = s;
+}
+
+static void math_quatToUp(void)
+{
+  float u[3], s = 0.0f;
+  for (int i=0; i<num_op; i++)
+    s += IMU_math_quatToUp(&quat[4*i], u)[2];
+  sink = s;
+}
+
+static void math_upFrwdToQuat(void)
+{
+  float q[4], s = 0.0f;
+  for (int i=0; i<num_op; i++)
+    s += IMU_math_upFrwdToQuat(&vect[4*i], &quat[4*i+1], q)[0];
+  sink = s;
+}
+
+static void math_quatToEuler(void)
+{
+  float E[3], s = 0.0f;
+  for (int i=0; i<num_op; i++)
+    s += IMU_math_quatToEuler(&quat[4*i], E)[0];
+  sink = s;
+}
+
+static void math_quatToEulerFast(void)
+{
+  float E[3], s = 0.0f;
+  for (int i=0; i<num_op; i++)
+    s += IMU_math_quatToEulerFast(&quat[4*i], E)[0];
+  sink = s;
+}
+
+
+/******************************************************************************
+* IMU_math filter updates (dependent chain on a single quaternion, as in the
+* core where each update feeds the next)
+******************************************************************************/
+
+static void math_init(void)
+{
+  float q[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+  memcpy(q_state, q, sizeof(q));
+}
+
+static void math_estmGyro(void)
+{
+  for (int i=0; i<num_op; i++)
+    IMU_math_estmGyro(q_state, &vect[4*i], 0.001f);
+  sink = q_state[0];
+}
+
+static void math_estmGyroExp(void)
+{
+  for (int i=0; i<num_op; i++)
+    IMU_math_estmGyroExp(q_state, &vect[4*i], 0.001f);
+  sink = q_state[0];
+}
+
+static void math_estmGyroRK4(void)
+{
+  for (int i=1; i<num_op; i++)
+    IMU_math_estmGyroRK4(q_state, &vect[4*i-4], &vect[4*i], 0.001f);
+  sink = q_state[0];
+}
+
+static void math_estmAccl(void)
+{
+  float FOM;
+  for (int i=0; i<num_op; i++)
+    IMU_math_estmAccl(q_state, &vect[4*i], 0.01f, &FOM);
+  sink = q_state[0];
+}
+
+static void math_estmMagnNorm(void)
+{
+  float FOM;
+  for (int i=0; i<num_op; i++)
+    IMU_math_estmMagnNorm(q_state, &vect[4*i], 0.01f, &FOM);
+  sink = q_state[0];
+}
+
+static void math_estmFused(void)
+{
+  float FOM[2];
+  for (int i=1; i<num_op; i++)
+    IMU_math_estmFused(q_state, &vect[4*i-4], 0.001f, &vect[4*i],
+                       &quat[4*i+1], 0.01f, 0.01f, FOM);
+  sink = q_state[0];
+}
+
+static void math_mhnyAccl(void)
+{
+  float e[3], FOM;
+  for (int i=0; i<num_op; i++)
+    IMU_math_mhnyAccl(q_state, &vect[4*i], 0.01f, e, &FOM);
+  sink = q_state[0];
+}
+
+static void math_mhnyMagn(void)
+{
+  float e[3], FOM;
+  for (int i=0; i<num_op; i++)
+    IMU_math_mhnyMagn(q_state, &vect[4*i], 0.01f, e, &FOM);
+  sink = q_state[0];
+}
+
+static void math_mhnyFused(void)
+{
+  float e[3], FOM[2];
+  for (int i=1; i<num_op; i++)
+    IMU_math_mhnyFused(q_state, &vect[4*i-4], 0.001f, &vect[4*i],
+                       &quat[4*i+1], 0.01f, 0.01f, e, FOM);
+  sink = q_state[0];
+}
+
+
+/******************************************************************************
+* subsystem entry points (sensor stream, copied since callers modify datum)
+******************************************************************************/
+
+static void rect_datum(void)
+{
+  IMU_datum d;
+  for (int i=0; i<num_op; i++) {
+    d = datum[i];
+    IMU_rect_datum(idRect, &d);
+  }
+}
+
+static void rect_data3(void)
+{
+  IMU_data3 d;
+  for (int i=0; i<num_op; i++) {
+    d = data3[i];
+    IMU_rect_data3(idRect, &d);
+  }
+}
+
+static void pnts_init(void)
+{
+  IMU_pnts_reset(idPnts);
+  IMU_pnts_start(idPnts, UINT16_MAX);
+}
+
+static void pnts_datum(void)
+{
+  IMU_pnts_entry *entry;
+  IMU_datum d;
+  for (int i=0; i<num_op; i++) {
+    d = datum[i];
+    IMU_pnts_datum(idPnts, &d, &entry);
+  }
+}
+
+static void pnts_data3(void)
+{
+  IMU_pnts_entry *entry;
+  IMU_data3 d;
+  for (int i=0; i<num_op; i++) {
+    d = data3[i];
+    IMU_pnts_data3(idPnts, &d, &entry);
+  }
+}
+
+static void core_init(void)
+{
+  IMU_core_reset(idCore);
+}
+
+static void core_datum(void)
+{
+  IMU_datum d;
+  for (int i=0; i<num_op; i++) {
+    d = datum[i];
+    IMU_core_datum(idCore, &d, NULL);
+  }
+}
+
+static void core_data3(void)
+{
+  IMU_data3 d;
+  for (int i=0; i<num_op; i++) {
+    d = data3[i];
+    IMU_core_data3(idCore, &d, NULL);
+  }
+}
+
+static void core_mhnyDatum(void)
+{
+  IMU_datum d;
+  for (int i=0; i<num_op; i++) {
+    d = datum[i];
+    IMU_core_mhnyDatum(idCore, &d, NULL);
+  }
+}
+
+static void core_mhnyData3(void)
+{
+  IMU_data3 d;
+  for (int i=0; i<num_op; i++) {
+    d = data3[i];
+    IMU_core_mhnyData3(idCore, &d, NULL);
+  }
+}
+
+static void engn_init(void)
+{
+  IMU_engn_reset(idEngn);
+}
+
+static void engn_process(void)
+{
+  IMU_datum d;
+  for (int i=0; i<num_op; i++) {
+    d = datum[i];
+    IMU_engn_process(idEngn, &d);
+  }
+}
+
+static void engn_data3(void)
+{
+  IMU_data3 d;
+  for (int i=0; i<num_op; i++) {
+    d = data3[i];
+    IMU_engn_data3(idEngn, &d);
+  }
+}
+
+
+// benchmark case list
+static const kern_case case_list[] = {
+  {"math",  "IMU_math_rsqrt",           NULL,      math_rsqrt},
+  {"math",  "IMU_math_norm3",           NULL,      math_norm3},
+  {"math",  "IMU_math_norm4",           NULL,      math_norm4},
+  {"math",  "IMU_math_quatMult",        NULL,      math_quatMult},
+  {"math",  "IMU_math_rotateForward",   NULL,      math_rotateForward},
+  {"math",  "IMU_math_quatToDCM",       NULL,      math_quatToDCM},
+  {"math",  "IMU_math_quatToUp",        NULL,      math_quatToUp},
+  {"math",  "IMU_math_upFrwdToQuat",    NULL,      math_upFrwdToQuat},
+  {"math",  "IMU_math_quatToEuler",     NULL,      math_quatToEuler},
+  {"math",  "IMU_math_quatToEulerFast", NULL,      math_quatToEulerFast},
+  {"math",  "IMU_math_estmGyro",        math_init, math_estmGyro},
+  {"math",  "IMU_math_estmGyroExp",     math_init, math_estmGyroExp},
+  {"math",  "IMU_math_estmGyroRK4",     math_init, math_estmGyroRK4},
+  {"math",  "IMU_math_estmAccl",        math_init, math_estmAccl},
+  {"math",  "IMU_math_estmMagnNorm",    math_init, math_estmMagnNorm},
+  {"math",  "IMU_math_estmFused",       math_init, math_estmFused},
+  {"math",  "IMU_math_mhnyAccl",        math_init, math_mhnyAccl},
+  {"math",  "IMU_math_mhnyMagn",        math_init, math_mhnyMagn},
+  {"math",  "IMU_math_mhnyFused",       math_init, math_mhnyFused},
+  {"rect",  "IMU_rect_datum",           NULL,      rect_datum},
+  {"rect",  "IMU_rect_data3",           NULL,      rect_data3},
+  {"pnts",  "IMU_pnts_datum",           pnts_init, pnts_datum},
+  {"pnts",  "IMU_pnts_data3",           pnts_init, pnts_data3},
+  {"core",  "IMU_core_datum",           core_init, core_datum},
+  {"core",  "IMU_core_data3",           core_init, core_data3},
+  {"core",  "IMU_core_mhnyDatum",       core_init, core_mhnyDatum},
+  {"core",  "IMU_core_mhnyData3",       core_init, core_mhnyData3},
+  {"engn",  "IMU_engn_process",         engn_init, engn_process},
+  {"engn",  "IMU_engn_data3",           engn_init, engn_data3}};
+static const int num_case = sizeof(case_list) / sizeof(case_list[0]);
+
+
+/******************************************************************************
+* main function - per kernel cost (table, optional json file argument)
+* usage: bench_kern [-c] [file.json | -], -c adds hardware counters per op
+******************************************************************************/
+
+int main(
+  int                 argc,
+  char                **argv)
+{
+  // define local variables
+  IMU_rect_config     *rect;
+  IMU_pnts_config     *pnts;
+  IMU_core_config     *core;
+  IMU_union_config    config;
+  kern_result         *result = malloc(num_case * sizeof(kern_result));
+  bench_perf          perf;
+  FILE                *file;
+  char                *path   = NULL;
+  int                 isPerf  = 0;
+  int                 opt, i;
+
+  // parse options (counters flag, json path)
+  while ((opt = getopt(argc, argv, "c")) != -1) {
+    if (opt == 'c') {
+      isPerf        = 1;
+    } else {
+      printf("usage: %s [-c] [file.json | -]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (optind < argc)
+    path            = argv[optind];
+
+  // standalone subsystems plus full pipeline engine
+  printf("starting bench_kern...\n");
+  vect              = malloc(4 * (num_op + 1) * sizeof(float));
+  quat              = malloc(4 * (num_op + 1) * sizeof(float));
+  datum             = malloc(num_op * sizeof(IMU_datum));
+  data3             = malloc(num_op * sizeof(IMU_data3));
+  stream();
+  IMU_rect_init(&idRect, &rect);
+  IMU_pnts_init(&idPnts, &pnts);
+  pnts->enable      = 1;
+  pnts->gThresh     = 20.0 * 20.0;
+  pnts->aThresh     = 30.0 * 30.0;
+  pnts->mThresh     = 40.0 * 40.0;
+  IMU_core_init(&idCore, &core);
+  IMU_engn_init(IMU_engn_calb_full, &idEngn);
+  IMU_engn_getConfig(idEngn, IMU_engn_pnts, &config);
+  config.pnts->enable = 1;
+
+  // print table header
+  printf("%-6s %-26s %10s %10s %10s %14s\n", "group", "function",
+         "ns/op", "ns (min)", "ns (max)", "ops/sec");
+
+  // time each case
+  for (i=0; i<num_case; i++) {
+    measure(&case_list[i], &result[i]);
+    printf("%-6s %-26s %10.2f %10.2f %10.2f %14.0f\n", case_list[i].group,
+           case_list[i].name, result[i].ns_med, result[i].ns_min,
+           result[i].ns_max, 1e9 / result[i].ns_med);
+  }
+
+  // hardware counters per op (separate passes, timing is not perturbed)
+  if (isPerf && perf_open(&perf) == 0) {
+    printf("\nwarning: hardware counters unavailable (%s)\n",
+           strerror(perf.err));
+    isPerf          = 0;
+  }
+  if (isPerf) {
+    printf("\n%-6s %-26s %10s %10s %6s %10s %10s %10s\n", "group",
+           "function", "cycles/op", "instr/op", "IPC", "brMiss/op",
+           "l1dMiss/op", "llcMiss/op");
+    for (i=0; i<num_case; i++) {
+      count(&case_list[i], &result[i], &perf);
+      print_perf(&case_list[i], &result[i]);
+    }
+    perf_close(&perf);
+  }
+
+  // write json results ("-" for stdout)
+  if (path != NULL) {
+    file            = strcmp(path, "-") ? fopen(path, "w") : stdout;
+    if (file == NULL) {
+      printf("error: unable to write %s\n", path);
+      exit(0);
+    }
+    write_json(file, result, isPerf);
+    if (file != stdout)
+      fclose(file);
+  }
+
+  // exit program
+  free(vect);
+  free(quat);
+  free(datum);
+  free(data3);
+  free(result);
+  printf("pass: bench_kern\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* generate unit vectors, unit quaternions, and an interleaved sensor stream
+* (level and north w/ slow oscillation and a few counts of noise)
+******************************************************************************/
+
+void stream(void)
+{
+  // define local variables
+  double            t, w;
+  int               i, j;
+
+  // random unit vectors and quaternions
+  srand(1);
+  for (i=0; i<=num_op; i++) {
+    for (j=0; j<4; j++) {
+      vect[4*i+j]   = (float)(rand() % 2001 - 1000) / 1000.0f;
+      quat[4*i+j]   = (float)(rand() % 2001 - 1000) / 1000.0f;
+    }
+    vect[4*i+3]     = 0.0f;
+    if (IMU_math_norm3(&vect[4*i]) < 0.01f)
+      vect[4*i]     = 1.0f;
+    if (IMU_math_norm4(&quat[4*i]) < 0.01f)
+      quat[4*i]     = 1.0f;
+  }
+
+  // sensor stream (gyro/accl/magn interleaved, synchronized copy)
+  for (i=0; i<num_op; i++) {
+    t               = (double)i * tick * 0.00001;
+    w               = 200.0 * sin(2.0 * M_PI * 0.5 * t);
+    data3[i].t      = (i + 1) * tick;
+    for (j=0; j<3; j++) {
+      data3[i].g[j] = (IMU_TYPE)((j == 0 ? w : 0.0) + rand() % 5 - 2);
+      data3[i].a[j] = (IMU_TYPE)((j == 2 ? 255 : 0) + rand() % 5 - 2);
+      data3[i].m[j] = (IMU_TYPE)((j == 0 ? 255 : 0) + rand() % 5 - 2);
+    }
+    datum[i].t      = data3[i].t;
+    datum[i].type   = (IMU_sensor)(IMU_gyro + i % 3);
+    memcpy(datum[i].val, datum[i].type == IMU_gyro ? data3[i].g :
+                         datum[i].type == IMU_accl ? data3[i].a : data3[i].m,
+           sizeof(datum[i].val));
+  }
+}
+
+
+/******************************************************************************
+* warm-up then timed passes, reports min/median/max ns per operation
+******************************************************************************/
+
+void measure(
+  const kern_case   *kern,
+  kern_result       *result)
+{
+  // define local variables
+  double            ns[num_rep];
+  double            t_start;
+  int               i;
+
+  // warm-up (caches, branch predictors, frequency ramp)
+  for (i=0; i<num_warm; i++) {
+    if (kern->init != NULL)
+      kern->init();
+    kern->run();
+  }
+
+  // timed passes (setup excluded)
+  for (i=0; i<num_rep; i++) {
+    if (kern->init != NULL)
+      kern->init();
+    t_start         = now();
+    kern->run();
+    ns[i]           = 1e9 * (now() - t_start) / num_op;
+  }
+  qsort(ns, num_rep, sizeof(double), compare);
+  result->ns_min    = ns[0];
+  result->ns_med    = ns[num_rep / 2];
+  result->ns_max    = ns[num_rep - 1];
+}
+
+
+/******************************************************************************
+* counted passes (setup excluded), reports counts per operation
+******************************************************************************/
+
+void count(
+  const kern_case   *kern,
+  kern_result       *result,
+  bench_perf        *perf)
+{
+  // define local variables
+  double            sum[BENCH_PERF_NUM];
+  int               i, j;
+
+  // accumulate over the same number of passes as the timing
+  memset(sum, 0, sizeof(sum));
+  for (i=0; i<num_rep; i++) {
+    if (kern->init != NULL)
+      kern->init();
+    perf_start(perf);
+    kern->run();
+    perf_stop(perf);
+    for (j=0; j<BENCH_PERF_NUM; j++)
+      sum[j]       += (double)perf->val[j];
+  }
+  for (j=0; j<BENCH_PERF_NUM; j++)
+    result->perf[j] = perf->isValid[j] ? sum[j] / num_rep / num_op : -1.0;
+}
+
+
+/******************************************************************************
+* print counter row (missing counters shown as n/a)
+******************************************************************************/
+
+void print_perf(
+  const kern_case   *kern,
+  kern_result       *result)
+{
+  double            *c = result->perf;
+  int               j;
+  printf("%-6s %-26s", kern->group, kern->name);
+  for (j=0; j<BENCH_PERF_NUM; j++) {
+    if (j == bench_perf_brMiss) {
+      if (c[bench_perf_cycles] > 0.0 && c[bench_perf_instr] >= 0.0)
+        printf(" %6.2f", c[bench_perf_instr] / c[bench_perf_cycles]);
+      else
+        printf(" %6s", "n/a");
+    }
+    if (c[j] >= 0.0)
+      printf(" %10.3f", c[j]);
+    else
+      printf(" %10s", "n/a");
+  }
+  printf("\n");
+}
+
+
+/******************************************************************************
+* write results as json (one object per case, counters when measured)
+******************************************************************************/
+
+void write_json(
+  FILE              *file,
+  kern_result       *result,
+  int               isPerf)
+{
+  int               i, j;
+  fprintf(file, "{\n");
+  fprintf(file, "  \"bench\": \"bench_kern\",\n");
+  fprintf(file, "  \"imu_type\": \"%s\",\n", BENCH_XSTR(IMU_TYPE));
+  fprintf(file, "  \"num_op\": %d,\n", num_op);
+  fprintf(file, "  \"num_rep\": %d,\n", num_rep);
+  fprintf(file, "  \"results\": [\n");
+  for (i=0; i<num_case; i++) {
+    fprintf(file, "    {\"group\": \"%s\", \"name\": \"%s\", "
+            "\"ns_op\": %.3f, \"ns_min\": %.3f, \"ns_max\": %.3f, "
+            "\"ops_sec\": %.0f", case_list[i].group, case_list[i].name,
+            result[i].ns_med, result[i].ns_min, result[i].ns_max,
+            1e9 / result[i].ns_med);
+    for (j=0; j<BENCH_PERF_NUM && isPerf; j++) {
+      if (result[i].perf[j] >= 0.0)
+        fprintf(file, ", \"%s\": %.3f", bench_perf_name[j],
+                result[i].perf[j]);
+      else
+        fprintf(file, ", \"%s\": null", bench_perf_name[j]);
+    }
+    fprintf(file, "}%s\n", (i < num_case - 1) ? "," : "");
+  }
+  fprintf(file, "  ]\n");
+  fprintf(file, "}\n");
+}
+
+
+/******************************************************************************
+* qsort comparison (ascending doubles)
+******************************************************************************/
+
+int compare(
+  const void        *a,
+  const void        *b)
+{
+  double da         = *(const double*)a;
+  double db         = *(const double*)b;
+  return (da > db) - (da < db);
+}
+
+
+/******************************************************************************
+* monotonic wall clock (seconds)
+******************************************************************************/
+
+double now(void)
+{
+  struct timespec   ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
@@ -0,0 +1,325 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#include "IMU_engn.h"
+
+// define constants
+static const double   duration    = 1.0;      // seconds per configuration
+static const int      num_bin     = 18;       // log2 bins from 1usec
+static const int      bar_width   = 40;       // histogram bar (characters)
+static const int      num_rate    = 3;
+static const double   rate_list[] = {1000.0, 5000.0, 20000.0};
+static const int      num_load    = 2;
+static const int      load_list[] = {0, 2};
+
+// benchmark configuration
+typedef struct {
+  double              rate;               // datum/sec submitted
+  int                 load;               // competing busy threads
+  int                 cpuProd;            // producer cpu (-1 unpinned)
+  int                 cpuWork;            // engine worker cpu
+  int                 cpuObsv;            // estimate observer cpu
+  int                 isHist;             // print histogram
+} bench_config;
+
+// shared between producer, observer, and load threads
+static int            num_samp;
+static double         *tSubmit;           // submission time per datum
+static double         *tPublish;          // first estimate including datum
+static uint16_t       id;
+static volatile int   isDone;
+
+// internal functions
+static int    child     (bench_config *cfg);
+static void*  observe   (void *pntr);
+static void*  load      (void *pntr);
+static int    pin       (pthread_t thrd, int cpu);
+static int    compare   (const void *a, const void *b);
+static double now       (void);
+
+
+/******************************************************************************
+* main function - submission to estimate latency through the engine queue
+* usage: bench_latency [-r rate] [-l load] [-p prod,work,obsv] [-s]
+******************************************************************************/
+
+int main(
+  int                 argc,
+  char                **argv)
+{
+  // define local variables
+  bench_config        cfg   = {0.0, -1, -1, -1, -1, 1};
+  int                 opt, status, i, j;
+  pid_t               pid;
+
+  // parse options (rate and load override the default sweep)
+  while ((opt = getopt(argc, argv, "r:l:p:s")) != -1) {
+    if      (opt == 'r')
+      cfg.rate        = atof(optarg);
+    else if (opt == 'l')
+      cfg.load        = atoi(optarg);
+    else if (opt == 'p')
+      sscanf(optarg, "%d,%d,%d", &cfg.cpuProd, &cfg.cpuWork, &cfg.cpuObsv);
+    else if (opt == 's')
+      cfg.isHist      = 0;
+    else {
+      printf("usage: %s [-r rate] [-l load] [-p prod,work,obsv] [-s]\n",
+             argv[0]);
+      return 1;
+    }
+  }
+
+  // print table header
+  printf("starting bench_latency...\n");
+  printf("host cpus: %ld, pinning: %d,%d,%d\n",
+         sysconf(_SC_NPROCESSORS_ONLN), cfg.cpuProd, cfg.cpuWork,
+         cfg.cpuObsv);
+  printf("%10s %5s %8s %10s %10s %10s %10s %8s\n", "rate (Hz)", "load",
+         "datum", "p50 (us)", "p99 (us)", "p99.9 (us)", "max (us)", "drop");
+
+  // sweep rate and load (each in its own process, engine is static)
+  for (i=0; i<num_rate; i++) {
+    for (j=0; j<num_load; j++) {
+      bench_config run = cfg;
+      if (cfg.rate > 0.0 && i > 0)
+        break;
+      if (cfg.load >= 0 && j > 0)
+        break;
+      if (cfg.rate <= 0.0)
+        run.rate      = rate_list[i];
+      if (cfg.load < 0)
+        run.load      = load_list[j];
+      fflush(stdout);
+      pid             = fork();
+      if (pid == 0)
+        exit(child(&run));
+      waitpid(pid, &status, 0);
+      if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        printf("error: configuration failed\n");
+        exit(0);
+      }
+    }
+  }
+
+  // exit program
+  printf("pass: bench_latency\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* run one configuration (child process), producer is the calling thread
+******************************************************************************/
+
+int child(
+  bench_config      *cfg)
+{
+  // define local variables
+  pthread_t         thrdObsv, thrdLoad[cfg->load > 0 ? cfg->load : 1];
+  IMU_datum         datum;
+  double            *lat, t_start, t_next;
+  double            period = 1.0 / cfg->rate;
+  uint32_t          tick   = (uint32_t)(100000.0 / cfg->rate + 0.5);
+  long              hist[num_bin];
+  int               dropped = 0, num = 0, i, j, bar;
+
+  // allocate per datum timestamps
+  num_samp          = (int)(cfg->rate * duration);
+  tSubmit           = calloc(num_samp, sizeof(double));
+  tPublish          = calloc(num_samp, sizeof(double));
+  lat               = malloc(num_samp * sizeof(double));
+
+  // worker inherits the affinity of the thread that starts the engine
+  if (IMU_engn_init(IMU_engn_core_only, &id) < 0)
+    return 1;
+  if (pin(pthread_self(), cfg->cpuWork) < 0)
+    return 1;
+  if (IMU_engn_start() != 0)
+    return 1;
+  if (pin(pthread_self(), cfg->cpuProd) < 0)
+    return 1;
+
+  // observer and load threads
+  isDone            = 0;
+  pthread_create(&thrdObsv, NULL, observe, NULL);
+  if (pin(thrdObsv, cfg->cpuObsv) < 0)
+    return 1;
+  for (i=0; i<cfg->load; i++)
+    pthread_create(&thrdLoad[i], NULL, load, NULL);
+
+  // paced submission (absolute schedule, interleaved gyro/accl/magn)
+  t_start           = now();
+  for (i=0; i<num_samp; i++) {
+    t_next          = t_start + i * period;
+    struct timespec ts = {(time_t)t_next,
+                          (long)((t_next - (time_t)t_next) * 1e9)};
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    datum.t         = (i + 1) * tick;
+    datum.type      = (IMU_sensor)(IMU_gyro + i % 3);
+    datum.val[0]    = (datum.type == IMU_magn) ? 255 : 0;
+    datum.val[1]    = 0;
+    datum.val[2]    = (datum.type == IMU_accl) ? 255 : 0;
+    tSubmit[i]      = now();
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    if (IMU_engn_datum(id, &datum) < 0)
+      dropped++;
+  }
+
+  // wait for the last estimate (bounded), then stop helper threads
+  t_next            = now() + 0.5;
+  while (tPublish[num_samp-1] == 0.0 && now() < t_next)
+    usleep(1000);
+  isDone            = 1;
+  pthread_join(thrdObsv, NULL);
+  for (i=0; i<cfg->load; i++)
+    pthread_join(thrdLoad[i], NULL);
+
+  // latency of published datum (microseconds) and log2 histogram
+  memset(hist, 0, sizeof(hist));
+  for (i=0; i<num_samp; i++) {
+    if (tPublish[i] == 0.0)
+      continue;
+    lat[num]        = 1e6 * (tPublish[i] - tSubmit[i]);
+    for (j=0; j<num_bin-1 && lat[num] >= (double)(1L << j); j++);
+    hist[j]++;
+    num++;
+  }
+  qsort(lat, num, sizeof(double), compare);
+
+  // report (drops are oldest queued datum, counted latency is approximate)
+  if (num == 0)
+    return 1;
+  printf("%10.0f %5d %8d %10.1f %10.1f %10.1f %10.1f %7.2f%%\n", cfg->rate,
+         cfg->load, num, lat[num/2], lat[(int)(0.99*(num-1))],
+         lat[(int)(0.999*(num-1))], lat[num-1], 100.0 * dropped / num_samp);
+  for (j=0; j<num_bin && cfg->isHist; j++) {
+    if (hist[j] == 0)
+      continue;
+    bar             = (int)ceil((double)bar_width * hist[j] / num);
+    printf("    < %6ld us %8ld |%.*s\n", 1L << j, hist[j], bar,
+           "########################################");
+  }
+
+  // worker is not stopped (it may be waiting on an empty queue), process
+  // exit releases it
+  fflush(stdout);
+  return 0;
+}
+
+
+/******************************************************************************
+* observer thread - polls the published estimate, every datum counted by
+* the engine since the last poll is stamped with the current time
+******************************************************************************/
+
+void* observe(
+  void              *pntr)
+{
+  // define local variables
+  IMU_engn_estm     estm;
+  int               count, prev = 0, i;
+  (void)pntr;
+
+  // main loop (yield so a shared cpu still runs the worker)
+  while (!isDone) {
+    count           = IMU_engn_getEstm(id, 0, &estm);
+    if (count > prev) {
+      double t      = now();
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      for (i=prev; i<count && i<num_samp; i++)
+        tPublish[i] = t;
+      prev          = count;
+    }
+    sched_yield();
+  }
+  return NULL;
+}
+
+
+/******************************************************************************
+* load thread - competing compute until the configuration completes
+******************************************************************************/
+
+void* load(
+  void              *pntr)
+{
+  volatile double   x = 1.0;
+  (void)pntr;
+  while (!isDone)
+    x               = sqrt(x + 1.0);
+  return NULL;
+}
+
+
+/******************************************************************************
+* pin thread to cpu (negative leaves the affinity unchanged)
+******************************************************************************/
+
+int pin(
+  pthread_t         thrd,
+  int               cpu)
+{
+  cpu_set_t         set;
+  if (cpu < 0)
+    return 0;
+  if (cpu >= sysconf(_SC_NPROCESSORS_ONLN)) {
+    printf("error: cpu %d not available\n", cpu);
+    return -1;
+  }
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(thrd, sizeof(set), &set) == 0 ? 0 : -1;
+}
+
+
+/******************************************************************************
+* qsort comparison (ascending doubles)
+******************************************************************************/
+
+int compare(
+  const void        *a,
+  const void        *b)
+{
+  double da         = *(const double*)a;
+  double db         = *(const double*)b;
+  return (da > db) - (da < db);
+}
+
+
+/******************************************************************************
+* monotonic wall clock (seconds)
+******************************************************************************/
+
+double now(void)
+{
+  struct timespec   ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
@@ -0,0 +1,160 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _BENCH_PERF_H
+#define _BENCH_PERF_H
+
+// include statements
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+// define counters (user space only, each opened independently so a missing
+// hardware event does not disable the others)
+#define BENCH_PERF_NUM           5
+typedef enum {
+  bench_perf_cycles       = 0,
+  bench_perf_instr        = 1,
+  bench_perf_brMiss       = 2,
+  bench_perf_l1Miss       = 3,
+  bench_perf_llcMiss      = 4
+} bench_perf_event;
+static const char* bench_perf_name[BENCH_PERF_NUM] = {
+  "cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses"};
+
+// counter set
+typedef struct {
+  int                    fd     [BENCH_PERF_NUM];
+  uint64_t               val    [BENCH_PERF_NUM];
+  int                    isValid[BENCH_PERF_NUM];
+  int                    err;             // errno of last failed open
+} bench_perf;
+
+// function definitions
+int  perf_open   (bench_perf *perf);
+void perf_start  (bench_perf *perf);
+void perf_stop   (bench_perf *perf);
+void perf_close  (bench_perf *perf);
+
+
+/******************************************************************************
+* opens the counters for the calling thread, returns number available
+******************************************************************************/
+
+int perf_open(
+  bench_perf               *perf)
+{
+  // event type and config per counter
+  static const uint32_t    type[BENCH_PERF_NUM]   = {
+    PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+    PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE};
+  static const uint64_t    config[BENCH_PERF_NUM] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+    PERF_COUNT_HW_CACHE_LL  | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+  struct perf_event_attr   attr;
+  int                      num = 0, i;
+
+  // open each counter disabled (time scaled if multiplexed)
+  perf->err                = 0;
+  for (i=0; i<BENCH_PERF_NUM; i++) {
+    memset(&attr, 0, sizeof(attr));
+    attr.size              = sizeof(attr);
+    attr.type              = type[i];
+    attr.config            = config[i];
+    attr.disabled          = 1;
+    attr.exclude_kernel    = 1;
+    attr.exclude_hv        = 1;
+    attr.read_format       = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                             PERF_FORMAT_TOTAL_TIME_RUNNING;
+    perf->fd[i]            = (int)syscall(SYS_perf_event_open, &attr, 0, -1,
+                                          -1, 0);
+    perf->isValid[i]       = (perf->fd[i] >= 0);
+    if (!perf->isValid[i])
+      perf->err            = errno;
+    perf->val[i]           = 0;
+    num                   += perf->isValid[i];
+  }
+  return num;
+}
+
+
+/******************************************************************************
+* resets and enables the available counters
+******************************************************************************/
+
+void perf_start(
+  bench_perf               *perf)
+{
+  int                      i;
+  for (i=0; i<BENCH_PERF_NUM; i++) {
+    if (!perf->isValid[i])
+      continue;
+    ioctl(perf->fd[i], PERF_EVENT_IOC_RESET, 0);
+    ioctl(perf->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+  }
+}
+
+
+/******************************************************************************
+* disables the counters and reads the (multiplex scaled) counts into val
+******************************************************************************/
+
+void perf_stop(
+  bench_perf               *perf)
+{
+  uint64_t                 buf[3];
+  int                      i;
+  for (i=0; i<BENCH_PERF_NUM; i++) {
+    if (!perf->isValid[i])
+      continue;
+    ioctl(perf->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+    if (read(perf->fd[i], buf, sizeof(buf)) != sizeof(buf) || buf[2] == 0) {
+      perf->val[i]         = 0;
+      continue;
+    }
+    perf->val[i]           = (buf[1] == buf[2]) ? buf[0] :
+                             (uint64_t)((double)buf[0] * buf[1] / buf[2]);
+  }
+}
+
+
+/******************************************************************************
+* closes the counters
+******************************************************************************/
+
+void perf_close(
+  bench_perf               *perf)
+{
+  int                      i;
+  for (i=0; i<BENCH_PERF_NUM; i++) {
+    if (perf->isValid[i])
+      close(perf->fd[i]);
+    perf->isValid[i]       = 0;
+  }
+}
+
+#endif
@@ -0,0 +1,421 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "IMU_engn.h"
+
+// engine internal (synchronous) processing function
+int IMU_engn_process(uint16_t id, IMU_datum*);
+
+// define constants
+static const int      num_samp    = 30000;    // sensor samples per pass
+static const int      num_warm    = 2;        // untimed warm-up passes
+static const int      num_rep     = 9;        // timed passes (best kept)
+static const uint32_t tick        = 100;      // 1kHz per sensor (10usec)
+static const int      max_inst    = 64;       // multi instance limit
+static const int      max_metric  = 32;
+static const int      line_size   = 64;       // csv line buffer (dataIF)
+
+// standard workloads
+typedef enum {
+  work_datum          = 0,                    // IMU_engn_process
+  work_data3          = 1,                    // IMU_engn_data3
+  work_multi          = 2,                    // datum over all instances
+  work_csv            = 3                     // dataIF csv parse + datum
+} work_mode;
+typedef struct {
+  const char*         name;
+  const char*         unit;
+  IMU_engn_type       type;
+  work_mode           mode;
+  float               tol;                    // allowed slowdown (fraction)
+} work_case;
+static const int      num_work    = 5;
+static const work_case work_list[] = {
+  {"datum_core",  "ns/datum", IMU_engn_core_only, work_datum, 0.25},
+  {"datum_full",  "ns/datum", IMU_engn_calb_full, work_datum, 0.25},
+  {"data3_full",  "ns/data3", IMU_engn_calb_full, work_data3, 0.25},
+  {"multi_full",  "ns/datum", IMU_engn_calb_full, work_multi, 0.30},
+  {"csv_full",    "ns/line",  IMU_engn_calb_full, work_csv,   0.30}};
+
+// benchmark metric (baseline or current run)
+typedef struct {
+  char                name[64];
+  char                unit[16];
+  double              value;
+  double              tol;
+} regress_metric;
+
+// shared inputs (sensor stream and its dataIF csv lines)
+static IMU_datum      *datum;
+static IMU_data3      *data3;
+static char           *lines;
+
+// internal functions
+static void   stream    (void);
+static int    child     (const work_case *work, int fd);
+static void   run       (const work_case *work, uint16_t *id, int numInst);
+static int    load      (const char *filename, regress_metric *metric);
+static int    save      (const char *filename, regress_metric *metric,
+                         int num);
+static double now       (void);
+
+
+/******************************************************************************
+* main function - standard workloads compared against a stored baseline
+* (exits nonzero when any metric is slower than baseline plus tolerance,
+* -u records the current run as the new baseline)
+******************************************************************************/
+
+int main(
+  int               argc,
+  char              *argv[])
+{
+  // define local variables
+  const char        *filename = "../baseline.json";
+  regress_metric    base[max_metric], cur[max_metric];
+  const char        *status;
+  double            change;
+  int               numBase = 0, numCur = 0, isUpdate = 0, isFail = 0;
+  int               fd[2], inst, opt, found, i, j;
+  pid_t             pid;
+
+  // parse command line (bench_regress [-u] [baseline.json])
+  while ((opt = getopt(argc, argv, "u")) != -1) {
+    if (opt == 'u') {
+      isUpdate      = 1;
+    } else {
+      printf("usage: bench_regress [-u] [baseline.json]\n");
+      return 2;
+    }
+  }
+  if (optind < argc)
+    filename        = argv[optind];
+
+  // generate inputs and read baseline
+  printf("starting bench_regress...\n");
+  datum             = malloc(num_samp * sizeof(IMU_datum));
+  data3             = malloc(num_samp / 3 * sizeof(IMU_data3));
+  lines             = malloc(num_samp * line_size);
+  stream();
+  if (!isUpdate) {
+    numBase         = load(filename, base);
+    if (numBase <= 0) {
+      printf("error: unable to read baseline %s (record one with -u)\n",
+             filename);
+      return 1;
+    }
+  }
+
+  // run each workload in its own process (engines are static instances)
+  for (i=0; i<num_work; i++) {
+    if (pipe(fd) != 0)
+      return 1;
+    fflush(stdout);
+    pid             = fork();
+    if (pid == 0) {
+      close(fd[0]);
+      exit(child(&work_list[i], fd[1]));
+    }
+    close(fd[1]);
+    cur[numCur]     = (regress_metric){"", "", 0.0, work_list[i].tol};
+    if (read(fd[0], &cur[numCur].value, sizeof(double)) == sizeof(double) &&
+        read(fd[0], &inst, sizeof(int)) == sizeof(int)) {
+      if (work_list[i].mode == work_multi)
+        snprintf(cur[numCur].name, sizeof(cur[0].name), "%s_x%d",
+                 work_list[i].name, inst);
+      else
+        snprintf(cur[numCur].name, sizeof(cur[0].name), "%s",
+                 work_list[i].name);
+      snprintf(cur[numCur].unit, sizeof(cur[0].unit), "%s",
+               work_list[i].unit);
+      numCur++;
+    }
+    close(fd[0]);
+    waitpid(pid, NULL, 0);
+  }
+
+  // record new baseline
+  if (isUpdate) {
+    for (i=0; i<numCur; i++)
+      printf("%-16s %10.2f %s\n", cur[i].name, cur[i].value, cur[i].unit);
+    if (save(filename, cur, numCur) < 0) {
+      printf("error: unable to write baseline %s\n", filename);
+      return 1;
+    }
+    printf("baseline written: %s\n", filename);
+    printf("pass: bench_regress\n\n");
+    return 0;
+  }
+
+  // compare against baseline (lower is better for every metric)
+  printf("%-16s %-9s %10s %10s %9s %7s  %s\n", "metric", "unit", "baseline",
+         "current", "change", "tol", "status");
+  for (i=0; i<numCur; i++) {
+    found           = 0;
+    for (j=0; j<numBase && !found; j++) {
+      if (strcmp(cur[i].name, base[j].name) != 0)
+        continue;
+      found         = 1;
+      change        = cur[i].value / base[j].value - 1.0;
+      if (change > base[j].tol) {
+        status      = "REGRESSION";
+        isFail      = 1;
+      } else if (change < -base[j].tol) {
+        status      = "faster";
+      } else {
+        status      = "ok";
+      }
+      printf("%-16s %-9s %10.2f %10.2f %+8.1f%% %6.0f%%  %s\n", cur[i].name,
+             cur[i].unit, base[j].value, cur[i].value, 100.0 * change,
+             100.0 * base[j].tol, status);
+    }
+    if (!found)
+      printf("%-16s %-9s %10s %10.2f %9s %7s  %s\n", cur[i].name,
+             cur[i].unit, "-", cur[i].value, "-", "-", "new");
+  }
+  for (j=0; j<numBase; j++) {
+    found           = 0;
+    for (i=0; i<numCur; i++)
+      found        |= !strcmp(cur[i].name, base[j].name);
+    if (!found)
+      printf("%-16s %-9s %10.2f %10s %9s %7s  %s\n", base[j].name,
+             base[j].unit, base[j].value, "-", "-", "-", "missing");
+  }
+
+  // exit program (nonzero on regression)
+  free(datum);
+  free(data3);
+  free(lines);
+  if (isFail) {
+    printf("fail: bench_regress (slower than %s)\n\n", filename);
+    return 1;
+  }
+  printf("pass: bench_regress\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* generate interleaved gyro/accl/magn stream, synchronized copy, and the
+* equivalent dataIF csv lines (level and north w/ slow oscillation and noise)
+******************************************************************************/
+
+void stream(void)
+{
+  // define local variables
+  double            t, w;
+  int               i, j;
+
+  // main loop (one data3 for every three datum)
+  srand(1);
+  for (i=0; i<num_samp/3; i++) {
+    t               = (double)i * tick * 0.00001;
+    w               = 200.0 * sin(2.0 * M_PI * 0.5 * t);
+    data3[i].t      = (i + 1) * tick;
+    for (j=0; j<3; j++) {
+      data3[i].g[j] = (IMU_TYPE)((j == 0 ? w : 0.0) + rand() % 5 - 2);
+      data3[i].a[j] = (IMU_TYPE)((j == 2 ? 255 : 0) + rand() % 5 - 2);
+      data3[i].m[j] = (IMU_TYPE)((j == 0 ? 255 : 0) + rand() % 5 - 2);
+    }
+    for (j=0; j<3; j++) {
+      datum[3*i+j].t    = data3[i].t;
+      datum[3*i+j].type = (IMU_sensor)(IMU_gyro + j);
+    }
+    memcpy(datum[3*i].val,   data3[i].g, sizeof(datum[0].val));
+    memcpy(datum[3*i+1].val, data3[i].a, sizeof(datum[0].val));
+    memcpy(datum[3*i+2].val, data3[i].m, sizeof(datum[0].val));
+  }
+
+  // csv lines (dataIF "type, t, x, y, z" format)
+  for (i=0; i<num_samp; i++)
+    snprintf(&lines[i*line_size], line_size, "%d, %u, %d, %d, %d\n",
+             (int)datum[i].type, datum[i].t, datum[i].val[0],
+             datum[i].val[1], datum[i].val[2]);
+}
+
+
+/******************************************************************************
+* run one workload (child process), best pass written to the pipe as ns per
+* operation followed by the instance count
+******************************************************************************/
+
+int child(
+  const work_case   *work,
+  int               fd)
+{
+  // define local variables
+  uint16_t          id[max_inst];
+  IMU_union_config  config;
+  double            t_start, ns, ns_min = 0.0;
+  int               numInst = 0, num, i;
+
+  // create engines (multi uses every instance the library allows)
+  do {
+    if (IMU_engn_init(work->type, &id[numInst]) < 0)
+      break;
+    if (work->type == IMU_engn_calb_pnts || work->type == IMU_engn_calb_full) {
+      IMU_engn_getConfig(id[numInst], IMU_engn_pnts, &config);
+      config.pnts->enable   = 1;
+      config.pnts->gThresh  = 20.0 * 20.0;
+      config.pnts->aThresh  = 30.0 * 30.0;
+      config.pnts->mThresh  = 40.0 * 40.0;
+    }
+    numInst++;
+  } while (work->mode == work_multi && numInst < max_inst);
+  if (numInst == 0)
+    return 1;
+
+  // warm-up, then timed passes (best kept, least disturbed by the host)
+  num               = (work->mode == work_data3) ? num_samp / 3 :
+                      num_samp * numInst;
+  for (i=0; i<num_warm+num_rep; i++) {
+    t_start         = now();
+    run(work, id, numInst);
+    ns              = 1e9 * (now() - t_start) / num;
+    if (i == num_warm || (i > num_warm && ns < ns_min))
+      ns_min        = ns;
+  }
+
+  // pass result to parent
+  if (write(fd, &ns_min, sizeof(double)) != sizeof(double) ||
+      write(fd, &numInst, sizeof(int)) != sizeof(int))
+    return 1;
+  return 0;
+}
+
+
+/******************************************************************************
+* one pass of a workload (instances reset, engine modifies datum in place)
+******************************************************************************/
+
+void run(
+  const work_case   *work,
+  uint16_t          *id,
+  int               numInst)
+{
+  // define local variables
+  IMU_datum         d;
+  IMU_data3         d3;
+  int               type, i, j;
+
+  // main processing loop
+  for (j=0; j<numInst; j++)
+    IMU_engn_reset(id[j]);
+  if (work->mode == work_data3) {
+    for (i=0; i<num_samp/3; i++) {
+      d3            = data3[i];
+      IMU_engn_data3(id[0], &d3);
+    }
+  } else if (work->mode == work_csv) {
+    for (i=0; i<num_samp; i++) {
+      sscanf(&lines[i*line_size], "%d, %u, %hd, %hd, %hd", &type, &d.t,
+             &d.val[0], &d.val[1], &d.val[2]);
+      d.type        = (IMU_sensor)type;
+      IMU_engn_process(id[0], &d);
+    }
+  } else {
+    for (i=0; i<num_samp; i++) {
+      for (j=0; j<numInst; j++) {
+        d           = datum[i];
+        IMU_engn_process(id[j], &d);
+      }
+    }
+  }
+}
+
+
+/******************************************************************************
+* read baseline json (one metric object per line), returns number of metrics
+******************************************************************************/
+
+int load(
+  const char        *filename,
+  regress_metric    *metric)
+{
+  // define local variables
+  FILE              *file = fopen(filename, "r");
+  char              line[256], *obj;
+  int               num   = 0;
+  if (file == NULL)
+    return -1;
+
+  // parse metric objects
+  while (num < max_metric && fgets(line, sizeof(line), file) != NULL) {
+    obj             = strstr(line, "{\"name\"");
+    if (obj == NULL)
+      continue;
+    if (sscanf(obj, "{\"name\": \"%63[^\"]\", \"unit\": \"%15[^\"]\", "
+               "\"value\": %lf, \"tol\": %lf", metric[num].name,
+               metric[num].unit, &metric[num].value, &metric[num].tol) == 4)
+      num++;
+  }
+
+  // exit function
+  fclose(file);
+  return num;
+}
+
+
+/******************************************************************************
+* write baseline json (one metric object per line)
+******************************************************************************/
+
+int save(
+  const char        *filename,
+  regress_metric    *metric,
+  int               num)
+{
+  // define local variables
+  FILE              *file = fopen(filename, "w");
+  int               i;
+  if (file == NULL)
+    return -1;
+
+  // metric list
+  fprintf(file, "{\n  \"bench\": \"bench_regress\",\n  \"metrics\": [\n");
+  for (i=0; i<num; i++)
+    fprintf(file, "    {\"name\": \"%s\", \"unit\": \"%s\", \"value\": "
+            "%0.2f, \"tol\": %0.2f}%s\n", metric[i].name, metric[i].unit,
+            metric[i].value, metric[i].tol, (i < num-1) ? "," : "");
+  fprintf(file, "  ]\n}\n");
+
+  // exit function
+  fclose(file);
+  return 0;
+}
+
+
+/******************************************************************************
+* monotonic wall clock (seconds)
+******************************************************************************/
+
+double now(void)
+{
+  struct timespec   ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
@@ -0,0 +1,172 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "IMU_math.h"
+
+// define constants
+static const int      num_vect    = 4096;     // working set (fits in L1/L2)
+static const int      num_loop    = 2000;     // passes over working set
+static const int      num_rep     = 5;        // timing passes (best kept)
+
+// internal functions
+static float  norm3_div (float *v);
+static float  norm4_div (float *v);
+static double run       (float (*fnc)(float*), float *in, float *out,
+                         int dim, int isChain);
+static double now       (void);
+
+
+/******************************************************************************
+* main function - sqrt/divide vs reciprocal sqrt normalization cost
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  float             *in  = malloc(4 * num_vect * sizeof(float));
+  float             *ref = malloc(4 * num_vect * sizeof(float));
+  float             *out = malloc(4 * num_vect * sizeof(float));
+  double            ns_div, ns_rsqrt, err, max;
+  int               dim, isChain, i;
+
+  // random vectors (sensor count scale)
+  printf("starting bench_rsqrt...\n");
+  srand(1);
+  for (i=0; i<4*num_vect; i++)
+    in[i]           = (float)(rand() % 2001 - 1000);
+
+  // print table header
+  printf("%-6s %-8s %12s %12s %10s %12s\n", "dim", "mode", "ns (div)",
+         "ns (rsqrt)", "speedup", "max err");
+
+  // time each normalization (3x1 sensor vectors, 4x1 quaternions), both
+  // independent vectors (throughput) and a dependent chain (latency, as in
+  // the filter where each update feeds the next)
+  for (dim=3; dim<=4; dim++) {
+    for (isChain=0; isChain<=1; isChain++) {
+      ns_div        = run(dim == 3 ? norm3_div : norm4_div, in, ref, dim,
+                          isChain);
+      ns_rsqrt      = run(dim == 3 ? IMU_math_norm3 : IMU_math_norm4,
+                          in, out, dim, isChain);
+      max           = 0.0;
+      for (i=0; i<dim*num_vect; i++) {
+        err         = fabs(out[i] - ref[i]);
+        if (err > max)
+          max       = err;
+      }
+      printf("%-6d %-8s %12.2f %12.2f %10.2f %12.3g\n", dim,
+             isChain ? "latency" : "thruput", ns_div, ns_rsqrt,
+             ns_div / ns_rsqrt, max);
+    }
+  }
+
+  // exit program
+  free(in);
+  free(ref);
+  free(out);
+  printf("pass: bench_rsqrt\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* reference 3x1 normalize (sqrt followed by divides)
+******************************************************************************/
+
+float norm3_div(
+  float             *v)
+{
+  float norm        = sqrtf(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+  v[0]              = v[0] / norm;
+  v[1]              = v[1] / norm;
+  v[2]              = v[2] / norm;
+  return norm;
+}
+
+
+/******************************************************************************
+* reference 4x1 normalize (sqrt followed by divides)
+******************************************************************************/
+
+float norm4_div(
+  float             *v)
+{
+  float norm        = sqrtf(v[0]*v[0] + v[1]*v[1] + v[2]*v[2] + v[3]*v[3]);
+  if (norm > 0.001f) {
+    v[0]           /= norm;
+    v[1]           /= norm;
+    v[2]           /= norm;
+    v[3]           /= norm;
+  }
+  return norm;
+}
+
+
+/******************************************************************************
+* normalize working set repeatedly, returns best ns per vector (chain adds
+* the previous result to each input, serializing the normalizations)
+******************************************************************************/
+
+double run(
+  float             (*fnc)(float*),
+  float             *in,
+  float             *out,
+  int               dim,
+  int               isChain)
+{
+  // define local variables
+  volatile float    sink = 0.0f;
+  double            t_start, ns, ns_min = 0.0;
+  int               i, j, k, n;
+
+  // main timing loop (input copied so every pass sees unnormalized data)
+  for (k=0; k<num_rep; k++) {
+    t_start         = now();
+    for (j=0; j<num_loop; j++) {
+      memcpy(out, in, dim * num_vect * sizeof(float));
+      for (i=0; i<num_vect; i++) {
+        for (n=0; n<dim && isChain && i>0; n++)
+          out[dim*i+n] += out[dim*(i-1)+n];
+        sink       += fnc(&out[dim*i]);
+      }
+    }
+    ns              = 1e9 * (now() - t_start) / ((double)num_loop * num_vect);
+    if (k == 0 || ns < ns_min)
+      ns_min        = ns;
+  }
+  return ns_min;
+}
+
+
+/******************************************************************************
+* monotonic wall clock (seconds)
+******************************************************************************/
+
+double now(void)
+{
+  struct timespec   ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
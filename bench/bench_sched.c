@@ -0,0 +1,215 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "IMU_core.h"
+
+// define constants
+static const int      max_datum   = 4096;
+static const int      num_rep     = 2000;     // timing repetitions
+static const int      num_file    = 2;
+static const char*    file_list[] = {"../../stim/applyAcclTest.csv",
+                                     "../../stim/applyMagnTest.csv"};
+static const int      num_sched   = 6;
+static const uint16_t decim_list[]  = {1,     2,     4,     8,     8,     8};
+static const float    thresh_list[] = {0.0,   0.0,   0.0,   0.0,   0.001, 0.01};
+
+// internal functions
+static int    load      (const char *filename, IMU_datum *data);
+static int    run       (uint16_t id, IMU_datum *data, int num, float *q);
+static void   error     (float *q1, float *q2, int num, float *rms,
+                         float *max);
+static double now       (void);
+
+
+/******************************************************************************
+* main function - cost vs accuracy of decimated accl/magn corrections
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  uint16_t          id;
+  IMU_core_config   *config;
+  IMU_datum         *data  = malloc(max_datum * sizeof(IMU_datum));
+  float             *q_ref = malloc(4 * max_datum * sizeof(float));
+  float             *q     = malloc(4 * max_datum * sizeof(float));
+  double            t_start, t_stop, ns, ns_ref = 0.0;
+  float             rms, max;
+  int               num, count, file, i, j;
+
+  // initialize core instance (gyroscope disabled, stim files are static)
+  printf("starting bench_sched...\n");
+  IMU_core_init(&id, &config);
+  config->isGyro    = 0;
+
+  // print table header
+  printf("%-18s %6s %8s %8s %10s %8s %10s %10s\n", "file", "decim",
+         "thresh", "updates", "ns/datum", "saved", "rms (deg)", "max (deg)");
+
+  // process each stimulus file and schedule
+  for (file=0; file<num_file; file++) {
+    num = load(file_list[file], data);
+    if (num <= 0) {
+      printf("error: unable to read %s\n", file_list[file]);
+      exit(0);
+    }
+    for (i=0; i<num_sched; i++) {
+      config->aDecim     = decim_list[i];
+      config->mDecim     = decim_list[i];
+      config->aErrThresh = thresh_list[i];
+      config->mErrThresh = thresh_list[i];
+
+      // measure accuracy (single pass)
+      count = run(id, data, num, (i == 0) ? q_ref : q);
+      error((i == 0) ? q_ref : q, q_ref, num, &rms, &max);
+
+      // measure cost (repeated passes)
+      t_start  = now();
+      for (j=0; j<num_rep; j++)
+        run(id, data, num, q);
+      t_stop   = now();
+      ns       = 1e9 * (t_stop - t_start) / ((double)num_rep * num);
+      if (i == 0)
+        ns_ref = ns;
+
+      // print results
+      printf("%-18s %6d %8.3f %8d %10.2f %7.1f%% %10.4f %10.4f\n",
+             strrchr(file_list[file], '/') + 1, decim_list[i],
+             thresh_list[i], count, ns, 100.0 * (1.0 - ns / ns_ref),
+             rms, max);
+    }
+  }
+
+  // exit program
+  free(data);
+  free(q_ref);
+  free(q);
+  printf("pass: bench_sched\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* read stimulus csv file (type, t, x, y, z), returns number of datum
+******************************************************************************/
+
+int load(
+  const char        *filename,
+  IMU_datum         *data)
+{
+  // open stimulus file
+  FILE              *file = fopen(filename, "r");
+  int               type, t, x, y, z;
+  int               num   = 0;
+  if (file == NULL)
+    return -1;
+
+  // main loop that parses file line by line
+  while (num < max_datum &&
+         fscanf(file, "%d, %d, %d, %d, %d", &type, &t, &x, &y, &z) == 5) {
+    data[num].type   = (IMU_sensor)type;
+    data[num].t      = (uint32_t)t;
+    data[num].val[0] = (IMU_TYPE)x;
+    data[num].val[1] = (IMU_TYPE)y;
+    data[num].val[2] = (IMU_TYPE)z;
+    num++;
+  }
+
+  // exit function
+  fclose(file);
+  return num;
+}
+
+
+/******************************************************************************
+* feed stimulus through core, returns number of applied corrections
+******************************************************************************/
+
+int run(
+  uint16_t          id,
+  IMU_datum         *data,
+  int               num,
+  float             *q)
+{
+  // define local variables
+  IMU_core_state    *state;
+  int               count = 0;
+  int               i;
+
+  // main processing loop (orientation saved after each datum)
+  IMU_core_reset(id);
+  IMU_core_getState(id, &state);
+  for (i=0; i<num; i++) {
+    if (IMU_core_datum(id, &data[i], NULL) == IMU_core_enum_normal_op)
+      count++;
+    memcpy(&q[4*i], state->q, sizeof(state->q));
+  }
+  return count;
+}
+
+
+/******************************************************************************
+* rms and max angle between two orientation sequences (degrees)
+******************************************************************************/
+
+void error(
+  float             *q1,
+  float             *q2,
+  int               num,
+  float             *rms,
+  float             *max)
+{
+  double            sum = 0.0, err, n1, n2, dot;
+  float             *a, *b;
+  int               i;
+  *max              = 0.0f;
+  for (i=0; i<num; i++) {
+    a               = &q1[4*i];
+    b               = &q2[4*i];
+    n1              = sqrt(a[0]*a[0] + a[1]*a[1] + a[2]*a[2] + a[3]*a[3]);
+    n2              = sqrt(b[0]*b[0] + b[1]*b[1] + b[2]*b[2] + b[3]*b[3]);
+    dot             = fabs(a[0]*b[0] + a[1]*b[1] + a[2]*b[2] + a[3]*b[3]);
+    dot             = dot / (n1 * n2);
+    if (dot > 1.0)
+      dot           = 1.0;
+    err             = 2.0 * acos(dot) * 180.0 / M_PI;
+    sum            += err * err;
+    if (err > *max)
+      *max          = (float)err;
+  }
+  *rms              = (float)sqrt(sum / num);
+}
+
+
+/******************************************************************************
+* monotonic wall clock (seconds)
+******************************************************************************/
+
+double now(void)
+{
+  struct timespec   ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
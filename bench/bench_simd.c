@@ -0,0 +1,155 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "IMU_simd.h"
+
+// define constants
+static const uint32_t num_max     = 1 << 20;  // largest batch (memory bound)
+static const int      num_size    = 2;
+static const uint32_t size_list[] = {4096, 1 << 20};
+static const int      num_rep     = 5;        // timing passes (best kept)
+static const char*    isa_name[]  = {"scalar", "sse2", "avx2", "avx512"};
+
+// operations under test
+typedef enum {
+  op_quatMult, op_quatMultConj, op_rotateForward, op_rotateReverse,
+  op_quatToUp, op_quatToFrwd, num_op
+} bench_op;
+static const char*    op_name[]   = {"quatMult", "quatMultConj",
+                                     "rotateForward", "rotateReverse",
+                                     "quatToUp", "quatToFrwd"};
+
+// internal functions
+static double run       (bench_op op, IMU_simd_quat *q1, IMU_simd_quat *q2,
+                         IMU_simd_quat *qOut, IMU_simd_vect *v,
+                         IMU_simd_vect *vOut, uint32_t num);
+static double now       (void);
+
+
+/******************************************************************************
+* main function - batched quaternion cost per instruction set
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  float             *buf = malloc(18 * num_max * sizeof(float));
+  IMU_simd_quat     q1, q2, qOut;
+  IMU_simd_vect     v, vOut;
+  IMU_simd_isa      best = IMU_simd_bestIsa(), isa;
+  double            ns[4];
+  uint32_t          i;
+  int               op, size;
+
+  // structure of arrays (component planes within one buffer)
+  printf("starting bench_simd...\n");
+  for (i=0; i<4; i++) {
+    q1.q[i]         = &buf[( 0 + i) * num_max];
+    q2.q[i]         = &buf[( 4 + i) * num_max];
+    qOut.q[i]       = &buf[( 8 + i) * num_max];
+  }
+  for (i=0; i<3; i++) {
+    v.v[i]          = &buf[(12 + i) * num_max];
+    vOut.v[i]       = &buf[(15 + i) * num_max];
+  }
+  srand(1);
+  for (i=0; i<18*num_max; i++)
+    buf[i]          = (float)(rand() % 2001 - 1000) / 1000.0f;
+
+  // print table header
+  printf("%-14s %8s", "operation", "samples");
+  for (isa=IMU_simd_scalar; isa<=best; isa++)
+    printf(" %10s", isa_name[isa]);
+  printf(" %10s\n", "speedup");
+
+  // time each operation and batch size across supported sets (ns/sample)
+  for (size=0; size<num_size; size++) {
+    for (op=0; op<num_op; op++) {
+      printf("%-14s %8u", op_name[op], size_list[size]);
+      for (isa=IMU_simd_scalar; isa<=best; isa++) {
+        IMU_simd_setIsa(isa);
+        ns[isa]     = run(op, &q1, &q2, &qOut, &v, &vOut, size_list[size]);
+        printf(" %10.3f", ns[isa]);
+      }
+      printf(" %10.2f\n", ns[IMU_simd_scalar] / ns[best]);
+    }
+  }
+
+  // exit program
+  free(buf);
+  printf("pass: bench_simd\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* apply operation repeatedly (~16M samples per pass), returns best ns/sample
+******************************************************************************/
+
+double run(
+  bench_op          op,
+  IMU_simd_quat     *q1,
+  IMU_simd_quat     *q2,
+  IMU_simd_quat     *qOut,
+  IMU_simd_vect     *v,
+  IMU_simd_vect     *vOut,
+  uint32_t          num)
+{
+  // define local variables
+  uint32_t          num_loop = (1 << 24) / num;
+  double            t_start, ns, ns_min = 0.0;
+  uint32_t          j;
+  int               k;
+
+  // main timing loop
+  for (k=0; k<num_rep; k++) {
+    t_start         = now();
+    for (j=0; j<num_loop; j++) {
+      switch (op) {
+        case op_quatMult:      IMU_simd_quatMult(q1, q2, qOut, num);    break;
+        case op_quatMultConj:  IMU_simd_quatMultConj(q1, q2, qOut, num);break;
+        case op_rotateForward: IMU_simd_rotateForward(v, q1, vOut, num);break;
+        case op_rotateReverse: IMU_simd_rotateReverse(v, q1, vOut, num);break;
+        case op_quatToUp:      IMU_simd_quatToUp(q1, vOut, num);        break;
+        case op_quatToFrwd:    IMU_simd_quatToFrwd(q1, vOut, num);      break;
+        default:                                                         break;
+      }
+    }
+    ns              = 1e9 * (now() - t_start) / ((double)num_loop * num);
+    if (k == 0 || ns < ns_min)
+      ns_min        = ns;
+  }
+  return ns_min;
+}
+
+
+/******************************************************************************
+* monotonic wall clock (seconds)
+******************************************************************************/
+
+double now(void)
+{
+  struct timespec   ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
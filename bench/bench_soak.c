@@ -0,0 +1,229 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "IMU_engn.h"
+
+// engine internal (synchronous) processing function
+int IMU_engn_process(uint16_t id, IMU_datum*);
+
+// define constants
+static const int      num_hour    = 48;       // soak duration (hours)
+static const int      num_samp    = 360000;   // samples per hour (100Hz)
+static const uint32_t tick        = 1000;     // 100Hz (10usec ticks)
+static const float    gScale      = 0.001;    // rad/sec per count
+static const float    gBias[3]    = {0.02, -0.01, 0.015};   // rad/sec
+static const int      noise       = 5;        // uniform noise (+/- counts)
+static const float    dip         = 0.5;      // magnetic dip (rad)
+static const int      num_slice   = 100;      // samples per error check
+static const int      num_avg     = 8;        // hours in cost comparison
+static const float    err_limit   = 2.0;      // max hourly rms (deg)
+static const float    cost_limit  = 1.25;     // max late/early cost ratio
+
+// internal functions
+static void   stream    (int hour, double *q, IMU_datum *data, float *truth);
+static float  error     (float *q1, float *q2);
+static double now       (void);
+
+
+/******************************************************************************
+* main function - 48 hour stream (32-bit timestamps wrap every ~11.9 hours),
+* verifies accuracy and per-datum cost stay constant
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  uint16_t          id;
+  IMU_union_config  config;
+  IMU_engn_estm     estm;
+  IMU_datum         *data  = malloc(3 * num_samp * sizeof(IMU_datum));
+  float             *truth = malloc(4 * num_samp * sizeof(float));
+  double            q[4]   = {1.0, 0.0, 0.0, 0.0};
+  double            ns[num_hour], t_start, sum, early = 0.0, late = 0.0;
+  float             rms, max, err;
+  int               isFail = 0, hour, i, j;
+
+  // full pipeline w/ mahony backend (gyro bias integral)
+  printf("starting bench_soak...\n");
+  IMU_engn_init(IMU_engn_calb_full, &id);
+  IMU_engn_getConfig(id, IMU_engn_self, &config);
+  config.engn->filter       = IMU_engn_mahony;
+  config.engn->isFOM        = 1;
+  IMU_engn_getConfig(id, IMU_engn_core, &config);
+  config.core->gScale       = gScale;
+  config.core->aWeight      = 0.02;
+  config.core->mWeight      = 0.02;
+  config.core->iWeight      = 0.5;
+  IMU_engn_reset(id);
+
+  // print table header
+  printf("%5s %12s %10s %10s %10s\n", "hour", "t (ticks)", "ns/datum",
+         "rms (deg)", "max (deg)");
+
+  // process one hour at a time (cost excludes stream generation and error)
+  for (hour=0; hour<num_hour; hour++) {
+    stream(hour, q, data, truth);
+    sum             = 0.0;
+    max             = 0.0f;
+    ns[hour]        = 0.0;
+    for (i=0; i<num_samp; i++) {
+      t_start       = now();
+      for (j=0; j<3*num_slice; j++)
+        IMU_engn_process(id, &data[3*i+j]);
+      ns[hour]     += now() - t_start;
+
+      // orientation error once per slice (against truth at slice end)
+      i            += num_slice - 1;
+      IMU_engn_getEstm(id, 0, &estm);
+      err           = error(estm.qOrg, &truth[4*i]);
+      sum          += err * err;
+      if (err > max)
+        max         = err;
+    }
+    ns[hour]        = 1e9 * ns[hour] / (3 * num_samp);
+    rms             = (float)sqrt(sum / (num_samp / num_slice));
+    printf("%5d %12u %10.2f %10.3f %10.3f\n", hour + 1,
+           data[3*num_samp-1].t, ns[hour], rms, max);
+    if (hour > 0 && !(rms <= err_limit))
+      isFail        = 1;
+  }
+
+  // compare per-datum cost of the first and last hours (after warm-up)
+  for (i=0; i<num_avg; i++) {
+    early          += ns[1+i] / num_avg;
+    late           += ns[num_hour-num_avg+i] / num_avg;
+  }
+  printf("cost: %0.2f ns/datum (hours 2-%d), %0.2f ns/datum (hours %d-%d)\n",
+         early, num_avg + 1, late, num_hour - num_avg + 1, num_hour);
+
+  // exit program
+  free(data);
+  free(truth);
+  if (isFail) {
+    printf("error: soak accuracy failure (rms > %0.1f deg)\n\n", err_limit);
+    return 1;
+  }
+  if (late > cost_limit * early) {
+    printf("error: soak cost failure (late/early %0.2f)\n\n", late / early);
+    return 1;
+  }
+  printf("pass: bench_soak\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* generate one hour of the tumbling trajectory (biased, noisy gyro w/ matching
+* accl/magn), truth propagated in q across calls
+******************************************************************************/
+
+void stream(
+  int               hour,
+  double            *q,
+  IMU_datum         *data,
+  float             *truth)
+{
+  // define local variables
+  double            w[3], dq[4], p[4], v[3], f[3], n, t;
+  uint64_t          k;
+  int               i, j;
+
+  // main loop (truth propagated w/ exact rotation of body rates)
+  srand(hour + 1);
+  for (i=0; i<num_samp; i++) {
+    k               = (uint64_t)hour * num_samp + i;
+    t               = (double)k * tick * 0.00001;
+    w[0]            = 0.8 * sin(2.0 * M_PI * 0.11 * t);
+    w[1]            = 0.6 * sin(2.0 * M_PI * 0.07 * t + 1.0);
+    w[2]            = 1.0 * sin(2.0 * M_PI * 0.05 * t + 2.0);
+
+    // rotate truth by the body rate over one sample
+    n               = sqrt(w[0]*w[0] + w[1]*w[1] + w[2]*w[2]);
+    dq[0]           = cos(0.5 * n * tick * 0.00001);
+    for (j=0; j<3; j++)
+      dq[j+1]       = (n > 0.0) ? w[j] / n * sin(0.5 * n * tick * 0.00001)
+                                : 0.0;
+    p[0]            = q[0]*dq[0] - q[1]*dq[1] - q[2]*dq[2] - q[3]*dq[3];
+    p[1]            = q[0]*dq[1] + q[1]*dq[0] + q[2]*dq[3] - q[3]*dq[2];
+    p[2]            = q[0]*dq[2] - q[1]*dq[3] + q[2]*dq[0] + q[3]*dq[1];
+    p[3]            = q[0]*dq[3] + q[1]*dq[2] - q[2]*dq[1] + q[3]*dq[0];
+    n               = sqrt(p[0]*p[0] + p[1]*p[1] + p[2]*p[2] + p[3]*p[3]);
+    for (j=0; j<4; j++) {
+      q[j]          = p[j] / n;
+      truth[4*i+j]  = (float)q[j];
+    }
+
+    // up and forward vectors in the body frame (estimator model)
+    v[0]            = 2.0 * (q[1]*q[3] - q[0]*q[2]);
+    v[1]            = 2.0 * (q[0]*q[1] + q[2]*q[3]);
+    v[2]            = 1.0 - 2.0 * (q[1]*q[1] + q[2]*q[2]);
+    f[0]            = 1.0 - 2.0 * (q[2]*q[2] + q[3]*q[3]);
+    f[1]            = 2.0 * (q[1]*q[2] - q[0]*q[3]);
+    f[2]            = 2.0 * (q[0]*q[2] + q[1]*q[3]);
+
+    // sensor datum (32-bit timestamps wrap)
+    for (j=0; j<3; j++) {
+      data[3*i+j].t    = (uint32_t)((k + 1) * tick);
+      data[3*i+j].type = (IMU_sensor)(IMU_gyro + j);
+      data[3*i].val[j]   = (IMU_TYPE)lround((w[j] + gBias[j]) / gScale +
+                                            rand() % (2*noise+1) - noise);
+      data[3*i+1].val[j] = (IMU_TYPE)lround(255.0 * v[j] +
+                                            rand() % (2*noise+1) - noise);
+      data[3*i+2].val[j] = (IMU_TYPE)lround(255.0 * (cos(dip)*f[j] -
+                                            sin(dip)*v[j]) +
+                                            rand() % (2*noise+1) - noise);
+    }
+  }
+}
+
+
+/******************************************************************************
+* angle between two orientations (degrees)
+******************************************************************************/
+
+float error(
+  float             *q1,
+  float             *q2)
+{
+  double n1  = sqrt(q1[0]*q1[0] + q1[1]*q1[1] + q1[2]*q1[2] + q1[3]*q1[3]);
+  double n2  = sqrt(q2[0]*q2[0] + q2[1]*q2[1] + q2[2]*q2[2] + q2[3]*q2[3]);
+  double dot = fabs(q1[0]*q2[0] + q1[1]*q2[1] + q1[2]*q2[2] + q1[3]*q2[3]);
+  dot        = dot / (n1 * n2);
+  if (dot > 1.0)
+    dot      = 1.0;
+  return (float)(2.0 * acos(dot) * 180.0 / M_PI);
+}
+
+
+/******************************************************************************
+* monotonic wall clock (seconds)
+******************************************************************************/
+
+double now(void)
+{
+  struct timespec   ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
@@ -0,0 +1,229 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "IMU_core.h"
+
+// define constants
+static const int      max_datum   = 4096;
+static const int      num_hold    = 10;       // 1sec power-on hold
+static const int      noise       = 25;       // uniform noise (+/- counts)
+static const float    conv_thresh = 1.0;      // converged error (deg)
+static const int      num_file    = 2;
+static const char*    file_list[] = {"../../stim/applyAcclTest.csv",
+                                     "../../stim/applyMagnTest.csv"};
+
+// startup configurations
+typedef struct {
+  const char*         name;
+  uint16_t            zeroNum;
+  float               startGain;
+  float               startTime;
+} start_mode;
+static const int      num_mode    = 3;
+static const start_mode mode_list[] = {
+  {"default",  1,  1.0, 0.0},
+  {"average", 10,  1.0, 0.0},
+  {"startup", 10, 20.0, 5.0}};
+
+// internal functions
+static int    load      (const char *filename, IMU_datum *data);
+static float  align     (float *q, IMU_datum *truth);
+static void   run       (uint16_t id, IMU_datum *data, IMU_datum *truth,
+                         int num, float *err0, float *conv, int num_seg);
+
+
+/******************************************************************************
+* main function - time-to-converge after reset for each startup mode
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  uint16_t          id;
+  IMU_core_config   *config;
+  IMU_datum         *truth = malloc(max_datum * sizeof(IMU_datum));
+  IMU_datum         *data  = malloc(max_datum * sizeof(IMU_datum));
+  float             err0 = 0.0f, conv[4];
+  int               num, file, isNoise, i, j;
+
+  // initialize core instance (gyroscope disabled, stim files are static)
+  printf("starting bench_start...\n");
+  IMU_core_init(&id, &config);
+  config->isGyro    = 0;
+
+  // print table header
+  printf("%-18s %-6s %-8s %10s %10s %10s %10s %10s\n", "file", "noise",
+         "mode", "zero (deg)", "seg1 (s)", "seg2 (s)", "seg3 (s)",
+         "seg4 (s)");
+
+  // process each stimulus file (w/ and w/o noise) and startup mode
+  for (file=0; file<num_file; file++) {
+    num = load(file_list[file], truth);
+    if (num <= 0) {
+      printf("error: unable to read %s\n", file_list[file]);
+      exit(0);
+    }
+    config->isAccl  = (truth[0].type == IMU_accl);
+    config->isMagn  = (truth[0].type == IMU_magn);
+    for (isNoise=0; isNoise<=1; isNoise++) {
+      srand(1);
+      for (i=0; i<num; i++) {
+        data[i]     = truth[i];
+        for (j=0; j<3 && isNoise; j++)
+          data[i].val[j] += (IMU_TYPE)(rand() % (2*noise+1) - noise);
+      }
+      for (i=0; i<num_mode; i++) {
+        config->zeroNum   = mode_list[i].zeroNum;
+        config->startGain = mode_list[i].startGain;
+        config->startTime = mode_list[i].startTime;
+        run(id, data, truth, num, &err0, conv, 4);
+        printf("%-18s %-6s %-8s %10.3f %10.1f %10.1f %10.1f %10.1f\n",
+               strrchr(file_list[file], '/') + 1, isNoise ? "yes" : "no",
+               mode_list[i].name, err0, conv[0], conv[1], conv[2], conv[3]);
+      }
+    }
+  }
+
+  // exit program
+  free(truth);
+  free(data);
+  printf("pass: bench_start\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* read stimulus csv file, first datum held for the power-on period
+******************************************************************************/
+
+int load(
+  const char        *filename,
+  IMU_datum         *data)
+{
+  // open stimulus file
+  FILE              *file = fopen(filename, "r");
+  int               type, t, x, y, z;
+  int               num   = 0;
+  uint32_t          tHold = 0;
+  if (file == NULL)
+    return -1;
+
+  // main loop that parses file line by line (power-on hold inserted)
+  while (num < max_datum - num_hold &&
+         fscanf(file, "%d, %d, %d, %d, %d", &type, &t, &x, &y, &z) == 5) {
+    int rep          = (num == 0) ? num_hold : 1;
+    while (rep--) {
+      data[num].type   = (IMU_sensor)type;
+      data[num].t      = (uint32_t)t + tHold;
+      data[num].val[0] = (IMU_TYPE)x;
+      data[num].val[1] = (IMU_TYPE)y;
+      data[num].val[2] = (IMU_TYPE)z;
+      if (rep > 0)
+        tHold         += 10000;
+      else if (num > 0)
+        data[num].t    = data[num-1].t + 10000;
+      num++;
+    }
+  }
+
+  // exit function
+  fclose(file);
+  return num;
+}
+
+
+/******************************************************************************
+* alignment error between estimate and noiseless datum (degrees), uses the
+* same model as IMU_math_estmAccl and IMU_math_estmMagnNorm
+******************************************************************************/
+
+float align(
+  float             *q,
+  IMU_datum         *truth)
+{
+  // normalize reference vector
+  float v[3]        = {truth->val[0], truth->val[1], truth->val[2]};
+  float mag         = sqrtf(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+  float u[3], dot;
+
+  // accelerometer (up) or magnetometer (forward) prediction
+  if (truth->type == IMU_accl) {
+    u[0]            = 2.0f*(q[1]*q[3] - q[0]*q[2]);
+    u[1]            = 2.0f*(q[0]*q[1] + q[2]*q[3]);
+    u[2]            = 1.0f - 2.0f*(q[1]*q[1] + q[2]*q[2]);
+  } else {
+    u[0]            = 1.0f - 2.0f*(q[2]*q[2] + q[3]*q[3]);
+    u[1]            = 2.0f*(q[1]*q[2] - q[0]*q[3]);
+    u[2]            = 2.0f*(q[0]*q[2] + q[1]*q[3]);
+  }
+  dot               = (u[0]*v[0] + u[1]*v[1] + u[2]*v[2]) / mag;
+  if (dot >  1.0f) dot =  1.0f;
+  if (dot < -1.0f) dot = -1.0f;
+  return acosf(dot) * 180.0f / M_PI;
+}
+
+
+/******************************************************************************
+* feed stimulus, returns zeroing error and per-segment time to converge
+******************************************************************************/
+
+void run(
+  uint16_t          id,
+  IMU_datum         *data,
+  IMU_datum         *truth,
+  int               num,
+  float             *err0,
+  float             *conv,
+  int               num_seg)
+{
+  // define local variables
+  IMU_core_state    *state;
+  uint32_t          tSeg  = data[0].t;
+  int               seg   = -1, isZero = 0, status, i;
+
+  // main processing loop
+  IMU_core_reset(id);
+  IMU_core_getState(id, &state);
+  for (i=0; i<num_seg; i++)
+    conv[i]         = -1.0f;
+  for (i=0; i<num; i++) {
+    status          = IMU_core_datum(id, &data[i], NULL);
+
+    // zeroing error (first datum after zero)
+    if (!isZero && status != IMU_core_enum_zero_accum) {
+      *err0         = align(state->q, &truth[i]);
+      isZero        = 1;
+    }
+
+    // segment starts on change of reference vector
+    if (i > 0 && memcmp(truth[i].val, truth[i-1].val,
+                        sizeof(truth[i].val)) != 0) {
+      seg++;
+      tSeg          = truth[i].t;
+    }
+    if (seg >= 0 && seg < num_seg && conv[seg] < 0.0f &&
+        align(state->q, &truth[i]) < conv_thresh)
+      conv[seg]     = (truth[i].t - tSeg) * IMU_CORE_10USEC_TO_SEC;
+  }
+}
@@ -0,0 +1,167 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "IMU_engn.hpp"
+
+// engine internal (synchronous) processing function
+extern "C" int IMU_engn_process(uint16_t id, IMU_datum*);
+
+// define constants
+static const int      num_samp    = 60000;    // datum per pass
+static const int      num_rep     = 7;        // timing passes (best kept)
+static const int      noise       = 5;        // uniform noise (+/- counts)
+
+// compile-time pipelines (match the C engine types)
+typedef IMU::engn<IMU_TYPE, IMU::stage_ref | IMU::stage_ang> engn_core;
+typedef IMU::engn<IMU_TYPE, IMU::stage_rect | IMU::stage_pnts |
+                  IMU::stage_stat | IMU::stage_calb | IMU::stage_ref |
+                  IMU::stage_ang> engn_full;
+
+// internal functions
+template <typename E>
+static void   compare   (const char *name, IMU_engn_type type,
+                         IMU_datum *data);
+static void   stream    (IMU_datum *data);
+static double now       (void);
+
+
+/******************************************************************************
+* main function - per-datum cost of IMU_engn_process vs the template engine
+* (engines are static instances, each configuration runs in its own process)
+******************************************************************************/
+
+int main(void)
+{
+  // generate datum stream
+  IMU_datum         *data = (IMU_datum*)malloc(num_samp * sizeof(IMU_datum));
+  stream(data);
+
+  // print table header
+  printf("starting bench_tmpl...\n");
+  printf("%-10s %12s %12s %8s\n", "pipeline", "C ns/datum", "tmpl ns/dtm",
+         "ratio");
+
+  // one child per configuration (flushed so children do not repeat output)
+  fflush(stdout);
+  if (fork() == 0) {
+    compare<engn_core>("core", IMU_engn_core_only, data);
+    exit(0);
+  }
+  wait(NULL);
+  fflush(stdout);
+  if (fork() == 0) {
+    compare<engn_full>("calb_full", IMU_engn_calb_full, data);
+    exit(0);
+  }
+  wait(NULL);
+
+  // exit program
+  free(data);
+  printf("\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* best pass of each engine over the same stream
+******************************************************************************/
+
+template <typename E>
+void compare(
+  const char        *name,
+  IMU_engn_type     type,
+  IMU_datum         *data)
+{
+  // define local variables
+  uint16_t          id;
+  IMU_union_config  config;
+  IMU_datum         d;
+  double            t_start, ns, cMin = 0.0, tMin = 0.0;
+  int               i, j;
+
+  // C engine (no sensor structure or FOM, as the template)
+  IMU_engn_init(type, &id);
+  IMU_engn_getConfig(id, IMU_engn_self, &config);
+  config.engn->isSensorStruct = 0;
+  config.engn->isFOM          = 0;
+  E                 tmpl;
+
+  // timed passes
+  for (j=0; j<num_rep; j++) {
+    IMU_engn_reset(id);
+    t_start         = now();
+    for (i=0; i<num_samp; i++) {
+      d             = data[i];
+      IMU_engn_process(id, &d);
+    }
+    ns              = 1e9 * (now() - t_start) / num_samp;
+    cMin            = (j == 0 || ns < cMin) ? ns : cMin;
+
+    tmpl.reset();
+    t_start         = now();
+    for (i=0; i<num_samp; i++) {
+      d             = data[i];
+      tmpl.process(&d);
+    }
+    ns              = 1e9 * (now() - t_start) / num_samp;
+    tMin            = (j == 0 || ns < tMin) ? ns : tMin;
+  }
+  printf("%-10s %12.2f %12.2f %8.2f\n", name, cMin, tMin, cMin / tMin);
+}
+
+
+/******************************************************************************
+* tumbling stream (gyro, accl, magn in turn)
+******************************************************************************/
+
+void stream(
+  IMU_datum         *data)
+{
+  int               i, k;
+  float             w;
+  srand(1);
+  for (i=0; i<num_samp; i++) {
+    k               = i / 3;
+    w               = 0.01f * k;
+    data[i].type    = (IMU_sensor)(IMU_gyro + i % 3);
+    data[i].t       = 1000 * (k + 1);
+    data[i].val[0]  = (IMU_TYPE)(200.0f * sinf(w) + rand() % (2*noise+1));
+    data[i].val[1]  = (IMU_TYPE)(150.0f * cosf(w) + rand() % (2*noise+1));
+    data[i].val[2]  = (IMU_TYPE)(250.0f - rand() % (2*noise+1));
+  }
+}
+
+
+/******************************************************************************
+* monotonic wall clock (seconds)
+******************************************************************************/
+
+double now(void)
+{
+  struct timespec   ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
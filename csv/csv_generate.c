@@ -0,0 +1,646 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/******************************************************************************
+* synthetic sensor-stream generator (load testing w/ ground truth)
+*
+* Each IMU follows a tumbling trajectory (sum of sinusoidal body rates, seeded
+* per IMU) and emits gyro/accl/magn samples at independent rates, or data3
+* at the gyro rate with -s.  Sensors use the estimator model (255 counts per
+* g/field, gScale of 0.001 rad/sec per count), so the truth quaternions are
+* directly comparable to estm.qOrg.  Time is in 10usec ticks (uint32_t, wraps
+* after ~11.9 hours and is extended to 64 bits by the library).
+*
+* outputs:
+*   csv - dataIF lines "type, t, x, y, z" or "0, t, g.., a.., m.."; the
+*         format has no IMU id, so multiple IMUs write <name>_<id>.csv
+*   bin - gen_header followed by fixed-size gen_record (native layout)
+*   udp - one csv line per datagram, IMU id sent to port + id
+*   truth (-T) - csv lines "id, t, q0, q1, q2, q3" at the gyro rate
+******************************************************************************/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "IMU_type.h"
+
+// define constants
+#define GEN_MAX_IMU      4096
+static const float    gScale      = 0.001;    // rad/sec per count
+static const float    unit        = 255.0;    // counts per g and per field
+static const float    dip         = 0.5;      // magnetic dip (rad)
+static const double   tick        = 0.00001;  // seconds per time tick
+
+// binary output format
+typedef struct {
+  char                magic[4];               // "IMUB"
+  uint16_t            version;
+  uint16_t            numIMU;
+  uint16_t            typeSize;               // sizeof(IMU_TYPE)
+  uint16_t            reserved;
+} gen_header;
+typedef struct {
+  uint16_t            id;
+  uint8_t             type;                   // IMU_sensor (IMU_sync=data3)
+  uint8_t             reserved;
+  uint32_t            t;
+  IMU_TYPE            val[9];                 // g, a, m (datum uses val[0..2])
+} gen_record;
+
+// generator configuration
+typedef enum {
+  gen_csv             = 0,
+  gen_bin             = 1,
+  gen_udp             = 2
+} gen_format;
+typedef struct {
+  double              duration;               // seconds
+  double              rate[3];                // gyro, accl, magn (Hz)
+  uint8_t             isData3;
+  double              noise[3];               // std dev (counts)
+  double              gBias[3];               // rad/sec
+  double              jitter;                 // std dev (usec)
+  double              wMax;                   // peak body rate (rad/sec)
+  double              vibAmp;                 // g
+  double              vibFreq;                // Hz
+  double              distAmp;                // fraction of field
+  double              distPeriod;             // seconds
+  double              distLen;                // seconds
+  int                 numIMU;
+  unsigned long       seed;
+  gen_format          format;
+  const char          *output;
+  const char          *host;
+  int                 port;
+  double              speed;                  // x real time (0=unthrottled)
+  const char          *truth;
+} gen_config;
+
+// per IMU trajectory state
+typedef struct {
+  uint64_t            rng;
+  double              q[4];
+  double              tLast;
+  double              freq[3];
+  double              phase[3];
+  double              dist[3];
+  uint32_t            tPrev;
+  FILE                *file;
+  struct sockaddr_in  addr;
+} gen_state;
+
+// define globals
+static gen_config     config;
+static gen_state      *state;
+static FILE           *fileBin;
+static FILE           *fileTruth;
+static int            sock        = -1;
+
+// internal functions
+static void   usage      (void);
+static int    parse      (const char *arg, double *val, int num);
+static void   open_out   (void);
+static void   init_imu   (int id);
+static void   propagate  (gen_state *s, double t);
+static void   sample     (gen_state *s, IMU_sensor type, double t,
+                          IMU_TYPE *val);
+static void   emit       (int id, IMU_sensor type, uint32_t t, IMU_TYPE *val);
+static double rnd        (uint64_t *rng);
+static double gauss      (uint64_t *rng);
+static double now        (void);
+
+
+/******************************************************************************
+* main function - synthesize trajectories and emit sensor streams
+******************************************************************************/
+
+int main(
+  int                 argc,
+  char                *argv[])
+{
+  // define local variables
+  IMU_TYPE            val[9];
+  double              tNext[3], arg[3] = {0.0, 0.0, 0.0}, t, t0, wall;
+  uint64_t            k[3] = {0, 0, 0}, count = 0;
+  uint32_t            tick_t;
+  int                 sensor, num, opt, id, i;
+
+  // default configuration (1 min, 100Hz, quiet sensors)
+  config.duration     = 60.0;
+  config.rate[0]      = config.rate[1] = config.rate[2] = 100.0;
+  config.noise[0]     = config.noise[1] = config.noise[2] = 2.0;
+  config.wMax         = 1.0;
+  config.numIMU       = 1;
+  config.seed         = 1;
+  config.format       = gen_csv;
+  config.output       = "-";
+  config.host         = "127.0.0.1";
+  config.port         = 5005;
+  config.speed        = -1.0;
+
+  // parse command line
+  while ((opt = getopt(argc, argv, "t:r:sn:b:j:w:v:d:i:k:f:o:u:x:T:h")) != -1) {
+    if (opt == 't') {
+      config.duration = atof(optarg);
+    } else if (opt == 'r') {
+      num             = parse(optarg, config.rate, 3);
+      for (i=1; i<3 && num == 1; i++)
+        config.rate[i]  = config.rate[0];
+    } else if (opt == 's') {
+      config.isData3  = 1;
+    } else if (opt == 'n') {
+      num             = parse(optarg, config.noise, 3);
+      for (i=1; i<3 && num == 1; i++)
+        config.noise[i] = config.noise[0];
+    } else if (opt == 'b') {
+      parse(optarg, config.gBias, 3);
+    } else if (opt == 'j') {
+      config.jitter   = atof(optarg);
+    } else if (opt == 'w') {
+      config.wMax     = atof(optarg);
+    } else if (opt == 'v') {
+      parse(optarg, arg, 2);
+      config.vibAmp   = arg[0];
+      config.vibFreq  = arg[1];
+    } else if (opt == 'd') {
+      arg[1]          = 10.0;
+      arg[2]          = 1.0;
+      parse(optarg, arg, 3);
+      config.distAmp    = arg[0];
+      config.distPeriod = arg[1];
+      config.distLen    = arg[2];
+    } else if (opt == 'i') {
+      config.numIMU   = atoi(optarg);
+    } else if (opt == 'k') {
+      config.seed     = strtoul(optarg, NULL, 10);
+    } else if (opt == 'f') {
+      if      (!strcmp(optarg, "csv")) config.format = gen_csv;
+      else if (!strcmp(optarg, "bin")) config.format = gen_bin;
+      else if (!strcmp(optarg, "udp")) config.format = gen_udp;
+      else    usage();
+    } else if (opt == 'o') {
+      config.output   = optarg;
+    } else if (opt == 'u') {
+      char *c         = strrchr(optarg, ':');
+      if (c == NULL)
+        usage();
+      *c              = 0;
+      config.host     = optarg;
+      config.port     = atoi(c + 1);
+    } else if (opt == 'x') {
+      config.speed    = atof(optarg);
+    } else if (opt == 'T') {
+      config.truth    = optarg;
+    } else {
+      usage();
+    }
+  }
+  if (config.numIMU < 1 || config.numIMU > GEN_MAX_IMU ||
+      config.duration <= 0.0 || config.rate[0] <= 0.0 ||
+      config.rate[1] <= 0.0 || config.rate[2] <= 0.0)
+    usage();
+  if (config.speed < 0.0)
+    config.speed      = (config.format == gen_udp) ? 1.0 : 0.0;
+
+  // initialize outputs and per IMU trajectories
+  state               = calloc(config.numIMU, sizeof(gen_state));
+  for (id=0; id<config.numIMU; id++)
+    init_imu(id);
+  open_out();
+
+
+  /****************************************************************************
+  * main loop (all IMUs share the sample schedule, not the trajectory)
+  ****************************************************************************/
+
+  for (i=0; i<3; i++)
+    tNext[i]          = 0.0;
+  t0                  = now();
+  while (1) {
+
+    // next sensor due (data3 runs on the gyro schedule)
+    sensor            = 0;
+    for (i=1; i<3 && !config.isData3; i++)
+      if (tNext[i] < tNext[sensor])
+        sensor        = i;
+    t                 = tNext[sensor];
+    if (t > config.duration)
+      break;
+    k[sensor]++;
+    tNext[sensor]     = (double)k[sensor] / config.rate[sensor];
+
+    // pace output against the wall clock
+    if (config.speed > 0.0) {
+      wall            = now() - t0;
+      if (t / config.speed > wall)
+        usleep((useconds_t)(1e6 * (t / config.speed - wall)));
+    }
+
+    // sample every IMU
+    for (id=0; id<config.numIMU; id++) {
+      gen_state *s    = &state[id];
+      propagate(s, t);
+
+      // timestamp jitter (monotonic per IMU)
+      wall            = t + 1e-6 * config.jitter * gauss(&s->rng);
+      tick_t          = (uint32_t)llround((wall > 0.0 ? wall : 0.0) / tick);
+      if ((int32_t)(tick_t - s->tPrev) < 0)
+        tick_t        = s->tPrev;
+      s->tPrev        = tick_t;
+
+      // sensor counts
+      if (config.isData3) {
+        sample(s, IMU_gyro, t, &val[0]);
+        sample(s, IMU_accl, t, &val[3]);
+        sample(s, IMU_magn, t, &val[6]);
+        emit(id, IMU_sync, tick_t, val);
+      } else {
+        sample(s, (IMU_sensor)(IMU_gyro + sensor), t, val);
+        emit(id, (IMU_sensor)(IMU_gyro + sensor), tick_t, val);
+      }
+
+      // ground truth at the gyro rate
+      if (fileTruth != NULL && sensor == 0)
+        fprintf(fileTruth, "%d, %u, %0.6f, %0.6f, %0.6f, %0.6f\n", id,
+                tick_t, s->q[0], s->q[1], s->q[2], s->q[3]);
+    }
+    count++;
+  }
+
+  // close outputs
+  for (id=0; id<config.numIMU; id++)
+    if (state[id].file != NULL && state[id].file != stdout)
+      fclose(state[id].file);
+  if (fileBin != NULL && fileBin != stdout)
+    fclose(fileBin);
+  if (fileTruth != NULL)
+    fclose(fileTruth);
+  if (sock >= 0)
+    close(sock);
+  fprintf(stderr, "generated %llu samples per IMU (%d IMUs) in %0.2f sec\n",
+          (unsigned long long)count * (config.isData3 ? 3 : 1),
+          config.numIMU, now() - t0);
+  free(state);
+  return 0;
+}
+
+
+/******************************************************************************
+* command line help
+******************************************************************************/
+
+void usage(void)
+{
+  printf("usage: csvGenerate [options]\n");
+  printf("  -t sec          duration (60)\n");
+  printf("  -r hz[,hz,hz]   gyro, accl, magn rates (100)\n");
+  printf("  -s              synchronized data3 at the gyro rate\n");
+  printf("  -n cnt[,c,c]    gyro, accl, magn noise std dev in counts (2)\n");
+  printf("  -b x,y,z        gyro bias (rad/sec)\n");
+  printf("  -j usec         timestamp jitter std dev (0)\n");
+  printf("  -w rad/sec      peak body rate of the trajectory (1.0)\n");
+  printf("  -v g,hz         accelerometer vibration amplitude and frequency\n");
+  printf("  -d amp,per,len  magnetic disturbance (field fraction, period and\n");
+  printf("                  length in sec, defaults per=10 len=1)\n");
+  printf("  -i num          number of IMUs (1)\n");
+  printf("  -k seed         random seed (1)\n");
+  printf("  -f csv|bin|udp  output format (csv)\n");
+  printf("  -o path         output file, - for stdout (-)\n");
+  printf("  -u host:port    udp destination, IMU id added to port "
+         "(127.0.0.1:5005)\n");
+  printf("  -x speed        real-time factor, 0 unthrottled (udp 1, else 0)\n");
+  printf("  -T path         ground truth csv (id, t, q0, q1, q2, q3)\n");
+  exit(0);
+}
+
+
+/******************************************************************************
+* parse comma separated values, returns number parsed
+******************************************************************************/
+
+int parse(
+  const char          *arg,
+  double              *val,
+  int                 num)
+{
+  char                *end;
+  int                 i;
+  for (i=0; i<num; i++) {
+    val[i]            = strtod(arg, &end);
+    if (end == arg)
+      break;
+    if (*end != ',') {
+      i++;
+      break;
+    }
+    arg               = end + 1;
+  }
+  return i;
+}
+
+
+/******************************************************************************
+* open output files/socket
+******************************************************************************/
+
+void open_out(void)
+{
+  // define local variables
+  gen_header          header = {{'I','M','U','B'}, 1, 0, sizeof(IMU_TYPE), 0};
+  char                name[1024];
+  const char          *ext;
+  int                 id;
+
+  // csv output (one file per IMU, dataIF has no id field)
+  if (config.format == gen_csv) {
+    for (id=0; id<config.numIMU; id++) {
+      if (!strcmp(config.output, "-")) {
+        state[id].file = stdout;
+        continue;
+      }
+      if (config.numIMU == 1) {
+        snprintf(name, sizeof(name), "%s", config.output);
+      } else {
+        ext            = strrchr(config.output, '.');
+        if (ext == NULL)
+          ext          = config.output + strlen(config.output);
+        snprintf(name, sizeof(name), "%.*s_%d%s",
+                 (int)(ext - config.output), config.output, id, ext);
+      }
+      state[id].file   = fopen(name, "w");
+      if (state[id].file == NULL) {
+        perror(name);
+        exit(1);
+      }
+    }
+  }
+
+  // binary output (single file, id in every record)
+  else if (config.format == gen_bin) {
+    fileBin            = strcmp(config.output, "-") ?
+                         fopen(config.output, "wb") : stdout;
+    if (fileBin == NULL) {
+      perror(config.output);
+      exit(1);
+    }
+    header.numIMU      = (uint16_t)config.numIMU;
+    fwrite(&header, sizeof(header), 1, fileBin);
+  }
+
+  // udp output (one destination port per IMU)
+  else {
+    sock               = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) {
+      perror("socket");
+      exit(1);
+    }
+    for (id=0; id<config.numIMU; id++) {
+      state[id].addr.sin_family = AF_INET;
+      state[id].addr.sin_port   = htons(config.port + id);
+      if (inet_pton(AF_INET, config.host, &state[id].addr.sin_addr) != 1) {
+        printf("error: invalid udp host %s\n", config.host);
+        exit(1);
+      }
+    }
+  }
+
+  // ground truth
+  if (config.truth != NULL) {
+    fileTruth          = fopen(config.truth, "w");
+    if (fileTruth == NULL) {
+      perror(config.truth);
+      exit(1);
+    }
+  }
+}
+
+
+/******************************************************************************
+* seed IMU trajectory (rate frequencies/phases and disturbance direction)
+******************************************************************************/
+
+void init_imu(
+  int                 id)
+{
+  // define local variables
+  gen_state           *s = &state[id];
+  double              n;
+  int                 i;
+
+  // independent random stream per IMU (splitmix of seed and id)
+  s->rng              = (config.seed + 1) * 0x9E3779B97F4A7C15ULL +
+                        (uint64_t)id * 0xBF58476D1CE4E5B9ULL;
+  if (s->rng == 0)
+    s->rng            = 1;
+
+  // level and north, slowly varying tumble (0.03 to 0.15 Hz per axis)
+  s->q[0]             = 1.0;
+  for (i=0; i<3; i++) {
+    s->freq[i]        = 0.03 + 0.12 * rnd(&s->rng);
+    s->phase[i]       = 2.0 * M_PI * rnd(&s->rng);
+    s->dist[i]        = gauss(&s->rng);
+  }
+  n                   = sqrt(s->dist[0]*s->dist[0] + s->dist[1]*s->dist[1] +
+                             s->dist[2]*s->dist[2]);
+  for (i=0; i<3; i++)
+    s->dist[i]       /= (n > 0.0) ? n : 1.0;
+}
+
+
+/******************************************************************************
+* propagate truth to time t (exact rotation at the midpoint body rate)
+******************************************************************************/
+
+void propagate(
+  gen_state           *s,
+  double              t)
+{
+  // define local variables
+  double              dt = t - s->tLast;
+  double              w[3], dq[4], p[4], n, tm;
+  int                 i;
+  if (dt <= 0.0)
+    return;
+
+  // midpoint body rate
+  tm                  = s->tLast + 0.5 * dt;
+  for (i=0; i<3; i++)
+    w[i]              = config.wMax * sin(2.0 * M_PI * s->freq[i] * tm +
+                                          s->phase[i]);
+
+  // rotate truth by the body rate over dt
+  n                   = sqrt(w[0]*w[0] + w[1]*w[1] + w[2]*w[2]);
+  dq[0]               = cos(0.5 * n * dt);
+  for (i=0; i<3; i++)
+    dq[i+1]           = (n > 0.0) ? w[i] / n * sin(0.5 * n * dt) : 0.0;
+  p[0]                = s->q[0]*dq[0] - s->q[1]*dq[1] - s->q[2]*dq[2] -
+                        s->q[3]*dq[3];
+  p[1]                = s->q[0]*dq[1] + s->q[1]*dq[0] + s->q[2]*dq[3] -
+                        s->q[3]*dq[2];
+  p[2]                = s->q[0]*dq[2] - s->q[1]*dq[3] + s->q[2]*dq[0] +
+                        s->q[3]*dq[1];
+  p[3]                = s->q[0]*dq[3] + s->q[1]*dq[2] - s->q[2]*dq[1] +
+                        s->q[3]*dq[0];
+  n                   = sqrt(p[0]*p[0] + p[1]*p[1] + p[2]*p[2] + p[3]*p[3]);
+  for (i=0; i<4; i++)
+    s->q[i]           = p[i] / n;
+  s->tLast            = t;
+}
+
+
+/******************************************************************************
+* sensor counts at time t (estimator model, noise/bias/vibration/disturbance)
+******************************************************************************/
+
+void sample(
+  gen_state           *s,
+  IMU_sensor          type,
+  double              t,
+  IMU_TYPE            *val)
+{
+  // define local variables
+  double              *q = s->q;
+  double              v[3], f[3], x[3], c;
+  int                 i;
+
+  // up and forward vectors in the body frame (estimator model)
+  v[0]                = 2.0 * (q[1]*q[3] - q[0]*q[2]);
+  v[1]                = 2.0 * (q[0]*q[1] + q[2]*q[3]);
+  v[2]                = 1.0 - 2.0 * (q[1]*q[1] + q[2]*q[2]);
+  f[0]                = 1.0 - 2.0 * (q[2]*q[2] + q[3]*q[3]);
+  f[1]                = 2.0 * (q[1]*q[2] - q[0]*q[3]);
+  f[2]                = 2.0 * (q[0]*q[2] + q[1]*q[3]);
+
+  // ideal measurement (counts)
+  for (i=0; i<3; i++) {
+    if (type == IMU_gyro) {
+      x[i]            = (config.wMax * sin(2.0 * M_PI * s->freq[i] * t +
+                                           s->phase[i]) +
+                         config.gBias[i]) / gScale;
+    } else if (type == IMU_accl) {
+      x[i]            = unit * (v[i] + config.vibAmp *
+                        sin(2.0 * M_PI * (config.vibFreq * t + i / 3.0)));
+    } else {
+      x[i]            = unit * (cos(dip) * f[i] - sin(dip) * v[i]);
+      if (config.distAmp != 0.0 &&
+          fmod(t, config.distPeriod) < config.distLen)
+        x[i]         += unit * config.distAmp * s->dist[i];
+    }
+  }
+
+  // sensor noise and saturation
+  for (i=0; i<3; i++) {
+    c                 = x[i] + config.noise[type - IMU_gyro] * gauss(&s->rng);
+    c                 = round(c);
+    if (c >  32767.0) c =  32767.0;
+    if (c < -32768.0) c = -32768.0;
+    val[i]            = (IMU_TYPE)c;
+  }
+}
+
+
+/******************************************************************************
+* write one sample in the configured output format
+******************************************************************************/
+
+void emit(
+  int                 id,
+  IMU_sensor          type,
+  uint32_t            t,
+  IMU_TYPE            *val)
+{
+  // define local variables
+  gen_record          rec;
+  char                line[256];
+  int                 len;
+
+  // binary record (data3 carries all nine values)
+  if (config.format == gen_bin) {
+    memset(&rec, 0, sizeof(rec));
+    rec.id            = (uint16_t)id;
+    rec.type          = (uint8_t)type;
+    rec.t             = t;
+    memcpy(rec.val, val, (type == IMU_sync ? 9 : 3) * sizeof(IMU_TYPE));
+    fwrite(&rec, sizeof(rec), 1, fileBin);
+    return;
+  }
+
+  // dataIF csv line
+  if (type == IMU_sync)
+    len = snprintf(line, sizeof(line),
+                   "0, %u, %d, %d, %d, %d, %d, %d, %d, %d, %d\n", t,
+                   val[0], val[1], val[2], val[3], val[4], val[5],
+                   val[6], val[7], val[8]);
+  else
+    len = snprintf(line, sizeof(line), "%d, %u, %d, %d, %d\n", (int)type,
+                   t, val[0], val[1], val[2]);
+  if (config.format == gen_csv)
+    fwrite(line, 1, len, state[id].file);
+  else
+    sendto(sock, line, len, 0, (struct sockaddr *)&state[id].addr,
+           sizeof(state[id].addr));
+}
+
+
+/******************************************************************************
+* uniform [0,1) random number (xorshift64*)
+******************************************************************************/
+
+double rnd(
+  uint64_t            *rng)
+{
+  *rng               ^= *rng >> 12;
+  *rng               ^= *rng << 25;
+  *rng               ^= *rng >> 27;
+  return (double)((*rng * 0x2545F4914F6CDD1DULL) >> 11) / 9007199254740992.0;
+}
+
+
+/******************************************************************************
+* standard normal random number (box-muller)
+******************************************************************************/
+
+double gauss(
+  uint64_t            *rng)
+{
+  double u1           = rnd(rng);
+  double u2           = rnd(rng);
+  if (u1 < 1e-300)
+    u1                = 1e-300;
+  return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+
+/******************************************************************************
+* monotonic wall clock (seconds)
+******************************************************************************/
+
+double now(void)
+{
+  struct timespec     ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
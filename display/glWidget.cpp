@@ -60,12 +60,16 @@ GLWidget::GLWidget(QWidget *parent) :
   scaleMagn  = 1;
   scaleGyro  = 1;
   
-  // get pointer to the sensor data
+  // enable outputs (published w/ engn config) and get sensor data pointer
+  IMU_engn_config  engn;
   IMU_union_config configIMU;
-  IMU_engn_getConfig(0, IMU_engn_self, &configIMU);
-  configIMU.engn->isRef          = 1;
-  configIMU.engn->isAng          = 1;
-  configIMU.engn->isSensorStruct = 1;
+  configIMU.engn      = &engn;
+  IMU_engn_copyConfig(0, IMU_engn_self, &configIMU);
+  engn.isRef          = 1;
+  engn.isAng          = 1;
+  engn.isSensorStruct = 1;
+  IMU_engn_setConfig(0, IMU_engn_self, &configIMU);
+  IMU_engn_syncConfig(0);
   IMU_engn_getSensor(0, &sensor);
 
   // create timer
@@ -37,19 +37,6 @@ windowGUI::windowGUI(QWidget *parent) :
   // create and place window widgets
   ui->setupUi(this);
 
-  // get pointers to config and state structures
-  IMU_union_config configUnion;
-  IMU_engn_getConfig(0, IMU_engn_core, &configUnion);
-  configCore = configUnion.core;
-  IMU_engn_getConfig(0, IMU_engn_rect, &configUnion);
-  configRect = configUnion.rect;
-  IMU_engn_getConfig(0, IMU_engn_pnts, &configUnion);
-  configPnts = configUnion.pnts;
-  IMU_engn_getConfig(0, IMU_engn_stat, &configUnion);
-  configStat = configUnion.stat;
-  IMU_engn_getConfig(0, IMU_engn_calb, &configUnion);
-  configCalb = configUnion.calb;
-
   // get points to IMU_stat state
   IMU_union_state stateIMU;
   IMU_engn_getState(0, IMU_engn_stat, &stateIMU);
@@ -134,6 +121,7 @@ void windowGUI::stat_update()
 void windowGUI::on_calb_go_clicked()
 {
   IMU_engn_calbStat(0);
+  IMU_engn_syncConfig(0);
   rect_write();
   core_write();
   pnts_write();
@@ -147,6 +135,7 @@ void windowGUI::on_calb_go_clicked()
 void windowGUI::on_calb_undo_clicked()
 {
   IMU_engn_calbRevert(0);
+  IMU_engn_syncConfig(0);
   rect_write();
   core_write();
   pnts_write();
@@ -159,22 +148,27 @@ void windowGUI::on_calb_undo_clicked()
 
 void windowGUI::core_write()
 {
-  ui->core_isGyro->setChecked(configCore->isGyro);
-  ui->core_isAccl->setChecked(configCore->isAccl);
-  ui->core_isMagn->setChecked(configCore->isMagn);
-  ui->core_isFOM->setChecked(configCore->isFOM);
-  ui->core_isTran->setChecked(configCore->isTran);
-  ui->core_isPredict->setChecked(configCore->isPredict);
-  ui->core_gScale->setText(QString::number(configCore->gScale, 'f', 6));
-  ui->core_aWeight->setText(QString::number(configCore->aWeight, 'f', 3));
-  ui->core_aMag->setText(QString::number(configCore->aMag, 'f', 2));
-  ui->core_aMagThresh->setText(QString::number(configCore->aMagThresh, 'f', 2));
-  ui->core_mWeight->setText(QString::number(configCore->mWeight, 'f', 3));
-  ui->core_mMag->setText(QString::number(configCore->mMag, 'f', 2));
-  ui->core_mMagThresh->setText(QString::number(configCore->mMagThresh, 'f', 2));
-  ui->core_mDot->setText(QString::number(configCore->mDot, 'f', 3));
-  ui->core_mDotThresh->setText(QString::number(configCore->mDotThresh, 'f', 3));
-  ui->core_tranAlpha->setText(QString::number(configCore->tranAlpha, 'f', 2));
+  // consistent copy of published config
+  IMU_core_config cur;
+  IMU_union_config configUnion;
+  configUnion.core = &cur;
+  IMU_engn_copyConfig(0, IMU_engn_core, &configUnion);
+  ui->core_isGyro->setChecked(cur.isGyro);
+  ui->core_isAccl->setChecked(cur.isAccl);
+  ui->core_isMagn->setChecked(cur.isMagn);
+  ui->core_isFOM->setChecked(cur.isFOM);
+  ui->core_isTran->setChecked(cur.isTran);
+  ui->core_isPredict->setChecked(cur.isPredict);
+  ui->core_gScale->setText(QString::number(cur.gScale, 'f', 6));
+  ui->core_aWeight->setText(QString::number(cur.aWeight, 'f', 3));
+  ui->core_aMag->setText(QString::number(cur.aMag, 'f', 2));
+  ui->core_aMagThresh->setText(QString::number(cur.aMagThresh, 'f', 2));
+  ui->core_mWeight->setText(QString::number(cur.mWeight, 'f', 3));
+  ui->core_mMag->setText(QString::number(cur.mMag, 'f', 2));
+  ui->core_mMagThresh->setText(QString::number(cur.mMagThresh, 'f', 2));
+  ui->core_mDot->setText(QString::number(cur.mDot, 'f', 3));
+  ui->core_mDotThresh->setText(QString::number(cur.mDotThresh, 'f', 3));
+  ui->core_tranAlpha->setText(QString::number(cur.tranAlpha, 'f', 2));
 }
 
 
@@ -184,22 +178,28 @@ void windowGUI::core_write()
 
 void windowGUI::core_read()
 {
-  configCore->isGyro       = ui->core_isGyro->isChecked();
-  configCore->isAccl       = ui->core_isAccl->isChecked();
-  configCore->isMagn       = ui->core_isMagn->isChecked();
-  configCore->isFOM        = ui->core_isFOM->isChecked();
-  configCore->isTran       = ui->core_isTran->isChecked();
-  configCore->isPredict    = ui->core_isPredict->isChecked();
-  configCore->gScale       = ui->core_gScale->text().toFloat();
-  configCore->aWeight      = ui->core_aWeight->text().toFloat();
-  configCore->aMag         = ui->core_aMag->text().toFloat();
-  configCore->aMagThresh   = ui->core_aMagThresh->text().toFloat();
-  configCore->mWeight      = ui->core_mWeight->text().toFloat();
-  configCore->mMag         = ui->core_mMag->text().toFloat();
-  configCore->mMagThresh   = ui->core_mMagThresh->text().toFloat();
-  configCore->mDot         = ui->core_mDot->text().toFloat();
-  configCore->mDotThresh   = ui->core_mDotThresh->text().toFloat();
-  configCore->tranAlpha    = ui->core_tranAlpha->text().toFloat();
+  // edit copy of published config (consistent, published whole)
+  IMU_core_config cur;
+  IMU_union_config configUnion;
+  configUnion.core = &cur;
+  IMU_engn_copyConfig(0, IMU_engn_core, &configUnion);
+  cur.isGyro               = ui->core_isGyro->isChecked();
+  cur.isAccl               = ui->core_isAccl->isChecked();
+  cur.isMagn               = ui->core_isMagn->isChecked();
+  cur.isFOM                = ui->core_isFOM->isChecked();
+  cur.isTran               = ui->core_isTran->isChecked();
+  cur.isPredict            = ui->core_isPredict->isChecked();
+  cur.gScale               = ui->core_gScale->text().toFloat();
+  cur.aWeight              = ui->core_aWeight->text().toFloat();
+  cur.aMag                 = ui->core_aMag->text().toFloat();
+  cur.aMagThresh           = ui->core_aMagThresh->text().toFloat();
+  cur.mWeight              = ui->core_mWeight->text().toFloat();
+  cur.mMag                 = ui->core_mMag->text().toFloat();
+  cur.mMagThresh           = ui->core_mMagThresh->text().toFloat();
+  cur.mDot                 = ui->core_mDot->text().toFloat();
+  cur.mDotThresh           = ui->core_mDotThresh->text().toFloat();
+  cur.tranAlpha            = ui->core_tranAlpha->text().toFloat();
+  IMU_engn_setConfig(0, IMU_engn_core, &configUnion);
 }
 
 
@@ -209,43 +209,48 @@ void windowGUI::core_read()
 
 void windowGUI::rect_write()
 {
-  ui->rect_enable->setChecked(configRect->enable);
-  ui->rect_gBias0->setText(QString::number(configRect->gBias[0], 'f', 5));
-  ui->rect_gBias1->setText(QString::number(configRect->gBias[1], 'f', 5));
-  ui->rect_gBias2->setText(QString::number(configRect->gBias[2], 'f', 5));
-  ui->rect_gMult0->setText(QString::number(configRect->gMult[0], 'f', 5));
-  ui->rect_gMult1->setText(QString::number(configRect->gMult[1], 'f', 5));
-  ui->rect_gMult2->setText(QString::number(configRect->gMult[2], 'f', 5));
-  ui->rect_gMult3->setText(QString::number(configRect->gMult[3], 'f', 5));
-  ui->rect_gMult4->setText(QString::number(configRect->gMult[4], 'f', 5));
-  ui->rect_gMult5->setText(QString::number(configRect->gMult[5], 'f', 5));
-  ui->rect_gMult6->setText(QString::number(configRect->gMult[6], 'f', 5));
-  ui->rect_gMult7->setText(QString::number(configRect->gMult[7], 'f', 5));
-  ui->rect_gMult8->setText(QString::number(configRect->gMult[8], 'f', 5));
-  ui->rect_aBias0->setText(QString::number(configRect->aBias[0], 'f', 5));
-  ui->rect_aBias1->setText(QString::number(configRect->aBias[1], 'f', 5));
-  ui->rect_aBias2->setText(QString::number(configRect->aBias[2], 'f', 5));
-  ui->rect_aMult0->setText(QString::number(configRect->aMult[0], 'f', 5));
-  ui->rect_aMult1->setText(QString::number(configRect->aMult[1], 'f', 5));
-  ui->rect_aMult2->setText(QString::number(configRect->aMult[2], 'f', 5));
-  ui->rect_aMult3->setText(QString::number(configRect->aMult[3], 'f', 5));
-  ui->rect_aMult4->setText(QString::number(configRect->aMult[4], 'f', 5));
-  ui->rect_aMult5->setText(QString::number(configRect->aMult[5], 'f', 5));
-  ui->rect_aMult6->setText(QString::number(configRect->aMult[6], 'f', 5));
-  ui->rect_aMult7->setText(QString::number(configRect->aMult[7], 'f', 5));
-  ui->rect_aMult8->setText(QString::number(configRect->aMult[8], 'f', 5));
-  ui->rect_mBias0->setText(QString::number(configRect->mBias[0], 'f', 5));
-  ui->rect_mBias1->setText(QString::number(configRect->mBias[1], 'f', 5));
-  ui->rect_mBias2->setText(QString::number(configRect->mBias[2], 'f', 5));
-  ui->rect_mMult0->setText(QString::number(configRect->mMult[0], 'f', 5));
-  ui->rect_mMult1->setText(QString::number(configRect->mMult[1], 'f', 5));
-  ui->rect_mMult2->setText(QString::number(configRect->mMult[2], 'f', 5));
-  ui->rect_mMult3->setText(QString::number(configRect->mMult[3], 'f', 5));
-  ui->rect_mMult4->setText(QString::number(configRect->mMult[4], 'f', 5));
-  ui->rect_mMult5->setText(QString::number(configRect->mMult[5], 'f', 5));
-  ui->rect_mMult6->setText(QString::number(configRect->mMult[6], 'f', 5));
-  ui->rect_mMult7->setText(QString::number(configRect->mMult[7], 'f', 5));
-  ui->rect_mMult8->setText(QString::number(configRect->mMult[8], 'f', 5));
+  // consistent copy of published config
+  IMU_rect_config cur;
+  IMU_union_config configUnion;
+  configUnion.rect = &cur;
+  IMU_engn_copyConfig(0, IMU_engn_rect, &configUnion);
+  ui->rect_enable->setChecked(cur.enable);
+  ui->rect_gBias0->setText(QString::number(cur.gBias[0], 'f', 5));
+  ui->rect_gBias1->setText(QString::number(cur.gBias[1], 'f', 5));
+  ui->rect_gBias2->setText(QString::number(cur.gBias[2], 'f', 5));
+  ui->rect_gMult0->setText(QString::number(cur.gMult[0], 'f', 5));
+  ui->rect_gMult1->setText(QString::number(cur.gMult[1], 'f', 5));
+  ui->rect_gMult2->setText(QString::number(cur.gMult[2], 'f', 5));
+  ui->rect_gMult3->setText(QString::number(cur.gMult[3], 'f', 5));
+  ui->rect_gMult4->setText(QString::number(cur.gMult[4], 'f', 5));
+  ui->rect_gMult5->setText(QString::number(cur.gMult[5], 'f', 5));
+  ui->rect_gMult6->setText(QString::number(cur.gMult[6], 'f', 5));
+  ui->rect_gMult7->setText(QString::number(cur.gMult[7], 'f', 5));
+  ui->rect_gMult8->setText(QString::number(cur.gMult[8], 'f', 5));
+  ui->rect_aBias0->setText(QString::number(cur.aBias[0], 'f', 5));
+  ui->rect_aBias1->setText(QString::number(cur.aBias[1], 'f', 5));
+  ui->rect_aBias2->setText(QString::number(cur.aBias[2], 'f', 5));
+  ui->rect_aMult0->setText(QString::number(cur.aMult[0], 'f', 5));
+  ui->rect_aMult1->setText(QString::number(cur.aMult[1], 'f', 5));
+  ui->rect_aMult2->setText(QString::number(cur.aMult[2], 'f', 5));
+  ui->rect_aMult3->setText(QString::number(cur.aMult[3], 'f', 5));
+  ui->rect_aMult4->setText(QString::number(cur.aMult[4], 'f', 5));
+  ui->rect_aMult5->setText(QString::number(cur.aMult[5], 'f', 5));
+  ui->rect_aMult6->setText(QString::number(cur.aMult[6], 'f', 5));
+  ui->rect_aMult7->setText(QString::number(cur.aMult[7], 'f', 5));
+  ui->rect_aMult8->setText(QString::number(cur.aMult[8], 'f', 5));
+  ui->rect_mBias0->setText(QString::number(cur.mBias[0], 'f', 5));
+  ui->rect_mBias1->setText(QString::number(cur.mBias[1], 'f', 5));
+  ui->rect_mBias2->setText(QString::number(cur.mBias[2], 'f', 5));
+  ui->rect_mMult0->setText(QString::number(cur.mMult[0], 'f', 5));
+  ui->rect_mMult1->setText(QString::number(cur.mMult[1], 'f', 5));
+  ui->rect_mMult2->setText(QString::number(cur.mMult[2], 'f', 5));
+  ui->rect_mMult3->setText(QString::number(cur.mMult[3], 'f', 5));
+  ui->rect_mMult4->setText(QString::number(cur.mMult[4], 'f', 5));
+  ui->rect_mMult5->setText(QString::number(cur.mMult[5], 'f', 5));
+  ui->rect_mMult6->setText(QString::number(cur.mMult[6], 'f', 5));
+  ui->rect_mMult7->setText(QString::number(cur.mMult[7], 'f', 5));
+  ui->rect_mMult8->setText(QString::number(cur.mMult[8], 'f', 5));
 }
 
 
@@ -255,43 +260,49 @@ void windowGUI::rect_write()
 
 void windowGUI::rect_read()
 {
-  configRect->enable   = ui->rect_enable->isChecked();
-  configRect->gBias[0] = ui->rect_gBias0->text().toFloat();
-  configRect->gBias[1] = ui->rect_gBias1->text().toFloat();
-  configRect->gBias[2] = ui->rect_gBias2->text().toFloat();
-  configRect->gMult[0] = ui->rect_gMult0->text().toFloat();
-  configRect->gMult[1] = ui->rect_gMult1->text().toFloat();
-  configRect->gMult[2] = ui->rect_gMult2->text().toFloat();
-  configRect->gMult[3] = ui->rect_gMult3->text().toFloat();
-  configRect->gMult[4] = ui->rect_gMult4->text().toFloat();
-  configRect->gMult[5] = ui->rect_gMult5->text().toFloat();
-  configRect->gMult[6] = ui->rect_gMult6->text().toFloat();
-  configRect->gMult[7] = ui->rect_gMult7->text().toFloat();
-  configRect->gMult[8] = ui->rect_gMult8->text().toFloat();
-  configRect->aBias[0] = ui->rect_aBias0->text().toFloat();
-  configRect->aBias[1] = ui->rect_aBias1->text().toFloat();
-  configRect->aBias[2] = ui->rect_aBias2->text().toFloat();
-  configRect->aMult[0] = ui->rect_aMult0->text().toFloat();
-  configRect->aMult[1] = ui->rect_aMult1->text().toFloat();
-  configRect->aMult[2] = ui->rect_aMult2->text().toFloat();
-  configRect->aMult[3] = ui->rect_aMult3->text().toFloat();
-  configRect->aMult[4] = ui->rect_aMult4->text().toFloat();
-  configRect->aMult[5] = ui->rect_aMult5->text().toFloat();
-  configRect->aMult[6] = ui->rect_aMult6->text().toFloat();
-  configRect->aMult[7] = ui->rect_aMult7->text().toFloat();
-  configRect->aMult[8] = ui->rect_aMult8->text().toFloat();
-  configRect->mBias[0] = ui->rect_mBias0->text().toFloat();
-  configRect->mBias[1] = ui->rect_mBias1->text().toFloat();
-  configRect->mBias[2] = ui->rect_mBias2->text().toFloat();
-  configRect->mMult[0] = ui->rect_mMult0->text().toFloat();
-  configRect->mMult[1] = ui->rect_mMult1->text().toFloat();
-  configRect->mMult[2] = ui->rect_mMult2->text().toFloat();
-  configRect->mMult[3] = ui->rect_mMult3->text().toFloat();
-  configRect->mMult[4] = ui->rect_mMult4->text().toFloat();
-  configRect->mMult[5] = ui->rect_mMult5->text().toFloat();
-  configRect->mMult[6] = ui->rect_mMult6->text().toFloat();
-  configRect->mMult[7] = ui->rect_mMult7->text().toFloat();
-  configRect->mMult[8] = ui->rect_mMult8->text().toFloat();
+  // edit copy of published config (consistent, published whole)
+  IMU_rect_config cur;
+  IMU_union_config configUnion;
+  configUnion.rect = &cur;
+  IMU_engn_copyConfig(0, IMU_engn_rect, &configUnion);
+  cur.enable           = ui->rect_enable->isChecked();
+  cur.gBias[0]         = ui->rect_gBias0->text().toFloat();
+  cur.gBias[1]         = ui->rect_gBias1->text().toFloat();
+  cur.gBias[2]         = ui->rect_gBias2->text().toFloat();
+  cur.gMult[0]         = ui->rect_gMult0->text().toFloat();
+  cur.gMult[1]         = ui->rect_gMult1->text().toFloat();
+  cur.gMult[2]         = ui->rect_gMult2->text().toFloat();
+  cur.gMult[3]         = ui->rect_gMult3->text().toFloat();
+  cur.gMult[4]         = ui->rect_gMult4->text().toFloat();
+  cur.gMult[5]         = ui->rect_gMult5->text().toFloat();
+  cur.gMult[6]         = ui->rect_gMult6->text().toFloat();
+  cur.gMult[7]         = ui->rect_gMult7->text().toFloat();
+  cur.gMult[8]         = ui->rect_gMult8->text().toFloat();
+  cur.aBias[0]         = ui->rect_aBias0->text().toFloat();
+  cur.aBias[1]         = ui->rect_aBias1->text().toFloat();
+  cur.aBias[2]         = ui->rect_aBias2->text().toFloat();
+  cur.aMult[0]         = ui->rect_aMult0->text().toFloat();
+  cur.aMult[1]         = ui->rect_aMult1->text().toFloat();
+  cur.aMult[2]         = ui->rect_aMult2->text().toFloat();
+  cur.aMult[3]         = ui->rect_aMult3->text().toFloat();
+  cur.aMult[4]         = ui->rect_aMult4->text().toFloat();
+  cur.aMult[5]         = ui->rect_aMult5->text().toFloat();
+  cur.aMult[6]         = ui->rect_aMult6->text().toFloat();
+  cur.aMult[7]         = ui->rect_aMult7->text().toFloat();
+  cur.aMult[8]         = ui->rect_aMult8->text().toFloat();
+  cur.mBias[0]         = ui->rect_mBias0->text().toFloat();
+  cur.mBias[1]         = ui->rect_mBias1->text().toFloat();
+  cur.mBias[2]         = ui->rect_mBias2->text().toFloat();
+  cur.mMult[0]         = ui->rect_mMult0->text().toFloat();
+  cur.mMult[1]         = ui->rect_mMult1->text().toFloat();
+  cur.mMult[2]         = ui->rect_mMult2->text().toFloat();
+  cur.mMult[3]         = ui->rect_mMult3->text().toFloat();
+  cur.mMult[4]         = ui->rect_mMult4->text().toFloat();
+  cur.mMult[5]         = ui->rect_mMult5->text().toFloat();
+  cur.mMult[6]         = ui->rect_mMult6->text().toFloat();
+  cur.mMult[7]         = ui->rect_mMult7->text().toFloat();
+  cur.mMult[8]         = ui->rect_mMult8->text().toFloat();
+  IMU_engn_setConfig(0, IMU_engn_rect, &configUnion);
 }
 
 
@@ -301,18 +312,23 @@ void windowGUI::rect_read()
 
 void windowGUI::pnts_write()
 {
-  ui->pnts_enable->setChecked(configPnts->enable);
-  ui->pnts_isGyro->setChecked(configPnts->isGyro);
-  ui->pnts_isAccl->setChecked(configPnts->isAccl);
-  ui->pnts_isMagn->setChecked(configPnts->isMagn);
-  ui->pnts_tHold->setText(QString::number(configPnts->tHold/100.0, 'f', 1));
-  ui->pnts_tStable->setText(QString::number(configPnts->tStable/100.0, 'f', 1));
-  ui->pnts_gAlpha->setText(QString::number(configPnts->gAlpha, 'f', 3));
-  ui->pnts_gThresh->setText(QString::number(sqrt(configPnts->gThresh), 'f', 2));
-  ui->pnts_aAlpha->setText(QString::number(configPnts->aAlpha, 'f', 3));
-  ui->pnts_aThresh->setText(QString::number(sqrt(configPnts->aThresh), 'f', 2));
-  ui->pnts_mAlpha->setText(QString::number(configPnts->mAlpha, 'f', 3));
-  ui->pnts_mThresh->setText(QString::number(sqrt(configPnts->mThresh), 'f', 2));
+  // consistent copy of published config
+  IMU_pnts_config cur;
+  IMU_union_config configUnion;
+  configUnion.pnts = &cur;
+  IMU_engn_copyConfig(0, IMU_engn_pnts, &configUnion);
+  ui->pnts_enable->setChecked(cur.enable);
+  ui->pnts_isGyro->setChecked(cur.isGyro);
+  ui->pnts_isAccl->setChecked(cur.isAccl);
+  ui->pnts_isMagn->setChecked(cur.isMagn);
+  ui->pnts_tHold->setText(QString::number(cur.tHold/100.0, 'f', 1));
+  ui->pnts_tStable->setText(QString::number(cur.tStable/100.0, 'f', 1));
+  ui->pnts_gAlpha->setText(QString::number(cur.gAlpha, 'f', 3));
+  ui->pnts_gThresh->setText(QString::number(sqrt(cur.gThresh), 'f', 2));
+  ui->pnts_aAlpha->setText(QString::number(cur.aAlpha, 'f', 3));
+  ui->pnts_aThresh->setText(QString::number(sqrt(cur.aThresh), 'f', 2));
+  ui->pnts_mAlpha->setText(QString::number(cur.mAlpha, 'f', 3));
+  ui->pnts_mThresh->setText(QString::number(sqrt(cur.mThresh), 'f', 2));
 }
 
 
@@ -322,18 +338,24 @@ void windowGUI::pnts_write()
 
 void windowGUI::pnts_read()
 {
-  configPnts->enable       = ui->pnts_enable->isChecked();
-  configPnts->isGyro       = ui->pnts_isGyro->isChecked();
-  configPnts->isAccl       = ui->pnts_isAccl->isChecked();
-  configPnts->isMagn       = ui->pnts_isMagn->isChecked();
-  configPnts->tHold        = 100.0*ui->pnts_tHold->text().toFloat();
-  configPnts->tStable      = 100.0*ui->pnts_tStable->text().toFloat();
-  configPnts->gAlpha       = ui->pnts_gAlpha->text().toFloat();
-  configPnts->gThresh      = pow(ui->pnts_gThresh->text().toFloat(),2);
-  configPnts->aAlpha       = ui->pnts_aAlpha->text().toFloat();
-  configPnts->aThresh      = pow(ui->pnts_aThresh->text().toFloat(),2);
-  configPnts->mAlpha       = ui->pnts_mAlpha->text().toFloat();
-  configPnts->mThresh      = pow(ui->pnts_mThresh->text().toFloat(),2);
+  // edit copy of published config (consistent, published whole)
+  IMU_pnts_config cur;
+  IMU_union_config configUnion;
+  configUnion.pnts = &cur;
+  IMU_engn_copyConfig(0, IMU_engn_pnts, &configUnion);
+  cur.enable               = ui->pnts_enable->isChecked();
+  cur.isGyro               = ui->pnts_isGyro->isChecked();
+  cur.isAccl               = ui->pnts_isAccl->isChecked();
+  cur.isMagn               = ui->pnts_isMagn->isChecked();
+  cur.tHold                = 100.0*ui->pnts_tHold->text().toFloat();
+  cur.tStable              = 100.0*ui->pnts_tStable->text().toFloat();
+  cur.gAlpha               = ui->pnts_gAlpha->text().toFloat();
+  cur.gThresh              = pow(ui->pnts_gThresh->text().toFloat(),2);
+  cur.aAlpha               = ui->pnts_aAlpha->text().toFloat();
+  cur.aThresh              = pow(ui->pnts_aThresh->text().toFloat(),2);
+  cur.mAlpha               = ui->pnts_mAlpha->text().toFloat();
+  cur.mThresh              = pow(ui->pnts_mThresh->text().toFloat(),2);
+  IMU_engn_setConfig(0, IMU_engn_pnts, &configUnion);
 }
 
 
@@ -343,8 +365,13 @@ void windowGUI::pnts_read()
 
 void windowGUI::stat_write()
 {
-  ui->stat_enable->setChecked(configStat->enable);
-  ui->stat_alpha->setText(QString::number(configStat->alpha, 'f', 5));
+  // consistent copy of published config
+  IMU_stat_config cur;
+  IMU_union_config configUnion;
+  configUnion.stat = &cur;
+  IMU_engn_copyConfig(0, IMU_engn_stat, &configUnion);
+  ui->stat_enable->setChecked(cur.enable);
+  ui->stat_alpha->setText(QString::number(cur.alpha, 'f', 5));
 }
 
 
@@ -354,8 +381,14 @@ void windowGUI::stat_write()
 
 void windowGUI::stat_read()
 {
-  configStat->enable       = ui->stat_enable->isChecked();
-  configStat->alpha        = ui->stat_alpha->text().toFloat();
+  // edit copy of published config (consistent, published whole)
+  IMU_stat_config cur;
+  IMU_union_config configUnion;
+  configUnion.stat = &cur;
+  IMU_engn_copyConfig(0, IMU_engn_stat, &configUnion);
+  cur.enable               = ui->stat_enable->isChecked();
+  cur.alpha                = ui->stat_alpha->text().toFloat();
+  IMU_engn_setConfig(0, IMU_engn_stat, &configUnion);
 }
 
 
@@ -365,8 +398,13 @@ void windowGUI::stat_read()
 
 void windowGUI::calb_write()
 {
-  ui->calb_enable->setChecked(configCalb->enable);
-  ui->calb_sigma->setText(QString::number(configCalb->sigma, 'f', 2));
+  // consistent copy of published config
+  IMU_calb_config cur;
+  IMU_union_config configUnion;
+  configUnion.calb = &cur;
+  IMU_engn_copyConfig(0, IMU_engn_calb, &configUnion);
+  ui->calb_enable->setChecked(cur.enable);
+  ui->calb_sigma->setText(QString::number(cur.sigma, 'f', 2));
 }
 
 
@@ -376,8 +414,14 @@ void windowGUI::calb_write()
 
 void windowGUI::calb_read()
 {
-  configCalb->enable       = ui->calb_enable->isChecked();
-  configCalb->sigma        = ui->calb_sigma->text().toFloat();
+  // edit copy of published config (consistent, published whole)
+  IMU_calb_config cur;
+  IMU_union_config configUnion;
+  configUnion.calb = &cur;
+  IMU_engn_copyConfig(0, IMU_engn_calb, &configUnion);
+  cur.enable               = ui->calb_enable->isChecked();
+  cur.sigma                = ui->calb_sigma->text().toFloat();
+  IMU_engn_setConfig(0, IMU_engn_calb, &configUnion);
 }
 
 
@@ -72,11 +72,6 @@ private slots:
 
 private:
   // internal structures/classes
-  IMU_core_config     *configCore;
-  IMU_rect_config     *configRect;
-  IMU_pnts_config     *configPnts;
-  IMU_stat_config     *configStat;
-  IMU_calb_config     *configCalb;
   IMU_stat_state      *stat;
   Ui::windowGUI       *ui;
   QTimer              *refresh_timer;
@@ -20,28 +20,65 @@
 // include statements 
 #include <math.h>             // sqrt
 #include <string.h>           // memcpy
+#include <stdatomic.h>
 #if IMU_USE_PTHREAD
 #include <pthread.h>
+#include <semaphore.h>
 #include <unistd.h>
 #endif
 #include "IMU_calb.h"
 
+// internal type definitions (points and starting solution copied to job)
+typedef struct {
+  IMU_calb_mode         mode;
+  IMU_pnts_entry        table  [IMU_CALB_SIZE];
+  IMU_rect_config       rect;
+  IMU_core_config       core;
+  IMU_calb_FOM          FOM;
+} IMU_calb_job;
+typedef struct {
+  IMU_calb_job          job    [IMU_CALB_QUEUE_SIZE];
+  atomic_uint           head;                // queued (pipeline thread)
+  atomic_uint           done;                // solved (worker thread)
+  atomic_uint           tail;                // applied (pipeline thread)
+} IMU_calb_queue;
+typedef struct {
+  double                P      [9][9];       // parameter covariance
+  double                theta  [9];          // quadric coefficients
+  double                scale;               // input normalization (counts)
+  double                resid;               // mean squared residual (ewma)
+  float                 bias   [3];          // last published solution
+  float                 mult   [9];
+  uint8_t               isPub;
+} IMU_calb_rls;
+
 // internally defined variables
-static IMU_calb_config  config [IMU_MAX_INST];
+static IMU_calb_config *config [IMU_MAX_INST];
+static IMU_calb_config  configOwn[IMU_MAX_INST];
 static IMU_calb_state   state  [IMU_MAX_INST];
 static IMU_pnts_entry   table  [IMU_MAX_INST][IMU_CALB_SIZE]; 
+static IMU_calb_queue   queue  [IMU_MAX_INST];
+static IMU_calb_rls     rls    [IMU_MAX_INST];
 static uint16_t         numInst  = 0;
 #if IMU_USE_PTHREAD
-static pthread_t        thrd     [IMU_MAX_INST];
-static pthread_attr_t   thrdAttr [IMU_MAX_INST];
-static uint16_t         thrdVal  [IMU_MAX_INST];
+static pthread_t        thrd;
+static sem_t            thrdSem;
+static uint8_t          isThrd   = 0;
 #endif
 
 // internally defined functions
-static void calb_1pnt_gyro (uint16_t id);
-static void calb_4pnt_magn (uint16_t id);
-static void calb_6pnt_full (uint16_t id);
-void* IMU_calb_update     (void    *id);
+static void calb_1pnt_gyro (IMU_calb_job*);
+static void calb_4pnt_magn (IMU_calb_job*);
+static void calb_6pnt_full (IMU_calb_job*);
+static void calb_solve     (IMU_calb_job*);
+static void rls_reset      (uint16_t id);
+static void rls_update     (uint16_t id, double *phi);
+static int  rls_solve      (uint16_t id, float *bias, float *mult, float *r);
+static void sym_eig3       (double A[3][3], double *w, double V[3][3]);
+#if IMU_USE_PTHREAD
+static int  start_worker   (void);
+static void* run_worker    (void*);
+#endif
 void  IMU_calb_defaultFnc (IMU_CALB_FNC_ARG);
 
 
@@ -57,8 +94,18 @@ int IMU_calb_init(
   if (numInst >= IMU_MAX_INST)
     return IMU_CALB_INST_OVERFLOW;
 
+  // start solver worker (shared by all instances)
+  #if IMU_USE_PTHREAD
+  if (start_worker())
+    return IMU_CALB_THRD_FAILURE;
+  #endif
+
   // initialize to known state
-  config[numInst].enable  = 1;
+  configOwn[numInst].enable  = 1;
+  configOwn[numInst].mLambda = 0.999f;
+  configOwn[numInst].mCount  = 200;
+  configOwn[numInst].mResid  = 0.03f;
+  configOwn[numInst].mDelta  = 0.01f;
 
   // assign internal calb function
   state[numInst].fnc      = IMU_calb_defaultFnc;
@@ -66,7 +113,8 @@ int IMU_calb_init(
   
   // pass handle and config pointer
   *id                     = numInst; 
-  *pntr                   = &config[*id];
+  config[*id]             = &configOwn[*id];
+  *pntr                   = config[*id];
   numInst++;
   
   // exit function (no errors)
@@ -87,7 +135,43 @@ int IMU_calb_getConfig(
     return IMU_CALB_BAD_INST; 
 
   // pass config and exit (no errors)
-  *pntr = &config[id];
+  *pntr = config[id];
+  return 0;
+}
+
+
+/******************************************************************************
+* point instance at external config structure (owned by caller)
+******************************************************************************/
+
+int IMU_calb_setConfig(
+  uint16_t                id,
+  IMU_calb_config          *pntr)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_CALB_BAD_INST;
+
+  // replace config pointer and exit (no errors)
+  config[id] = pntr;
+  return 0;
+}
+
+
+/******************************************************************************
+* function to return state structure
+******************************************************************************/
+
+int IMU_calb_getState( 
+  uint16_t                id,  
+  IMU_calb_state          **pntr)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_CALB_BAD_INST; 
+
+  // pass state and exit (no errors)
+  *pntr = &state[id];
   return 0;
 }
 
@@ -167,7 +251,7 @@ int IMU_calb_start(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_CALB_BAD_INST;
-  if (!config[id].enable)
+  if (!config[id]->enable)
     return IMU_CALB_FNC_DISABLED;
 
   // copy current entry to the table
@@ -176,6 +260,8 @@ int IMU_calb_start(
   state[id].calbArg       = pntr;
   memcpy(&state[id].rect, state[id].rectPntr, sizeof(IMU_rect_config));
   memcpy(&state[id].core, state[id].corePntr, sizeof(IMU_core_config));
+  if (mode == IMU_calb_rls_magn)
+    rls_reset(id);
   
   // exit function (no errors)
   return IMU_calb_mode_pnts[mode];
@@ -197,7 +283,7 @@ int IMU_calb_stat(
   
   // update core config
   IMU_core_config *core   = &state[id].core;
-  float sigma             = config[id].sigma;
+  float sigma             = config[id]->sigma;
   core->aMag              = stat->aMag;
   core->mMag              = stat->mMag;
   core->mDot              = stat->mDot;
@@ -220,7 +306,7 @@ int IMU_calb_save(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_CALB_BAD_INST;
-  if (!config[id].enable)
+  if (!config[id]->enable)
     return IMU_CALB_FNC_DISABLED;
 
   // create temporary swap storage
@@ -250,7 +336,7 @@ int IMU_calb_revert(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_CALB_BAD_INST;
-  if (!config[id].enable)
+  if (!config[id]->enable)
     return IMU_CALB_FNC_DISABLED;
 
   // copy current entry to the IMU rectify config 
@@ -273,53 +359,243 @@ int IMU_calb_point(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_CALB_BAD_INST; 
-  if (!config[id].enable)
+  if (!config[id]->enable)
     return IMU_CALB_FNC_DISABLED;
 
+  // ignore points outside of a calibration (or once it is complete)
+  uint16_t numPnts        = IMU_calb_mode_pnts[state[id].mode];
+  if (state[id].numPnts >= numPnts)
+    return 0;
+
   // copy current entry to the table
   IMU_pnts_entry *entry = &table[id][state[id].numPnts]; 
   memcpy(entry, pntr, sizeof(IMU_pnts_entry));
   state[id].numPnts++;
+  if (state[id].numPnts < numPnts)
+    return 0;
+
+  // check job queue overflow
+  IMU_calb_queue *q       = &queue[id];
+  unsigned head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  unsigned tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  if (head - tail >= IMU_CALB_QUEUE_SIZE)
+    return IMU_CALB_QUEUE_OVERFLOW;
+
+  // copy points and starting solution to job
+  IMU_calb_job *job       = &q->job[head & (IMU_CALB_QUEUE_SIZE-1)];
+  job->mode               = state[id].mode;
+  memcpy(job->table, table[id], numPnts * sizeof(IMU_pnts_entry));
+  memcpy(&job->rect, &state[id].rect, sizeof(IMU_rect_config));
+  memcpy(&job->core, &state[id].core, sizeof(IMU_core_config));
+  job->FOM                = state[id].FOM;
+  atomic_store_explicit(&q->head, head + 1, memory_order_release);
+
+  // hand job to worker (solution applied by IMU_calb_poll)
+  #if IMU_USE_PTHREAD
+  sem_post(&thrdSem);
+  return IMU_CALB_QUEUED;
+  #else
+  calb_solve(job);
+  atomic_store_explicit(&q->done, head + 1, memory_order_release);
+  return IMU_calb_poll(id);
+  #endif
+}
+
+
+/******************************************************************************
+* applies completed solutions (called between datum by the pipeline thread,
+* the swap-in and callback never overlap datum processing)
+******************************************************************************/
 
-  // determine whether enough points were collected
-  if (state[id].numPnts >= IMU_calb_mode_pnts[state[id].mode]) {
-    thrdVal[id] = id;
-    #if IMU_USE_PTHREAD
-    pthread_create(&thrd[id], &thrdAttr[id], IMU_calb_update, &thrdVal);
-    #else
-    IMU_calb_update(&id);
-    #endif    
-    return IMU_CALB_UPDATED;
+int IMU_calb_poll(
+  uint16_t                id)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_CALB_BAD_INST; 
+
+  // check for solved job (single atomic load given none)
+  IMU_calb_queue *q       = &queue[id];
+  unsigned done = atomic_load_explicit(&q->done, memory_order_acquire);
+  unsigned tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  if (done == tail)
+    return 0;
+
+  // swap in each solution and call calibration function
+  while (tail != done) {
+    IMU_calb_job *job     = &q->job[tail & (IMU_CALB_QUEUE_SIZE-1)];
+    memcpy(&state[id].rect, &job->rect, sizeof(IMU_rect_config));
+    memcpy(&state[id].core, &job->core, sizeof(IMU_core_config));
+    state[id].FOM         = job->FOM;
+    tail++;
+    atomic_store_explicit(&q->tail, tail, memory_order_relaxed);
+    state[id].fnc(id, &state[id].FOM, state[id].fncPntr);
   }
-    
-  // exit fuction (no errors)
-  return 0;
+
+  // exit function (solution updated)
+  return IMU_CALB_UPDATED;
+}
+
+
+/******************************************************************************
+* online magnetometer calibration - recursive least-squares ellipsoid fit of
+* each raw sample (fixed cost), publishes bias/transform once converged
+******************************************************************************/
+
+int IMU_calb_magn(
+  uint16_t                id,
+  IMU_TYPE                *m)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_CALB_BAD_INST;
+  if (state[id].mode != IMU_calb_rls_magn || !config[id]->enable)
+    return 0;
+
+  // normalize to first sample magnitude (conditions quadric terms)
+  IMU_calb_rls *cur       = &rls[id];
+  if (cur->scale == 0.0) {
+    cur->scale            = sqrt((double)m[0]*m[0] + (double)m[1]*m[1] +
+                                 (double)m[2]*m[2]);
+    if (cur->scale < 1.0) {
+      cur->scale          = 0.0;
+      return 0;
+    }
+  }
+  double x[3]             = {m[0] / cur->scale, m[1] / cur->scale,
+                             m[2] / cur->scale};
+
+  // update fit w/ quadric regressor (x'Mx + 2v'x = 1)
+  double phi[9]           = {x[0]*x[0], x[1]*x[1], x[2]*x[2],
+                             2.0*x[0]*x[1], 2.0*x[0]*x[2], 2.0*x[1]*x[2],
+                             2.0*x[0], 2.0*x[1], 2.0*x[2]};
+  rls_update(id, phi);
+  state[id].rlsCount++;
+  state[id].rlsResid      = (float)sqrt(cur->resid);
+
+  // periodic solve once enough samples and fit residual is small
+  if (state[id].rlsCount < config[id]->mCount ||
+      state[id].rlsCount % IMU_CALB_RLS_SOLVE != 0 ||
+      state[id].rlsResid > config[id]->mResid)
+    return 0;
+  float bias[3], mult[9], radius;
+  if (rls_solve(id, bias, mult, &radius) < 0)
+    return 0;
+
+  // republish only given a significant change
+  float delta             = 0.0f;
+  int i;
+  for (i=0; i<3; i++)
+    delta = fmaxf(delta, fabsf(bias[i] - cur->bias[i]) / radius);
+  for (i=0; i<9; i++)
+    delta = fmaxf(delta, fabsf(mult[i] - cur->mult[i]));
+  if (cur->isPub && delta < config[id]->mDelta)
+    return 0;
+  memcpy(cur->bias, bias, sizeof(bias));
+  memcpy(cur->mult, mult, sizeof(mult));
+  cur->isPub              = 1;
+
+  // update copy of live config and call calibration function
+  if (state[id].rectPntr != NULL)
+    memcpy(&state[id].rect, state[id].rectPntr, sizeof(IMU_rect_config));
+  if (state[id].corePntr != NULL)
+    memcpy(&state[id].core, state[id].corePntr, sizeof(IMU_core_config));
+  memcpy(state[id].rect.mBias, bias, sizeof(bias));
+  memcpy(state[id].rect.mMult, mult, sizeof(mult));
+  state[id].core.mMag     = radius;
+  state[id].FOM.calbFOM   = state[id].rlsResid;
+  state[id].fnc(id, &state[id].FOM, state[id].fncPntr);
+  return IMU_CALB_UPDATED;
 }
 
+
 /******************************************************************************
-* adds points for calibration
+* perform the specified calibration routine
 ******************************************************************************/
 
-void* IMU_calb_update(
-  void                    *pntr)
+void calb_solve(
+  IMU_calb_job            *job)
 {
-  // define internal variables
-  int *id                 = (int*)pntr;  
+  if      (job->mode == IMU_calb_1pnt_gyro)
+    calb_1pnt_gyro(job);
+  else if (job->mode == IMU_calb_4pnt_magn)
+    calb_4pnt_magn(job);
+  else if (job->mode == IMU_calb_6pnt_full)
+    calb_6pnt_full(job);
+}
+
 
-  // perform the specified calibration routine
-  if      (state[*id].mode == IMU_calb_1pnt_gyro)
-    calb_1pnt_gyro(*id);
-  else if (state[*id].mode == IMU_calb_4pnt_magn)
-    calb_4pnt_magn(*id);
-  else if (state[*id].mode == IMU_calb_6pnt_full)
-    calb_6pnt_full(*id);
+#if IMU_USE_PTHREAD
+/******************************************************************************
+* start persistent solver worker (detached, runs for the life of the process)
+******************************************************************************/
 
-  // call calibration function
-  state[*id].fnc(*id, &state[*id].FOM, state[*id].fncPntr);
+int start_worker(void)
+{
+  // define local variables
+  pthread_attr_t          attr;
+  int                     status;
+
+  // worker already running
+  if (isThrd)
+    return 0;
+
+  // create wake-up semaphore and detached worker
+  if (sem_init(&thrdSem, 0, 0))
+    return IMU_CALB_THRD_FAILURE;
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  status = pthread_create(&thrd, &attr, run_worker, NULL);
+  pthread_attr_destroy(&attr);
+  if (status) {
+    sem_destroy(&thrdSem);
+    return IMU_CALB_THRD_FAILURE;
+  }
 
   // exit function (no errors)
+  isThrd                  = 1;
+  return 0;
+}
+
+
+/******************************************************************************
+* solver worker (one semaphore count per queued job, solves in queue order)
+******************************************************************************/
+
+void* run_worker(
+  void                    *pntr)
+{
+  // define local variables
+  IMU_calb_queue          *q    = NULL;
+  unsigned                head  = 0, done = 0;
+  uint16_t                i, next = 0;
+  (void)pntr;
+
+  // main processing loop
+  while (1) {
+
+    // wait until a job is queued
+    while (sem_wait(&thrdSem) != 0);
+
+    // find instance with pending job (rotate start for fairness)
+    for (i=0; i<IMU_MAX_INST; i++) {
+      q    = &queue[(next + i) % IMU_MAX_INST];
+      done = atomic_load_explicit(&q->done, memory_order_relaxed);
+      head = atomic_load_explicit(&q->head, memory_order_acquire);
+      if (head != done)
+        break;
+    }
+    next                  = (next + 1) % IMU_MAX_INST;
+    if (head == done)
+      continue;
+
+    // solve job in place then publish to pipeline thread
+    calb_solve(&q->job[done & (IMU_CALB_QUEUE_SIZE-1)]);
+    atomic_store_explicit(&q->done, done + 1, memory_order_release);
+  }
   return NULL;
 }
+#endif
 
 
 /******************************************************************************
@@ -327,13 +603,13 @@ void* IMU_calb_update(
 ******************************************************************************/
 
 void calb_1pnt_gyro(
-  uint16_t                id)
+  IMU_calb_job            *job)
 {
   // process completed points table
-  IMU_rect_config *rect   = &state[id].rect;
-  rect->gBias[0]          = -table[id][0].gFltr[0];
-  rect->gBias[1]          = -table[id][0].gFltr[1];
-  rect->gBias[2]          = -table[id][0].gFltr[2];
+  IMU_rect_config *rect   = &job->rect;
+  rect->gBias[0]          = -job->table[0].gFltr[0];
+  rect->gBias[1]          = -job->table[0].gFltr[1];
+  rect->gBias[2]          = -job->table[0].gFltr[2];
 }
 
 
@@ -342,11 +618,11 @@ void calb_1pnt_gyro(
 ******************************************************************************/
 
 void calb_4pnt_magn(
-  uint16_t                id)
+  IMU_calb_job            *job)
 {
   // define internal variables
-  IMU_rect_config *rect   = &state[id].rect;
-  IMU_core_config *core   = &state[id].core;
+  IMU_rect_config *rect   = &job->rect;
+  IMU_core_config *core   = &job->core;
   float                   *g;
   float                   *m;
   float                   *a;
@@ -361,9 +637,9 @@ void calb_4pnt_magn(
   core->mMag              = 0.0f;
   core->mDot              = 0.0f;
   for (i=0; i<4; i++) {
-    g                     = table[id][i].gFltr;
-    a                     = table[id][i].aFltr;
-    m                     = table[id][i].mFltr;
+    g                     = job->table[i].gFltr;
+    a                     = job->table[i].aFltr;
+    m                     = job->table[i].mFltr;
     rect->gBias[0]       -= g[0];
     rect->gBias[1]       -= g[1];
     rect->gBias[2]       -= g[2];
@@ -389,11 +665,11 @@ void calb_4pnt_magn(
 ******************************************************************************/
 
 void calb_6pnt_full(
-  uint16_t                id)
+  IMU_calb_job            *job)
 { 
   // define internal variables
-  IMU_rect_config *rect   = &state[id].rect;
-  IMU_core_config *core   = &state[id].core;
+  IMU_rect_config *rect   = &job->rect;
+  IMU_core_config *core   = &job->core;
   float                   *g;
   float                   *a;
   int                     i;
@@ -407,8 +683,8 @@ void calb_6pnt_full(
   rect->aBias[2]          = 0.0f;
   core->aMag              = 0.0f;
   for (i=0; i<6; i++) {
-    g                     = table[id][i].gFltr;
-    a                     = table[id][i].aFltr;
+    g                     = job->table[i].gFltr;
+    a                     = job->table[i].aFltr;
     rect->gBias[0]       -= g[0];
     rect->gBias[1]       -= g[1];
     rect->gBias[2]       -= g[2];
@@ -447,3 +723,195 @@ void IMU_calb_defaultFnc(
   // verify FOM is above threshold and save
   IMU_calb_save(id);
 }
+
+
+/******************************************************************************
+* utility function - reset ellipsoid fit
+******************************************************************************/
+
+void rls_reset(
+  uint16_t                id)
+{
+  IMU_calb_rls *cur       = &rls[id];
+  int                     i;
+  memset(cur, 0, sizeof(IMU_calb_rls));
+  for (i=0; i<9; i++)
+    cur->P[i][i]          = IMU_CALB_RLS_DELTA;
+  cur->resid              = 1.0;
+  state[id].rlsCount      = 0;
+  state[id].rlsResid      = 1.0f;
+}
+
+
+/******************************************************************************
+* utility function - recursive least-squares update (target of one),
+* forgetting suspended while the covariance exceeds its initial value
+******************************************************************************/
+
+void rls_update(
+  uint16_t                id,
+  double                  *phi)
+{
+  // define local variables
+  IMU_calb_rls *cur       = &rls[id];
+  double                  Pphi[9], k[9];
+  double                  denom, err, trace = 0.0;
+  double                  lambda = config[id]->mLambda;
+  int                     i, j;
+
+  // gain vector
+  denom                   = lambda;
+  for (i=0; i<9; i++) {
+    Pphi[i]               = 0.0;
+    for (j=0; j<9; j++)
+      Pphi[i]            += cur->P[i][j] * phi[j];
+    denom                += phi[i] * Pphi[i];
+  }
+  for (i=0; i<9; i++)
+    k[i]                  = Pphi[i] / denom;
+
+  // a priori residual and parameter update
+  err                     = 1.0;
+  for (i=0; i<9; i++)
+    err                  -= phi[i] * cur->theta[i];
+  for (i=0; i<9; i++)
+    cur->theta[i]        += k[i] * err;
+  cur->resid              = 0.95 * cur->resid + 0.05 * err * err;
+
+  // covariance update (symmetric)
+  for (i=0; i<9; i++)
+    trace                += cur->P[i][i] - k[i] * Pphi[i];
+  if (trace > 9.0 * IMU_CALB_RLS_DELTA)
+    lambda                = 1.0;
+  for (i=0; i<9; i++)
+    for (j=i; j<9; j++) {
+      cur->P[i][j]        = (cur->P[i][j] - k[i] * Pphi[j]) / lambda;
+      cur->P[j][i]        = cur->P[i][j];
+    }
+}
+
+
+/******************************************************************************
+* utility function - ellipsoid center and shape from quadric, transform is
+* the symmetric square root scaled to the mean radius (field magnitude kept)
+******************************************************************************/
+
+int rls_solve(
+  uint16_t                id,
+  float                   *bias,
+  float                   *mult,
+  float                   *radius)
+{
+  // define local variables
+  IMU_calb_rls *cur       = &rls[id];
+  double                  *t = cur->theta;
+  double                  M[3][3] = {{t[0], t[3], t[4]},
+                                     {t[3], t[1], t[5]},
+                                     {t[4], t[5], t[2]}};
+  double                  Minv[3][3], V[3][3], w[3], c[3], k, s;
+  int                     i, j;
+
+  // center (M c = -v)
+  Minv[0][0]              = M[1][1]*M[2][2] - M[1][2]*M[2][1];
+  Minv[0][1]              = M[0][2]*M[2][1] - M[0][1]*M[2][2];
+  Minv[0][2]              = M[0][1]*M[1][2] - M[0][2]*M[1][1];
+  Minv[1][1]              = M[0][0]*M[2][2] - M[0][2]*M[2][0];
+  Minv[1][2]              = M[0][2]*M[1][0] - M[0][0]*M[1][2];
+  Minv[2][2]              = M[0][0]*M[1][1] - M[0][1]*M[1][0];
+  Minv[1][0]              = Minv[0][1];
+  Minv[2][0]              = Minv[0][2];
+  Minv[2][1]              = Minv[1][2];
+  double det              = M[0][0]*Minv[0][0] + M[0][1]*Minv[1][0] +
+                            M[0][2]*Minv[2][0];
+  if (fabs(det) < 1e-12)
+    return -1;
+  for (i=0; i<3; i++)
+    c[i]                  = -(Minv[i][0]*t[6] + Minv[i][1]*t[7] +
+                              Minv[i][2]*t[8]) / det;
+
+  // shape normalized to unit quadric ((x-c)' A (x-c) = 1)
+  k                       = 1.0;
+  for (i=0; i<3; i++)
+    for (j=0; j<3; j++)
+      k                  += c[i] * M[i][j] * c[j];
+  if (k <= 0.0)
+    return -1;
+  for (i=0; i<3; i++)
+    for (j=0; j<3; j++)
+      M[i][j]            /= k;
+
+  // eigenvalues must be positive (ellipsoid)
+  sym_eig3(M, w, V);
+  if (w[0] <= 0.0 || w[1] <= 0.0 || w[2] <= 0.0)
+    return -1;
+  s                       = 1.0 / cbrt(sqrt(w[0] * w[1] * w[2]));
+
+  // pass bias, transform (s * A^1/2), and radius in raw counts
+  for (i=0; i<3; i++) {
+    bias[i]               = (float)(-c[i] * cur->scale);
+    for (j=0; j<3; j++)
+      mult[3*i+j]         = (float)(s * (V[i][0]*sqrt(w[0])*V[j][0] +
+                                         V[i][1]*sqrt(w[1])*V[j][1] +
+                                         V[i][2]*sqrt(w[2])*V[j][2]));
+  }
+  *radius                 = (float)(s * cur->scale);
+  return 0;
+}
+
+
+/******************************************************************************
+* utility function - eigen decomposition of symmetric 3x3 (cyclic Jacobi),
+* eigenvectors are the columns of V
+******************************************************************************/
+
+void sym_eig3(
+  double                  A[3][3],
+  double                  *w,
+  double                  V[3][3])
+{
+  // define local variables
+  double                  a[3][3], c, s, t, theta, tmp;
+  int                     sweep, p, q, r;
+
+  // initialize working copy and eigenvectors
+  memcpy(a, A, sizeof(a));
+  for (p=0; p<3; p++)
+    for (q=0; q<3; q++)
+      V[p][q]             = (p == q) ? 1.0 : 0.0;
+
+  // rotate away off-diagonal terms
+  for (sweep=0; sweep<16; sweep++) {
+    if (fabs(a[0][1]) + fabs(a[0][2]) + fabs(a[1][2]) < 1e-15)
+      break;
+    for (p=0; p<2; p++)
+      for (q=p+1; q<3; q++) {
+        if (a[p][q] == 0.0)
+          continue;
+        theta             = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+        t                 = ((theta >= 0.0) ? 1.0 : -1.0) /
+                            (fabs(theta) + sqrt(theta * theta + 1.0));
+        c                 = 1.0 / sqrt(t * t + 1.0);
+        s                 = t * c;
+        for (r=0; r<3; r++) {
+          tmp             = a[r][p];
+          a[r][p]         = c * tmp - s * a[r][q];
+          a[r][q]         = s * tmp + c * a[r][q];
+        }
+        for (r=0; r<3; r++) {
+          tmp             = a[p][r];
+          a[p][r]         = c * tmp - s * a[q][r];
+          a[q][r]         = s * tmp + c * a[q][r];
+        }
+        for (r=0; r<3; r++) {
+          tmp             = V[r][p];
+          V[r][p]         = c * tmp - s * V[r][q];
+          V[r][q]         = s * tmp + c * V[r][q];
+        }
+      }
+  }
+
+  // pass eigenvalues
+  w[0]                    = a[0][0];
+  w[1]                    = a[1][1];
+  w[2]                    = a[2][2];
+}
@@ -39,12 +39,22 @@ extern "C" {
 #define IMU_CALB_UPDATED           2
 #define IMU_CALB_CALBFNC_SAVED     3
 #define IMU_CALB_CALBFNC_REJECTED  4
+#define IMU_CALB_QUEUED            5
 
 // define error codes
 #define IMU_CALB_INST_OVERFLOW     -1
 #define IMU_CALB_BAD_INST          -2
 #define IMU_CALB_BAD_MODE          -3
 #define IMU_CALB_BAD_PNTR          -4
+#define IMU_CALB_QUEUE_OVERFLOW    -5
+#define IMU_CALB_THRD_FAILURE      -6
+
+// define constants
+#ifndef IMU_CALB_QUEUE_SIZE
+#define IMU_CALB_QUEUE_SIZE        4      // solver jobs (power of two)
+#endif
+#define IMU_CALB_RLS_SOLVE         32     // samples between ellipsoid solves
+#define IMU_CALB_RLS_DELTA         1000.0 // initial RLS covariance
 
 // define callback function args
 #define IMU_CALB_FNC_ARG           uint16_t, IMU_calb_FOM*, void*
@@ -55,14 +65,19 @@ typedef enum {
   IMU_calb_1pnt_gyro    = 1,
   IMU_calb_2pnt_gyro    = 2,
   IMU_calb_4pnt_magn    = 3,
-  IMU_calb_6pnt_full    = 4
+  IMU_calb_6pnt_full    = 4,
+  IMU_calb_rls_magn     = 5               // online ellipsoid fit (no pnts)
 } IMU_calb_mode;
-static const uint16_t IMU_calb_mode_pnts[5] = {0, 1, 2, 4, 6};
+static const uint16_t IMU_calb_mode_pnts[6] = {0, 1, 2, 4, 6, 0};
 
 // configuration structure definition
 typedef struct  {
   uint8_t               enable;
   float                 sigma;
+  float                 mLambda;          // ellipsoid RLS forgetting factor
+  uint32_t              mCount;           // min samples before publishing
+  float                 mResid;           // max rms fit residual (unit)
+  float                 mDelta;           // min solution change to republish
 } IMU_calb_config;
 
 // subsystem state structure definition
@@ -75,6 +90,8 @@ typedef struct  {
   void                  *calbArg;
   IMU_calb_FOM          FOM;
   uint16_t              numPnts;
+  uint32_t              rlsCount;         // ellipsoid fit samples
+  float                 rlsResid;         // ellipsoid fit rms residual
   void                  *fncPntr;
   void                  (*fnc)(IMU_CALB_FNC_ARG);
 } IMU_calb_state;
@@ -83,6 +100,8 @@ typedef struct  {
 // control side functions 
 int IMU_calb_init      (uint16_t *id, IMU_calb_config**);
 int IMU_calb_getConfig  (uint16_t id, IMU_calb_config**);
+int IMU_calb_setConfig  (uint16_t id, IMU_calb_config*);
+int IMU_calb_getState   (uint16_t id, IMU_calb_state**);
 int IMU_calb_setStruct  (uint16_t id, IMU_rect_config*, IMU_core_config*);
 int IMU_calb_setFnc     (uint16_t id, void (*fnc)(IMU_CALB_FNC_ARG), void*);
 
@@ -95,6 +114,8 @@ int IMU_calb_revert     (uint16_t id);
 
 // sensor interface functions
 int IMU_calb_point      (uint16_t id, IMU_pnts_entry*);
+int IMU_calb_poll       (uint16_t id);
+int IMU_calb_magn       (uint16_t id, IMU_TYPE *m);
 
 
 #ifdef __cplusplus
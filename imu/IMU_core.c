@@ -28,10 +28,23 @@
 #include "IMU_math.h"
 #include "IMU_core.h"
 
+// compiled threshold reciprocals (refreshed by IMU_core_compile)
+typedef enum {
+  IMU_core_plan_aMag    = 0,
+  IMU_core_plan_mMag    = 1,
+  IMU_core_plan_mDot    = 2
+} IMU_core_plan_enum;
+typedef struct {
+  float                 inv    [3];     // reciprocal (zero disables)
+} IMU_core_plan;
+
 // internally managed structures
-static IMU_core_config  config [IMU_MAX_INST]; 
+static IMU_core_config *config [IMU_MAX_INST];
+static IMU_core_config  configOwn[IMU_MAX_INST];
 static IMU_core_state   state  [IMU_MAX_INST];
+static IMU_core_plan    plan   [IMU_MAX_INST];
 static IMU_core_FOM     staticFOM;
+static IMU_core_FOM     staticFOM3 [3];
 static uint16_t         numInst = 0;
 #if IMU_USE_PTHREAD
 pthread_mutex_t         lock   [IMU_MAX_INST];
@@ -40,10 +53,24 @@ pthread_mutex_t         lock   [IMU_MAX_INST];
 // internal functions definitions
 static inline float  norm3(IMU_TYPE *in, float *out);
 static inline float* scale(float *v, float m);  
+static inline void   integrate(uint16_t id, float *g, float dt);
+static inline float  schedAccl(uint16_t id, float *R, float *a);
+static inline float  schedMagn(uint16_t id, float *R, float *m);
+static inline int    zeroAccum(uint16_t id, uint32_t t, IMU_TYPE *a,
+                               IMU_TYPE *m);
+static inline int    zeroState(uint16_t id, uint32_t t, float *a, float *m);
+static inline float  gainSched(uint16_t id, uint32_t t);
+static inline float  elapsed  (uint16_t id, uint32_t t, IMU_time *tExt);
+static inline float  weight   (uint16_t id, IMU_core_plan_enum, float val,
+                               float ref);
 int IMU_core_newGyro (uint16_t id, uint32_t t, IMU_TYPE *g, IMU_core_FOM*);
 int IMU_core_newAccl (uint16_t id, uint32_t t, IMU_TYPE *a, IMU_core_FOM*);
 int IMU_core_newMagn (uint16_t id, uint32_t t, IMU_TYPE *m, IMU_core_FOM*);
-int IMU_core_zero    (uint16_t id, uint32_t t, IMU_TYPE *a, IMU_TYPE *m);
+int IMU_core_newData3(uint16_t id, IMU_data3 *data3, IMU_core_FOM*);
+int IMU_core_zero    (uint16_t id, uint32_t t, float *a, float *m);
+int IMU_core_mhnyGyro(uint16_t id, uint32_t t, IMU_TYPE *g, IMU_core_FOM*);
+int IMU_core_mhnyAccl(uint16_t id, uint32_t t, IMU_TYPE *a, IMU_core_FOM*);
+int IMU_core_mhnyMagn(uint16_t id, uint32_t t, IMU_TYPE *m, IMU_core_FOM*);
 
 
 /******************************************************************************
@@ -65,28 +92,42 @@ int IMU_core_init(
   #endif
 
   // intialize to known state
-  config[numInst].enable      = 1;
-  config[numInst].isGyro      = 1;
-  config[numInst].isAccl      = 1;
-  config[numInst].isMagn      = 1;
-  config[numInst].isFOM       = 0;
-  config[numInst].isTran      = 0;
-  config[numInst].isPredict   = 0;
-  config[numInst].gScale      = 0.001f;
-  config[numInst].aWeight     = 0.005f;
-  config[numInst].aMag        = 0.0f;
-  config[numInst].aMagThresh  = 0.0f;
-  config[numInst].mWeight     = 0.005f;
-  config[numInst].mMag        = 0.0f;
-  config[numInst].mMagThresh  = 0.0f;
-  config[numInst].mDot        = 0.0f;
-  config[numInst].mDotThresh  = 0.0f;
-  config[numInst].tranAlpha   = 0.01f;
+  configOwn[numInst].enable      = 1;
+  configOwn[numInst].isGyro      = 1;
+  configOwn[numInst].isAccl      = 1;
+  configOwn[numInst].isMagn      = 1;
+  configOwn[numInst].isFOM       = 0;
+  configOwn[numInst].isTran      = 0;
+  configOwn[numInst].isPredict   = 0;
+  configOwn[numInst].isFused     = 0;
+  configOwn[numInst].gIntegrate  = IMU_core_gyro_euler;
+  configOwn[numInst].gScale      = 0.001f;
+  configOwn[numInst].aWeight     = 0.005f;
+  configOwn[numInst].aMag        = 0.0f;
+  configOwn[numInst].aMagThresh  = 0.0f;
+  configOwn[numInst].aDecim      = 1;
+  configOwn[numInst].aErrThresh  = 0.0f;
+  configOwn[numInst].aSchedMax   = 16;
+  configOwn[numInst].mWeight     = 0.005f;
+  configOwn[numInst].mMag        = 0.0f;
+  configOwn[numInst].mMagThresh  = 0.0f;
+  configOwn[numInst].mDot        = 0.0f;
+  configOwn[numInst].mDotThresh  = 0.0f;
+  configOwn[numInst].mDecim      = 1;
+  configOwn[numInst].mErrThresh  = 0.0f;
+  configOwn[numInst].mSchedMax   = 16;
+  configOwn[numInst].iWeight     = 0.0f;
+  configOwn[numInst].zeroNum     = 1;
+  configOwn[numInst].startGain   = 1.0f;
+  configOwn[numInst].startTime   = 0.0f;
+  configOwn[numInst].tranAlpha   = 0.01f;
 
   // pass handle and config pointer
   *id      = numInst; 
-  *pntr    = &config[*id];
+  config[*id] = &configOwn[*id];
+  *pntr    = config[*id];
   numInst++;
+  IMU_core_compile(*id);
 
   // exit function (no errors)
   return 0;
@@ -106,7 +147,25 @@ int IMU_core_getConfig(
     return IMU_CORE_BAD_INST; 
 
   // pass config and exit (no errors)
-  *pntr = &config[id];
+  *pntr = config[id];
+  return 0;
+}
+
+
+/******************************************************************************
+* point instance at external config structure (owned by caller)
+******************************************************************************/
+
+int IMU_core_setConfig(
+  uint16_t              id,
+  IMU_core_config         *pntr)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_CORE_BAD_INST;
+
+  // replace config pointer and exit (no errors)
+  config[id] = pntr;
   return 0;
 }
 
@@ -129,6 +188,28 @@ int IMU_core_getState(
 }
 
 
+/******************************************************************************
+* compiles config into the per-datum plan (threshold reciprocals), called by
+* init, reset, and the engine whenever a threshold changes
+******************************************************************************/
+
+int IMU_core_compile(
+  uint16_t              id)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_CORE_BAD_INST; 
+
+  // reciprocal of each FOM threshold (zero disables the weight)
+  float thresh[3]       = {config[id]->aMagThresh, config[id]->mMagThresh,
+                           config[id]->mDotThresh};
+  int   k;
+  for (k=0; k<3; k++)
+    plan[id].inv[k]     = (thresh[k] < 0.01) ? 0.0f : 1.0f / thresh[k];
+  return 0;
+}
+
+
 /******************************************************************************
 * initialize state and autocal to known state
 ******************************************************************************/
@@ -140,6 +221,9 @@ int IMU_core_reset(
   if (id >= numInst)
     return IMU_CORE_BAD_INST; 
 
+  // compile config (thresholds written in place since the last compile)
+  IMU_core_compile(id);
+
   // lock before modifying state
   #if IMU_USE_PTHREAD
   IMU_thrd_mutex_lock(&lock[id]);
@@ -147,6 +231,7 @@ int IMU_core_reset(
 
   // initialize to known state
   state[id].status      = IMU_core_enum_unitialized;
+  state[id].t           = 0;
   state[id].q[0]        = 1.0;
   state[id].q[1]        = 0.0;
   state[id].q[2]        = 0.0;
@@ -154,9 +239,23 @@ int IMU_core_reset(
   state[id].aTran[0]    = 0.0;
   state[id].aTran[1]    = 0.0;
   state[id].aTran[2]    = 0.0;
-  state[id].gReset      = config[id].isGyro;
-  state[id].aReset      = config[id].isAccl;
-  state[id].mReset      = config[id].isMagn;
+  state[id].gPrev[0]    = 0.0;
+  state[id].gPrev[1]    = 0.0;
+  state[id].gPrev[2]    = 0.0;
+  state[id].aCount      = 0;
+  state[id].mCount      = 0;
+  state[id].aErr        = 0.0;
+  state[id].mErr        = 0.0;
+  memset(state[id].aSum, 0, sizeof(state[id].aSum));
+  memset(state[id].mSum, 0, sizeof(state[id].mSum));
+  state[id].aNum        = 0;
+  state[id].mNum        = 0;
+  state[id].tZero       = 0.0;
+  memset(state[id].gBias, 0, sizeof(state[id].gBias));
+  state[id].gReset      = config[id]->isGyro;
+  state[id].aReset      = config[id]->isAccl;
+  state[id].mReset      = config[id]->isMagn;
+  state[id].version++;
 
   // unlock function and exit (no errors)
   #if IMU_USE_PTHREAD
@@ -173,106 +272,16 @@ int IMU_core_reset(
 int IMU_core_zero(
   uint16_t              id,  
   uint32_t              t,
-  IMU_TYPE              *a_in, 
-  IMU_TYPE              *m_in)
+  float                 *a_in, 
+  float                 *m_in)
 {
-  // define local variables
-  int                   status = IMU_CORE_FNC_DISABLED;
-
-  // copy vectors to have the correct type
-  float                 a[3], m[3];
-  if (a_in != NULL) {   
-    a[0]                = (float)a_in[0]; 
-    a[1]                = (float)a_in[1];
-    a[2]                = (float)a_in[2];
-  }
-  if (m_in != NULL) {   
-    m[0]                = (float)m_in[0]; 
-    m[1]                = (float)m_in[1];
-    m[2]                = (float)m_in[2];
-  }
-
   // lock before modifying state
   #if IMU_USE_PTHREAD
   IMU_thrd_mutex_lock(&lock[id]);
   #endif
 
-  // update state time
-  state[id].t           = (float)t;
-
-  // zero with accerometer and magnetometer
-  if        ( config[id].isAccl && config[id].isMagn) {
-
-    // synced sensor data (datum3)
-    if        (a_in!=NULL && m_in!=NULL) {
-      IMU_math_upFrwdToQuat(a, m, state[id].q);
-      state[id].aReset  = 0;
-      state[id].mReset  = 0;
-      status            = IMU_core_enum_zeroed_both;
-
-    // asynchnous accelerometer vector
-    } else if (a_in!=NULL && m_in==NULL) {
-      if (state[id].mReset) {
-        IMU_math_upToQuat(a, state[id].q);
-        status          = IMU_core_enum_zeroed_accl;
-      } else {
-        IMU_math_upFrwdToQuat(a, state[id].mInit, state[id].q);
-        status          = IMU_core_enum_zeroed_both;
-      }
-      state[id].aReset  = 0;
-      
-    // asynchnous magnetometer vector
-    } else if (a_in==NULL && m_in!=NULL) {
-      if (state[id].aReset) {
-        a[0]            = 0.0f;
-        a[1]            = 0.0f;
-        a[2]            = 1.0f;
-        IMU_math_upFrwdToQuat(a, m, state[id].q);
-        memcpy(state[id].mInit, m, sizeof(m));
-        status          = IMU_core_enum_zeroed_save;
-      } else {
-        IMU_math_quatToUp(state[id].q, a);
-        IMU_math_upFrwdToQuat(a, m, state[id].q);
-        status          = IMU_core_enum_zeroed_magn;
-      }
-      state[id].mReset  = 0;
-    
-    // no sensor data provided
-    } else {
-      status            = IMU_CORE_FNC_DISABLED;
-    }
-
-  // no magnetometer configuation
-  } else if ( config[id].isAccl && !config[id].isMagn) {
-    if (a==NULL || !state[id].aReset) {
-      status            = IMU_CORE_FNC_DISABLED;
-    } else {
-      IMU_math_upToQuat(a, state[id].q);
-      state[id].aReset  = 0;
-      status            = IMU_core_enum_zeroed_accl;
-    }
-
-  // no accelerometer configuration
-  } else if (!config[id].isAccl &&  config[id].isMagn) {
-    if (m==NULL || !state[id].mReset) {
-      status            = IMU_CORE_FNC_DISABLED;
-    } else {
-      a[0]              = 0.0f;
-      a[1]              = 0.0f;
-      a[2]              = 1.0f;
-      IMU_math_upFrwdToQuat(a, m, state[id].q);
-      state[id].mReset  = 0;
-      status            = IMU_core_enum_zeroed_magn;
-    }
-
-  // gyroscope only configuration
-  } else {
-    state[id].q[0]      = 1.0f;
-    state[id].q[1]      = 0.0f;
-    state[id].q[2]      = 0.0f;
-    state[id].q[3]      = 0.0f;
-    status              = IMU_core_enum_zeroed_gyro;
-  }
+  // zero orientation to the sensor vectors
+  int status            = zeroState(id, t, a_in, m_in);
 
   // unlock function and exit (no errors)
   #if IMU_USE_PTHREAD
@@ -337,7 +346,14 @@ int IMU_core_data3(
     
     // zero the system to the current sensor
     state[id].status    = IMU_core_enum_zeroed_both;
-    return IMU_core_zero(id, data3->t, data3->a, data3->m);
+    return zeroAccum(id, data3->t, data3->a, data3->m);
+  }
+
+  // single-pass update (requires all three sensors)
+  if (config[id]->isFused && config[id]->isGyro &&
+      config[id]->isAccl  && config[id]->isMagn) {
+    IMU_core_newData3(id, data3, FOM);
+    return IMU_core_enum_normal_op;
   }
   
   // update system state w/ each sensor
@@ -378,13 +394,13 @@ int IMU_core_newGyro(
   // determine whether function executes
   if (id >= numInst)
     return IMU_CORE_BAD_INST; 
-  if (!config[id].enable || !config[id].isGyro)
+  if (!config[id]->enable || !config[id]->isGyro)
     return IMU_CORE_FNC_DISABLED;
   
   // copy values and calcuate mag 
-  float g[3]            = {(float)g_in[0]*config[id].gScale, 
-                           (float)g_in[1]*config[id].gScale, 
-                           (float)g_in[2]*config[id].gScale};
+  float g[3]            = {(float)g_in[0]*config[id]->gScale, 
+                           (float)g_in[1]*config[id]->gScale, 
+                           (float)g_in[2]*config[id]->gScale};
   FOM->magSqrd          = g[0]*g[0] + g[1]*g[1] + g[2]*g[2];
  
   // lock before modifying state
@@ -393,13 +409,66 @@ int IMU_core_newGyro(
   #endif
 
   // update system state with gyro
-  if (!state[id].gReset) {
-    float dt = ((float)t-state[id].t)*IMU_CORE_10USEC_TO_SEC;
-    IMU_math_estmGyro(state[id].q, g, dt);
-  } else {
+  IMU_time tExt;
+  float dt              = elapsed(id, t, &tExt);
+  if (!state[id].gReset)
+    integrate(id, g, dt);
+  else
     state[id].gReset    = 0;
+  memcpy(state[id].gPrev, g, sizeof(g));
+  state[id].t           = tExt;
+  state[id].version++;
+
+  // unlock mutex and exit (no errors)
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_unlock(&lock[id]);
+  #endif
+  return IMU_core_enum_normal_op;
+}
+
+
+/******************************************************************************
+* apply pre-integrated gyroscope increment (delta quaternion)
+******************************************************************************/
+
+int IMU_core_delta(
+  uint16_t              id,
+  uint32_t              t,
+  float                 *dq,
+  float                 *g,
+  IMU_core_FOM          *pntr)
+{
+  // initialize figure of merit
+  IMU_core_FOM_gyro     *FOM;
+  if (pntr != NULL) {
+    pntr->isValid       = 0;
+    FOM                 = &pntr->FOM.gyro;
+  } else {
+    FOM                 = &staticFOM.FOM.gyro;
   }
-  state[id].t           = (float)t;
+
+  // determine whether function executes
+  if (id >= numInst)
+    return IMU_CORE_BAD_INST;
+  if (!config[id]->enable || !config[id]->isGyro)
+    return IMU_CORE_FNC_DISABLED;
+  FOM->magSqrd          = g[0]*g[0] + g[1]*g[1] + g[2]*g[2];
+
+  // lock before modifying state
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&lock[id]);
+  #endif
+
+  // rotate by increment (increment carries its own time base)
+  float q[4];
+  IMU_math_quatMult(state[id].q, dq, q);
+  IMU_math_norm4(q);
+  memcpy(state[id].q, q, sizeof(q));
+  memcpy(state[id].gPrev, g, 3*sizeof(float));
+  state[id].gReset      = 0;
+  state[id].t           = IMU_time_extend(state[id].t, t);
+  state[id].status      = IMU_core_enum_normal_op;
+  state[id].version++;
 
   // unlock mutex and exit (no errors)
   #if IMU_USE_PTHREAD
@@ -409,6 +478,35 @@ int IMU_core_newGyro(
 }
 
 
+/******************************************************************************
+* advance time base w/o a state update (datum gated while stationary, the
+* next datum integrates only its own interval)
+******************************************************************************/
+
+int IMU_core_advance(
+  uint16_t              id,
+  uint32_t              t)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_CORE_BAD_INST; 
+
+  // lock before modifying state
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&lock[id]);
+  #endif
+
+  // extend datum time (estimates unchanged, version kept)
+  state[id].t           = IMU_time_extend(state[id].t, t);
+
+  // unlock mutex and exit (no errors)
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_unlock(&lock[id]);
+  #endif
+  return 0;
+}
+
+
 /******************************************************************************
 * apply accelerometer vector
 ******************************************************************************/
@@ -431,20 +529,19 @@ int IMU_core_newAccl(
   // determine whether function executes
   if (id >= numInst)
     return IMU_CORE_BAD_INST;
-  if (!config[id].enable || !config[id].isAccl)
+  if (!config[id]->enable || !config[id]->isAccl)
     return IMU_CORE_FNC_DISABLED;
   if (state[id].aReset) 
-    return IMU_core_zero(id, t, a_in, NULL);
+    return zeroAccum(id, t, a_in, NULL);
 
   // normalize input vector
   float a[3];
   FOM->mag              = norm3(a_in, a);
   
   // determine datum quality (based on amplitude)
-  if (config[id].isFOM) {
-    float ref           = config[id].aMag;
-    float thresh        = config[id].aMagThresh;
-    FOM->magFOM         = IMU_math_calcWeight(FOM->mag, ref, thresh);
+  if (config[id]->isFOM) {
+    float ref           = config[id]->aMag;
+    FOM->magFOM         = weight(id, IMU_core_plan_aMag, FOM->mag, ref);
     pntr->isValid       = 1;
     if (FOM->magFOM <= 0.001)
       return IMU_core_enum_no_weight;
@@ -452,46 +549,65 @@ int IMU_core_newAccl(
     FOM->magFOM         = 1.0f;
   }
 
-  // copy internal orientation state
+  // copy internal orientation state, advance schedule (counters locked)
+  // rotation matrix shared by schedule, transient, and update
+  float R[9], sched, gain;
   #if IMU_USE_PTHREAD
-  float q[4], aTran[3], t_copy;
+  float q[4], aTran[3];
+  IMU_time t_copy;
   IMU_thrd_mutex_lock(&lock[id]);
   memcpy(q, state[id].q, sizeof(state[id].q));
-  if (config[id].isTran)
+  if (config[id]->isTran)
     memcpy(aTran, state[id].aTran, sizeof(aTran));
   t_copy         = state[id].t;
+  sched          = schedAccl(id, IMU_math_quatToDCM(q, R), a);
+  gain           = gainSched(id, t);
   IMU_thrd_mutex_unlock(&lock[id]);
 
   // pass pointers given blocking I/F
   #else
   float *q       = state[id].q;
   float *aTran   = state[id].aTran;
-  state[id].t    = t;
+  sched          = schedAccl(id, IMU_math_quatToDCM(q, R), a);
+  gain           = gainSched(id, t);
+  #endif
+
+  // determine whether scheduled correction is due
+  if (sched <= 0.0f && !config[id]->isTran)
+    return IMU_core_enum_sched_skip;
+  #if !IMU_USE_PTHREAD
+  state[id].t    = IMU_time_extend(state[id].t, t);
   #endif
 
   // save accelerometer data
-  if (config[id].isTran) {
-    float   G[3];       
-    scale(IMU_math_quatToUp(state[id].q, G), config[id].aMag);
-    float alpha  = config[id].tranAlpha;
+  if (config[id]->isTran) {
+    float   G[4];       
+    scale(IMU_math_dcmToUp(R, G), config[id]->aMag);
+    float alpha  = config[id]->tranAlpha;
     aTran[0]     = alpha*aTran[0] + (1.0f-alpha)*((float)a_in[0]-G[0]);
     aTran[1]     = alpha*aTran[1] + (1.0f-alpha)*((float)a_in[1]-G[1]);
     aTran[2]     = alpha*aTran[2] + (1.0f-alpha)*((float)a_in[2]-G[2]);
   }
 
   // update system state (quaternion)
-  float weight   = FOM->magFOM * config[id].aWeight;
-  int   status   = IMU_math_estmAccl(q, a, weight, &FOM->delt);
+  float aGain    = FOM->magFOM * config[id]->aWeight * sched * gain;
+  int   status   = 0;
+  FOM->delt      = 0.0f;
+  if (sched > 0.0f)
+    status       = IMU_math_estmAcclDCM(q, R, a, aGain, &FOM->delt);
   
   // save results to system state
   #if IMU_USE_PTHREAD
   IMU_thrd_mutex_lock(&lock[id]);
   memcpy(state[id].q, q, sizeof(state[id].q));
-  if (config[id].isTran)
+  if (config[id]->isTran)
     memcpy(state[id].aTran, aTran, sizeof(aTran));
   if (t_copy > state[id].t)
     state[id].t         = t_copy;
+  state[id].version++;
   IMU_thrd_mutex_unlock(&lock[id]);
+  #else
+  state[id].version++;
   #endif
 
   // pass status and exit function
@@ -524,29 +640,44 @@ int IMU_core_newMagn(
   // determine whether function executes
   if (id >= numInst)
     return IMU_CORE_BAD_INST; 
-  if (!config[id].isMagn || !config[id].enable)
+  if (!config[id]->isMagn || !config[id]->enable)
     return IMU_CORE_FNC_DISABLED;
   if (state[id].mReset) 
-    return IMU_core_zero(id, t, NULL, m_in);
+    return zeroAccum(id, t, NULL, m_in);
 
   // normalize input vector
   float m[3];
   FOM->mag              = norm3(m_in, m);
 
+  // copy internal orientation state
+  #if IMU_USE_PTHREAD
+  float                 q[4];
+  IMU_thrd_mutex_lock(&lock[id]);
+  memcpy(q, state[id].q, sizeof(state[id].q));
+  IMU_time t_copy       = state[id].t;
+  IMU_thrd_mutex_unlock(&lock[id]);
+
+  // pass pointers given blocking I/F
+  #else
+  float *q              = state[id].q;
+  #endif
+
+  // rotation matrix shared by quality, schedule, and update
+  float R[9];
+  IMU_math_quatToDCM(q, R);
+
   // determine datum quality factor
-  if (config[id].isFOM) {
+  if (config[id]->isFOM) {
     // determine magnitude error
-    float ref           = config[id].mMag;
-    float thresh        = config[id].mMagThresh;
-    FOM->magFOM         = IMU_math_calcWeight(FOM->mag, ref, thresh);
+    float ref           = config[id]->mMag;
+    FOM->magFOM         = weight(id, IMU_core_plan_mMag, FOM->mag, ref);
     
     // determine angle error
-    ref                 = config[id].mDot;
-    thresh              = config[id].mDotThresh;
+    ref                 = config[id]->mDot;
     float a[3];
-    IMU_math_quatToUp(state[id].q, a);
+    IMU_math_dcmToUp(R, a);
     FOM->dot            = a[0]*m[0] + a[1]*m[1] + a[2]*m[2];
-    FOM->dotFOM         = IMU_math_calcWeight(FOM->dot, ref, thresh);
+    FOM->dotFOM         = weight(id, IMU_core_plan_mDot, FOM->dot, ref);
 
     // check zero weight conditiond
     pntr->isValid       = 1;
@@ -557,24 +688,26 @@ int IMU_core_newMagn(
     FOM->magFOM         = 1.0f;
     FOM->dotFOM         = 1.0f;
   }
-  
-  // copy internal orientation state
+
+  // determine whether scheduled correction is due (counters locked)
   #if IMU_USE_PTHREAD
-  float                 q[4];
   IMU_thrd_mutex_lock(&lock[id]);
-  memcpy(q, state[id].q, sizeof(state[id].q));
-  float t_copy          = state[id].t;
+  #endif
+  float sched           = schedMagn(id, R, m);
+  float gain            = gainSched(id, t);
+  #if IMU_USE_PTHREAD
   IMU_thrd_mutex_unlock(&lock[id]);
-
-  // pass pointers given blocking I/F
-  #else
-  float *q              = state[id].q;
-  state[id].t           = t;
+  #endif
+  if (sched <= 0.0f)
+    return IMU_core_enum_sched_skip;
+  #if !IMU_USE_PTHREAD
+  state[id].t           = IMU_time_extend(state[id].t, t);
   #endif
 
   // update system state (quaternion)
-  float weight = FOM->magFOM * FOM->dotFOM * config[id].mWeight;
-  int   status = IMU_math_estmMagnNorm(q, m, weight, &FOM->delt);
+  float mGain  = FOM->magFOM * FOM->dotFOM * config[id]->mWeight * sched;
+  mGain       *= gain;
+  int   status = IMU_math_estmMagnNormDCM(q, R, m, mGain, &FOM->delt);
     
   // save results to system state
   #if IMU_USE_PTHREAD
@@ -582,7 +715,10 @@ int IMU_core_newMagn(
   memcpy(state[id].q, q, sizeof(state[id].q));
   if (t_copy > state[id].t)
     state[id].t         = t_copy;
+  state[id].version++;
   IMU_thrd_mutex_unlock(&lock[id]);
+  #else
+  state[id].version++;
   #endif
 
   // pass status and exit function
@@ -594,63 +730,560 @@ int IMU_core_newMagn(
 
 
 /******************************************************************************
-* estimate orientation (returns quaternion)
+* apply gyroscope, accelerometer, and magnetometer (single pass)
 ******************************************************************************/
 
-int IMU_core_estmQuat(
+int IMU_core_newData3(
   uint16_t              id,
-  uint32_t              t,
-  float                 *estm)
+  IMU_data3             *data3,
+  IMU_core_FOM          *pntr)
 {
-  // check out-of-bounds condition
+  // initialize figure of merit
+  if (pntr == NULL)
+    pntr                = staticFOM3;
+  pntr[0].isValid       = 0;
+  pntr[1].isValid       = 0;
+  pntr[2].isValid       = 0;
+  IMU_core_FOM_gyro     *gFOM = &pntr[0].FOM.gyro;
+  IMU_core_FOM_accl     *aFOM = &pntr[1].FOM.accl;
+  IMU_core_FOM_magn     *mFOM = &pntr[2].FOM.magn;
+
+  // determine whether function executes
   if (id >= numInst)
-    return IMU_CORE_BAD_INST; 
-  if (!config[id].enable)
+    return IMU_CORE_BAD_INST;
+  if (!config[id]->enable)
     return IMU_CORE_FNC_DISABLED;
 
-  // lock before copying state
+  // copy values and normalize input vectors
+  float g[3]            = {(float)data3->g[0]*config[id]->gScale,
+                           (float)data3->g[1]*config[id]->gScale,
+                           (float)data3->g[2]*config[id]->gScale};
+  float a[3], m[3];
+  gFOM->magSqrd         = g[0]*g[0] + g[1]*g[1] + g[2]*g[2];
+  aFOM->mag             = norm3(data3->a, a);
+  mFOM->mag             = norm3(data3->m, m);
+
+  // lock before reading state (schedule counters modified)
   #if IMU_USE_PTHREAD
   IMU_thrd_mutex_lock(&lock[id]);
   #endif
 
-  // copy current orientation state and return
-  memcpy(estm, state[id].q, 4*sizeof(float));
+  // determine datum quality (zero weight removes sensor from update)
+  float aWeight         = config[id]->aWeight;
+  float mWeight         = config[id]->mWeight;
+  float R[9], u[3];
+  IMU_math_quatToDCM(state[id].q, R);
+  if (config[id]->isFOM) {
+    IMU_math_dcmToUp(R, u);
+    aFOM->magFOM        = weight(id, IMU_core_plan_aMag, aFOM->mag,
+                            config[id]->aMag);
+    mFOM->magFOM        = weight(id, IMU_core_plan_mMag, mFOM->mag,
+                            config[id]->mMag);
+    mFOM->dot           = u[0]*m[0] + u[1]*m[1] + u[2]*m[2];
+    mFOM->dotFOM        = weight(id, IMU_core_plan_mDot, mFOM->dot,
+                            config[id]->mDot);
+    pntr[1].isValid     = 1;
+    pntr[2].isValid     = 1;
+    if (aFOM->magFOM <= 0.001)
+      aWeight           = 0.0f;
+    if (mFOM->magFOM <= 0.0001 || mFOM->dotFOM <= 0.0001)
+      mWeight           = 0.0f;
+    aWeight            *= aFOM->magFOM;
+    mWeight            *= mFOM->magFOM * mFOM->dotFOM;
+  } else {
+    aFOM->magFOM        = 1.0f;
+    mFOM->magFOM        = 1.0f;
+    mFOM->dotFOM        = 1.0f;
+  }
+  if (aWeight > 0.0f)
+    aWeight            *= schedAccl(id, R, a);
+  if (mWeight > 0.0f)
+    mWeight            *= schedMagn(id, R, m);
+  aWeight              *= gainSched(id, data3->t);
+  mWeight              *= gainSched(id, data3->t);
 
-  // unlock mutex and exit
+  // save accelerometer data
+  if (config[id]->isTran) {
+    float   G[4];
+    scale(IMU_math_dcmToUp(R, G), config[id]->aMag);
+    float alpha         = config[id]->tranAlpha;
+    float *aTran        = state[id].aTran;
+    aTran[0]  = alpha*aTran[0] + (1.0f-alpha)*((float)data3->a[0]-G[0]);
+    aTran[1]  = alpha*aTran[1] + (1.0f-alpha)*((float)data3->a[1]-G[1]);
+    aTran[2]  = alpha*aTran[2] + (1.0f-alpha)*((float)data3->a[2]-G[2]);
+  }
+
+  // update system state (quaternion)
+  IMU_time tExt;
+  float dt              = elapsed(id, data3->t, &tExt);
+  if (state[id].gReset) {
+    dt                  = 0.0f;
+    state[id].gReset    = 0;
+  }
+  if (config[id]->gIntegrate != IMU_core_gyro_euler) {
+    integrate(id, g, dt);
+    dt                  = 0.0f;
+  }
+  memcpy(state[id].gPrev, g, sizeof(g));
+  if (aWeight > 0.0f || mWeight > 0.0f) {
+    float delt[2];
+    IMU_math_estmFused(state[id].q, g, dt, a, m, aWeight, mWeight, delt);
+    aFOM->delt          = delt[0];
+    mFOM->delt          = delt[1];
+  } else {
+    IMU_math_estmGyro(state[id].q, g, dt);
+    aFOM->delt          = 0.0f;
+    mFOM->delt          = 0.0f;
+  }
+  state[id].t           = tExt;
+  state[id].version++;
+
+  // unlock mutex and exit (no errors)
   #if IMU_USE_PTHREAD
   IMU_thrd_mutex_unlock(&lock[id]);
   #endif
-  return 0;
+  return IMU_core_enum_normal_op;
 }
 
 
 /******************************************************************************
-* estimate acceleration (minus gravity)
+* mahony filter - process one datum (shares zeroing, FOM, and scheduling
+* with the gradient descent filter)
 ******************************************************************************/
 
-int IMU_core_estmAccl(
+int IMU_core_mhnyDatum(
   uint16_t              id,
-  uint32_t              t,
-  float                 *estm)
+  IMU_datum             *datum,
+  IMU_core_FOM          *FOM)
 {
   // check out-of-bounds condition
   if (id >= numInst)
-    return IMU_CORE_BAD_INST; 
-  if (!config[id].enable)
-    return IMU_CORE_FNC_DISABLED;
+    return IMU_CORE_BAD_INST;
 
-  // copy translation accleration and quaternion
-  #if IMU_USE_PTHREAD
-  IMU_thrd_mutex_lock(&lock[id]);
-  float aTran[3];  memcpy(aTran, state[id].aTran, sizeof(aTran));
-  float q[4];      memcpy(q,     state[id].q,     sizeof(q));
-  IMU_thrd_mutex_unlock(&lock[id]);
+  // define local variables
+  int                   status = IMU_CORE_FNC_DISABLED;
 
-  // pass pointers given blocking I/F
-  #else
-  float *aTran   = state[id].aTran;
-  float *q       = state[id].q
-  #endif
+  // check sensor type and execute
+  if      (datum->type == IMU_gyro)
+    status = IMU_core_mhnyGyro(id, datum->t, datum->val, FOM);
+  else if (datum->type == IMU_accl)
+    status = IMU_core_mhnyAccl(id, datum->t, datum->val, FOM);
+  else if (datum->type == IMU_magn)
+    status = IMU_core_mhnyMagn(id, datum->t, datum->val, FOM);
+
+  // exit fucntion
+  state[id].status      = status;
+  return status;
+}
+
+
+/******************************************************************************
+* mahony filter - apply gyroscope rates (minus bias estimate)
+******************************************************************************/
+
+int IMU_core_mhnyGyro(
+  uint16_t              id,
+  uint32_t              t,
+  IMU_TYPE              *g_in,
+  IMU_core_FOM          *pntr)
+{
+  // initialize figure of merit
+  IMU_core_FOM_gyro     *FOM;
+  if (pntr != NULL) {
+    pntr->isValid       = 0;
+    FOM                 = &pntr->FOM.gyro;
+  } else {
+    FOM                 = &staticFOM.FOM.gyro;
+  }
+
+  // determine whether function executes
+  if (id >= numInst)
+    return IMU_CORE_BAD_INST;
+  if (!config[id]->enable || !config[id]->isGyro)
+    return IMU_CORE_FNC_DISABLED;
+
+  // copy values and calcuate mag
+  float g[3]            = {(float)g_in[0]*config[id]->gScale,
+                           (float)g_in[1]*config[id]->gScale,
+                           (float)g_in[2]*config[id]->gScale};
+  FOM->magSqrd          = g[0]*g[0] + g[1]*g[1] + g[2]*g[2];
+
+  // lock before modifying state
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&lock[id]);
+  #endif
+
+  // update system state with bias corrected gyro
+  g[0]                 += state[id].gBias[0];
+  g[1]                 += state[id].gBias[1];
+  g[2]                 += state[id].gBias[2];
+  IMU_time tExt;
+  float dt              = elapsed(id, t, &tExt);
+  if (!state[id].gReset)
+    integrate(id, g, dt);
+  else
+    state[id].gReset    = 0;
+  memcpy(state[id].gPrev, g, sizeof(g));
+  state[id].t           = tExt;
+  state[id].version++;
+
+  // unlock mutex and exit (no errors)
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_unlock(&lock[id]);
+  #endif
+  return IMU_core_enum_normal_op;
+}
+
+
+/******************************************************************************
+* mahony filter - apply accelerometer vector
+******************************************************************************/
+
+int IMU_core_mhnyAccl(
+  uint16_t              id,
+  uint32_t              t,
+  IMU_TYPE              *a_in,
+  IMU_core_FOM          *pntr)
+{
+  // initialize figure of merit
+  IMU_core_FOM_accl     *FOM;
+  if (pntr != NULL) {
+    pntr->isValid       = 0;
+    FOM                 = &pntr->FOM.accl;
+  } else {
+    FOM                 = &staticFOM.FOM.accl;
+  }
+
+  // determine whether function executes
+  if (id >= numInst)
+    return IMU_CORE_BAD_INST;
+  if (!config[id]->enable || !config[id]->isAccl)
+    return IMU_CORE_FNC_DISABLED;
+  if (state[id].aReset)
+    return zeroAccum(id, t, a_in, NULL);
+
+  // normalize input vector
+  float a[3];
+  FOM->mag              = norm3(a_in, a);
+
+  // determine datum quality (based on amplitude)
+  if (config[id]->isFOM) {
+    float ref           = config[id]->aMag;
+    FOM->magFOM         = weight(id, IMU_core_plan_aMag, FOM->mag, ref);
+    pntr->isValid       = 1;
+    if (FOM->magFOM <= 0.001)
+      return IMU_core_enum_no_weight;
+  } else {
+    FOM->magFOM         = 1.0f;
+  }
+
+  // lock before modifying state
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&lock[id]);
+  #endif
+
+  // rotation matrix shared by transient, schedule, and update
+  float R[9];
+  IMU_math_quatToDCM(state[id].q, R);
+
+  // save accelerometer data
+  if (config[id]->isTran) {
+    float   G[4];
+    scale(IMU_math_dcmToUp(R, G), config[id]->aMag);
+    float alpha         = config[id]->tranAlpha;
+    float *aTran        = state[id].aTran;
+    aTran[0]  = alpha*aTran[0] + (1.0f-alpha)*((float)a_in[0]-G[0]);
+    aTran[1]  = alpha*aTran[1] + (1.0f-alpha)*((float)a_in[1]-G[1]);
+    aTran[2]  = alpha*aTran[2] + (1.0f-alpha)*((float)a_in[2]-G[2]);
+  }
+
+  // proportional correction and gyro bias integral
+  float sched           = schedAccl(id, R, a);
+  float e[3];
+  int   status          = IMU_core_enum_sched_skip;
+  FOM->delt             = 0.0f;
+  if (sched > 0.0f) {
+    float kp            = FOM->magFOM * config[id]->aWeight * sched;
+    kp                 *= gainSched(id, t);
+    IMU_math_mhnyAcclDCM(state[id].q, R, a, kp, e, &FOM->delt);
+    state[id].gBias[0] += config[id]->iWeight * e[0];
+    state[id].gBias[1] += config[id]->iWeight * e[1];
+    state[id].gBias[2] += config[id]->iWeight * e[2];
+    status              = IMU_core_enum_normal_op;
+  }
+  state[id].version++;
+
+  // unlock mutex and exit
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_unlock(&lock[id]);
+  #endif
+  return status;
+}
+
+
+/******************************************************************************
+* mahony filter - apply magnetometer vector
+******************************************************************************/
+
+int IMU_core_mhnyMagn(
+  uint16_t              id,
+  uint32_t              t,
+  IMU_TYPE              *m_in,
+  IMU_core_FOM          *pntr)
+{
+  // initialize figure of merit
+  IMU_core_FOM_magn     *FOM;
+  if (pntr != NULL) {
+    pntr->isValid       = 0;
+    FOM                 = &pntr->FOM.magn;
+  } else {
+    FOM                 = &staticFOM.FOM.magn;
+  }
+
+  // determine whether function executes
+  if (id >= numInst)
+    return IMU_CORE_BAD_INST;
+  if (!config[id]->isMagn || !config[id]->enable)
+    return IMU_CORE_FNC_DISABLED;
+  if (state[id].mReset)
+    return zeroAccum(id, t, NULL, m_in);
+
+  // normalize input vector
+  float m[3];
+  FOM->mag              = norm3(m_in, m);
+
+  // rotation matrix shared by quality, schedule, and update
+  float R[9];
+  IMU_math_quatToDCM(state[id].q, R);
+
+  // determine datum quality factor
+  if (config[id]->isFOM) {
+    float a[3];
+    IMU_math_dcmToUp(R, a);
+    FOM->magFOM         = weight(id, IMU_core_plan_mMag, FOM->mag,
+                            config[id]->mMag);
+    FOM->dot            = a[0]*m[0] + a[1]*m[1] + a[2]*m[2];
+    FOM->dotFOM         = weight(id, IMU_core_plan_mDot, FOM->dot,
+                            config[id]->mDot);
+    pntr->isValid       = 1;
+    if (FOM->magFOM <= 0.0001 || FOM->dotFOM <= 0.0001)
+      return IMU_core_enum_no_weight;
+  } else {
+    FOM->magFOM         = 1.0f;
+    FOM->dotFOM         = 1.0f;
+  }
+
+  // lock before modifying state
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&lock[id]);
+  #endif
+
+  // proportional correction and gyro bias integral
+  float sched           = schedMagn(id, R, m);
+  float e[3];
+  int   status          = IMU_core_enum_sched_skip;
+  FOM->delt             = 0.0f;
+  if (sched > 0.0f) {
+    float kp  = FOM->magFOM * FOM->dotFOM * config[id]->mWeight * sched;
+    kp                 *= gainSched(id, t);
+    IMU_math_mhnyMagnDCM(state[id].q, R, m, kp, e, &FOM->delt);
+    state[id].gBias[0] += config[id]->iWeight * e[0];
+    state[id].gBias[1] += config[id]->iWeight * e[1];
+    state[id].gBias[2] += config[id]->iWeight * e[2];
+    status              = IMU_core_enum_normal_op;
+  }
+  state[id].version++;
+
+  // unlock mutex and exit
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_unlock(&lock[id]);
+  #endif
+  return status;
+}
+
+
+/******************************************************************************
+* mahony filter - apply gyroscope, accelerometer, and magnetometer
+******************************************************************************/
+
+int IMU_core_mhnyData3(
+  uint16_t              id,
+  IMU_data3             *data3,
+  IMU_core_FOM          *pntr)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_CORE_BAD_INST;
+
+  // initialize figure of merit
+  if (pntr == NULL)
+    pntr                = staticFOM3;
+  pntr[0].isValid       = 0;
+  pntr[1].isValid       = 0;
+  pntr[2].isValid       = 0;
+  IMU_core_FOM_gyro     *gFOM = &pntr[0].FOM.gyro;
+  IMU_core_FOM_accl     *aFOM = &pntr[1].FOM.accl;
+  IMU_core_FOM_magn     *mFOM = &pntr[2].FOM.magn;
+
+  // check reset conditions
+  if (state[id].mReset || state[id].aReset) {
+    state[id].status    = IMU_core_enum_zeroed_both;
+    return zeroAccum(id, data3->t, data3->a, data3->m);
+  }
+  if (!config[id]->enable)
+    return IMU_CORE_FNC_DISABLED;
+
+  // copy values and normalize input vectors
+  float g[3]            = {(float)data3->g[0]*config[id]->gScale,
+                           (float)data3->g[1]*config[id]->gScale,
+                           (float)data3->g[2]*config[id]->gScale};
+  float a[3], m[3];
+  gFOM->magSqrd         = g[0]*g[0] + g[1]*g[1] + g[2]*g[2];
+  aFOM->mag             = norm3(data3->a, a);
+  mFOM->mag             = norm3(data3->m, m);
+
+  // determine datum quality (zero weight removes sensor from update)
+  float aWeight         = config[id]->isAccl ? config[id]->aWeight : 0.0f;
+  float mWeight         = config[id]->isMagn ? config[id]->mWeight : 0.0f;
+  float R[9], u[3];
+  IMU_math_quatToDCM(state[id].q, R);
+  if (config[id]->isFOM) {
+    IMU_math_dcmToUp(R, u);
+    aFOM->magFOM        = weight(id, IMU_core_plan_aMag, aFOM->mag,
+                            config[id]->aMag);
+    mFOM->magFOM        = weight(id, IMU_core_plan_mMag, mFOM->mag,
+                            config[id]->mMag);
+    mFOM->dot           = u[0]*m[0] + u[1]*m[1] + u[2]*m[2];
+    mFOM->dotFOM        = weight(id, IMU_core_plan_mDot, mFOM->dot,
+                            config[id]->mDot);
+    pntr[1].isValid     = 1;
+    pntr[2].isValid     = 1;
+    if (aFOM->magFOM <= 0.001)
+      aWeight           = 0.0f;
+    if (mFOM->magFOM <= 0.0001 || mFOM->dotFOM <= 0.0001)
+      mWeight           = 0.0f;
+    aWeight            *= aFOM->magFOM;
+    mWeight            *= mFOM->magFOM * mFOM->dotFOM;
+  } else {
+    aFOM->magFOM        = 1.0f;
+    mFOM->magFOM        = 1.0f;
+    mFOM->dotFOM        = 1.0f;
+  }
+
+  // lock before modifying state
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&lock[id]);
+  #endif
+
+  // correction weights (scheduled and startup gain)
+  if (aWeight > 0.0f)
+    aWeight            *= schedAccl(id, R, a);
+  if (mWeight > 0.0f)
+    mWeight            *= schedMagn(id, R, m);
+  aWeight              *= gainSched(id, data3->t);
+  mWeight              *= gainSched(id, data3->t);
+
+  // save accelerometer data
+  if (config[id]->isTran) {
+    float   G[4];
+    scale(IMU_math_dcmToUp(R, G), config[id]->aMag);
+    float alpha         = config[id]->tranAlpha;
+    float *aTran        = state[id].aTran;
+    aTran[0]  = alpha*aTran[0] + (1.0f-alpha)*((float)data3->a[0]-G[0]);
+    aTran[1]  = alpha*aTran[1] + (1.0f-alpha)*((float)data3->a[1]-G[1]);
+    aTran[2]  = alpha*aTran[2] + (1.0f-alpha)*((float)data3->a[2]-G[2]);
+  }
+
+  // update system state (single rotation w/ bias corrected gyro)
+  IMU_time tExt;
+  float dt              = elapsed(id, data3->t, &tExt);
+  if (!config[id]->isGyro)
+    g[0] = g[1] = g[2]  = 0.0f;
+  if (state[id].gReset) {
+    dt                  = 0.0f;
+    state[id].gReset    = 0;
+  }
+  g[0]                 += state[id].gBias[0];
+  g[1]                 += state[id].gBias[1];
+  g[2]                 += state[id].gBias[2];
+  float e[3], delt[2];
+  IMU_math_mhnyFusedDCM(state[id].q, R, g, dt, a, m, aWeight, mWeight, e,
+                        delt);
+  state[id].gBias[0]   += config[id]->iWeight * e[0];
+  state[id].gBias[1]   += config[id]->iWeight * e[1];
+  state[id].gBias[2]   += config[id]->iWeight * e[2];
+  memcpy(state[id].gPrev, g, sizeof(g));
+  aFOM->delt            = delt[0];
+  mFOM->delt            = delt[1];
+  state[id].t           = tExt;
+  state[id].version++;
+
+  // unlock mutex and exit (no errors)
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_unlock(&lock[id]);
+  #endif
+  return IMU_core_enum_normal_op;
+}
+
+
+/******************************************************************************
+* estimate orientation (returns quaternion)
+******************************************************************************/
+
+int IMU_core_estmQuat(
+  uint16_t              id,
+  uint32_t              t,
+  float                 *estm)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_CORE_BAD_INST; 
+  if (!config[id]->enable)
+    return IMU_CORE_FNC_DISABLED;
+
+  // lock before copying state
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&lock[id]);
+  #endif
+
+  // copy current orientation state and return
+  memcpy(estm, state[id].q, 4*sizeof(float));
+
+  // unlock mutex and exit
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_unlock(&lock[id]);
+  #endif
+  return 0;
+}
+
+
+/******************************************************************************
+* estimate acceleration (minus gravity)
+******************************************************************************/
+
+int IMU_core_estmAccl(
+  uint16_t              id,
+  uint32_t              t,
+  float                 *estm)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_CORE_BAD_INST; 
+  if (!config[id]->enable)
+    return IMU_CORE_FNC_DISABLED;
+
+  // copy translation accleration and quaternion
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&lock[id]);
+  float aTran[3];  memcpy(aTran, state[id].aTran, sizeof(aTran));
+  float q[4];      memcpy(q,     state[id].q,     sizeof(q));
+  IMU_thrd_mutex_unlock(&lock[id]);
+
+  // pass pointers given blocking I/F
+  #else
+  float *aTran   = state[id].aTran;
+  float *q       = state[id].q;
+  #endif
 
   // apply rotation to acceleration vector
   IMU_math_rotateForward(aTran, q, estm);
@@ -660,6 +1293,32 @@ int IMU_core_estmAccl(
 }
 
 
+/******************************************************************************
+* state version (estimates derived from the same version are unchanged)
+******************************************************************************/
+
+int IMU_core_estmVersion(
+  uint16_t              id,
+  unsigned int          *version)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_CORE_BAD_INST; 
+  if (!config[id]->enable)
+    return IMU_CORE_FNC_DISABLED;
+
+  // copy version under the state lock (pairs w/ the state it tags)
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&lock[id]);
+  #endif
+  *version              = state[id].version;
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_unlock(&lock[id]);
+  #endif
+  return 0;
+}
+
+
 /******************************************************************************
 * utility function - normalize 3x1 array
 ******************************************************************************/
@@ -668,13 +1327,342 @@ inline float norm3(
   IMU_TYPE       *in, 
   float          *out)
 {
-  float norm     = sqrtf((float)in[0]*(float)in[0] + 
-                         (float)in[1]*(float)in[1] + 
-                         (float)in[2]*(float)in[2]); 
-  out[0]         = (float)in[0] / norm;
-  out[1]         = (float)in[1] / norm;
-  out[2]         = (float)in[2] / norm;
-  return norm;
+  out[0]         = (float)in[0];
+  out[1]         = (float)in[1];
+  out[2]         = (float)in[2];
+  return IMU_math_norm3(out);
+}
+
+
+/******************************************************************************
+* utility function - apply gyroscope rates w/ configured integrator
+******************************************************************************/
+
+inline void integrate(
+  uint16_t       id,
+  float          *g,
+  float          dt)
+{
+  if      (config[id]->gIntegrate == IMU_core_gyro_exp)
+    IMU_math_estmGyroExp(state[id].q, g, dt);
+  else if (config[id]->gIntegrate == IMU_core_gyro_rk4)
+    IMU_math_estmGyroRK4(state[id].q, state[id].gPrev, g, dt);
+  else
+    IMU_math_estmGyro(state[id].q, g, dt);
+}
+
+
+/******************************************************************************
+* utility function - accumulates sensor vectors until zeroNum datum are
+* available, then zeros the system to their average
+******************************************************************************/
+
+inline int zeroAccum(
+  uint16_t       id,
+  uint32_t       t,
+  IMU_TYPE       *a_in,
+  IMU_TYPE       *m_in)
+{
+  // lock before modifying state (accumulators and orientation)
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&lock[id]);
+  #endif
+
+  // accumulate vectors
+  uint16_t num   = (config[id]->zeroNum > 1) ? config[id]->zeroNum : 1;
+  if (a_in != NULL) {
+    state[id].aSum[0] += (float)a_in[0];
+    state[id].aSum[1] += (float)a_in[1];
+    state[id].aSum[2] += (float)a_in[2];
+    state[id].aNum++;
+  }
+  if (m_in != NULL) {
+    state[id].mSum[0] += (float)m_in[0];
+    state[id].mSum[1] += (float)m_in[1];
+    state[id].mSum[2] += (float)m_in[2];
+    state[id].mNum++;
+  }
+  if ((a_in != NULL && state[id].aNum < num) ||
+      (m_in != NULL && state[id].mNum < num)) {
+    #if IMU_USE_PTHREAD
+    IMU_thrd_mutex_unlock(&lock[id]);
+    #endif
+    return IMU_core_enum_zero_accum;
+  }
+
+  // average vectors and clear accumulators
+  float a[3], m[3];
+  float *aPntr   = NULL;
+  float *mPntr   = NULL;
+  if (a_in != NULL) {
+    a[0]         = state[id].aSum[0] / (float)state[id].aNum;
+    a[1]         = state[id].aSum[1] / (float)state[id].aNum;
+    a[2]         = state[id].aSum[2] / (float)state[id].aNum;
+    aPntr        = a;
+    memset(state[id].aSum, 0, sizeof(state[id].aSum));
+    state[id].aNum = 0;
+  }
+  if (m_in != NULL) {
+    m[0]         = state[id].mSum[0] / (float)state[id].mNum;
+    m[1]         = state[id].mSum[1] / (float)state[id].mNum;
+    m[2]         = state[id].mSum[2] / (float)state[id].mNum;
+    mPntr        = m;
+    memset(state[id].mSum, 0, sizeof(state[id].mSum));
+    state[id].mNum = 0;
+  }
+
+  // zero system and restart gain schedule
+  state[id].tZero  = IMU_time_extend(state[id].t, t);
+  int status       = zeroState(id, t, aPntr, mPntr);
+
+  // unlock mutex and exit
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_unlock(&lock[id]);
+  #endif
+  return status;
+}
+
+
+/******************************************************************************
+* utility function - zeros orientation to the given sensor vectors (caller
+* holds the core lock)
+******************************************************************************/
+
+inline int zeroState(
+  uint16_t       id,
+  uint32_t       t,
+  float          *a_in,
+  float          *m_in)
+{
+  // define local variables
+  int            status = IMU_CORE_FNC_DISABLED;
+
+  // copy vectors (magnetometer only zeroing modifies up vector)
+  float                 a[3], m[3];
+  if (a_in != NULL)
+    memcpy(a, a_in, sizeof(a));
+  if (m_in != NULL)
+    memcpy(m, m_in, sizeof(m));
+
+  // update state time
+  state[id].t           = IMU_time_extend(state[id].t, t);
+
+  // zero with accerometer and magnetometer
+  if        ( config[id]->isAccl && config[id]->isMagn) {
+
+    // synced sensor data (datum3)
+    if        (a_in!=NULL && m_in!=NULL) {
+      IMU_math_upFrwdToQuat(a, m, state[id].q);
+      state[id].aReset  = 0;
+      state[id].mReset  = 0;
+      status            = IMU_core_enum_zeroed_both;
+
+    // asynchnous accelerometer vector
+    } else if (a_in!=NULL && m_in==NULL) {
+      if (state[id].mReset) {
+        IMU_math_upToQuat(a, state[id].q);
+        status          = IMU_core_enum_zeroed_accl;
+      } else {
+        IMU_math_upFrwdToQuat(a, state[id].mInit, state[id].q);
+        status          = IMU_core_enum_zeroed_both;
+      }
+      state[id].aReset  = 0;
+      
+    // asynchnous magnetometer vector
+    } else if (a_in==NULL && m_in!=NULL) {
+      if (state[id].aReset) {
+        a[0]            = 0.0f;
+        a[1]            = 0.0f;
+        a[2]            = 1.0f;
+        IMU_math_upFrwdToQuat(a, m, state[id].q);
+        memcpy(state[id].mInit, m, sizeof(m));
+        status          = IMU_core_enum_zeroed_save;
+      } else {
+        IMU_math_quatToUp(state[id].q, a);
+        IMU_math_upFrwdToQuat(a, m, state[id].q);
+        status          = IMU_core_enum_zeroed_magn;
+      }
+      state[id].mReset  = 0;
+    
+    // no sensor data provided
+    } else {
+      status            = IMU_CORE_FNC_DISABLED;
+    }
+
+  // no magnetometer configuation
+  } else if ( config[id]->isAccl && !config[id]->isMagn) {
+    if (a_in==NULL || !state[id].aReset) {
+      status            = IMU_CORE_FNC_DISABLED;
+    } else {
+      IMU_math_upToQuat(a, state[id].q);
+      state[id].aReset  = 0;
+      status            = IMU_core_enum_zeroed_accl;
+    }
+
+  // no accelerometer configuration
+  } else if (!config[id]->isAccl &&  config[id]->isMagn) {
+    if (m_in==NULL || !state[id].mReset) {
+      status            = IMU_CORE_FNC_DISABLED;
+    } else {
+      a[0]              = 0.0f;
+      a[1]              = 0.0f;
+      a[2]              = 1.0f;
+      IMU_math_upFrwdToQuat(a, m, state[id].q);
+      state[id].mReset  = 0;
+      status            = IMU_core_enum_zeroed_magn;
+    }
+
+  // gyroscope only configuration
+  } else {
+    state[id].q[0]      = 1.0f;
+    state[id].q[1]      = 0.0f;
+    state[id].q[2]      = 0.0f;
+    state[id].q[3]      = 0.0f;
+    status              = IMU_core_enum_zeroed_gyro;
+  }
+  state[id].version++;
+  return status;
+}
+
+
+/******************************************************************************
+* utility function - startup gain, decays linearly from startGain to one
+* over startTime seconds after the last zero
+******************************************************************************/
+
+inline float gainSched(
+  uint16_t       id,
+  uint32_t       t)
+{
+  float gain     = config[id]->startGain;
+  float tEnd     = config[id]->startTime;
+  if (gain <= 1.0f || tEnd <= 0.0f)
+    return 1.0f;
+  IMU_time tExt  = IMU_time_extend(state[id].t, t);
+  float dt       = (float)(int64_t)(tExt - state[id].tZero) *
+                   IMU_CORE_10USEC_TO_SEC;
+  if (dt >= tEnd)
+    return 1.0f;
+  return gain + (1.0f - gain) * dt / tEnd;
+}
+
+
+/******************************************************************************
+* utility function - extends datum time to the 64-bit state time base,
+* returns seconds since the last datum (exact for any stream duration)
+******************************************************************************/
+
+inline float elapsed(
+  uint16_t       id,
+  uint32_t       t,
+  IMU_time       *tExt)
+{
+  *tExt          = IMU_time_extend(state[id].t, t);
+  return (float)(int64_t)(*tExt - state[id].t) * IMU_CORE_10USEC_TO_SEC;
+}
+
+
+/******************************************************************************
+* utility function - FOM weight w/ compiled threshold reciprocal (read only,
+* so no divide per datum)
+******************************************************************************/
+
+inline float weight(
+  uint16_t           id,
+  IMU_core_plan_enum k,
+  float              val,
+  float              ref)
+{
+  return IMU_math_calcWeightInv(val, ref, plan[id].inv[k]);
+}
+
+
+/******************************************************************************
+* utility function - accelerometer correction schedule, returns gain scale
+* (zero when correction is skipped), R is the current rotation matrix
+******************************************************************************/
+
+inline float schedAccl(
+  uint16_t       id,
+  float          *R,
+  float          *a)
+{
+  // threshold on accumulated misalignment (matches IMU_math_estmAccl model)
+  if      (config[id]->aErrThresh > 0.0f) {
+    float *u         = &R[6];
+    state[id].aErr  += 1.0f - (u[0]*a[0] + u[1]*a[1] + u[2]*a[2]);
+    if (state[id].aCount < UINT16_MAX)
+      state[id].aCount++;
+    if (state[id].aErr < config[id]->aErrThresh)
+      return 0.0f;
+
+  // fixed decimation
+  } else if (config[id]->aDecim > 1) {
+    state[id].aCount++;
+    if (state[id].aCount < config[id]->aDecim)
+      return 0.0f;
+
+  // every datum
+  } else {
+    return 1.0f;
+  }
+
+  // scale gain by skipped datum (capped by aSchedMax in threshold mode)
+  float scale    = (float)state[id].aCount;
+  if (config[id]->aErrThresh > 0.0f &&
+      state[id].aCount > config[id]->aSchedMax)
+    scale        = (float)config[id]->aSchedMax;
+  state[id].aCount = 0;
+  state[id].aErr   = 0.0f;
+  return scale;
+}
+
+
+/******************************************************************************
+* utility function - magnetometer correction schedule, returns gain scale
+* (zero when correction is skipped), R is the current rotation matrix
+******************************************************************************/
+
+inline float schedMagn(
+  uint16_t       id,
+  float          *R,
+  float          *m)
+{
+  // threshold on accumulated misalignment (matches IMU_math_estmMagnNorm)
+  if      (config[id]->mErrThresh > 0.0f) {
+    float u[3];
+    IMU_math_dcmToUp(R, u);
+    float *f         = &R[0];
+    float n          = u[0]*m[0] + u[1]*m[1] + u[2]*m[2];
+    float h[3]       = {m[0]-n*u[0], m[1]-n*u[1], m[2]-n*u[2]};
+    float h_mag2     = h[0]*h[0] + h[1]*h[1] + h[2]*h[2];
+    if (h_mag2 > 0.0f)
+      state[id].mErr += 1.0f - (f[0]*h[0] + f[1]*h[1] + f[2]*h[2]) *
+                               IMU_math_rsqrt(h_mag2);
+    if (state[id].mCount < UINT16_MAX)
+      state[id].mCount++;
+    if (state[id].mErr < config[id]->mErrThresh)
+      return 0.0f;
+
+  // fixed decimation
+  } else if (config[id]->mDecim > 1) {
+    state[id].mCount++;
+    if (state[id].mCount < config[id]->mDecim)
+      return 0.0f;
+
+  // every datum
+  } else {
+    return 1.0f;
+  }
+
+  // scale gain by skipped datum (capped by mSchedMax in threshold mode)
+  float scale    = (float)state[id].mCount;
+  if (config[id]->mErrThresh > 0.0f &&
+      state[id].mCount > config[id]->mSchedMax)
+    scale        = (float)config[id]->mSchedMax;
+  state[id].mCount = 0;
+  state[id].mErr   = 0.0f;
+  return scale;
 }
 
 
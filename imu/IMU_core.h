@@ -51,28 +51,59 @@ typedef struct {
   unsigned char        isFOM;           // enable weight based on FOM
   unsigned char        isTran;          // enable translational estimate
   unsigned char        isPredict;       // enable extrapolation of estim
+  unsigned char        isFused;         // enable single-pass data3 update
+  unsigned char        gIntegrate;      // gyro integrator (IMU_core_gyro)
   float                gScale;          // scale to covert to rad/sec
   float                aWeight;         // accelerometer IMU weight
   float                aMag;            // gravity magnitude
   float                aMagThresh;      // gravity magnitude error thresh
+  uint16_t             aDecim;          // apply accl every Nth datum
+  float                aErrThresh;      // accumulated accl error thresh
+  uint16_t             aSchedMax;       // max accl gain scale (thresh)
   float                mWeight;         // magnetometer IMU weight
   float                mMag;            // magnetic north magn  
   float                mMagThresh;      // magnetic north magn error thres
   float                mDot;            // magnetic north angle
   float                mDotThresh;      // magnetic north angle error thresh
+  uint16_t             mDecim;          // apply magn every Nth datum
+  float                mErrThresh;      // accumulated magn error thresh
+  uint16_t             mSchedMax;       // max magn gain scale (thresh)
+  float                iWeight;         // gyro bias integral gain (mahony)
+  uint16_t             zeroNum;         // datum averaged before zeroing
+  float                startGain;       // accl/magn weight gain after zero
+  float                startTime;       // gain decay time (sec)
   float                tranAlpha;       // translational accleration alpha
 } IMU_core_config;
 
+// gyroscope integration methods
+typedef enum {
+  IMU_core_gyro_euler        = 0,       // first-order (fastest)
+  IMU_core_gyro_exp          = 1,       // exponential map (exact rate)
+  IMU_core_gyro_rk4          = 2        // Runge-Kutta (interpolated rate)
+} IMU_core_gyro;
+
 // subsystem state structure definition
 typedef struct {
   int                  status;          // captures last datum status
-  float                t;               // last datum time
+  IMU_time             t;               // last datum time (10usec)
   float                q[4];            // current quaterion
   float                aTran[3];        // last acceleration estimate
+  float                gPrev[3];        // last gyroscope rate (rad/sec)
   float                mInit[3];        // initial magnetometer value
+  uint16_t             aCount;          // accl datum since last correction
+  uint16_t             mCount;          // magn datum since last correction
+  float                aErr;            // accumulated accl error
+  float                mErr;            // accumulated magn error
+  float                aSum[3];         // accl sum awaiting zero
+  float                mSum[3];         // magn sum awaiting zero
+  uint16_t             aNum;            // accl datum awaiting zero
+  uint16_t             mNum;            // magn datum awaiting zero
+  IMU_time             tZero;           // last zero time (gain schedule)
+  float                gBias[3];        // gyro bias estimate (mahony)
   unsigned char        gReset;          // gyroscope reset signal
   unsigned char        aReset;          // accelerometer reset signal
   unsigned char        mReset;          // magnetometer reset signal
+  unsigned int         version;         // bumped on each state update
 } IMU_core_state;
 
 // core datum internal state
@@ -84,22 +115,34 @@ typedef enum {
   IMU_core_enum_zeroed_both  = 5,
   IMU_core_enum_zeroed_gyro  = 6,
   IMU_core_enum_normal_op    = 7,
+  IMU_core_enum_sched_skip   = 8,
   IMU_core_enum_no_weight    = 9,
+  IMU_core_enum_zero_accum   = 10,
 } IMU_core_enum;
   
 // data structure access functions
 int IMU_core_init     (uint16_t *id, IMU_core_config **config);
 int IMU_core_getConfig (uint16_t id, IMU_core_config **config);
+int IMU_core_setConfig (uint16_t id, IMU_core_config *config);
 int IMU_core_getState  (uint16_t id, IMU_core_state  **state);
+int IMU_core_compile   (uint16_t id);
 
 // state update functions
 int IMU_core_reset     (uint16_t id);
 int IMU_core_datum     (uint16_t id, IMU_datum*, IMU_core_FOM*);
 int IMU_core_data3     (uint16_t id, IMU_data3*, IMU_core_FOM*);
+int IMU_core_delta     (uint16_t id, uint32_t t, float *dq, float *g,
+                        IMU_core_FOM*);
+int IMU_core_advance   (uint16_t id, uint32_t t);
+
+// state update functions (mahony complementary filter)
+int IMU_core_mhnyDatum (uint16_t id, IMU_datum*, IMU_core_FOM*);
+int IMU_core_mhnyData3 (uint16_t id, IMU_data3*, IMU_core_FOM*);
 
 // state estimation functions
 int IMU_core_estmQuat  (uint16_t id, uint32_t t, float* estm);
 int IMU_core_estmAccl  (uint16_t id, uint32_t t, float* estm);
+int IMU_core_estmVersion(uint16_t id, unsigned int *version);
 
 
 #ifdef __cplusplus
@@ -30,6 +30,8 @@
 #include <unistd.h>
 #endif
 #include <string.h>
+#include <math.h>
+#include <stdatomic.h>
 #include "IMU_file.h"
 #include "IMU_thrd.h"
 #include "IMU_math.h"
@@ -40,40 +42,131 @@
 typedef struct {
   uint16_t               id       [IMU_ENGN_QUEUE_SIZE+1];
   IMU_datum              datum    [IMU_ENGN_QUEUE_SIZE+1];
+  IMU_data3              data3    [IMU_ENGN_QUEUE_SIZE+1];  // IMU_sync datum
   int                    first;
   int                    last;
   int                    count;
 } IMU_engn_queue;
 #endif
+typedef struct {
+  unsigned int           version;
+  unsigned int           opEnd;              // calb ops requested (sequence)
+  IMU_core_config        core;
+  IMU_rect_config        rect;
+  IMU_pnts_config        pnts;
+  IMU_stat_config        stat;
+  IMU_calb_config        calb;
+  IMU_engn_config        engn;
+  IMU_intg_config        intg;
+} IMU_engn_snap;
+typedef enum {
+  IMU_engn_op_calbStat   = 0,
+  IMU_engn_op_calbSave   = 1,
+  IMU_engn_op_calbRevert = 2
+} IMU_engn_op;
+typedef struct {
+  uint16_t               stage;              // enabled stages (mask)
+  IMU_core_FOM           *FOM;               // FOM output (NULL given none)
+  float                  gGateSqrd;          // gate rate limit (counts^2)
+  int (*process)(uint16_t id, IMU_datum*);   // selected datum pipeline
+} IMU_engn_plan;
+typedef enum {
+  IMU_engn_stage_rect    = 0x01,
+  IMU_engn_stage_pnts    = 0x02,
+  IMU_engn_stage_stat    = 0x04,
+  IMU_engn_stage_calb    = 0x08,
+  IMU_engn_stage_intg    = 0x10,
+  IMU_engn_stage_gate    = 0x20,
+  IMU_engn_stage_sensor  = 0x40
+} IMU_engn_stage;
+typedef struct {
+  unsigned int           version;            // core state version cached
+  uint8_t                valid;              // cached outputs (estm mask)
+  uint8_t                isRef;              // reference applied to ang
+  float                  qRef     [4];       // reference applied to q
+  float                  qOrg     [4];
+  float                  q        [4];
+  float                  ang      [3];
+  float                  tran     [3];
+} IMU_engn_cache;
+typedef enum {
+  IMU_engn_estm_quat     = 0x01,
+  IMU_engn_estm_tran     = 0x02,
+  IMU_engn_estm_ref      = 0x04,
+  IMU_engn_estm_ang      = 0x08
+} IMU_engn_estm_mask;
 
 // internally define variables
 static IMU_core_FOM      datumFOM [3];
-static IMU_engn_config   config   [IMU_MAX_INST]; 
+static IMU_engn_config   *config  [IMU_MAX_INST];  // snapshot in use
 static IMU_engn_state    state    [IMU_MAX_INST];
 static IMU_engn_sensor   sensor   [IMU_MAX_INST];
+static IMU_intg_incr     incr     [IMU_MAX_INST];
+static uint32_t          gateTime [IMU_MAX_INST][4];
+static float             gateRate [IMU_MAX_INST];
+static IMU_engn_plan     plan     [IMU_MAX_INST];
+static IMU_engn_cache    cache    [IMU_MAX_INST];
+static const IMU_engn_backend *backend [IMU_MAX_INST];
 static uint16_t          numInst = 0;
+static IMU_engn_snap     snap     [IMU_MAX_INST][3];
+static IMU_engn_snap * _Atomic snapPub  [IMU_MAX_INST];  // last published
+static IMU_engn_snap * _Atomic snapUse  [IMU_MAX_INST];  // read by pipeline
+static unsigned int      snapVer  [IMU_MAX_INST];
+static uint8_t           snapOp   [IMU_MAX_INST][IMU_ENGN_SNAP_OPS];
+static unsigned int      opDone   [IMU_MAX_INST];
 #if IMU_ENGN_QUEUE_SIZE
 static IMU_engn_queue    queue;
 #endif
 #if IMU_USE_PTHREAD
 static useconds_t        sleepTime = 20;
+static pthread_mutex_t   snapLock;
+static pthread_mutex_t   cacheLock[IMU_MAX_INST];
 static pthread_mutex_t   thrdLock;
 static pthread_t         thrd;
 static pthread_attr_t    thrdAttr;
 static uint8_t           thrdExit;
 static uint8_t           thrdIsExit;
+static uint8_t           thrdIsRun = 0;
 #endif
 
+// core backend function tables (indexed by IMU_engn_core_filter)
+static const int         numBackend = 2;
+static const IMU_engn_backend backendList[] = {
+  {IMU_core_init, IMU_core_reset, IMU_core_datum, IMU_core_data3,
+   IMU_core_delta, IMU_core_estmQuat, IMU_core_estmAccl,
+   IMU_core_estmVersion},
+  {IMU_core_init, IMU_core_reset, IMU_core_mhnyDatum, IMU_core_mhnyData3,
+   IMU_core_delta, IMU_core_estmQuat, IMU_core_estmAccl,
+   IMU_core_estmVersion}};
+
 // internally defined functions
 int IMU_engn_calbFnc    (uint16_t id, IMU_calb_FOM*);
 int IMU_engn_process    (uint16_t id, IMU_datum*);
+int IMU_engn_procData3  (uint16_t id, IMU_data3*);
+int IMU_engn_procCore   (uint16_t id, IMU_datum*);
+int IMU_engn_procRect   (uint16_t id, IMU_datum*);
+int IMU_engn_procFull   (uint16_t id, IMU_datum*);
+int IMU_engn_preIntg    (uint16_t id, IMU_datum*);
+int IMU_engn_gate       (uint16_t id, IMU_sensor, uint32_t t, float *g,
+                         IMU_pnts_enum);
 int IMU_copy_datumRaw   (uint16_t id, IMU_datum*);
 int IMU_copy_data3Raw   (uint16_t id, IMU_data3*);
 int IMU_copy_results1   (uint16_t id, IMU_datum*, IMU_core_FOM*);
 int IMU_copy_results3   (uint16_t id, IMU_data3*, IMU_core_FOM*);
 int IMU_engn_typeCheck  (uint16_t id, IMU_engn_system);
+int IMU_engn_setBackend (uint16_t id);
+int IMU_engn_sync       (uint16_t id);
+int IMU_engn_compile    (uint16_t id);
+IMU_engn_snap* IMU_engn_snapOpen   (uint16_t id);
+int            IMU_engn_snapCommit (uint16_t id, IMU_engn_snap*);
+int            IMU_engn_snapOp     (uint16_t id, IMU_engn_op);
+IMU_engn_snap* IMU_engn_snapFree   (uint16_t id, IMU_engn_snap *pub);
+IMU_engn_snap* IMU_engn_snapTake   (uint16_t id, IMU_engn_snap *cur);
+IMU_engn_snap* IMU_engn_snapCalb   (uint16_t id);
+void           IMU_engn_snapPoint  (uint16_t id, IMU_engn_snap*);
+void*          IMU_engn_snapStruct (IMU_engn_snap*, IMU_engn_system);
 #if IMU_ENGN_QUEUE_SIZE
-int IMU_engn_addQueue   (uint16_t id, IMU_datum*);
+int IMU_engn_addQueue   (uint16_t id, IMU_datum*, IMU_data3*);
 void* IMU_engn_run      (void*);
 #endif
 
@@ -94,72 +187,103 @@ int IMU_engn_init(
   *id                   = numInst;
   numInst++;
 
-  // initialize config structure
+  // initialize config structure (first snapshot)
+  config[*id]              = &snap[*id][0].engn;
   if        (type == IMU_engn_core_only) {
-    config[*id].isRect       = 0;
-    config[*id].isPnts       = 0;
-    config[*id].isStat       = 0;
-    config[*id].isCalb       = 0;
+    config[*id]->isRect      = 0;
+    config[*id]->isPnts      = 0;
+    config[*id]->isStat      = 0;
+    config[*id]->isCalb      = 0;
   } else if (type == IMU_engn_rect_core) {
-    config[*id].isRect       = 1;
-    config[*id].isPnts       = 0;
-    config[*id].isStat       = 0;
-    config[*id].isCalb       = 0;
+    config[*id]->isRect      = 1;
+    config[*id]->isPnts      = 0;
+    config[*id]->isStat      = 0;
+    config[*id]->isCalb      = 0;
   } else if (type == IMU_engn_calb_pnts) {
-    config[*id].isRect       = 1;
-    config[*id].isPnts       = 1;
-    config[*id].isStat       = 0;
-    config[*id].isCalb       = 1;
+    config[*id]->isRect      = 1;
+    config[*id]->isPnts      = 1;
+    config[*id]->isStat      = 0;
+    config[*id]->isCalb      = 1;
   } else if (type == IMU_engn_calb_stat) {
-    config[*id].isRect       = 1;
-    config[*id].isPnts       = 0;
-    config[*id].isStat       = 1;
-    config[*id].isCalb       = 1;
+    config[*id]->isRect      = 1;
+    config[*id]->isPnts      = 0;
+    config[*id]->isStat      = 1;
+    config[*id]->isCalb      = 1;
   } else if (type == IMU_engn_calb_full) {
-    config[*id].isRect       = 1;
-    config[*id].isPnts       = 1;
-    config[*id].isStat       = 1;
-    config[*id].isCalb       = 1;
+    config[*id]->isRect      = 1;
+    config[*id]->isPnts      = 1;
+    config[*id]->isStat      = 1;
+    config[*id]->isCalb      = 1;
   } else {
     return IMU_ENGN_BAD_ENGN_TYPE;
   }
-  config[*id].isFOM          = 0;
-  config[*id].isTran         = 0;
-  config[*id].isRef          = 1;
-  config[*id].isAng          = 1;
-  config[*id].isSensorStruct = 0;
-  config[*id].qRef[0]        = 1;
-  config[*id].qRef[1]        = 0;
-  config[*id].qRef[2]        = 0;
-  config[*id].qRef[3]        = 0;
+  config[*id]->isIntg        = 0;
+  config[*id]->isGate        = 0;
+  config[*id]->tGate         = 100000;
+  config[*id]->gGate         = 0.05;
+  config[*id]->isFOM         = 0;
+  config[*id]->isTran        = 0;
+  config[*id]->isRef         = 1;
+  config[*id]->isAng         = 1;
+  config[*id]->isSensorStruct = 0;
+  config[*id]->filter        = IMU_engn_madgwick;
+  config[*id]->qRef[0]       = 1;
+  config[*id]->qRef[1]       = 0;
+  config[*id]->qRef[2]       = 0;
+  config[*id]->qRef[3]       = 0;
   state[*id].rect            = 0;
   state[*id].pnts            = 0;
   state[*id].stat            = 0;
   state[*id].calb            = 0;
+  state[*id].intg            = 0;
   state[*id].datumCount      = 0;
+  state[*id].gateCount       = 0;
+  state[*id].configVersion   = 0;
+  state[*id].estmCount       = 0;
+  cache[*id].valid           = 0;
   
   // create IMU subsystem instances
   IMU_engn_state *cur = &state[*id];
-  state[*id].core     = IMU_core_init(&cur->idCore, &cur->configCore);
-  if (config[*id].isRect)
+  IMU_engn_setBackend(*id);
+  state[*id].core     = backend[*id]->init(&cur->idCore, &cur->configCore);
+  if (config[*id]->isRect)
     state[*id].rect   = IMU_rect_init(&cur->idRect, &cur->configRect);
-  if (config[*id].isPnts)
+  if (config[*id]->isPnts)
     state[*id].pnts   = IMU_pnts_init(&cur->idPnts, &cur->configPnts);
-  if (config[*id].isStat)
+  if (config[*id]->isStat)
     state[*id].stat   = IMU_stat_init(&cur->idStat, &cur->configStat);
-  if (config[*id].isCalb)
+  if (config[*id]->isCalb)
     state[*id].calb   = IMU_calb_init(&cur->idCalb, &cur->configCalb);
+  state[*id].intg     = IMU_intg_init(&cur->idIntg, &cur->configIntg);
   if (cur->core < 0 || cur->rect < 0 || cur->pnts < 0 ||
-      cur->stat < 0 || cur->calb < 0)
+      cur->stat < 0 || cur->calb < 0 || cur->intg < 0)
     return IMU_ENGN_SUBSYSTEM_FAILURE;
 
-  // initialize config structures
-  if (config[*id].isCalb > 0)
-    IMU_calb_setStruct(cur->idCalb, cur->configRect, cur->configCore);
-
-  // create pthread mutex
+  // publish subsystem defaults w/ the first snapshot (read in place)
+  IMU_engn_snap *first  = &snap[*id][0];
+  memcpy(&first->core, cur->configCore, sizeof(IMU_core_config));
+  if (config[*id]->isRect)
+    memcpy(&first->rect, cur->configRect, sizeof(IMU_rect_config));
+  if (config[*id]->isPnts)
+    memcpy(&first->pnts, cur->configPnts, sizeof(IMU_pnts_config));
+  if (config[*id]->isStat)
+    memcpy(&first->stat, cur->configStat, sizeof(IMU_stat_config));
+  if (config[*id]->isCalb)
+    memcpy(&first->calb, cur->configCalb, sizeof(IMU_calb_config));
+  memcpy(&first->intg, cur->configIntg, sizeof(IMU_intg_config));
+  IMU_engn_snapPoint(*id, first);
+  atomic_store(&snapPub[*id], first);
+  atomic_store(&snapUse[*id], first);
+  IMU_engn_compile(*id);
+
+  // create pthread mutex (engine-wide locks with the first instance)
   #if IMU_USE_PTHREAD
-  int err  = IMU_thrd_mutex_init(&thrdLock);
+  int err  = 0;
+  if (*id == 0) {
+    err   |= IMU_thrd_mutex_init(&thrdLock);
+    err   |= IMU_thrd_mutex_init(&snapLock);
+  }
+  err     |= IMU_thrd_mutex_init(&cacheLock[*id]);
   if (err) return IMU_CORE_FAILED_MUTEX;
   #endif
 
@@ -192,6 +316,8 @@ int IMU_engn_getSysID(
     *sysID              = state[id].idStat;
   else if (system == IMU_engn_calb)
     *sysID              = state[id].idCalb;
+  else if (system == IMU_engn_intg)
+    *sysID              = state[id].idIntg;
   else
     return IMU_ENGN_NONEXISTANT_SYSID;
   
@@ -201,7 +327,9 @@ int IMU_engn_getSysID(
 
 
 /******************************************************************************
-* function to return config structure
+* function to return config structure (last published snapshot, written in
+* place only while no datum is processed and applied at the next reset,
+* otherwise use setConfig)
 ******************************************************************************/
 
 int IMU_engn_getConfig( 
@@ -213,19 +341,23 @@ int IMU_engn_getConfig(
   if (id >= numInst)
     return IMU_ENGN_BAD_INST; 
 
-  // pass subsystem config structure
+  // pass subsystem config structure (NULL given subsystem not running)
+  IMU_engn_snap *pub    = atomic_load(&snapPub[id]);
+  int           isSys   = IMU_engn_typeCheck(id, system) == 0;
   if      (system == IMU_engn_core)
-    pntr->core          = state[id].configCore;
+    pntr->core          = &pub->core;
   else if (system == IMU_engn_rect)
-    pntr->rect          = state[id].configRect;
+    pntr->rect          = isSys ? &pub->rect : NULL;
   else if (system == IMU_engn_pnts)
-    pntr->pnts          = state[id].configPnts;
+    pntr->pnts          = isSys ? &pub->pnts : NULL;
   else if (system == IMU_engn_stat)
-    pntr->stat          = state[id].configStat;
+    pntr->stat          = isSys ? &pub->stat : NULL;
   else if (system == IMU_engn_calb)
-    pntr->calb          = state[id].configCalb;
+    pntr->calb          = isSys ? &pub->calb : NULL;
   else if (system == IMU_engn_self)
-    pntr->engn          = &config[id];
+    pntr->engn          = &pub->engn;
+  else if (system == IMU_engn_intg)
+    pntr->intg          = &pub->intg;
   else
     return IMU_ENGN_NONEXISTANT_SYSID;
   
@@ -234,6 +366,135 @@ int IMU_engn_getConfig(
 }
 
 
+/******************************************************************************
+* function to copy config structure (consistent copy of the last published
+* snapshot, caller owned)
+******************************************************************************/
+
+int IMU_engn_copyConfig(
+  uint16_t              id,
+  IMU_engn_system       system,
+  IMU_union_config      *pntr)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_ENGN_BAD_INST;
+  if (IMU_engn_typeCheck(id, system) < 0)
+    return IMU_ENGN_UNINITIALIZE_SYS;
+  if (system > IMU_engn_intg)
+    return IMU_ENGN_NONEXISTANT_SYSID;
+
+  // copy structure (snapshot not reclaimed while writers are held off)
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&snapLock);
+  #endif
+  IMU_engn_snap *pub    = atomic_load(&snapPub[id]);
+  void          *src    = IMU_engn_snapStruct(pub, system);
+  if      (system == IMU_engn_core)
+    memcpy(pntr->core, src, sizeof(IMU_core_config));
+  else if (system == IMU_engn_rect)
+    memcpy(pntr->rect, src, sizeof(IMU_rect_config));
+  else if (system == IMU_engn_pnts)
+    memcpy(pntr->pnts, src, sizeof(IMU_pnts_config));
+  else if (system == IMU_engn_stat)
+    memcpy(pntr->stat, src, sizeof(IMU_stat_config));
+  else if (system == IMU_engn_calb)
+    memcpy(pntr->calb, src, sizeof(IMU_calb_config));
+  else if (system == IMU_engn_self)
+    memcpy(pntr->engn, src, sizeof(IMU_engn_config));
+  else if (system == IMU_engn_intg)
+    memcpy(pntr->intg, src, sizeof(IMU_intg_config));
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_unlock(&snapLock);
+  #endif
+
+  // exit (no errors)
+  return 0;
+}
+
+
+/******************************************************************************
+* function to replace config structure (copied to a versioned snapshot that
+* the pipeline reads from the next datum, returns version)
+******************************************************************************/
+
+int IMU_engn_setConfig(
+  uint16_t              id,
+  IMU_engn_system       system,
+  IMU_union_config      *pntr)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_ENGN_BAD_INST;
+  if (IMU_engn_typeCheck(id, system) < 0)
+    return IMU_ENGN_UNINITIALIZE_SYS;
+  if (system > IMU_engn_intg)
+    return IMU_ENGN_NONEXISTANT_SYSID;
+
+  // copy structure to snapshot (seeded from the last published)
+  IMU_engn_snap *cur    = IMU_engn_snapOpen(id);
+  void *dst             = IMU_engn_snapStruct(cur, system);
+  if      (system == IMU_engn_core)
+    memcpy(dst, pntr->core, sizeof(IMU_core_config));
+  else if (system == IMU_engn_rect)
+    memcpy(dst, pntr->rect, sizeof(IMU_rect_config));
+  else if (system == IMU_engn_pnts)
+    memcpy(dst, pntr->pnts, sizeof(IMU_pnts_config));
+  else if (system == IMU_engn_stat)
+    memcpy(dst, pntr->stat, sizeof(IMU_stat_config));
+  else if (system == IMU_engn_calb)
+    memcpy(dst, pntr->calb, sizeof(IMU_calb_config));
+  else if (system == IMU_engn_intg)
+    memcpy(dst, pntr->intg, sizeof(IMU_intg_config));
+  else if (system == IMU_engn_self) {
+    uint8_t isSys[4]    = {cur->engn.isRect, cur->engn.isPnts,
+                           cur->engn.isStat, cur->engn.isCalb};
+    memcpy(dst, pntr->engn, sizeof(IMU_engn_config));
+    cur->engn.isRect    = isSys[0];
+    cur->engn.isPnts    = isSys[1];
+    cur->engn.isStat    = isSys[2];
+    cur->engn.isCalb    = isSys[3];
+  }
+
+  // publish snapshot (pass version)
+  return IMU_engn_snapCommit(id, cur);
+}
+
+
+/******************************************************************************
+* function to wait until published config snapshots are applied (given no
+* queue thread, applied by the caller, which must be the thread feeding the
+* instance)
+******************************************************************************/
+
+int IMU_engn_syncConfig(
+  uint16_t              id)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_ENGN_BAD_INST;
+
+  // wait on pipeline (bounded)
+  #if IMU_USE_PTHREAD
+  int                   i;
+  if (!thrdIsRun)
+    IMU_engn_sync(id);
+  for (i=0; i<IMU_ENGN_SYNC_WAIT; i++) {
+    if (state[id].configVersion == snapVer[id])
+      return 0;
+    usleep(sleepTime);
+  }
+  #else
+  IMU_engn_sync(id);
+  #endif
+  if (state[id].configVersion != snapVer[id])
+    return IMU_ENGN_CONFIG_TIMEOUT;
+
+  // exit (no errors)
+  return 0;
+}
+
+
 /******************************************************************************
 * function to return state structure
 ******************************************************************************/
@@ -257,9 +518,11 @@ int IMU_engn_getState(
   else if (system == IMU_engn_stat)
     IMU_stat_getState(state[id].idStat, &pntr->stat);
   else if (system == IMU_engn_calb)
-    return IMU_ENGN_NONEXISTANT_STRUCT;
+    IMU_calb_getState(state[id].idCalb, &pntr->calb);
   else if (system == IMU_engn_self)
     pntr->engn          = &state[id];
+  else if (system == IMU_engn_intg)
+    IMU_intg_getState(state[id].idIntg, &pntr->intg);
   else
     return IMU_ENGN_NONEXISTANT_SYSID;
 
@@ -279,7 +542,7 @@ int IMU_engn_getSensor(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_ENGN_BAD_INST; 
-  if (!config[id].isSensorStruct)
+  if (!config[id]->isSensorStruct)
     return IMU_ENGN_DISABLED_SENSOR_STRUCT;
 
   // pass sensor structure and exit
@@ -300,7 +563,7 @@ int IMU_engn_setCalbFnc(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_ENGN_BAD_INST;
-  if (!config[id].isCalb)
+  if (!config[id]->isCalb)
     return IMU_ENGN_UNINITIALIZE_SYS;
 
   // pass sensor structure and exit
@@ -325,7 +588,7 @@ int IMU_engn_setStableFnc(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_ENGN_BAD_INST;
-  if (!config[id].isCalb)
+  if (!config[id]->isCalb)
     return IMU_ENGN_UNINITIALIZE_SYS;
 
   // pass sensor structure and exit
@@ -350,7 +613,7 @@ int IMU_engn_setBreakFnc(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_ENGN_BAD_INST;
-  if (!config[id].isCalb)
+  if (!config[id]->isCalb)
     return IMU_ENGN_UNINITIALIZE_SYS;
 
   // pass sensor structure and exit
@@ -369,11 +632,13 @@ int IMU_engn_setBreakFnc(
 
 int IMU_engn_start()
 {
-  // reset all instances
+  // apply published config and reset all instances (no pipeline yet)
   int             status  = 0;
   int             i;
-  for (i=0; i<numInst; i++)
+  for (i=0; i<numInst; i++) {
+    IMU_engn_sync(i);
     status  += max(0, IMU_engn_reset(i));
+  }
   if (status > 0)
     return IMU_ENGN_SUBSYSTEM_FAILURE;
 
@@ -390,6 +655,7 @@ int IMU_engn_start()
   // currently supports pthread only
   #if IMU_USE_PTHREAD
   thrdExit        = 0;
+  thrdIsRun       = 1;
   return pthread_create(&thrd, &thrdAttr, IMU_engn_run, NULL);
   #else
   return 0;
@@ -413,6 +679,7 @@ int IMU_engn_stop()
   while (!thrdIsExit)
     usleep(sleepTime);
   pthread_join(thrd, NULL);
+  thrdIsRun = 0;
   return 0;
   #else
   return IMU_ENGN_FAILED_THREAD;
@@ -421,7 +688,7 @@ int IMU_engn_stop()
 
 
 /******************************************************************************
-* function to load json configuration file
+* function to load json configuration file (published w/ one snapshot)
 ******************************************************************************/
 
 int IMU_engn_load(
@@ -432,39 +699,59 @@ int IMU_engn_load(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_ENGN_BAD_INST;
-    
-  // load respective json file
+  if (IMU_engn_typeCheck(id, system) < 0)
+    return IMU_ENGN_UNINITIALIZE_SYS;
+  if (system > IMU_engn_intg)
+    return IMU_ENGN_NONEXISTANT_SYSID;
+
+  // load respective json file to snapshot (seeded from the last published)
+  IMU_engn_snap *cur    = IMU_engn_snapOpen(id);
+  int           status  = 0;
   if      (system == IMU_engn_core)
-    return   IMU_file_coreLoad(filename, state[id].configCore);
+    status = IMU_file_coreLoad(filename, &cur->core);
   else if (system == IMU_engn_rect)
-    return IMU_file_rectLoad(filename, state[id].configRect);
+    status = IMU_file_rectLoad(filename, &cur->rect);
   else if (system == IMU_engn_pnts)
-    return IMU_file_pntsLoad(filename, state[id].configPnts);
+    status = IMU_file_pntsLoad(filename, &cur->pnts);
   else if (system == IMU_engn_stat)
-    return IMU_file_statLoad(filename, state[id].configStat);
+    status = IMU_file_statLoad(filename, &cur->stat);
   else if (system == IMU_engn_calb) 
-    return IMU_file_calbLoad(filename, state[id].configCalb);
+    status = IMU_file_calbLoad(filename, &cur->calb);
+  else if (system == IMU_engn_intg)
+    status = IMU_file_intgLoad(filename, &cur->intg);
   else if (system == IMU_engn_self) {
-    int status = IMU_file_engnLoad(filename, &config[id]);
-    if (config[id].configFileCore[0] != '\0')
-      IMU_file_coreLoad(config[id].configFileCore, state[id].configCore);
-    if (config[id].configFileRect[0] != '\0')
-      IMU_file_rectLoad(config[id].configFileRect, state[id].configRect);
-    if (config[id].configFilePnts[0] != '\0')
-      IMU_file_pntsLoad(config[id].configFilePnts, state[id].configPnts);
-    if (config[id].configFileStat[0] != '\0')
-      IMU_file_statLoad(config[id].configFileStat, state[id].configStat);
-    if (config[id].configFileCalb[0] != '\0')
-      IMU_file_calbLoad(config[id].configFileCalb, state[id].configCalb);
-    return status;
-  } else {
-    return IMU_ENGN_NONEXISTANT_SYSID;
+    IMU_engn_config *engn = &cur->engn;
+    uint8_t isSys[4]    = {engn->isRect, engn->isPnts,
+                           engn->isStat, engn->isCalb};
+    status = IMU_file_engnLoad(filename, engn);
+    engn->isRect        = isSys[0];
+    engn->isPnts        = isSys[1];
+    engn->isStat        = isSys[2];
+    engn->isCalb        = isSys[3];
+    if (status >= 0 && engn->filter >= numBackend)
+      status = IMU_ENGN_BAD_FILTER;
+    if (engn->configFileCore[0] != '\0')
+      IMU_file_coreLoad(engn->configFileCore, &cur->core);
+    if (engn->configFileRect[0] != '\0')
+      IMU_file_rectLoad(engn->configFileRect, &cur->rect);
+    if (engn->configFilePnts[0] != '\0')
+      IMU_file_pntsLoad(engn->configFilePnts, &cur->pnts);
+    if (engn->configFileStat[0] != '\0')
+      IMU_file_statLoad(engn->configFileStat, &cur->stat);
+    if (engn->configFileCalb[0] != '\0')
+      IMU_file_calbLoad(engn->configFileCalb, &cur->calb);
+    if (engn->configFileIntg[0] != '\0')
+      IMU_file_intgLoad(engn->configFileIntg, &cur->intg);
   }
+
+  // publish snapshot (pass load status)
+  IMU_engn_snapCommit(id, cur);
+  return status;
 }
 
 
 /******************************************************************************
-* function to save json configuration file
+* function to save json configuration file (last published snapshot)
 ******************************************************************************/
 
 int IMU_engn_save(
@@ -475,34 +762,51 @@ int IMU_engn_save(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_ENGN_BAD_INST;
+  if (IMU_engn_typeCheck(id, system) < 0)
+    return IMU_ENGN_UNINITIALIZE_SYS;
+  if (system > IMU_engn_intg)
+    return IMU_ENGN_NONEXISTANT_SYSID;
+
+  // snapshot not reclaimed while writers are held off
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&snapLock);
+  #endif
+  IMU_engn_snap *pub    = atomic_load(&snapPub[id]);
+  int           status  = 0;
     
-  // load respective json file
+  // save respective json file
   if      (system == IMU_engn_core)
-    return IMU_file_coreSave(filename, state[id].configCore);
+    status = IMU_file_coreSave(filename, &pub->core);
   else if (system == IMU_engn_rect)
-    return IMU_file_rectSave(filename, state[id].configRect);
+    status = IMU_file_rectSave(filename, &pub->rect);
   else if (system == IMU_engn_pnts)
-    return IMU_file_pntsSave(filename, state[id].configPnts);
+    status = IMU_file_pntsSave(filename, &pub->pnts);
   else if (system == IMU_engn_stat)
-    return IMU_file_statSave(filename, state[id].configStat);
+    status = IMU_file_statSave(filename, &pub->stat);
   else if (system == IMU_engn_calb)
-    return IMU_file_calbSave(filename, state[id].configCalb);
+    status = IMU_file_calbSave(filename, &pub->calb);
+  else if (system == IMU_engn_intg)
+    status = IMU_file_intgSave(filename, &pub->intg);
   else if (system == IMU_engn_self) {
-    int status = IMU_file_engnSave(filename, &config[id]);
-    if (config[id].configFileCore[0] != '\0')
-      IMU_file_coreSave(config[id].configFileCore, state[id].configCore);
-    if (config[id].configFileRect[0] != '\0')
-      IMU_file_rectSave(config[id].configFileRect, state[id].configRect);
-    if (config[id].configFilePnts[0] != '\0')
-      IMU_file_pntsSave(config[id].configFilePnts, state[id].configPnts);
-    if (config[id].configFileStat[0] != '\0')
-      IMU_file_statSave(config[id].configFileStat, state[id].configStat);
-    if (config[id].configFileCalb[0] != '\0')
-      IMU_file_calbSave(config[id].configFileCalb, state[id].configCalb);
-    return status;
-  } else {
-    return IMU_ENGN_NONEXISTANT_SYSID;
+    IMU_engn_config *engn = &pub->engn;
+    status = IMU_file_engnSave(filename, engn);
+    if (engn->configFileCore[0] != '\0')
+      IMU_file_coreSave(engn->configFileCore, &pub->core);
+    if (engn->configFileRect[0] != '\0')
+      IMU_file_rectSave(engn->configFileRect, &pub->rect);
+    if (engn->configFilePnts[0] != '\0')
+      IMU_file_pntsSave(engn->configFilePnts, &pub->pnts);
+    if (engn->configFileStat[0] != '\0')
+      IMU_file_statSave(engn->configFileStat, &pub->stat);
+    if (engn->configFileCalb[0] != '\0')
+      IMU_file_calbSave(engn->configFileCalb, &pub->calb);
+    if (engn->configFileIntg[0] != '\0')
+      IMU_file_intgSave(engn->configFileIntg, &pub->intg);
   }
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_unlock(&snapLock);
+  #endif
+  return status;
 }
 
 
@@ -529,16 +833,24 @@ int IMU_engn_reset(
   memset(sensor[id].mCor, 0, 3*sizeof(IMU_TYPE));
   memset(sensor[id].mFlt, 0, 3*sizeof(IMU_TYPE));
   
+  // select core backend (filter may have changed since init)
+  if (IMU_engn_setBackend(id) < 0)
+    return IMU_ENGN_BAD_FILTER;
+
+  // recompile plan (config may have been written in place since init)
+  IMU_engn_compile(id);
+
   // reset all open subsystems
-  state[id].core   = IMU_core_reset(state[id].idCore);
-  if (config[id].isPnts)
+  state[id].core   = backend[id]->reset(state[id].idCore);
+  if (config[id]->isPnts)
     state[id].pnts = IMU_pnts_reset(state[id].idPnts);
-  if (config[id].isStat)
+  if (config[id]->isStat)
     state[id].stat = IMU_stat_reset(state[id].idStat);
-  if (config[id].isCalb)
+  if (config[id]->isCalb)
     state[id].calb = IMU_calb_reset(state[id].idCalb);
+  state[id].intg   = IMU_intg_reset(state[id].idIntg);
   if (state[id].core < 0 || state[id].pnts < 0 || 
-      state[id].stat < 0 || state[id].calb < 0)
+      state[id].stat < 0 || state[id].calb < 0 || state[id].intg < 0)
     return IMU_ENGN_SUBSYSTEM_FAILURE;
    
   // exit function
@@ -558,14 +870,16 @@ int IMU_engn_setRef(
   if (id >= numInst)
     return IMU_ENGN_BAD_INST;
 
-  // copy contents of input vector
-  config[id].qRef[0]    = ref[0];
-  config[id].qRef[1]    = ref[1];
-  config[id].qRef[2]    = ref[2];
-  config[id].qRef[3]    = ref[3];
+  // copy contents of input vector (published w/ engn config)
+  IMU_engn_snap *cur    = IMU_engn_snapOpen(id);
+  cur->engn.qRef[0]     = ref[0];
+  cur->engn.qRef[1]     = ref[1];
+  cur->engn.qRef[2]     = ref[2];
+  cur->engn.qRef[3]     = ref[3];
   
   // exit function
-  return 0;
+  int status = IMU_engn_snapCommit(id, cur);
+  return (status < 0) ? status : 0;
 }
 
 
@@ -585,18 +899,12 @@ int IMU_engn_setRefCur(
   int                   status;
 
   // get current orientation and pass to setRef
-  status = IMU_core_estmQuat(state[id].idCore, 0, ref);
+  status = backend[id]->estmQuat(state[id].idCore, 0, ref);
   if (status < 0)
     return IMU_ENGN_SUBSYSTEM_FAILURE;
 
-  // copy contents of input vector
-  config[id].qRef[0]    = ref[0];
-  config[id].qRef[1]    = ref[1];
-  config[id].qRef[2]    = ref[2];
-  config[id].qRef[3]    = ref[3];
-  
-  // exit function
-  return 0;
+  // exit function (published w/ engn config)
+  return IMU_engn_setRef(id, ref);
 }
 
 
@@ -613,8 +921,14 @@ int IMU_engn_calbStart(
   if (id >= numInst)
     return IMU_ENGN_BAD_INST;
   
-  // get current orientation and pass to setRef
+  // start from the config in use (not reclaimed while writers are held off)
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&snapLock);
+  #endif
   int status = IMU_calb_start (state[id].idCalb, mode, pntr);
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_unlock(&snapLock);
+  #endif
   if (status < 0)
     return IMU_ENGN_SUBSYSTEM_FAILURE;
   status     = IMU_pnts_start (state[id].idPnts, status);
@@ -636,23 +950,9 @@ int IMU_engn_calbStat(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_ENGN_BAD_INST;
-  
-  // get pointer to stat state
-  IMU_union_state engn_state;
-  int status = IMU_engn_getState(0, IMU_engn_stat, &engn_state); 
-  if (status < 0)
-    return IMU_ENGN_SUBSYSTEM_FAILURE;
 
-  // get current orientation and pass to setRef
-  status     = IMU_calb_stat (state[id].idCalb, engn_state.stat);
-  if (status < 0)
-    return IMU_ENGN_SUBSYSTEM_FAILURE;
-  status     = IMU_calb_save (state[id].idCalb);
-  if (status < 0)
-    return IMU_ENGN_SUBSYSTEM_FAILURE;
-    
-  // exit function (no errors)
-  return 0;
+  // queue operation w/ config snapshot (run by pipeline)
+  return IMU_engn_snapOp(id, IMU_engn_op_calbStat);
 }
 
 
@@ -667,13 +967,8 @@ int IMU_engn_calbSave(
   if (id >= numInst)
     return IMU_ENGN_BAD_INST;
 
-  // get current orientation and pass to setRef
-  int status = IMU_calb_save(state[id].idCalb);
-  if (status < 0)
-    return IMU_ENGN_SUBSYSTEM_FAILURE;
-    
-  // exit function
-  return 0;
+  // queue operation w/ config snapshot (run by pipeline)
+  return IMU_engn_snapOp(id, IMU_engn_op_calbSave);
 }
 
 
@@ -688,13 +983,8 @@ int IMU_engn_calbRevert(
   if (id >= numInst)
     return IMU_ENGN_BAD_INST;
 
-  // get current orientation and pass to setRef
-  int status = IMU_calb_revert(state[id].idCalb);
-  if (status < 0)
-    return IMU_ENGN_SUBSYSTEM_FAILURE;
-    
-  // exit function
-  return 0;
+  // queue operation w/ config snapshot (run by pipeline)
+  return IMU_engn_snapOp(id, IMU_engn_op_calbRevert);
 }
 
 
@@ -712,7 +1002,7 @@ int IMU_engn_datum(
     
   // non-blocking call will add datum to queue
   #if IMU_ENGN_QUEUE_SIZE
-  return IMU_engn_addQueue(id, datum);
+  return IMU_engn_addQueue(id, datum, NULL);
   #else
   return IMU_engn_process(id, datum);
   #endif
@@ -726,43 +1016,77 @@ int IMU_engn_datum(
 int IMU_engn_data3(
   uint16_t              id, 
   IMU_data3             *data3)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_ENGN_BAD_INST;
+
+  // queued given running queue thread (sole pipeline thread of instance)
+  #if IMU_ENGN_QUEUE_SIZE && IMU_USE_PTHREAD
+  if (thrdIsRun)
+    return IMU_engn_addQueue(id, NULL, data3);
+  #endif
+  return IMU_engn_procData3(id, data3);
+}
+
+
+/******************************************************************************
+* internal function - data3 pipeline (synchronized sensors)
+******************************************************************************/
+
+int IMU_engn_procData3(
+  uint16_t              id, 
+  IMU_data3             *data3)
 {
   // define local variables
   IMU_core_FOM          *FOM   = NULL;
   IMU_pnts_entry        *pnt   = NULL;
   IMU_pnts_enum         status;
     
-  // create FOM pointer
-  if (config[id].isStat || config[id].isFOM)
-    FOM = datumFOM;
+  // apply published config and completed calibration solutions
+  IMU_engn_sync(id);
+  uint16_t              stage = plan[id].stage;
+  FOM                   = plan[id].FOM;
 
   // save data to sensor structure
-  if (config[id].isSensorStruct)
+  if (stage & IMU_engn_stage_sensor)
     IMU_copy_data3Raw(id, data3);
 
+  // online magnetometer calibration (raw sample, ahead of rect)
+  if (stage & IMU_engn_stage_calb)
+    state[id].calb = IMU_calb_magn(state[id].idCalb, data3->m);
+
   // update the datum counter
   state[id].datumCount++;
   
   // process datum by subsystems
-  if (config[id].isRect)
+  if (stage & IMU_engn_stage_rect)
     state[id].rect = IMU_rect_data3(state[id].idRect, data3);
-  if (config[id].isPnts) {
+  if (stage & IMU_engn_stage_pnts) {
     state[id].pnts = IMU_pnts_data3(state[id].idPnts, data3, &pnt);
     status         = (IMU_pnts_enum)state[id].pnts;
   } else {
     status         = IMU_pnts_enum_stable;
   }
-  state[id].core   = IMU_core_data3(state[id].idCore, data3, FOM);
-  if (config[id].isCalb && pnt != NULL)
+  int isGated      = 0;
+  if (stage & IMU_engn_stage_gate) {
+    float g[3]     = {data3->g[0], data3->g[1], data3->g[2]};
+    isGated        = IMU_engn_gate(id, IMU_sync, data3->t, g, status);
+  }
+  if (isGated)
+    state[id].gateCount++;
+  else
+    state[id].core = backend[id]->data3(state[id].idCore, data3, FOM);
+  if ((stage & IMU_engn_stage_calb) && pnt != NULL)
     state[id].calb = IMU_calb_point(state[id].idCalb, pnt);
-  if (config[id].isStat)
+  if ((stage & IMU_engn_stage_stat) && !isGated)
     state[id].stat = IMU_stat_data3(state[id].idStat, data3, FOM, status);
   if (state[id].rect < 0 || state[id].pnts < 0 ||
       state[id].core < 0 || state[id].stat < 0)
     return IMU_ENGN_SUBSYSTEM_FAILURE;
     
   // save data to sensor structure
-  if (config[id].isSensorStruct)
+  if (stage & IMU_engn_stage_sensor)
     IMU_copy_results3(id, data3, FOM);
     
   // exit function
@@ -779,22 +1103,85 @@ int IMU_engn_getEstm(
   float                 t,
   IMU_engn_estm         *estm)
 {
-  // get estimates
-  int status = IMU_core_estmQuat(state[id].idCore, t, estm->qOrg);
-  if (config[id].isTran)
-    IMU_core_estmAccl(state[id].idCore, t, estm->tran);
-  if (config[id].isRef)
-    IMU_math_quatMultConj(estm->qOrg, config[id].qRef, estm->q);
-  if (config[id].isAng &&  config[id].isRef)
-    IMU_math_quatToEuler(estm->q, estm->ang);
-  if (config[id].isAng && !config[id].isRef)
-    IMU_math_quatToEuler(estm->qOrg, estm->ang);
-  
-  // exit function
+  // define local variables
+  IMU_engn_cache        *cur = &cache[id];
+  IMU_engn_config       *pub;
+  IMU_engn_config       cfg;
+  unsigned int          version;
+  int                   status;
+
+  // reference and enabled outputs (last published snapshot)
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&snapLock);
+  #endif
+  pub                   = &atomic_load(&snapPub[id])->engn;
+  cfg.isTran            = pub->isTran;
+  cfg.isRef             = pub->isRef;
+  cfg.isAng             = pub->isAng;
+  memcpy(cfg.qRef, pub->qRef, sizeof(cfg.qRef));
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_unlock(&snapLock);
+  #endif
+
+  // core state version (read before the state it tags)
+  status = backend[id]->estmVer(state[id].idCore, &version);
   if (status < 0)
     return status;
-  else
-    return state[id].datumCount;
+
+  // drop outputs derived from an older state or reference
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&cacheLock[id]);
+  #endif
+  if (cur->version != version) {
+    cur->valid          = 0;
+    cur->version        = version;
+  }
+  if (cur->isRef != cfg.isRef ||
+      memcmp(cur->qRef, cfg.qRef, sizeof(cur->qRef)) != 0) {
+    cur->valid         &= ~(IMU_engn_estm_ref | IMU_engn_estm_ang);
+    cur->isRef          = cfg.isRef;
+    memcpy(cur->qRef, cfg.qRef, sizeof(cur->qRef));
+  }
+
+  // derive requested outputs not yet cached (once per state version)
+  if (!(cur->valid & IMU_engn_estm_quat)) {
+    status = backend[id]->estmQuat(state[id].idCore, t, cur->qOrg);
+    if (status < 0) {
+      #if IMU_USE_PTHREAD
+      IMU_thrd_mutex_unlock(&cacheLock[id]);
+      #endif
+      return status;
+    }
+    cur->valid         |= IMU_engn_estm_quat;
+    state[id].estmCount++;
+  }
+  if (cfg.isTran && !(cur->valid & IMU_engn_estm_tran)) {
+    backend[id]->estmAccl(state[id].idCore, t, cur->tran);
+    cur->valid         |= IMU_engn_estm_tran;
+  }
+  if (cfg.isRef && !(cur->valid & IMU_engn_estm_ref)) {
+    IMU_math_quatMultConj(cur->qOrg, cur->qRef, cur->q);
+    cur->valid         |= IMU_engn_estm_ref;
+  }
+  if (cfg.isAng && !(cur->valid & IMU_engn_estm_ang)) {
+    IMU_math_quatToEulerFast(cur->isRef ? cur->q : cur->qOrg, cur->ang);
+    cur->valid         |= IMU_engn_estm_ang;
+  }
+
+  // copy enabled outputs
+  memcpy(estm->qOrg, cur->qOrg, sizeof(estm->qOrg));
+  if (cfg.isTran)
+    memcpy(estm->tran, cur->tran, sizeof(estm->tran));
+  if (cfg.isRef)
+    memcpy(estm->q,    cur->q,    sizeof(estm->q));
+  if (cfg.isAng)
+    memcpy(estm->ang,  cur->ang,  sizeof(estm->ang));
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_unlock(&cacheLock[id]);
+  #endif
+  
+  // exit function
+  return state[id].datumCount;
 }
 
 
@@ -813,19 +1200,25 @@ void* IMU_engn_run(
   // define local variables
   uint16_t              id;
   IMU_datum             datum;
+  IMU_data3             data3;
 
-  // main processing loop
+  // main processing loop (pipeline thread of every instance)
   thrdIsExit            = 0;
   while(!thrdExit) {
   
-    // wait until queue contains datum
-    while (queue.count == 0)
+    // wait until queue contains datum (config/solutions applied while idle)
+    while (queue.count == 0) {
+      for (id=0; id<numInst; id++)
+        IMU_engn_sync(id);
       usleep(sleepTime);
+    }
     
     // remove datum from queue
     IMU_thrd_mutex_lock(&thrdLock);
     id                  = queue.id[queue.first];
     memcpy(&datum, &queue.datum[queue.first], sizeof(IMU_datum));
+    if (datum.type == IMU_sync)
+      memcpy(&data3, &queue.data3[queue.first], sizeof(IMU_data3));
     queue.count         = queue.count - 1;
     queue.first         = queue.first + 1;
     if (queue.first >= IMU_ENGN_QUEUE_SIZE)
@@ -833,7 +1226,10 @@ void* IMU_engn_run(
     IMU_thrd_mutex_unlock(&thrdLock);
           
     // process datum
-    IMU_engn_process(id, &datum);
+    if (datum.type == IMU_sync)
+      IMU_engn_procData3(id, &data3);
+    else
+      IMU_engn_process(id, &datum);
   }
   thrdIsExit            = 1;
   return NULL;
@@ -848,7 +1244,8 @@ void* IMU_engn_run(
 #if IMU_ENGN_QUEUE_SIZE
 int IMU_engn_addQueue( 
   uint16_t		id,
-  IMU_datum             *datum)
+  IMU_datum             *datum,
+  IMU_data3             *data3)
 {
   // define local variables
   int                   status = 0;
@@ -872,7 +1269,12 @@ int IMU_engn_addQueue(
     queue.last          = 0;
   int idx               = queue.last;
   queue.id[idx]         = id;
-  memcpy(&queue.datum[idx], datum, sizeof(IMU_datum));
+  if (data3 != NULL) {
+    queue.datum[idx].type = IMU_sync;
+    memcpy(&queue.data3[idx], data3, sizeof(IMU_data3));
+  } else {
+    memcpy(&queue.datum[idx], datum, sizeof(IMU_datum));
+  }
   
   // exiting critical section
   IMU_thrd_mutex_unlock(&thrdLock);
@@ -887,43 +1289,130 @@ int IMU_engn_addQueue(
 
 
 /******************************************************************************
-* internal function - processes one datum
+* internal function - processes one datum (compiled pipeline)
 ******************************************************************************/
 
 int IMU_engn_process(
   uint16_t              id, 
   IMU_datum             *datum)
+{
+  // apply published config and completed calibration solutions
+  IMU_engn_sync(id);
+  return plan[id].process(id, datum);
+}
+
+
+/******************************************************************************
+* internal function - core only pipeline (no enabled subsystem stages)
+******************************************************************************/
+
+int IMU_engn_procCore(
+  uint16_t              id, 
+  IMU_datum             *datum)
+{
+  state[id].core = backend[id]->datum(state[id].idCore, datum, plan[id].FOM);
+  state[id].datumCount++;
+  if (state[id].core < 0)
+    return IMU_ENGN_SUBSYSTEM_FAILURE;
+  else
+    return 0;
+}
+
+
+/******************************************************************************
+* internal function - rect and core pipeline
+******************************************************************************/
+
+int IMU_engn_procRect(
+  uint16_t              id, 
+  IMU_datum             *datum)
+{
+  state[id].rect = IMU_rect_datum(state[id].idRect, datum);
+  state[id].core = backend[id]->datum(state[id].idCore, datum, plan[id].FOM);
+  state[id].datumCount++;
+  if (state[id].rect < 0 || state[id].core < 0)
+    return IMU_ENGN_SUBSYSTEM_FAILURE;
+  else
+    return 0;
+}
+
+
+/******************************************************************************
+* internal function - full pipeline (stages selected by compiled mask)
+******************************************************************************/
+
+int IMU_engn_procFull(
+  uint16_t              id, 
+  IMU_datum             *datum)
 {
   // define local variables
-  IMU_core_FOM          *FOM   = NULL;
+  IMU_core_FOM          *FOM   = plan[id].FOM;
   IMU_pnts_entry        *pnt   = NULL;
   IMU_pnts_enum         status;
-    
-  // create FOM pointer
-  if (config[id].isStat || config[id].isFOM)
-    FOM = datumFOM;
+  uint16_t              stage  = plan[id].stage;
 
-  // save data to sensor structure
-  if (config[id].isSensorStruct)
+  // save data to sensor structure (raw sample, not the increment rate)
+  if (stage & IMU_engn_stage_sensor)
     IMU_copy_datumRaw(id, datum);
+
+  // pre-integrate gyroscope (passes one datum per increment)
+  int                   isIncr = 0;
+  if ((stage & IMU_engn_stage_intg) && datum->type == IMU_gyro) {
+    state[id].intg = IMU_engn_preIntg(id, datum);
+    if (state[id].intg < 0)
+      return IMU_ENGN_SUBSYSTEM_FAILURE;
+    if (state[id].intg == IMU_intg_enum_accum)
+      return 0;
+    isIncr         = 1;
+  }
+
+  // gyroscope rate in counts (increment keeps its unquantized mean rate)
+  float                 g[3];
+  float                 *gRate = NULL;
+  if (isIncr) {
+    float gScale   = state[id].configCore->gScale;
+    g[0]           = incr[id].g[0] / gScale;
+    g[1]           = incr[id].g[1] / gScale;
+    g[2]           = incr[id].g[2] / gScale;
+    gRate          = g;
+  } else if (datum->type == IMU_gyro && (stage & IMU_engn_stage_gate)) {
+    g[0]           = datum->val[0];
+    g[1]           = datum->val[1];
+    g[2]           = datum->val[2];
+    gRate          = g;
+  }
+
+  // online magnetometer calibration (raw sample, ahead of rect)
+  if ((stage & IMU_engn_stage_calb) && datum->type == IMU_magn)
+    state[id].calb = IMU_calb_magn(state[id].idCalb, datum->val);
   
   // process datum by subsystems
-  if (config[id].isRect)
+  if ((stage & IMU_engn_stage_rect) && !isIncr)
     state[id].rect = IMU_rect_datum(state[id].idRect, datum);
-  if (config[id].isPnts) {
+  if (stage & IMU_engn_stage_pnts) {
     state[id].pnts = IMU_pnts_datum(state[id].idPnts, datum, &pnt);
     status         = (IMU_pnts_enum)state[id].pnts;
   } else {
     status         = IMU_pnts_enum_move;
   }
-  state[id].core   = IMU_core_datum(state[id].idCore, datum, FOM);
-  if (config[id].isCalb && pnt != NULL)
+  int isGated      = (stage & IMU_engn_stage_gate) &&
+                     IMU_engn_gate(id, datum->type, datum->t, gRate, status);
+  if      (isGated)
+    state[id].gateCount++;
+  else if (isIncr)
+    state[id].core = backend[id]->delta(state[id].idCore, incr[id].t,
+                       incr[id].dq, incr[id].g, FOM);
+  else
+    state[id].core = backend[id]->datum(state[id].idCore, datum, FOM);
+  if ((stage & IMU_engn_stage_calb) && pnt != NULL)
     state[id].calb = IMU_calb_point(state[id].idCalb, pnt);
-  if (config[id].isStat && FOM != NULL)
+  if ((stage & IMU_engn_stage_stat) && FOM != NULL && !isGated && isIncr)
+    state[id].stat = IMU_stat_rate(state[id].idStat, datum->t, gRate, FOM);
+  else if ((stage & IMU_engn_stage_stat) && FOM != NULL && !isGated)
     state[id].stat = IMU_stat_datum(state[id].idStat, datum, FOM, status);
     
   // save data to sensor structure
-  if (config[id].isSensorStruct)
+  if (stage & IMU_engn_stage_sensor)
     IMU_copy_results1(id, datum, FOM);
 
   // update the datum counter
@@ -938,6 +1427,38 @@ int IMU_engn_process(
 }
 
 
+/******************************************************************************
+* internal function - rectifies and accumulates one gyroscope datum, once
+* the increment is complete the datum is replaced by its mean rate (rounded
+* for pnts and sensor outputs, gate and stat use the float rate in incr)
+******************************************************************************/
+
+int IMU_engn_preIntg(
+  uint16_t              id,
+  IMU_datum             *datum)
+{
+  // rectify datum and convert to rad/sec
+  if (plan[id].stage & IMU_engn_stage_rect)
+    state[id].rect = IMU_rect_datum(state[id].idRect, datum);
+  float gScale          = state[id].configCore->gScale;
+  float g[3]            = {(float)datum->val[0] * gScale,
+                           (float)datum->val[1] * gScale,
+                           (float)datum->val[2] * gScale};
+
+  // accumulate datum into current increment
+  int status = IMU_intg_gyro(state[id].idIntg, datum->t, g, &incr[id]);
+  if (status != IMU_intg_enum_ready)
+    return status;
+
+  // pass mean rate (rectified units) to remaining subsystems
+  datum->t              = incr[id].t;
+  datum->val[0]         = (IMU_TYPE)lrintf(incr[id].g[0] / gScale);
+  datum->val[1]         = (IMU_TYPE)lrintf(incr[id].g[1] / gScale);
+  datum->val[2]         = (IMU_TYPE)lrintf(incr[id].g[2] / gScale);
+  return status;
+}
+
+
 /******************************************************************************
 * internal function - processes one datum
 ******************************************************************************/
@@ -985,7 +1506,7 @@ int IMU_copy_results1(
   // get IMU_pnts state
   IMU_union_state       unionState;
   IMU_pnts_state        *pntsState;
-  if (config[id].isPnts && state[id].configPnts->enable) {
+  if (config[id]->isPnts && state[id].configPnts->enable) {
     IMU_engn_getState(id, IMU_engn_pnts, &unionState);
     pntsState = unionState.pnts;
   }
@@ -995,11 +1516,11 @@ int IMU_copy_results1(
 
   // copy gyroscope info
   if        (datum->type == IMU_gyro) {
-    if (config[id].isRect && state[id].configRect->enable)
+    if (config[id]->isRect && state[id].configRect->enable)
       memcpy(sensor[id].gCor, datum->val, sizeof(sensor[id].gCor));
     else
       memset(sensor[id].gCor, 0, 3*sizeof(float));
-    if (config[id].isPnts && state[id].configPnts->enable)
+    if (config[id]->isPnts && state[id].configPnts->enable)
       memcpy(sensor[id].gFlt, pntsState->current->gFltr, 3*sizeof(float));
     else
       memset(sensor[id].gFlt, 0, 3*sizeof(float));
@@ -1010,11 +1531,11 @@ int IMU_copy_results1(
       
   // copy accelerometer info
   } else if (datum->type == IMU_accl) {
-    if (config[id].isRect && state[id].configRect->enable)
+    if (config[id]->isRect && state[id].configRect->enable)
       memcpy(sensor[id].aCor, datum->val, sizeof(sensor[id].aCor));
     else
       memset(sensor[id].aCor, 0, 3*sizeof(float));
-    if (config[id].isPnts && state[id].configPnts->enable)
+    if (config[id]->isPnts && state[id].configPnts->enable)
       memcpy(sensor[id].aFlt, pntsState->current->aFltr, 3*sizeof(float));
     else
       memset(sensor[id].aFlt, 0, 3*sizeof(float));
@@ -1025,11 +1546,11 @@ int IMU_copy_results1(
       
   // copy magnetometer info
   } else if (datum->type == IMU_magn) {
-    if (config[id].isRect && state[id].configRect->enable)
+    if (config[id]->isRect && state[id].configRect->enable)
       memcpy(sensor[id].mCor, datum->val, sizeof(sensor[id].mCor));
     else
       memset(sensor[id].mCor, 0, 3*sizeof(float));
-    if (config[id].isPnts && state[id].configPnts->enable)
+    if (config[id]->isPnts && state[id].configPnts->enable)
       memcpy(sensor[id].mFlt, pntsState->current->mFltr, 3*sizeof(float));
     else
       memset(sensor[id].mFlt, 0, 3*sizeof(float));
@@ -1056,7 +1577,7 @@ int IMU_copy_results3(
   // get IMU_pnts state
   IMU_union_state       unionState;
   IMU_pnts_state        *pntsState;
-  if (config[id].isPnts) {
+  if (config[id]->isPnts) {
     IMU_engn_getState(id, IMU_engn_pnts, &unionState);
     pntsState = unionState.pnts;
   }
@@ -1065,7 +1586,7 @@ int IMU_copy_results3(
   sensor[id].time = data3->t;
 
   // copy rectified data
-  if (config[id].isRect && state[id].configRect->enable) {
+  if (config[id]->isRect && state[id].configRect->enable) {
     memcpy(sensor[id].gCor, data3->g, sizeof(sensor[id].gCor));
     memcpy(sensor[id].aCor, data3->a, sizeof(sensor[id].aCor));
     memcpy(sensor[id].mCor, data3->m, sizeof(sensor[id].mCor));
@@ -1076,7 +1597,7 @@ int IMU_copy_results3(
   }
 
   // copy filtered data
-  if (config[id].isPnts && state[id].configPnts->enable) {
+  if (config[id]->isPnts && state[id].configPnts->enable) {
     memcpy(sensor[id].aFlt, pntsState->current->aFltr, 3*sizeof(float));
     memcpy(sensor[id].gFlt, pntsState->current->gFltr, 3*sizeof(float));
     memcpy(sensor[id].mFlt, pntsState->current->mFltr, 3*sizeof(float));
@@ -1111,14 +1632,368 @@ int IMU_engn_typeCheck(
   uint16_t              id, 
   IMU_engn_system       system)
 {
-  if (system == IMU_engn_rect && !config[id].isRect)
+  if (system == IMU_engn_rect && !config[id]->isRect)
     return IMU_ENGN_UNINITIALIZE_SYS;
-  if (system == IMU_engn_pnts && !config[id].isPnts)
+  if (system == IMU_engn_pnts && !config[id]->isPnts)
     return IMU_ENGN_UNINITIALIZE_SYS;
-  if (system == IMU_engn_stat && !config[id].isStat)
+  if (system == IMU_engn_stat && !config[id]->isStat)
     return IMU_ENGN_UNINITIALIZE_SYS;
-  if (system == IMU_engn_calb && !config[id].isCalb)
+  if (system == IMU_engn_calb && !config[id]->isCalb)
     return IMU_ENGN_UNINITIALIZE_SYS;    
   return 0;
 }
 
+
+/******************************************************************************
+* internal function - select core backend from configured filter
+******************************************************************************/
+
+int IMU_engn_setBackend(
+  uint16_t              id)
+{
+  if (config[id]->filter >= numBackend) {
+    backend[id]         = &backendList[IMU_engn_madgwick];
+    return IMU_ENGN_BAD_FILTER;
+  }
+  backend[id]           = &backendList[config[id]->filter];
+  return 0;
+}
+
+
+/******************************************************************************
+* internal function - compiles config into the datum plan (enabled stage
+* mask, FOM output, gate limit in counts, core FOM thresholds, and pipeline
+* w/o disabled stages)
+******************************************************************************/
+
+int IMU_engn_compile(
+  uint16_t              id)
+{
+  // define local variables
+  IMU_engn_plan         *cur   = &plan[id];
+  float                 gScale = state[id].configCore->gScale;
+  uint16_t              prev   = cur->stage;
+  uint16_t              stage  = 0;
+
+  // enabled stages (disabled subsystems never called)
+  if (config[id]->isRect && state[id].configRect->enable)
+    stage              |= IMU_engn_stage_rect;
+  if (config[id]->isPnts)
+    stage              |= IMU_engn_stage_pnts;
+  if (config[id]->isStat)
+    stage              |= IMU_engn_stage_stat;
+  if (config[id]->isCalb)
+    stage              |= IMU_engn_stage_calb;
+  if (config[id]->isIntg && state[id].configIntg->enable)
+    stage              |= IMU_engn_stage_intg;
+  if (config[id]->isGate && config[id]->isPnts &&
+      state[id].configPnts->enable)
+    stage              |= IMU_engn_stage_gate;
+  if (config[id]->isSensorStruct)
+    stage              |= IMU_engn_stage_sensor;
+  cur->stage            = stage;
+
+  // skipped rect reports disabled, gate restarts from the next gyro datum
+  if (config[id]->isRect && !state[id].configRect->enable)
+    state[id].rect      = IMU_RECT_FNC_DISABLED;
+  if ((stage & IMU_engn_stage_gate) && !(prev & IMU_engn_stage_gate))
+    gateRate[id]        = INFINITY;
+
+  // FOM output and gate limit (rate compared in counts)
+  cur->FOM              = (config[id]->isStat || config[id]->isFOM) ?
+                          datumFOM : NULL;
+  if (gScale != 0.0f)
+    cur->gGateSqrd      = (config[id]->gGate / gScale) *
+                          (config[id]->gGate / gScale);
+  else
+    cur->gGateSqrd      = INFINITY;
+
+  // core threshold reciprocals
+  IMU_core_compile(state[id].idCore);
+
+  // select pipeline
+  if      (stage == 0)
+    cur->process        = IMU_engn_procCore;
+  else if (stage == IMU_engn_stage_rect)
+    cur->process        = IMU_engn_procRect;
+  else
+    cur->process        = IMU_engn_procFull;
+  return 0;
+}
+
+
+/******************************************************************************
+* internal function - motion gate, returns one when a stationary datum
+* bypasses the core (accl/magn still applied once per tGate interval), only
+* called given the compiled gate stage
+******************************************************************************/
+
+int IMU_engn_gate(
+  uint16_t              id,
+  IMU_sensor            type,
+  uint32_t              t,
+  float                 *g,
+  IMU_pnts_enum         status)
+{
+  // track gyroscope rate (counts, limit compiled w/ gScale folded in)
+  if (g != NULL)
+    gateRate[id]        = g[0]*g[0] + g[1]*g[1] + g[2]*g[2];
+
+  // full rate fusion while moving (restarts correction interval)
+  if (status != IMU_pnts_enum_stable || gateRate[id] > plan[id].gGateSqrd) {
+    gateTime[id][type]  = t;
+    return 0;
+  }
+
+  // periodic accelerometer/magnetometer correction
+  if (type != IMU_gyro && config[id]->tGate > 0 &&
+      t - gateTime[id][type] >= config[id]->tGate) {
+    gateTime[id][type]  = t;
+    return 0;
+  }
+
+  // advance gyroscope time base only (core skipped, no rotation or bias
+  // estimated while stationary, bias left to rect/calb stable points)
+  if (type == IMU_gyro || type == IMU_sync)
+    IMU_core_advance(state[id].idCore, t);
+  return 1;
+}
+
+
+/******************************************************************************
+* internal function - pipeline side of config publication, reads through the
+* last published snapshot (one atomic load given none) after running queued
+* calibration operations, recompiles the plan only when a snapshot is
+* applied, then applies calibration solutions
+******************************************************************************/
+
+int IMU_engn_sync(
+  uint16_t              id)
+{
+  // last published snapshot (calibration operations publish their own)
+  IMU_engn_snap *cur    = atomic_load_explicit(&snapPub[id],
+                                               memory_order_acquire);
+  if (cur->opEnd != opDone[id])
+    cur                 = IMU_engn_snapCalb(id);
+
+  // point subsystems at the newly published snapshot
+  if (cur != atomic_load_explicit(&snapUse[id], memory_order_relaxed)) {
+    cur                 = IMU_engn_snapTake(id, cur);
+    IMU_engn_snapPoint(id, cur);
+    IMU_engn_setBackend(id);
+    IMU_engn_compile(id);
+    state[id].configVersion = cur->version;
+  }
+
+  // swap in completed calibration solutions
+  if (config[id]->isCalb)
+    IMU_calb_poll(state[id].idCalb);
+  return 0;
+}
+
+
+/******************************************************************************
+* internal function - opens snapshot for writing (free slot seeded from the
+* last published, returns w/ writers held off until the commit)
+******************************************************************************/
+
+IMU_engn_snap* IMU_engn_snapOpen(
+  uint16_t              id)
+{
+  // serialize writers
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_lock(&snapLock);
+  #endif
+
+  // copy last published snapshot to free slot
+  IMU_engn_snap *pub    = atomic_load(&snapPub[id]);
+  IMU_engn_snap *cur    = IMU_engn_snapFree(id, pub);
+  memcpy(cur, pub, sizeof(IMU_engn_snap));
+  return cur;
+}
+
+
+/******************************************************************************
+* internal function - publishes snapshot w/ one atomic pointer store (read by
+* the pipeline from its next datum, never applied by the writer)
+******************************************************************************/
+
+int IMU_engn_snapCommit(
+  uint16_t              id,
+  IMU_engn_snap         *cur)
+{
+  // assign version and publish
+  unsigned int version  = ++snapVer[id];
+  cur->version          = version;
+  atomic_store(&snapPub[id], cur);
+
+  // release writers
+  #if IMU_USE_PTHREAD
+  IMU_thrd_mutex_unlock(&snapLock);
+  #endif
+  return (int)version;
+}
+
+
+/******************************************************************************
+* internal function - queues calibration operation w/ a new snapshot (op
+* sequence carried by every later snapshot, run once by the pipeline)
+******************************************************************************/
+
+int IMU_engn_snapOp(
+  uint16_t              id,
+  IMU_engn_op           op)
+{
+  // check for calibration subsystem
+  if (!config[id]->isCalb)
+    return IMU_ENGN_UNINITIALIZE_SYS;
+
+  // check operation overflow (requested but not yet run)
+  IMU_engn_snap *cur    = IMU_engn_snapOpen(id);
+  if (cur->opEnd - opDone[id] >= IMU_ENGN_SNAP_OPS) {
+    #if IMU_USE_PTHREAD
+    IMU_thrd_mutex_unlock(&snapLock);
+    #endif
+    return IMU_ENGN_QUEUE_OVERFLOW;
+  }
+
+  // append operation and publish
+  snapOp[id][cur->opEnd % IMU_ENGN_SNAP_OPS] = op;
+  cur->opEnd++;
+  int status = IMU_engn_snapCommit(id, cur);
+  return (status < 0) ? status : 0;
+}
+
+
+/******************************************************************************
+* internal function - slot neither published nor read by the pipeline (three
+* slots, called w/ writers held off)
+******************************************************************************/
+
+IMU_engn_snap* IMU_engn_snapFree(
+  uint16_t              id,
+  IMU_engn_snap         *pub)
+{
+  IMU_engn_snap *use    = atomic_load(&snapUse[id]);
+  IMU_engn_snap *cur    = &snap[id][0];
+  while (cur == pub || cur == use)
+    cur++;
+  return cur;
+}
+
+
+/******************************************************************************
+* internal function - announces the snapshot read by the pipeline then
+* confirms it is still published (writers never reclaim the announced slot,
+* the previous one is released by the same store)
+******************************************************************************/
+
+IMU_engn_snap* IMU_engn_snapTake(
+  uint16_t              id,
+  IMU_engn_snap         *cur)
+{
+  IMU_engn_snap         *pub;
+  while (1) {
+    atomic_store(&snapUse[id], cur);
+    pub                 = atomic_load(&snapPub[id]);
+    if (pub == cur)
+      return cur;
+    cur                 = pub;
+  }
+}
+
+
+/******************************************************************************
+* internal function - runs queued calibration operations on a copy of the
+* last published snapshot and publishes it (pipeline side, writers held off)
+******************************************************************************/
+
+IMU_engn_snap* IMU_engn_snapCalb(
+  uint16_t              id)
+{
+  // define local variables
+  IMU_union_state       stat;
+  IMU_engn_snap         *cur;
+  uint8_t               op;
+
+  // solutions saved to (and reverted from) the copy
+  cur                   = IMU_engn_snapOpen(id);
+  IMU_calb_setStruct(state[id].idCalb, &cur->rect, &cur->core);
+
+  // calibration operations (in request order)
+  for (; opDone[id] != cur->opEnd; opDone[id]++) {
+    op                  = snapOp[id][opDone[id] % IMU_ENGN_SNAP_OPS];
+    if (op == IMU_engn_op_calbStat) {
+      IMU_engn_getState(id, IMU_engn_stat, &stat);
+      IMU_calb_stat(state[id].idCalb, stat.stat);
+      IMU_calb_save(state[id].idCalb);
+    } else if (op == IMU_engn_op_calbSave) {
+      IMU_calb_save(state[id].idCalb);
+    } else if (op == IMU_engn_op_calbRevert) {
+      IMU_calb_revert(state[id].idCalb);
+    }
+  }
+
+  // publish copy (read through by the caller)
+  IMU_engn_snapCommit(id, cur);
+  return cur;
+}
+
+
+/******************************************************************************
+* internal function - points engine and subsystems at snapshot structures
+******************************************************************************/
+
+void IMU_engn_snapPoint(
+  uint16_t              id,
+  IMU_engn_snap         *cur)
+{
+  IMU_engn_state        *sys = &state[id];
+  config[id]            = &cur->engn;
+  sys->configCore       = &cur->core;
+  IMU_core_setConfig(sys->idCore, &cur->core);
+  if (config[id]->isRect) {
+    sys->configRect     = &cur->rect;
+    IMU_rect_setConfig(sys->idRect, &cur->rect);
+  }
+  if (config[id]->isPnts) {
+    sys->configPnts     = &cur->pnts;
+    IMU_pnts_setConfig(sys->idPnts, &cur->pnts);
+  }
+  if (config[id]->isStat) {
+    sys->configStat     = &cur->stat;
+    IMU_stat_setConfig(sys->idStat, &cur->stat);
+  }
+  if (config[id]->isCalb) {
+    sys->configCalb     = &cur->calb;
+    IMU_calb_setConfig(sys->idCalb, &cur->calb);
+    IMU_calb_setStruct(sys->idCalb, &cur->rect, &cur->core);
+  }
+  sys->configIntg       = &cur->intg;
+  IMU_intg_setConfig(sys->idIntg, &cur->intg);
+}
+
+
+/******************************************************************************
+* internal function - pointer to snapshot copy of subsystem config
+******************************************************************************/
+
+void* IMU_engn_snapStruct(
+  IMU_engn_snap         *cur,
+  IMU_engn_system       system)
+{
+  if      (system == IMU_engn_core)
+    return &cur->core;
+  else if (system == IMU_engn_rect)
+    return &cur->rect;
+  else if (system == IMU_engn_pnts)
+    return &cur->pnts;
+  else if (system == IMU_engn_stat)
+    return &cur->stat;
+  else if (system == IMU_engn_calb)
+    return &cur->calb;
+  else if (system == IMU_engn_self)
+    return &cur->engn;
+  else
+    return &cur->intg;
+}
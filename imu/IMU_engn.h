@@ -32,6 +32,7 @@ extern "C" {
 #include "IMU_pnts.h"
 #include "IMU_stat.h"
 #include "IMU_calb.h"
+#include "IMU_intg.h"
 
 // define error codes
 #define IMU_ENGN_INST_OVERFLOW           -1
@@ -46,6 +47,12 @@ extern "C" {
 #define IMU_ENGN_FAILED_THREAD           -10
 #define IMU_ENGN_FAILED_MUTEX            -11
 #define IMU_ENGN_QUEUE_OVERFLOW          -12
+#define IMU_ENGN_BAD_FILTER              -13
+#define IMU_ENGN_CONFIG_TIMEOUT          -14
+
+// define constants
+#define IMU_ENGN_SNAP_OPS                4      // pending calb ops
+#define IMU_ENGN_SYNC_WAIT               50000  // syncConfig polls (~1 sec)
 
 
 // configuration structure definition
@@ -54,17 +61,23 @@ typedef struct {
   uint8_t               isPnts;              // enable stable point collection
   uint8_t               isStat;              // enable continous metric collect
   uint8_t               isCalb;              // enable calibration subsystem 
+  uint8_t               isIntg;              // enable gyro pre-integration
+  uint8_t               isGate;              // bypass core while stationary
   uint8_t               isFOM;               // disable calculation of FOMs
   uint8_t               isTran;              // enable accl estm (minus gravity)
   uint8_t               isRef;               // disable application of reference
   uint8_t               isAng;               // disable Euler angles conversion
   uint8_t               isSensorStruct;      // enable storage of sensor data
+  uint8_t               filter;              // core filter (madgwick/mahony)
+  uint32_t              tGate;               // stationary correction interval
+  float                 gGate;               // max gated gyro rate (rad/sec)
   float                 qRef[4];             // quaternion reference
   char                  configFileCore[64];  // core config filneame
   char                  configFileRect[64];  // rect config filename
   char                  configFilePnts[64];  // pnts config filename
   char                  configFileStat[64];  // stat config filename
   char                  configFileCalb[64];  // calb config filename
+  char                  configFileIntg[64];  // intg config filename
 } IMU_engn_config;
 
 // system state structure definition
@@ -74,17 +87,23 @@ typedef struct {
   uint16_t                idPnts;            // pnts subsystem id
   uint16_t                idStat;            // stat subsystem id
   uint16_t                idCalb;            // calb subsystem id
+  uint16_t                idIntg;            // intg subsystem id
   IMU_core_config         *configCore;       // core configuration pointer
   IMU_rect_config         *configRect;       // rect configuration pointer
   IMU_pnts_config         *configPnts;       // pnts configuration pointer
   IMU_stat_config         *configStat;       // stat configuration pointer
   IMU_calb_config         *configCalb;       // calb configuration pointer
+  IMU_intg_config         *configIntg;       // intg configuration pointer
   int                     core;              // status of IMU core
   int                     rect;              // status of IMU rect
   int                     pnts;              // status of IMU pnts
   int                     stat;              // status of IMU stat
   int                     calb;              // status of IMU calb
+  int                     intg;              // status of IMU intg
   unsigned int            datumCount;        // datum counter
+  unsigned int            gateCount;         // datum bypassing core (gated)
+  unsigned int            configVersion;     // applied config snapshot
+  unsigned int            estmCount;         // estimate cache refreshes
 } IMU_engn_state;
 
 // define which subsystems are running
@@ -96,6 +115,25 @@ typedef enum {                               // input to IMU_engn_init
   IMU_engn_calb_full      = 4                // all susbsystems running
 } IMU_engn_type;
 
+// core backend (orientation filter) selection
+typedef enum {                               // IMU_engn_config filter
+  IMU_engn_madgwick       = 0,               // gradient descent (default)
+  IMU_engn_mahony         = 1                // PI complementary (cheaper)
+} IMU_engn_core_filter;
+
+// core backend function table (backends share the core config and state)
+typedef struct {
+  int (*init)     (uint16_t *id, IMU_core_config **config);
+  int (*reset)    (uint16_t id);
+  int (*datum)    (uint16_t id, IMU_datum*, IMU_core_FOM*);
+  int (*data3)    (uint16_t id, IMU_data3*, IMU_core_FOM*);
+  int (*delta)    (uint16_t id, uint32_t t, float *dq, float *g,
+                   IMU_core_FOM*);
+  int (*estmQuat) (uint16_t id, uint32_t t, float *estm);
+  int (*estmAccl) (uint16_t id, uint32_t t, float *estm);
+  int (*estmVer)  (uint16_t id, unsigned int *version);
+} IMU_engn_backend;
+
 // input to multiple functions
 typedef enum {
   IMU_engn_core           = 0,
@@ -103,7 +141,8 @@ typedef enum {
   IMU_engn_pnts           = 2,
   IMU_engn_stat           = 3,
   IMU_engn_calb           = 4,
-  IMU_engn_self           = 5
+  IMU_engn_self           = 5,
+  IMU_engn_intg           = 6
 } IMU_engn_system;
 
 // input to IMU_engn_getConfig
@@ -114,6 +153,7 @@ typedef union {
   IMU_stat_config         *stat;
   IMU_calb_config         *calb;
   IMU_engn_config         *engn;
+  IMU_intg_config         *intg;
 } IMU_union_config;
 
 // input to IMU_engn_getState
@@ -123,6 +163,7 @@ typedef union {
   IMU_stat_state          *stat;
   IMU_calb_state          *calb;
   IMU_engn_state          *engn;
+  IMU_intg_state          *intg;
 } IMU_union_state;
 
 // sensor data structure 
@@ -155,7 +196,10 @@ typedef struct {
 int IMU_engn_init         (IMU_engn_type, uint16_t *id);
 int IMU_engn_getSysID     (uint16_t id, IMU_engn_system, uint16_t *sysID);
 int IMU_engn_getConfig    (uint16_t id, IMU_engn_system, IMU_union_config*);
+int IMU_engn_copyConfig   (uint16_t id, IMU_engn_system, IMU_union_config*);
 int IMU_engn_getState     (uint16_t id, IMU_engn_system, IMU_union_state*);
+int IMU_engn_setConfig    (uint16_t id, IMU_engn_system, IMU_union_config*);
+int IMU_engn_syncConfig   (uint16_t id);
 int IMU_engn_getSensor    (uint16_t id, IMU_engn_sensor**);
 int IMU_engn_setCalbFnc   (uint16_t id, void (*fnc)(IMU_CALB_FNC_ARG), void*);
 int IMU_engn_setStableFnc (uint16_t id, void (*fnc)(IMU_PNTS_FNC_ARG), void*);
@@ -0,0 +1,368 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// header-only C++ engine w/ the pipeline fixed at compile time (C++17),
+// stages absent from the template mask generate no code, each datum runs
+// the same subsystem calls in the same order as IMU_engn_process (results
+// are bit-identical for the same config and stream)
+
+#ifndef _IMU_ENGN_HPP
+#define _IMU_ENGN_HPP
+
+// include statements
+#include <type_traits>
+#include "IMU_engn.h"
+#include "IMU_math.h"
+
+namespace IMU {
+
+// pipeline stages (template mask)
+enum : unsigned {
+  stage_rect            = 0x01,              // rectify raw datum
+  stage_pnts            = 0x02,              // stable point collection
+  stage_stat            = 0x04,              // continous metric collection
+  stage_calb            = 0x08,              // calibration (requires rect)
+  stage_FOM             = 0x10,              // core figures of merit
+  stage_tran            = 0x20,              // accl estm (minus gravity)
+  stage_ref             = 0x40,              // apply reference quaternion
+  stage_ang             = 0x80               // Euler angles conversion
+};
+
+// sensor set (template mask, datum of other sensors are dropped)
+enum : unsigned {
+  sensor_gyro           = 0x1,
+  sensor_accl           = 0x2,
+  sensor_magn           = 0x4,
+  sensor_all            = 0x7
+};
+
+
+/******************************************************************************
+* engine template - owns one instance of each enabled subsystem (move-only,
+* the library instances are static so a copy would alias them)
+******************************************************************************/
+
+template <typename Type             = IMU_TYPE,
+          unsigned Stages           = 0,
+          unsigned Sensors          = sensor_all,
+          IMU_engn_core_filter Filter = IMU_engn_madgwick>
+class engn
+{
+  static_assert(std::is_same<Type, IMU_TYPE>::value,
+                "Type must match the library build (IMU_TYPE)");
+  static_assert(!(Stages & stage_calb) || (Stages & stage_rect),
+                "calb stage requires the rect stage");
+  static_assert(Sensors != 0 && !(Sensors & ~sensor_all),
+                "invalid sensor set");
+
+  public:
+    engn();
+    engn(const engn&)            = delete;
+    engn& operator=(const engn&) = delete;
+    engn(engn&& src) noexcept              { take(src); }
+    engn& operator=(engn&& src) noexcept   { take(src); return *this; }
+    ~engn()                                = default;
+
+    // construction status (negative given subsystem failure)
+    int    status() const                  { return init; }
+
+    // config access (same structures as IMU_engn_getConfig, core FOM
+    // thresholds take effect on reset)
+    IMU_core_config  *core()               { return configCore; }
+    IMU_rect_config  *rect()               { static_assert(has(stage_rect));
+                                             return configRect; }
+    IMU_pnts_config  *pnts()               { static_assert(has(stage_pnts));
+                                             return configPnts; }
+    IMU_stat_config  *stat()               { static_assert(has(stage_stat));
+                                             return configStat; }
+    IMU_calb_config  *calb()               { static_assert(has(stage_calb));
+                                             return configCalb; }
+    uint16_t         sysID(IMU_engn_system system) const;
+    unsigned int     datumCount() const    { return count; }
+
+    // system control and state update/estimation functions
+    int    reset();
+    int    setRef(const float *ref);
+    int    process(IMU_datum *datum);
+    int    process(IMU_data3 *data3);
+    int    getEstm(float t, IMU_engn_estm *estm);
+
+  private:
+    static constexpr bool has(unsigned stage) { return Stages & stage; }
+    void   take(engn &src);
+
+    // owned subsystem instances
+    uint16_t             idCore = 0, idRect = 0, idPnts = 0;
+    uint16_t             idStat = 0, idCalb = 0;
+    IMU_core_config      *configCore = nullptr;
+    IMU_rect_config      *configRect = nullptr;
+    IMU_pnts_config      *configPnts = nullptr;
+    IMU_stat_config      *configStat = nullptr;
+    IMU_calb_config      *configCalb = nullptr;
+
+    // engine state
+    int                  init  = 0;
+    unsigned int         count = 0;
+    float                qRef[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+    IMU_core_FOM         FOM[3];
+};
+
+
+/******************************************************************************
+* constructor - creates subsystem instances (sensor set applied to core)
+******************************************************************************/
+
+template <typename T, unsigned S, unsigned N, IMU_engn_core_filter F>
+engn<T,S,N,F>::engn()
+{
+  // create IMU subsystem instances
+  int status[5] = {IMU_core_init(&idCore, &configCore), 0, 0, 0, 0};
+  if constexpr (has(stage_rect))
+    status[1]   = IMU_rect_init(&idRect, &configRect);
+  if constexpr (has(stage_pnts))
+    status[2]   = IMU_pnts_init(&idPnts, &configPnts);
+  if constexpr (has(stage_stat))
+    status[3]   = IMU_stat_init(&idStat, &configStat);
+  if constexpr (has(stage_calb))
+    status[4]   = IMU_calb_init(&idCalb, &configCalb);
+  for (int i=0; i<5; i++)
+    if (status[i] < 0)
+      init      = IMU_ENGN_SUBSYSTEM_FAILURE;
+  if (init < 0)
+    return;
+
+  // initialize config structures
+  configCore->isGyro = (N & sensor_gyro) ? 1 : 0;
+  configCore->isAccl = (N & sensor_accl) ? 1 : 0;
+  configCore->isMagn = (N & sensor_magn) ? 1 : 0;
+  if constexpr (has(stage_calb))
+    IMU_calb_setStruct(idCalb, configRect, configCore);
+}
+
+
+/******************************************************************************
+* move - takes ownership of the subsystem instances
+******************************************************************************/
+
+template <typename T, unsigned S, unsigned N, IMU_engn_core_filter F>
+void engn<T,S,N,F>::take(
+  engn                  &src)
+{
+  idCore                = src.idCore;
+  idRect                = src.idRect;
+  idPnts                = src.idPnts;
+  idStat                = src.idStat;
+  idCalb                = src.idCalb;
+  configCore            = src.configCore;
+  configRect            = src.configRect;
+  configPnts            = src.configPnts;
+  configStat            = src.configStat;
+  configCalb            = src.configCalb;
+  init                  = src.init;
+  count                 = src.count;
+  for (int i=0; i<4; i++)
+    qRef[i]             = src.qRef[i];
+  src.init              = IMU_ENGN_BAD_INST;
+  src.configCore        = nullptr;
+  src.configRect        = nullptr;
+  src.configPnts        = nullptr;
+  src.configStat        = nullptr;
+  src.configCalb        = nullptr;
+}
+
+
+/******************************************************************************
+* function to return subsystem ID
+******************************************************************************/
+
+template <typename T, unsigned S, unsigned N, IMU_engn_core_filter F>
+uint16_t engn<T,S,N,F>::sysID(
+  IMU_engn_system       system) const
+{
+  if      (system == IMU_engn_rect)
+    return idRect;
+  else if (system == IMU_engn_pnts)
+    return idPnts;
+  else if (system == IMU_engn_stat)
+    return idStat;
+  else if (system == IMU_engn_calb)
+    return idCalb;
+  else
+    return idCore;
+}
+
+
+/******************************************************************************
+* function to reset enabled subsystems
+******************************************************************************/
+
+template <typename T, unsigned S, unsigned N, IMU_engn_core_filter F>
+int engn<T,S,N,F>::reset()
+{
+  int status[4] = {IMU_core_reset(idCore), 0, 0, 0};
+  if constexpr (has(stage_pnts))
+    status[1]   = IMU_pnts_reset(idPnts);
+  if constexpr (has(stage_stat))
+    status[2]   = IMU_stat_reset(idStat);
+  if constexpr (has(stage_calb))
+    status[3]   = IMU_calb_reset(idCalb);
+  for (int i=0; i<4; i++)
+    if (status[i] < 0)
+      return IMU_ENGN_SUBSYSTEM_FAILURE;
+  return 0;
+}
+
+
+/******************************************************************************
+* function to set reference quaternion (manual)
+******************************************************************************/
+
+template <typename T, unsigned S, unsigned N, IMU_engn_core_filter F>
+int engn<T,S,N,F>::setRef(
+  const float           *ref)
+{
+  static_assert(has(stage_ref), "setRef requires the ref stage");
+  for (int i=0; i<4; i++)
+    qRef[i]             = ref[i];
+  return 0;
+}
+
+
+/******************************************************************************
+* processes one datum (stage order of IMU_engn_process)
+******************************************************************************/
+
+template <typename T, unsigned S, unsigned N, IMU_engn_core_filter F>
+inline int engn<T,S,N,F>::process(
+  IMU_datum             *datum)
+{
+  // define local variables
+  IMU_core_FOM          *fom   = has(stage_stat | stage_FOM) ? FOM : nullptr;
+  IMU_pnts_entry        *pnt   = nullptr;
+  IMU_pnts_enum         state  = IMU_pnts_enum_move;
+  int                   err    = 0;
+
+  // drop datum outside of the sensor set (bit zero is IMU_sync)
+  if constexpr (N != sensor_all)
+    if (!((N << 1) & (1u << datum->type)))
+      return 0;
+
+  // completed calibration solutions, then online magnetometer calibration
+  if constexpr (has(stage_calb)) {
+    IMU_calb_poll(idCalb);
+    if (datum->type == IMU_magn)
+      err      |= IMU_calb_magn(idCalb, datum->val);
+  }
+
+  // process datum by subsystems
+  if constexpr (has(stage_rect))
+    err        |= IMU_rect_datum(idRect, datum);
+  if constexpr (has(stage_pnts)) {
+    int status  = IMU_pnts_datum(idPnts, datum, &pnt);
+    err        |= status;
+    state       = (IMU_pnts_enum)status;
+  }
+  if constexpr (F == IMU_engn_mahony)
+    err        |= IMU_core_mhnyDatum(idCore, datum, fom);
+  else
+    err        |= IMU_core_datum(idCore, datum, fom);
+  if constexpr (has(stage_calb))
+    if (pnt != nullptr)
+      err      |= IMU_calb_point(idCalb, pnt);
+  if constexpr (has(stage_stat))
+    err        |= IMU_stat_datum(idStat, datum, fom, state);
+
+  // update the datum counter and exit (sign bit set by any failure)
+  count++;
+  return (err < 0) ? IMU_ENGN_SUBSYSTEM_FAILURE : 0;
+}
+
+
+/******************************************************************************
+* processes data3 (synchronized sensors, stage order of IMU_engn_data3)
+******************************************************************************/
+
+template <typename T, unsigned S, unsigned N, IMU_engn_core_filter F>
+inline int engn<T,S,N,F>::process(
+  IMU_data3             *data3)
+{
+  // define local variables
+  IMU_core_FOM          *fom   = has(stage_stat | stage_FOM) ? FOM : nullptr;
+  IMU_pnts_entry        *pnt   = nullptr;
+  IMU_pnts_enum         state  = IMU_pnts_enum_stable;
+  int                   err    = 0;
+
+  // completed calibration solutions, then online magnetometer calibration
+  if constexpr (has(stage_calb)) {
+    IMU_calb_poll(idCalb);
+    err        |= IMU_calb_magn(idCalb, data3->m);
+  }
+  count++;
+
+  // process data3 by subsystems
+  if constexpr (has(stage_rect))
+    err        |= IMU_rect_data3(idRect, data3);
+  if constexpr (has(stage_pnts)) {
+    int status  = IMU_pnts_data3(idPnts, data3, &pnt);
+    err        |= status;
+    state       = (IMU_pnts_enum)status;
+  }
+  if constexpr (F == IMU_engn_mahony)
+    err        |= IMU_core_mhnyData3(idCore, data3, fom);
+  else
+    err        |= IMU_core_data3(idCore, data3, fom);
+  if constexpr (has(stage_calb))
+    if (pnt != nullptr)
+      err      |= IMU_calb_point(idCalb, pnt);
+  if constexpr (has(stage_stat))
+    err        |= IMU_stat_data3(idStat, data3, fom, state);
+  return (err < 0) ? IMU_ENGN_SUBSYSTEM_FAILURE : 0;
+}
+
+
+/******************************************************************************
+* function to estimate orientation and acceleration (IMU_engn_getEstm)
+******************************************************************************/
+
+template <typename T, unsigned S, unsigned N, IMU_engn_core_filter F>
+inline int engn<T,S,N,F>::getEstm(
+  float                 t,
+  IMU_engn_estm         *estm)
+{
+  // get estimates
+  int status = IMU_core_estmQuat(idCore, t, estm->qOrg);
+  if constexpr (has(stage_tran))
+    IMU_core_estmAccl(idCore, t, estm->tran);
+  if constexpr (has(stage_ref))
+    IMU_math_quatMultConj(estm->qOrg, qRef, estm->q);
+  if constexpr (has(stage_ang) &&  has(stage_ref))
+    IMU_math_quatToEulerFast(estm->q, estm->ang);
+  if constexpr (has(stage_ang) && !has(stage_ref))
+    IMU_math_quatToEulerFast(estm->qOrg, estm->ang);
+
+  // exit function
+  if (status < 0)
+    return status;
+  else
+    return (int)count;
+}
+
+} // namespace IMU
+
+#endif
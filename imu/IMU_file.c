@@ -25,7 +25,7 @@
 #include "IMU_file.h"
 
 // core subsystem parsing inputs
-static const int   IMU_core_config_size   = 17;
+static const int   IMU_core_config_size   = 29;
 static const char* IMU_core_config_name[] = {
   "enable",
   "isGyro", 
@@ -34,15 +34,27 @@ static const char* IMU_core_config_name[] = {
   "isFOM",
   "isTran",
   "isPredict",
+  "isFused",
+  "gIntegrate",
   "gScale",
   "aWeight",
   "aMag",
   "aMagThresh",
+  "aDecim",
+  "aErrThresh",
+  "aSchedMax",
   "mWeight",
   "mMag",
   "mMagThresh",
   "mDot",
   "mDotThresh",
+  "mDecim",
+  "mErrThresh",
+  "mSchedMax",
+  "iWeight",
+  "zeroNum",
+  "startGain",
+  "startTime",
   "tranAlpha"
 };
 typedef enum {
@@ -53,16 +65,28 @@ typedef enum {
   IMU_core_isFOM        = 4,
   IMU_core_isTran       = 5,
   IMU_core_isPredict    = 6,
-  IMU_core_gScale       = 7,
-  IMU_core_aWeight      = 8,
-  IMU_core_aMag         = 9,
-  IMU_core_aMagThresh   = 10,
-  IMU_core_mWeight      = 11,
-  IMU_core_mMag         = 12,
-  IMU_core_mMagThresh   = 13,
-  IMU_core_mDot         = 14,
-  IMU_core_mDotThresh   = 15,
-  IMU_core_tranAlpha    = 16
+  IMU_core_isFused      = 7,
+  IMU_core_gIntegrate   = 8,
+  IMU_core_gScale       = 9,
+  IMU_core_aWeight      = 10,
+  IMU_core_aMag         = 11,
+  IMU_core_aMagThresh   = 12,
+  IMU_core_aDecim       = 13,
+  IMU_core_aErrThresh   = 14,
+  IMU_core_aSchedMax    = 15,
+  IMU_core_mWeight      = 16,
+  IMU_core_mMag         = 17,
+  IMU_core_mMagThresh   = 18,
+  IMU_core_mDot         = 19,
+  IMU_core_mDotThresh   = 20,
+  IMU_core_mDecim       = 21,
+  IMU_core_mErrThresh   = 22,
+  IMU_core_mSchedMax    = 23,
+  IMU_core_iWeight      = 24,
+  IMU_core_zeroNum      = 25,
+  IMU_core_startGain    = 26,
+  IMU_core_startTime    = 27,
+  IMU_core_tranAlpha    = 28
 } IMU_core_config_enum;
 
 // rect subsystem parsing inputs
@@ -129,43 +153,76 @@ typedef enum {
 } IMU_stat_config_enum;
 
 // stat subsystem parsing inputs
-static const int   IMU_calb_config_size   = 2;
+static const int   IMU_calb_config_size   = 6;
 static const char* IMU_calb_config_name[] = {
   "enable",
-  "sigma"
+  "sigma",
+  "mLambda",
+  "mCount",
+  "mResid",
+  "mDelta"
 };
 typedef enum {
   IMU_calb_enable      = 0,
-  IMU_calb_sigma       = 1
+  IMU_calb_sigma       = 1,
+  IMU_calb_mLambda     = 2,
+  IMU_calb_mCount      = 3,
+  IMU_calb_mResid      = 4,
+  IMU_calb_mDelta      = 5
 } IMU_calb_config_enum;
 
+// intg subsystem parsing inputs
+static const int   IMU_intg_config_size   = 3;
+static const char* IMU_intg_config_name[] = {
+  "enable",
+  "isConing",
+  "numSamp"
+};
+typedef enum {
+  IMU_intg_enable      = 0,
+  IMU_intg_isConing    = 1,
+  IMU_intg_numSamp     = 2
+} IMU_intg_config_enum;
+
 // stat subsystem parsing inputs
-static const int   IMU_engn_config_size   = 11;
+static const int   IMU_engn_config_size   = 17;
 static const char* IMU_engn_config_name[] = {
+  "isIntg",
+  "isGate",
   "isFOM",
   "isTran",
   "isRef",
   "isAng",
   "isSensorStruct",
+  "filter",
+  "tGate",
+  "gGate",
   "qRef",
   "configFileCore",
   "configFileRect",
   "configFilePnts",
   "configFileStat",
-  "configFileCalb"
+  "configFileCalb",
+  "configFileIntg"
 };
 typedef enum {
-  IMU_engn_isFOM           = 0,
-  IMU_engn_isTran          = 1,
-  IMU_engn_isRef           = 2,
-  IMU_engn_isAng           = 3,
-  IMU_engn_isSensorStruct  = 4,
-  IMU_engn_qRef            = 5,
-  IMU_engn_configFileCore  = 6,
-  IMU_engn_configFileRect  = 7,
-  IMU_engn_configFilePnts  = 8,
-  IMU_engn_configFileStat  = 9,
-  IMU_engn_configFileCalb  = 10
+  IMU_engn_isIntg          = 0,
+  IMU_engn_isGate          = 1,
+  IMU_engn_isFOM           = 2,
+  IMU_engn_isTran          = 3,
+  IMU_engn_isRef           = 4,
+  IMU_engn_isAng           = 5,
+  IMU_engn_isSensorStruct  = 6,
+  IMU_engn_filter          = 7,
+  IMU_engn_tGate           = 8,
+  IMU_engn_gGate           = 9,
+  IMU_engn_qRef            = 10,
+  IMU_engn_configFileCore  = 11,
+  IMU_engn_configFileRect  = 12,
+  IMU_engn_configFilePnts  = 13,
+  IMU_engn_configFileStat  = 14,
+  IMU_engn_configFileCalb  = 15,
+  IMU_engn_configFileIntg  = 16
 } IMU_engn_config_enum;
 
 
@@ -230,6 +287,10 @@ int IMU_file_coreLoad(
       get_bool(args, &config->isTran);
     else if (type == IMU_core_isPredict)
       get_bool(args, &config->isPredict);
+    else if (type == IMU_core_isFused)
+      get_bool(args, &config->isFused);
+    else if (type == IMU_core_gIntegrate)
+      sscanf(args, "%hhu", &config->gIntegrate);
     else if (type == IMU_core_gScale)
       sscanf(args, "%f", &config->gScale);
     else if (type == IMU_core_aWeight)
@@ -238,6 +299,12 @@ int IMU_file_coreLoad(
       sscanf(args, "%f", &config->aMag);
     else if (type == IMU_core_aMagThresh)
       sscanf(args, "%f", &config->aMagThresh);
+    else if (type == IMU_core_aDecim)
+      sscanf(args, "%hu", &config->aDecim);
+    else if (type == IMU_core_aErrThresh)
+      sscanf(args, "%f", &config->aErrThresh);
+    else if (type == IMU_core_aSchedMax)
+      sscanf(args, "%hu", &config->aSchedMax);
     else if (type == IMU_core_mWeight)
       sscanf(args, "%f", &config->mWeight);
     else if (type == IMU_core_mMag)
@@ -248,6 +315,20 @@ int IMU_file_coreLoad(
       sscanf(args, "%f", &config->mDot);
     else if (type == IMU_core_mDotThresh)
       sscanf(args, "%f", &config->mDotThresh);
+    else if (type == IMU_core_mDecim)
+      sscanf(args, "%hu", &config->mDecim);
+    else if (type == IMU_core_mErrThresh)
+      sscanf(args, "%f", &config->mErrThresh);
+    else if (type == IMU_core_mSchedMax)
+      sscanf(args, "%hu", &config->mSchedMax);
+    else if (type == IMU_core_iWeight)
+      sscanf(args, "%f", &config->iWeight);
+    else if (type == IMU_core_zeroNum)
+      sscanf(args, "%hu", &config->zeroNum);
+    else if (type == IMU_core_startGain)
+      sscanf(args, "%f", &config->startGain);
+    else if (type == IMU_core_startTime)
+      sscanf(args, "%f", &config->startTime);
     else if (type == IMU_core_tranAlpha)
       sscanf(args, "%f", &config->tranAlpha);
   }
@@ -283,15 +364,27 @@ int IMU_file_coreSave(
   fprintf(file, "  \"isFOM\": ");       write_bool(file, config->isFOM);
   fprintf(file, "  \"isTran\": ");      write_bool(file, config->isTran);
   fprintf(file, "  \"isPredict\": ");   write_bool(file, config->isPredict);   
+  fprintf(file, "  \"isFused\": ");     write_bool(file, config->isFused);
+  fprintf(file, "  \"gIntegrate\": %d,\n",        config->gIntegrate);
   fprintf(file, "  \"gScale\": %0.6f,\n",          config->gScale);
   fprintf(file, "  \"aWeight\": %0.3f,\n",         config->aWeight);
   fprintf(file, "  \"aMag\": %0.2f,\n",            config->aMag);
   fprintf(file, "  \"aMagThresh\": %0.2f,\n",      config->aMagThresh);
+  fprintf(file, "  \"aDecim\": %d,\n",             config->aDecim);
+  fprintf(file, "  \"aErrThresh\": %0.4f,\n",      config->aErrThresh);
+  fprintf(file, "  \"aSchedMax\": %d,\n",          config->aSchedMax);
   fprintf(file, "  \"mWeight\": %0.3f,\n",         config->mWeight);
   fprintf(file, "  \"mMag\": %0.2f,\n",            config->mMag);
   fprintf(file, "  \"mMagThresh\": %0.2f,\n",      config->mMagThresh);
   fprintf(file, "  \"mDot\": %0.3f,\n",            config->mDot);
   fprintf(file, "  \"mDotThresh\": %0.3f,\n",      config->mDotThresh);
+  fprintf(file, "  \"mDecim\": %d,\n",             config->mDecim);
+  fprintf(file, "  \"mErrThresh\": %0.4f,\n",      config->mErrThresh);
+  fprintf(file, "  \"mSchedMax\": %d,\n",          config->mSchedMax);
+  fprintf(file, "  \"iWeight\": %0.4f,\n",         config->iWeight);
+  fprintf(file, "  \"zeroNum\": %d,\n",            config->zeroNum);
+  fprintf(file, "  \"startGain\": %0.2f,\n",       config->startGain);
+  fprintf(file, "  \"startTime\": %0.2f,\n",       config->startTime);
   fprintf(file, "  \"tranAlpha\": %0.2f,\n",       config->tranAlpha);
   fprintf(file, "}\n");
 
@@ -601,6 +694,14 @@ int IMU_file_calbLoad(
       get_bool(args, &config->enable);
     else if (type == IMU_calb_sigma)
       sscanf(args, "%f", &config->sigma);
+    else if (type == IMU_calb_mLambda)
+      sscanf(args, "%f", &config->mLambda);
+    else if (type == IMU_calb_mCount)
+      sscanf(args, "%u", &config->mCount);
+    else if (type == IMU_calb_mResid)
+      sscanf(args, "%f", &config->mResid);
+    else if (type == IMU_calb_mDelta)
+      sscanf(args, "%f", &config->mDelta);
   }
 
   // exit function
@@ -629,6 +730,84 @@ int IMU_file_calbSave(
   fprintf(file, "{\n");
   fprintf(file, "  \"enable\": ");        write_bool(file, config->enable);
   fprintf(file, "  \"sigma\": %0.2f,\n",  config->sigma);
+  fprintf(file, "  \"mLambda\": %0.5f,\n", config->mLambda);
+  fprintf(file, "  \"mCount\": %u,\n",   config->mCount);
+  fprintf(file, "  \"mResid\": %0.4f,\n", config->mResid);
+  fprintf(file, "  \"mDelta\": %0.4f,\n", config->mDelta);
+  fprintf(file, "}\n");
+
+  // exit function
+  fclose(file);
+  return 0;
+}
+
+
+/******************************************************************************
+* reads configuration json file into memory (structure)
+******************************************************************************/
+
+int IMU_file_intgLoad(
+  const char           *filename,
+  IMU_intg_config      *config)
+{
+  // define internal variables
+  FILE                  *file;
+  char                  *field;
+  char                  *args;
+  IMU_intg_config_enum  type;
+  int                   status;
+
+  // open configuration json file
+  file = fopen(filename, "r");
+  if (file == NULL)
+    return IMU_FILE_INVALID_FILE;
+
+  // main loop that parse json file line by line
+  while (1) {
+    // read line and parse field/args
+    status = get_line(file, &field, &args);
+    if (status == 1)
+      continue;
+    if (status > 1 || status < 0)
+      break;
+
+    // extract specified field arguments
+    type = get_field(field, IMU_intg_config_name, IMU_intg_config_size);
+    if      (type == IMU_intg_enable)
+      get_bool(args, &config->enable);
+    else if (type == IMU_intg_isConing)
+      get_bool(args, &config->isConing);
+    else if (type == IMU_intg_numSamp)
+      sscanf(args, "%hu", &config->numSamp);
+  }
+
+  // exit function
+  fclose(file);
+  return 0;
+}
+
+
+/******************************************************************************
+* writes configuration structure to a json file
+******************************************************************************/
+
+int IMU_file_intgSave(
+  const char           *filename,
+  IMU_intg_config      *config)
+{
+  // define internal variables
+  FILE                 *file;
+
+  // open configuration json file
+  file = fopen(filename, "w");
+  if (file == NULL)
+    return IMU_FILE_INVALID_FILE;
+
+  // write contents to json file one line at a time
+  fprintf(file, "{\n");
+  fprintf(file, "  \"enable\": ");        write_bool(file, config->enable);
+  fprintf(file, "  \"isConing\": ");      write_bool(file, config->isConing);
+  fprintf(file, "  \"numSamp\": %d\n",   config->numSamp);
   fprintf(file, "}\n");
 
   // exit function
@@ -663,6 +842,7 @@ int IMU_file_engnLoad(
   config->configFilePnts[0] = '\0';
   config->configFileStat[0] = '\0';
   config->configFileCalb[0] = '\0';
+  config->configFileIntg[0] = '\0';
 
   // main loop that parse json file line by line
   while (1) {
@@ -674,7 +854,11 @@ int IMU_file_engnLoad(
 
     // extract specified field arguments  
     type = get_field(field, IMU_engn_config_name, IMU_engn_config_size);
-    if      (type == IMU_engn_isFOM)
+    if      (type == IMU_engn_isIntg)
+      get_bool(args, &config->isIntg);
+    else if (type == IMU_engn_isGate)
+      get_bool(args, &config->isGate);
+    else if (type == IMU_engn_isFOM)
       get_bool(args, &config->isFOM);
     else if (type == IMU_engn_isTran)
       get_bool(args, &config->isTran);
@@ -684,6 +868,14 @@ int IMU_file_engnLoad(
       get_bool(args, &config->isAng);
     else if (type == IMU_engn_isSensorStruct)
       get_bool(args, &config->isSensorStruct);
+    else if (type == IMU_engn_filter)
+      sscanf(args, "%hhu", &config->filter);
+    else if (type == IMU_engn_tGate) {
+      sscanf(args, "%d", &config->tGate);
+      config->tGate    = config->tGate * 100;     // msec to 10usec
+    }
+    else if (type == IMU_engn_gGate)
+      sscanf(args, "%f", &config->gGate);
     else if (type == IMU_engn_qRef) 
       get_floats(args, config->qRef, 4);
     else if (type == IMU_engn_configFileCore)
@@ -696,6 +888,8 @@ int IMU_file_engnLoad(
       get_string(args, config->configFileStat);
     else if (type == IMU_engn_configFileCalb)
       get_string(args, config->configFileCalb);
+    else if (type == IMU_engn_configFileIntg)
+      get_string(args, config->configFileIntg);
   }
 
   // exit function
@@ -723,11 +917,16 @@ int IMU_file_engnSave(
   // write contents to json file one line at a time
   uint8_t               isSensor = config->isSensorStruct;
   fprintf(file, "{\n");
+  fprintf(file, "  \"isIntg\": ");          write_bool  (file, config->isIntg);
+  fprintf(file, "  \"isGate\": ");          write_bool  (file, config->isGate);
   fprintf(file, "  \"isFOM\": ");           write_bool  (file, config->isFOM);
   fprintf(file, "  \"isTran\": ");          write_bool  (file, config->isTran);
   fprintf(file, "  \"isRef\": ");           write_bool  (file, config->isRef);
   fprintf(file, "  \"isAng\": ");           write_bool  (file, config->isAng);
   fprintf(file, "  \"isSensorStruct\": ");  write_bool  (file, isSensor);
+  fprintf(file, "  \"filter\": %d,\n",       config->filter);
+  fprintf(file, "  \"tGate\": %d,\n",        config->tGate / 100);
+  fprintf(file, "  \"gGate\": %0.3f,\n",     config->gGate);
   fprintf(file, "  \"qRef\": ");            write_floats(file, config->qRef, 4);
   if (config->configFileCore[0] != '\0')
     fprintf(file, "  \"configFileCore\": %s", config->configFileCore);
@@ -739,6 +938,8 @@ int IMU_file_engnSave(
     fprintf(file, "  \"configFileStat\": %s", config->configFileStat);
   if (config->configFileCalb[0] != '\0')
     fprintf(file, "  \"configFileCalb\": %s", config->configFileCalb);
+  if (config->configFileIntg[0] != '\0')
+    fprintf(file, "  \"configFileIntg\": %s", config->configFileIntg);
   fprintf(file, "}\n");
 
   // exit function
@@ -26,6 +26,7 @@
 #include "IMU_pnts.h"
 #include "IMU_stat.h"
 #include "IMU_calb.h"
+#include "IMU_intg.h"
 #include "IMU_engn.h"
 
 #ifdef __cplusplus
@@ -51,6 +52,8 @@ int IMU_file_statLoad (const char *filename, IMU_stat_config *config);
 int IMU_file_statSave (const char *filename, IMU_stat_config *config);
 int IMU_file_calbLoad (const char *filename, IMU_calb_config *config);
 int IMU_file_calbSave (const char *filename, IMU_calb_config *config);
+int IMU_file_intgLoad (const char *filename, IMU_intg_config *config);
+int IMU_file_intgSave (const char *filename, IMU_intg_config *config);
 int IMU_file_engnLoad (const char *filename, IMU_engn_config *config);
 int IMU_file_engnSave (const char *filename, IMU_engn_config *config);
 
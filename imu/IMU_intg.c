@@ -0,0 +1,224 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * The coning compensation follows the recursive delta-angle formulation
+ * documented by Paul G. Savage in "Strapdown Inertial Navigation Integration
+ * Algorithm Design Part 1: Attitude Algorithms". The rotation vector over one
+ * increment is the summed delta angle plus the accumulated coning term.
+*/
+
+// include statements
+#include <string.h>
+#include "IMU_math.h"
+#include "IMU_intg.h"
+
+// internally managed structures
+static IMU_intg_config *config [IMU_MAX_INST];
+static IMU_intg_config  configOwn[IMU_MAX_INST];
+static IMU_intg_state   state  [IMU_MAX_INST];
+static uint16_t         numInst = 0;
+
+
+/******************************************************************************
+* initialize new instance (constructor)
+******************************************************************************/
+
+int IMU_intg_init(
+  uint16_t              *id,
+  IMU_intg_config       **pntr)
+{
+  // check device count overflow
+  if (numInst >= IMU_MAX_INST)
+    return IMU_INTG_INST_OVERFLOW;
+
+  // intialize to known state
+  configOwn[numInst].enable      = 1;
+  configOwn[numInst].isConing    = 1;
+  configOwn[numInst].numSamp     = 8;
+
+  // pass handle and config pointer
+  *id      = numInst;
+  config[*id] = &configOwn[*id];
+  *pntr    = config[*id];
+  numInst++;
+
+  // reset instance and exit (no errors)
+  IMU_intg_reset(*id);
+  return 0;
+}
+
+
+/******************************************************************************
+* return config structure
+******************************************************************************/
+
+int IMU_intg_getConfig(
+  uint16_t              id,
+  IMU_intg_config       **pntr)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_INTG_BAD_INST;
+
+  // pass config and exit (no errors)
+  *pntr = config[id];
+  return 0;
+}
+
+
+/******************************************************************************
+* point instance at external config structure (owned by caller)
+******************************************************************************/
+
+int IMU_intg_setConfig(
+  uint16_t              id,
+  IMU_intg_config        *pntr)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_INTG_BAD_INST;
+
+  // replace config pointer and exit (no errors)
+  config[id] = pntr;
+  return 0;
+}
+
+
+/******************************************************************************
+* return state structure
+******************************************************************************/
+
+int IMU_intg_getState(
+  uint16_t              id,
+  IMU_intg_state        **pntr)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_INTG_BAD_INST;
+
+  // pass state and exit (no errors)
+  *pntr = &state[id];
+  return 0;
+}
+
+
+/******************************************************************************
+* initialize state to known state
+******************************************************************************/
+
+int IMU_intg_reset(
+  uint16_t              id)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_INTG_BAD_INST;
+
+  // initialize to known state
+  state[id].isFirst     = 1;
+  state[id].count       = 0;
+  state[id].tStart      = 0;
+  state[id].tPrev       = 0;
+  memset(state[id].alpha, 0, sizeof(state[id].alpha));
+  memset(state[id].beta,  0, sizeof(state[id].beta));
+  memset(state[id].dPrev, 0, sizeof(state[id].dPrev));
+
+  // exit function (no errors)
+  return 0;
+}
+
+
+/******************************************************************************
+* accumulate gyroscope rates (rad/sec), fills increment once complete
+******************************************************************************/
+
+int IMU_intg_gyro(
+  uint16_t              id,
+  uint32_t              t,
+  float                 *g,
+  IMU_intg_incr         *incr)
+{
+  // determine whether function executes
+  if (id >= numInst)
+    return IMU_INTG_BAD_INST;
+  if (!config[id]->enable)
+    return IMU_INTG_FNC_DISABLED;
+
+  // first sample only establishes the time base
+  IMU_intg_state        *cur = &state[id];
+  if (cur->isFirst) {
+    cur->isFirst        = 0;
+    cur->tStart         = t;
+    cur->tPrev          = t;
+    return IMU_intg_enum_accum;
+  }
+
+  // delta angle over the sample period
+  float dt              = (float)(t - cur->tPrev) * IMU_INTG_10USEC_TO_SEC;
+  float d[3]            = {g[0]*dt, g[1]*dt, g[2]*dt};
+
+  // coning term (cross product of accumulated and current delta angle)
+  if (config[id]->isConing) {
+    const float sixth   = 1.0f / 6.0f;
+    float a[3]          = {cur->alpha[0] + sixth * cur->dPrev[0],
+                           cur->alpha[1] + sixth * cur->dPrev[1],
+                           cur->alpha[2] + sixth * cur->dPrev[2]};
+    cur->beta[0]       += 0.5f * (a[1]*d[2] - a[2]*d[1]);
+    cur->beta[1]       += 0.5f * (a[2]*d[0] - a[0]*d[2]);
+    cur->beta[2]       += 0.5f * (a[0]*d[1] - a[1]*d[0]);
+  }
+
+  // accumulate delta angle
+  cur->alpha[0]        += d[0];
+  cur->alpha[1]        += d[1];
+  cur->alpha[2]        += d[2];
+  memcpy(cur->dPrev, d, sizeof(d));
+  cur->tPrev            = t;
+  cur->count++;
+  if (cur->count < config[id]->numSamp)
+    return IMU_intg_enum_accum;
+
+  // convert rotation vector to delta quaternion
+  float phi[3]          = {cur->alpha[0] + cur->beta[0],
+                           cur->alpha[1] + cur->beta[1],
+                           cur->alpha[2] + cur->beta[2]};
+  incr->t               = t;
+  incr->dt              = (float)(t - cur->tStart) * IMU_INTG_10USEC_TO_SEC;
+  incr->dq[0]           = 1.0f;
+  incr->dq[1]           = 0.0f;
+  incr->dq[2]           = 0.0f;
+  incr->dq[3]           = 0.0f;
+  IMU_math_estmGyroExp(incr->dq, phi, 1.0f);
+  if (incr->dt > 0.0f) {
+    incr->g[0]          = cur->alpha[0] / incr->dt;
+    incr->g[1]          = cur->alpha[1] / incr->dt;
+    incr->g[2]          = cur->alpha[2] / incr->dt;
+  } else {
+    memcpy(incr->g, g, sizeof(incr->g));
+  }
+
+  // start next increment
+  cur->count            = 0;
+  cur->tStart           = t;
+  memset(cur->alpha, 0, sizeof(cur->alpha));
+  memset(cur->beta,  0, sizeof(cur->beta));
+
+  // exit function (increment ready)
+  return IMU_intg_enum_ready;
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _IMU_INTG_H
+#define _IMU_INTG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// include statements
+#include <stdint.h>
+#include "IMU_type.h"
+
+// define status codes
+#define IMU_INTG_FNC_DISABLED       1
+
+// define error codes
+#define IMU_INTG_INST_OVERFLOW     -1
+#define IMU_INTG_BAD_INST          -2
+
+// define constants
+#define IMU_INTG_10USEC_TO_SEC      0.00001
+
+// configuration structure definition
+typedef struct {
+  uint8_t               enable;          // enable gyroscope pre-integration
+  uint8_t               isConing;        // enable coning compensation
+  uint16_t              numSamp;         // gyro samples per output increment
+} IMU_intg_config;
+
+// subsystem state structure definition
+typedef struct {
+  uint8_t               isFirst;         // waiting on first sample time
+  uint16_t              count;           // samples in current increment
+  uint32_t              tStart;          // increment start time
+  uint32_t              tPrev;           // last sample time
+  float                 alpha[3];        // accumulated delta angle (rad)
+  float                 beta[3];         // accumulated coning term (rad)
+  float                 dPrev[3];        // last sample delta angle (rad)
+} IMU_intg_state;
+
+// integrated gyroscope increment
+typedef struct {
+  uint32_t              t;               // increment end time
+  float                 dt;              // increment duration (sec)
+  float                 dq[4];           // delta quaternion (body frame)
+  float                 g[3];            // mean rate (rad/sec)
+} IMU_intg_incr;
+
+// pre-integration internal state
+typedef enum {
+  IMU_intg_enum_accum        = 2,       // sample added to increment
+  IMU_intg_enum_ready        = 3        // increment complete
+} IMU_intg_enum;
+
+
+// data structure access functions
+int IMU_intg_init      (uint16_t *id, IMU_intg_config **config);
+int IMU_intg_getConfig  (uint16_t id, IMU_intg_config **config);
+int IMU_intg_setConfig  (uint16_t id, IMU_intg_config *config);
+int IMU_intg_getState   (uint16_t id, IMU_intg_state  **state);
+
+// general operation functions
+int IMU_intg_reset      (uint16_t id);
+int IMU_intg_gyro       (uint16_t id, uint32_t t, float *g, IMU_intg_incr*);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -34,6 +34,7 @@ static inline float  norm3(float *v);
 static inline float* norm4(float *v);
 static inline float* scale(float *v, float m);  
 static inline float* decrm(float *v, float *d);
+static inline void   rotate(float *q, float *w);
 
 
 /******************************************************************************
@@ -47,11 +48,29 @@ int IMU_math_estmAccl(
   float                 alpha,
   float                 *FOM)
 {
-  // compute the objective function 
+  float R[9];
+  return IMU_math_estmAcclDCM(q, IMU_math_quatToDCM(q, R), a, alpha, FOM);
+}
+
+
+/******************************************************************************
+* update quaternion with newest accelerometer datum, R is the direction
+* cosine matrix of q (IMU_math_quatToDCM) shared with the caller
+* assumes normalized quaternion and datum
+******************************************************************************/
+
+int IMU_math_estmAcclDCM(
+  float                 *q, 
+  float                 *R, 
+  float                 *a, 
+  float                 alpha,
+  float                 *FOM)
+{
+  // compute the objective function (gravity model is row 2)
   float two_q[4]        = {2.0f*q[0], 2.0f*q[1], 2.0f*q[2], 2.0f*q[3]};
-  float f_1             = two_q[1]*q[3] - two_q[0]*q[2] - a[0];
-  float f_2             = two_q[0]*q[1] + two_q[2]*q[3] - a[1];
-  float f_3             = 1.0f - two_q[1]*q[1] - two_q[2]*q[2] - a[2];
+  float f_1             = R[6] - a[0];
+  float f_2             = R[7] - a[1];
+  float f_3             = R[8] - a[2];
  
   // calculate the gradient
   float qHatDot[4]      = {two_q[1]*f_2 - two_q[2]*f_1,
@@ -76,19 +95,38 @@ int IMU_math_estmMagnNorm(
   float                 *m_in,
   float                 alpha,
   float                 *FOM)
+{
+  float R[9];
+  return IMU_math_estmMagnNormDCM(q, IMU_math_quatToDCM(q, R), m_in, alpha,
+                                  FOM);
+}
+
+
+/******************************************************************************
+* update quaternion with newest magnetometer datum, R is the direction
+* cosine matrix of q (IMU_math_quatToDCM) shared with the caller
+* (does not assume normalized datum)
+******************************************************************************/
+
+int IMU_math_estmMagnNormDCM(
+  float                 *q,
+  float                 *R,
+  float                 *m_in,
+  float                 alpha,
+  float                 *FOM)
 {
   // orthonormalize the magnetomter
   float u[3];           
-  IMU_math_quatToUp(q, u);
+  IMU_math_dcmToUp(R, u);
   float n               = u[0]*m_in[0] + u[1]*m_in[1] + u[2]*m_in[2];
   float m[3]            = {m_in[0]-n*u[0], m_in[1]-n*u[1], m_in[2]-n*u[2]};
   norm3(m);
 
-  // compute the objective function 
+  // compute the objective function (forward model is row 0)
   float two_q[4]        = {2.0f*q[0], 2.0f*q[1], 2.0f*q[2], 2.0f*q[3]};
-  float f_4             = 1.0f - two_q[2]*q[2] - two_q[3]*q[3] - m[0];
-  float f_5             = two_q[1]*q[2] - two_q[0]*q[3] - m[1];
-  float f_6             = two_q[0]*q[2] + two_q[1]*q[3] - m[2];
+  float f_4             = R[0] - m[0];
+  float f_5             = R[1] - m[1];
+  float f_6             = R[2] - m[2];
 
   // calculate the gradient
   float qHatDot[4]      = {-two_q[3]*f_5 + two_q[2]*f_6,
@@ -160,6 +198,258 @@ int IMU_math_estmMagnRef(
 }
 
 
+/******************************************************************************
+* update quaternion with synchronized gyroscope, accelerometer, and
+* magnetometer data (single pass w/ one quaternion normalization)
+* assumes normalized quaternion and accelerometer datum
+******************************************************************************/
+
+int IMU_math_estmFused(
+  float                 *q,
+  float                 *g,
+  float                 dt,
+  float                 *a,
+  float                 *m_in,
+  float                 aAlpha,
+  float                 mAlpha,
+  float                 *FOM)
+{
+  // quaternion products shared by all three sensors
+  float q0_q1           = q[0]*q[1];
+  float q0_q2           = q[0]*q[2];
+  float q0_q3           = q[0]*q[3];
+  float q1_q1           = q[1]*q[1];
+  float q1_q2           = q[1]*q[2];
+  float q1_q3           = q[1]*q[3];
+  float q2_q2           = q[2]*q[2];
+  float q2_q3           = q[2]*q[3];
+  float q3_q3           = q[3]*q[3];
+  float two_q[4]        = {2.0f*q[0], 2.0f*q[1], 2.0f*q[2], 2.0f*q[3]};
+
+  // compute the accelerometer objective function and gradient
+  float f_1             = 2.0f * (q1_q3 - q0_q2) - a[0];
+  float f_2             = 2.0f * (q0_q1 + q2_q3) - a[1];
+  float f_3             = 1.0f - 2.0f * (q1_q1 + q2_q2) - a[2];
+  float aHatDot[4]      = {two_q[1]*f_2 - two_q[2]*f_1,
+                           two_q[3]*f_1 + two_q[0]*f_2 - 2*two_q[1]*f_3,
+                           two_q[3]*f_2 - 2*two_q[2]*f_3 - two_q[0]*f_1,
+                           two_q[1]*f_1 + two_q[2]*f_2};
+
+  // orthonormalize the magnetometer (against up vector)
+  float u[3]            = {2.0f * (q1_q3 + q0_q2),
+                           2.0f * (q2_q3 - q0_q1),
+                           1.0f - 2.0f * (q1_q1 + q2_q2)};
+  float n               = u[0]*m_in[0] + u[1]*m_in[1] + u[2]*m_in[2];
+  float m[3]            = {m_in[0]-n*u[0], m_in[1]-n*u[1], m_in[2]-n*u[2]};
+  norm3(m);
+
+  // compute the magnetometer objective function and gradient
+  float f_4             = 1.0f - 2.0f * (q2_q2 + q3_q3) - m[0];
+  float f_5             = 2.0f * (q1_q2 - q0_q3) - m[1];
+  float f_6             = 2.0f * (q0_q2 + q1_q3) - m[2];
+  float mHatDot[4]      = {-two_q[3]*f_5 + two_q[2]*f_6,
+                            two_q[2]*f_5 + two_q[3]*f_6,
+                           -2*two_q[2]*f_4 + two_q[1]*f_5 + two_q[0]*f_6,
+                           -2*two_q[3]*f_4 - two_q[0]*f_5 + two_q[1]*f_6};
+  norm4(aHatDot);
+  norm4(mHatDot);
+  FOM[0]                = aHatDot[0];
+  FOM[1]                = mHatDot[0];
+
+  // apply gyroscope rates and both gradient steps, then normalize once
+  float half_dt         = 0.5f * dt;
+  float dq[4]           = {-q[1]*g[0] - q[2]*g[1] - q[3]*g[2],
+                            q[0]*g[0] + q[2]*g[2] - q[3]*g[1],
+                            q[0]*g[1] - q[1]*g[2] + q[3]*g[0],
+                            q[0]*g[2] + q[1]*g[1] - q[2]*g[0]};
+  q[0]                 += half_dt*dq[0] - aAlpha*aHatDot[0] - mAlpha*mHatDot[0];
+  q[1]                 += half_dt*dq[1] - aAlpha*aHatDot[1] - mAlpha*mHatDot[1];
+  q[2]                 += half_dt*dq[2] - aAlpha*aHatDot[2] - mAlpha*mHatDot[2];
+  q[3]                 += half_dt*dq[3] - aAlpha*aHatDot[3] - mAlpha*mHatDot[3];
+  norm4(q);
+
+  // exit (no errors)
+  return 0;
+}
+
+
+/******************************************************************************
+* update quaternion with newest accelerometer datum (mahony), the error is
+* the cross product of measured and predicted up vectors, returns the
+* applied correction (rad) in e for the integral term
+* assumes normalized quaternion and datum
+******************************************************************************/
+
+int IMU_math_mhnyAccl(
+  float                 *q,
+  float                 *a,
+  float                 kp,
+  float                 *e,
+  float                 *FOM)
+{
+  float R[9];
+  return IMU_math_mhnyAcclDCM(q, IMU_math_quatToDCM(q, R), a, kp, e, FOM);
+}
+
+
+/******************************************************************************
+* mahony accelerometer update, R is the direction cosine matrix of q
+* (IMU_math_quatToDCM) shared with the caller
+******************************************************************************/
+
+int IMU_math_mhnyAcclDCM(
+  float                 *q,
+  float                 *R,
+  float                 *a,
+  float                 kp,
+  float                 *e,
+  float                 *FOM)
+{
+  // predicted up vector (same model as IMU_math_estmAccl)
+  float *v              = &R[6];
+
+  // proportional correction (rotates prediction toward measurement)
+  e[0]                  = kp * (a[1]*v[2] - a[2]*v[1]);
+  e[1]                  = kp * (a[2]*v[0] - a[0]*v[2]);
+  e[2]                  = kp * (a[0]*v[1] - a[1]*v[0]);
+  rotate(q, e);
+  *FOM                  = 1.0f - (a[0]*v[0] + a[1]*v[1] + a[2]*v[2]);
+
+  // exit (no errors)
+  return 0;
+}
+
+
+/******************************************************************************
+* update quaternion with newest magnetometer datum (mahony), datum is
+* projected onto the horizontal plane so only heading is corrected
+* assumes normalized quaternion and datum
+******************************************************************************/
+
+int IMU_math_mhnyMagn(
+  float                 *q,
+  float                 *m,
+  float                 kp,
+  float                 *e,
+  float                 *FOM)
+{
+  float R[9];
+  return IMU_math_mhnyMagnDCM(q, IMU_math_quatToDCM(q, R), m, kp, e, FOM);
+}
+
+
+/******************************************************************************
+* mahony magnetometer update, R is the direction cosine matrix of q
+* (IMU_math_quatToDCM) shared with the caller
+******************************************************************************/
+
+int IMU_math_mhnyMagnDCM(
+  float                 *q,
+  float                 *R,
+  float                 *m,
+  float                 kp,
+  float                 *e,
+  float                 *FOM)
+{
+  // predicted up and forward vectors (same model as IMU_math_estmMagnNorm)
+  float *v              = &R[6];
+  float *f              = &R[0];
+
+  // horizontal component of the magnetometer
+  float n               = v[0]*m[0] + v[1]*m[1] + v[2]*m[2];
+  float h[3]            = {m[0]-n*v[0], m[1]-n*v[1], m[2]-n*v[2]};
+  norm3(h);
+
+  // proportional correction (about the up vector)
+  e[0]                  = kp * (h[1]*f[2] - h[2]*f[1]);
+  e[1]                  = kp * (h[2]*f[0] - h[0]*f[2]);
+  e[2]                  = kp * (h[0]*f[1] - h[1]*f[0]);
+  rotate(q, e);
+  *FOM                  = 1.0f - (h[0]*f[0] + h[1]*f[1] + h[2]*f[2]);
+
+  // exit (no errors)
+  return 0;
+}
+
+
+/******************************************************************************
+* update quaternion with synchronized gyroscope, accelerometer, and
+* magnetometer data (mahony), both corrections are added to the gyroscope
+* rotation so the quaternion is updated once
+* assumes normalized quaternion and accelerometer datum
+******************************************************************************/
+
+int IMU_math_mhnyFused(
+  float                 *q,
+  float                 *g,
+  float                 dt,
+  float                 *a,
+  float                 *m,
+  float                 aKp,
+  float                 mKp,
+  float                 *e,
+  float                 *FOM)
+{
+  float R[9];
+  return IMU_math_mhnyFusedDCM(q, IMU_math_quatToDCM(q, R), g, dt, a, m,
+                               aKp, mKp, e, FOM);
+}
+
+
+/******************************************************************************
+* mahony synchronized update, R is the direction cosine matrix of q
+* (IMU_math_quatToDCM) shared with the caller
+******************************************************************************/
+
+int IMU_math_mhnyFusedDCM(
+  float                 *q,
+  float                 *R,
+  float                 *g,
+  float                 dt,
+  float                 *a,
+  float                 *m,
+  float                 aKp,
+  float                 mKp,
+  float                 *e,
+  float                 *FOM)
+{
+  // predicted up and forward vectors
+  float *v              = &R[6];
+  float *f              = &R[0];
+
+  // accelerometer correction (zero weight skipped)
+  e[0]                  = 0.0f;
+  e[1]                  = 0.0f;
+  e[2]                  = 0.0f;
+  FOM[0]                = 0.0f;
+  FOM[1]                = 0.0f;
+  if (aKp > 0.0f) {
+    e[0]                = aKp * (a[1]*v[2] - a[2]*v[1]);
+    e[1]                = aKp * (a[2]*v[0] - a[0]*v[2]);
+    e[2]                = aKp * (a[0]*v[1] - a[1]*v[0]);
+    FOM[0]              = 1.0f - (a[0]*v[0] + a[1]*v[1] + a[2]*v[2]);
+  }
+
+  // magnetometer correction (horizontal component, zero weight skipped)
+  if (mKp > 0.0f) {
+    float n             = v[0]*m[0] + v[1]*m[1] + v[2]*m[2];
+    float h[3]          = {m[0]-n*v[0], m[1]-n*v[1], m[2]-n*v[2]};
+    norm3(h);
+    e[0]               += mKp * (h[1]*f[2] - h[2]*f[1]);
+    e[1]               += mKp * (h[2]*f[0] - h[0]*f[2]);
+    e[2]               += mKp * (h[0]*f[1] - h[1]*f[0]);
+    FOM[1]              = 1.0f - (h[0]*f[0] + h[1]*f[1] + h[2]*f[2]);
+  }
+
+  // apply gyroscope rotation and corrections together
+  float w[3]            = {dt*g[0] + e[0], dt*g[1] + e[1], dt*g[2] + e[2]};
+  rotate(q, w);
+
+  // exit (no errors)
+  return 0;
+}
+
+
 /******************************************************************************
 * utility function - normalize 3x1 array
 ******************************************************************************/
@@ -167,13 +457,7 @@ int IMU_math_estmMagnRef(
 inline float norm3(
   float          *v)
 {
-  float norm     = sqrtf((float)v[0]*(float)v[0] + 
-                         (float)v[1]*(float)v[1] + 
-                         (float)v[2]*(float)v[2]); 
-  v[0]           = (float)v[0] / norm;
-  v[1]           = (float)v[1] / norm;
-  v[2]           = (float)v[2] / norm;
-  return norm;
+  return IMU_math_norm3(v);
 }
 
 
@@ -184,13 +468,7 @@ inline float norm3(
 inline float* norm4(
   float                 *v)
 {
-  float norm            = sqrtf(v[0]*v[0] + v[1]*v[1] + v[2]*v[2] + v[3]*v[3]);
-  if (norm > 0.001f) {
-    v[0]               /= norm;
-    v[1]               /= norm;
-    v[2]               /= norm;
-    v[3]               /= norm;
-  }
+  IMU_math_norm4(v);
   return v;
 }
 
@@ -225,3 +503,29 @@ inline float* decrm(
   v[3]                  -= d[3];
   return v;
 }
+
+
+/******************************************************************************
+* utility function - rotate quaternion by small body-frame rotation vector,
+* first-order update w/ first-order renormalization (no square root)
+******************************************************************************/
+
+inline void rotate(
+  float                 *q,
+  float                 *w)
+{
+  float dq[4]           = {-q[1]*w[0] - q[2]*w[1] - q[3]*w[2],
+                            q[0]*w[0] + q[2]*w[2] - q[3]*w[1],
+                            q[0]*w[1] - q[1]*w[2] + q[3]*w[0],
+                            q[0]*w[2] + q[1]*w[1] - q[2]*w[0]};
+  q[0]                 += 0.5f * dq[0];
+  q[1]                 += 0.5f * dq[1];
+  q[2]                 += 0.5f * dq[2];
+  q[3]                 += 0.5f * dq[3];
+  float n               = 1.5f - 0.5f * (q[0]*q[0] + q[1]*q[1] +
+                                         q[2]*q[2] + q[3]*q[3]);
+  q[0]                 *= n;
+  q[1]                 *= n;
+  q[2]                 *= n;
+  q[3]                 *= n;
+}
@@ -26,6 +26,19 @@ extern "C" {
 
 // include statements 
 #include <math.h>            // sqrt/trig
+#include <stdint.h>          // uint32_t (portable rsqrt)
+#if defined(__SSE__)
+#include <xmmintrin.h>       // rsqrtss
+#endif
+
+// fast normalization (reciprocal square root)
+static inline float  IMU_math_rsqrt         (float x);
+static inline float  IMU_math_norm3         (float *v);
+static inline float  IMU_math_norm4         (float *v);
+
+// fast inverse trigonometry (polynomial, max error 2e-6 rad)
+static inline float  IMU_math_atan2         (float y,   float x);
+static inline float  IMU_math_asin          (float x);
 
 // basic quaternion operators
 static inline float* IMU_math_quatMult      (float *q1, float *q2, float *out);
@@ -33,6 +46,13 @@ static inline float* IMU_math_quatMultConj  (float *q1, float *q2, float *out);
 static inline float* IMU_math_rotateForward (float *v,  float *q,  float *out);
 static inline float* IMU_math_rotateReverse (float *v,  float *q,  float *out);
 
+// direction cosine matrix (computed once per update, shared by consumers)
+static inline float* IMU_math_quatToDCM     (float *q,  float *R);
+static inline float* IMU_math_dcmToUp       (float *R,  float *v);
+static inline float* IMU_math_dcmToFrwd     (float *R,  float *v);
+static inline float* IMU_math_dcmRotateForward(float *v, float *R, float *out);
+static inline float* IMU_math_dcmRotateReverse(float *v, float *R, float *out);
+
 // converting between quaternions and pointing vectors
 static inline float* IMU_math_quatToUp      (float *q,  float *v);
 static inline float* IMU_math_quatToFrwd    (float *q,  float *v);
@@ -42,17 +62,138 @@ static inline float* IMU_math_vectToQuat    (float *u,  float *v,  float *q);
 
 // converting between quaternions and Euler angles
 static inline float* IMU_math_quatToEuler   (float *q,  float *E);
+static inline float* IMU_math_quatToEulerFast(float *q, float *E);
 static inline float* IMU_math_eulerToQuat   (float *E,  float *q);
 static inline float* IMU_math_radToDeg      (float *r,  float *d);
 static inline float* IMU_math_degToRad      (float *d,  float *r);
 
 // core filters
 static inline float IMU_math_calcWeight (float val, float ref, float thresh);
+static inline float IMU_math_calcWeightInv(float val, float ref, float inv);
 static inline int   IMU_math_estmGyro   (float *q,  float *g,  float dt);
+static inline int   IMU_math_estmGyroExp(float *q,  float *g,  float dt);
+static inline int   IMU_math_estmGyroRK4(float *q,  float *g0, float *g1,
+                                         float dt);
+static inline float* IMU_math_gyroRate  (float *q,  float *g,  float *dq);
 int    IMU_math_estmAccl      (float *q, float *a, float alpha, float *FOM);
+int    IMU_math_estmAcclDCM   (float *q, float *R, float *a, float alpha,
+                               float *FOM);
 int    IMU_math_estmMagnNorm  (float *q, float *m, float alpha, float *FOM);
+int    IMU_math_estmMagnNormDCM(float *q, float *R, float *m, float alpha,
+                               float *FOM);
 int    IMU_math_estmMagnRef   (float *q, float *m, float refx,  float refz,
                                float alpha, float *FOM);
+int    IMU_math_estmFused     (float *q, float *g, float dt, float *a,
+                               float *m, float aAlpha, float mAlpha,
+                               float *FOM);
+int    IMU_math_mhnyAccl      (float *q, float *a, float kp, float *e,
+                               float *FOM);
+int    IMU_math_mhnyAcclDCM   (float *q, float *R, float *a, float kp,
+                               float *e, float *FOM);
+int    IMU_math_mhnyMagn      (float *q, float *m, float kp, float *e,
+                               float *FOM);
+int    IMU_math_mhnyMagnDCM   (float *q, float *R, float *m, float kp,
+                               float *e, float *FOM);
+int    IMU_math_mhnyFused     (float *q, float *g, float dt, float *a,
+                               float *m, float aKp, float mKp, float *e,
+                               float *FOM);
+int    IMU_math_mhnyFusedDCM  (float *q, float *R, float *g, float dt,
+                               float *a, float *m, float aKp, float mKp,
+                               float *e, float *FOM);
+
+
+/******************************************************************************
+* reciprocal square root - SSE estimate (12 bits) or the integer seed
+* (portable) refined by Newton-Raphson, relative error below 5e-6
+******************************************************************************/
+
+inline float IMU_math_rsqrt(
+  float                 x)
+{
+  #if defined(__SSE__)
+  float y               = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+  #else
+  union {float f; uint32_t i;} u = {x};
+  u.i                   = 0x5f375a86 - (u.i >> 1);
+  float y               = u.f;
+  y                     = y * (1.5f - 0.5f*x*y*y);
+  #endif
+  return y * (1.5f - 0.5f*x*y*y);
+}
+
+
+/******************************************************************************
+* normalize 3x1 array in place, returns magnitude
+******************************************************************************/
+
+inline float IMU_math_norm3(
+  float                 *v)
+{
+  float mag2            = v[0]*v[0] + v[1]*v[1] + v[2]*v[2];
+  float r               = IMU_math_rsqrt(mag2);
+  v[0]                 *= r;
+  v[1]                 *= r;
+  v[2]                 *= r;
+  return mag2 * r;
+}
+
+
+/******************************************************************************
+* normalize 4x1 array in place (left untouched near zero), returns magnitude
+******************************************************************************/
+
+inline float IMU_math_norm4(
+  float                 *v)
+{
+  float mag2            = v[0]*v[0] + v[1]*v[1] + v[2]*v[2] + v[3]*v[3];
+  if (mag2 <= 1e-6f)
+    return sqrtf(mag2);
+  float r               = IMU_math_rsqrt(mag2);
+  v[0]                 *= r;
+  v[1]                 *= r;
+  v[2]                 *= r;
+  v[3]                 *= r;
+  return mag2 * r;
+}
+
+
+/******************************************************************************
+* arc tangent of y/x (four quadrant) - odd 11th order minimax polynomial of
+* atan on [0,1] after octant reduction, max error 2e-6 rad (1e-4 deg)
+******************************************************************************/
+
+inline float IMU_math_atan2(
+  float                 y,
+  float                 x)
+{
+  float ax              = fabsf(x);
+  float ay              = fabsf(y);
+  float mx              = (ax > ay) ? ax : ay;
+  float a               = (ax > ay) ? ay : ax;
+  a                     = (mx > 0.0f) ? a / mx : 0.0f;
+  float s               = a * a;
+  float r               = a * ( 0.99997726f + s * (-0.33262347f +
+                                s * ( 0.19354346f + s * (-0.11643287f +
+                                s * ( 0.05265332f + s * (-0.01172120f))))));
+  if (ay > ax)
+    r                   = 1.57079637f - r;
+  if (x < 0.0f)
+    r                   = 3.14159274f - r;
+  return copysignf(r, y);
+}
+
+
+/******************************************************************************
+* arc sine - atan2 of x over cos, (1-x)(1+x) keeps cos accurate near +/-1
+******************************************************************************/
+
+inline float IMU_math_asin(
+  float                 x)
+{
+  if (x >  1.0f) x      =  1.0f;
+  if (x < -1.0f) x      = -1.0f;
+  return IMU_math_atan2(x, sqrtf((1.0f - x) * (1.0f + x)));
+}
 
 
 /******************************************************************************
@@ -133,6 +274,100 @@ inline float* IMU_math_rotateReverse(
 }
 
 
+/******************************************************************************
+* direction cosine matrix from quaternion (row major, R*v = rotateForward),
+* row 2 is the estimator gravity model, row 0 the estimator forward model,
+* columns 2 and 0 match quatToUp and quatToFrwd
+******************************************************************************/
+
+inline float* IMU_math_quatToDCM(
+  float                 *q,
+  float                 *R)
+{
+  float q0_q1           = q[0]*q[1];
+  float q0_q2           = q[0]*q[2];
+  float q0_q3           = q[0]*q[3];
+  float q1_q1           = q[1]*q[1];
+  float q1_q2           = q[1]*q[2];
+  float q1_q3           = q[1]*q[3];
+  float q2_q2           = q[2]*q[2];
+  float q2_q3           = q[2]*q[3];
+  float q3_q3           = q[3]*q[3];
+  R[0]                  = 1.0f - 2.0f * (q2_q2 + q3_q3);
+  R[1]                  = 2.0f * (q1_q2 - q0_q3);
+  R[2]                  = 2.0f * (q1_q3 + q0_q2);
+  R[3]                  = 2.0f * (q1_q2 + q0_q3);
+  R[4]                  = 1.0f - 2.0f * (q1_q1 + q3_q3);
+  R[5]                  = 2.0f * (q2_q3 - q0_q1);
+  R[6]                  = 2.0f * (q1_q3 - q0_q2);
+  R[7]                  = 2.0f * (q2_q3 + q0_q1);
+  R[8]                  = 1.0f - 2.0f * (q1_q1 + q2_q2);
+  return R;
+}
+
+
+/******************************************************************************
+* get up component from direction cosine matrix (same as quatToUp)
+******************************************************************************/
+
+inline float* IMU_math_dcmToUp(
+  float                 *R,
+  float                 *v)
+{
+  v[0]                  = R[2];
+  v[1]                  = R[5];
+  v[2]                  = R[8];
+  return v;
+}
+
+
+/******************************************************************************
+* get forward component from direction cosine matrix (same as quatToFrwd)
+******************************************************************************/
+
+inline float* IMU_math_dcmToFrwd(
+  float                 *R,
+  float                 *v)
+{
+  v[0]                  = R[0];
+  v[1]                  = R[3];
+  v[2]                  = R[6];
+  return v;
+}
+
+
+/******************************************************************************
+* rotate vector by direction cosine matrix (forward)
+******************************************************************************/
+
+inline float* IMU_math_dcmRotateForward(
+  float                 *v,
+  float                 *R,
+  float                 *out)
+{
+  out[0] = R[0]*v[0] + R[1]*v[1] + R[2]*v[2];
+  out[1] = R[3]*v[0] + R[4]*v[1] + R[5]*v[2];
+  out[2] = R[6]*v[0] + R[7]*v[1] + R[8]*v[2];
+  return out;
+}
+
+
+/******************************************************************************
+* rotate vector by direction cosine matrix (reverse)
+******************************************************************************/
+
+inline float* IMU_math_dcmRotateReverse(
+  float                 *v,
+  float                 *R,
+  float                 *out)
+{
+  out[0] = R[0]*v[0] + R[3]*v[1] + R[6]*v[2];
+  out[1] = R[1]*v[0] + R[4]*v[1] + R[7]*v[2];
+  out[2] = R[2]*v[0] + R[5]*v[1] + R[8]*v[2];
+  return out;
+}
+
+
 /******************************************************************************
 * get up component from quaternion
 ******************************************************************************/
@@ -171,13 +406,14 @@ inline float* IMU_math_upToQuat(
   float                 *u,
   float                 *q)
 {
-  float norm            = sqrtf(u[0]*u[0] + u[1]*u[1] + u[2]*u[2]);
+  float mag2            = u[0]*u[0] + u[1]*u[1] + u[2]*u[2];
+  float norm            = mag2 * IMU_math_rsqrt(mag2);
   q[0]                  = norm + u[2];
   if (q[0] > 0.001f * norm) {
-    norm                = sqrtf(q[0]*q[0] + u[0]*u[0] + u[1]*u[1]);
-    q[0]                =  q[0] / norm;
-    q[1]                = -u[1] / norm;
-    q[2]                =  u[0] / norm;
+    float r             = IMU_math_rsqrt(q[0]*q[0] + u[0]*u[0] + u[1]*u[1]);
+    q[0]                =  q[0] * r;
+    q[1]                = -u[1] * r;
+    q[2]                =  u[0] * r;
     q[3]                =  0.0f;
   } else {
     q[0]                =  1.0f;
@@ -199,48 +435,50 @@ inline float* IMU_math_upFrwdToQuat(
   float                 *q)
 {
   // normalize up vector
-  float n       = sqrtf(u_in[0]*u_in[0] + u_in[1]*u_in[1] + u_in[2]*u_in[2]);
-  float u[3]    = {u_in[0]/n, u_in[1]/n, u_in[2]/n};
+  float u[3]    = {u_in[0], u_in[1], u_in[2]};
+  IMU_math_norm3(u);
 
   // ortho-normalize forward vector 
-  n             = u[0]*f_in[0] + u[1]*f_in[1] + u[2]*f_in[2];
+  float n       = u[0]*f_in[0] + u[1]*f_in[1] + u[2]*f_in[2];
   float f[3]    = {f_in[0] - n*u[0], f_in[1] - n*u[1], f_in[2] - n*u[2]};
-  n             = sqrtf(f[0]*f[0] + f[1]*f[1] + f[2]*f[2]);
-  f[0]          = f[0] / n;
-  f[1]          = f[1] / n;
-  f[2]          = f[2] / n;
+  IMU_math_norm3(f);
 
   // calcuate the right vector (cross product)
   float r[3]    = {u[1]*f[2] - u[2]*f[1],
                    u[2]*f[0] - u[0]*f[2],
                    u[0]*f[1] - u[1]*f[0]};
+  float s;
 
-  // calculate the quaternion
+  // calculate the quaternion (1/(2*sqrt(t)) = 0.5*rsqrt(t), sqrt(t)/2 = t*s)
   n             = f[0]+r[1]+u[2];
   if (n > 0) {
-    n           = sqrtf(1.0+n)*2;
-    q[0]        = 0.25f*n;
-    q[1]        = (r[2]-u[1])/n;
-    q[2]        = (u[0]-f[2])/n;
-    q[3]        = (f[1]-r[0])/n;
+    n           = 1.0f + n;
+    s           = 0.5f * IMU_math_rsqrt(n);
+    q[0]        = n*s;
+    q[1]        = (r[2]-u[1])*s;
+    q[2]        = (u[0]-f[2])*s;
+    q[3]        = (f[1]-r[0])*s;
   } else if (f[0] > r[1] && f[0] > u[2]) {
-    n           = sqrtf(1.0+f[0]-r[1]-u[2])*2;
-    q[0]        = (r[2]-u[1])/n;
-    q[1]        = 0.25f*n;
-    q[2]        = (r[0]+f[1])/n;
-    q[3]        = (u[0]+f[2])/n;
+    n           = 1.0f+f[0]-r[1]-u[2];
+    s           = 0.5f * IMU_math_rsqrt(n);
+    q[0]        = (r[2]-u[1])*s;
+    q[1]        = n*s;
+    q[2]        = (r[0]+f[1])*s;
+    q[3]        = (u[0]+f[2])*s;
   } else if (r[1] > u[2]) {
-    n           = sqrtf(1.0+r[1]-f[0]-u[2])*2;
-    q[0]        = (u[0]-f[2])/n;
-    q[1]        = (r[0]+f[1])/n;
-    q[2]        = 0.25f*n;
-    q[3]        = (u[1]+r[2])/n;
+    n           = 1.0f+r[1]-f[0]-u[2];
+    s           = 0.5f * IMU_math_rsqrt(n);
+    q[0]        = (u[0]-f[2])*s;
+    q[1]        = (r[0]+f[1])*s;
+    q[2]        = n*s;
+    q[3]        = (u[1]+r[2])*s;
   } else {
-    n           = sqrtf(1.0+u[2]-f[0]-r[1])*2;
-    q[0]        = (f[1]-r[0])/n;
-    q[1]        = (u[0]+f[2])/n;
-    q[2]        = (u[1]+r[2])/n;
-    q[3]        = 0.25f*n;
+    n           = 1.0f+u[2]-f[0]-r[1];
+    s           = 0.5f * IMU_math_rsqrt(n);
+    q[0]        = (f[1]-r[0])*s;
+    q[1]        = (u[0]+f[2])*s;
+    q[2]        = (u[1]+r[2])*s;
+    q[3]        = n*s;
   }
 
   // exit function (allows function to be used as function argument)
@@ -313,6 +551,24 @@ inline float* IMU_math_quatToEuler(
 }
 
 
+/******************************************************************************
+* convert quaternion to Euler angles (single precision polynomial atan2/asin,
+* max error 2e-6 rad vs IMU_math_quatToEuler)
+******************************************************************************/
+
+inline float* IMU_math_quatToEulerFast(
+  float                 *q, 
+  float                 *E)
+{
+  E[2]  = IMU_math_atan2(2.0f * (q[0]*q[1] + q[2]*q[3]),
+                         1.0f - 2.0f * (q[1]*q[1] + q[2]*q[2]));
+  E[1]  = IMU_math_asin (2.0f * (q[0]*q[2] - q[3]*q[1]));
+  E[0]  = IMU_math_atan2(2.0f * (q[0]*q[3] + q[1]*q[2]),
+                         1.0f - 2.0f * (q[2]*q[2] + q[3]*q[3]));
+  return E; 
+}
+
+
 /******************************************************************************
 * convert Euler angles to quaternion
 * https://en.wikipedia.org/wiki/Conversion_between_quaternions_and_Euler_angles
@@ -388,6 +644,23 @@ inline float IMU_math_calcWeight(
 }
 
 
+/******************************************************************************
+* function used to apply target and threshold reciprocal (zero disables)
+******************************************************************************/
+
+inline float IMU_math_calcWeightInv(
+  float                 val, 
+  float                 ref, 
+  float                 inv)
+{
+  if (inv == 0.0f)
+    return              1.0f;
+  float error           = fabs(ref - val) * inv;
+  float result          = 1.0f - error;
+  return                (result < 0.0f) ? 0.0f : result;
+}
+
+
 /******************************************************************************
 * function used to apply gyroscope rates 
 ******************************************************************************/
@@ -410,6 +683,90 @@ inline int   IMU_math_estmGyro(
 }
 
 
+/******************************************************************************
+* function used to apply gyroscope rates (exponential map, exact for a
+* constant rate over dt, preserves quaternion norm)
+******************************************************************************/
+
+inline int   IMU_math_estmGyroExp(
+  float                 *q,
+  float                 *g,
+  float                 dt)
+{
+  float mag             = sqrtf(g[0]*g[0] + g[1]*g[1] + g[2]*g[2]);
+  float theta           = 0.5f * dt * mag;
+  float c, s;
+  if (theta > 0.001f) {
+    c                   = cosf(theta);
+    s                   = sinf(theta) / mag;
+  } else {
+    c                   = 1.0f - 0.5f * theta * theta;
+    s                   = 0.5f * dt * (1.0f - theta * theta / 6.0f);
+  }
+  float dq[4]           = {c, s*g[0], s*g[1], s*g[2]};
+  float q_in[4]         = {q[0], q[1], q[2], q[3]};
+  IMU_math_quatMult(q_in, dq, q);
+  return 0;
+}
+
+
+/******************************************************************************
+* function used to apply gyroscope rates (4th order Runge-Kutta, rate is
+* linearly interpolated from previous g0 to current g1 sample)
+******************************************************************************/
+
+inline int   IMU_math_estmGyroRK4(
+  float                 *q,
+  float                 *g0,
+  float                 *g1,
+  float                 dt)
+{
+  // define local variables
+  float half_dt         = 0.5f * dt;
+  float gm[3]           = {0.5f*(g0[0]+g1[0]),
+                           0.5f*(g0[1]+g1[1]),
+                           0.5f*(g0[2]+g1[2])};
+  float k1[4], k2[4], k3[4], k4[4], t[4];
+  int   i;
+
+  // evaluate the four slopes (quaternion rate is half of q*w)
+  IMU_math_gyroRate(q, g0, k1);
+  for (i=0; i<4; i++)
+    t[i]                = q[i] + 0.5f * half_dt * k1[i];
+  IMU_math_gyroRate(t, gm, k2);
+  for (i=0; i<4; i++)
+    t[i]                = q[i] + 0.5f * half_dt * k2[i];
+  IMU_math_gyroRate(t, gm, k3);
+  for (i=0; i<4; i++)
+    t[i]                = q[i] + half_dt * k3[i];
+  IMU_math_gyroRate(t, g1, k4);
+
+  // apply weighted slopes and normalize
+  float sixth_dt        = half_dt / 6.0f;
+  for (i=0; i<4; i++)
+    q[i]               += sixth_dt * (k1[i] + 2.0f*k2[i] + 2.0f*k3[i] + k4[i]);
+  IMU_math_norm4(q);
+  return 0;
+}
+
+
+/******************************************************************************
+* function used to compute quaternion product of q and gyroscope rates
+******************************************************************************/
+
+inline float* IMU_math_gyroRate(
+  float                 *q,
+  float                 *g,
+  float                 *dq)
+{
+  dq[0]                 = -q[1]*g[0] - q[2]*g[1] - q[3]*g[2];
+  dq[1]                 =  q[0]*g[0] + q[2]*g[2] - q[3]*g[1];
+  dq[2]                 =  q[0]*g[1] - q[1]*g[2] + q[3]*g[0];
+  dq[3]                 =  q[0]*g[2] + q[1]*g[1] - q[2]*g[0];
+  return dq;
+}
+
+
 #ifdef __cplusplus
 }
 #endif
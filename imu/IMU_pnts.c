@@ -23,45 +23,56 @@
 // include statements 
 #if IMU_USE_PTHREAD
 #include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
 #include <unistd.h>
 #endif
 #include <string.h>
 #include "IMU_pnts.h"
 
 // internal type definitions
-typedef struct{
-  uint16_t              id;
+#if IMU_USE_PTHREAD
+typedef struct {
   uint16_t              count;
-  IMU_pnts_entry        *entry;
+  IMU_pnts_entry        entry;
   void                  *pntr;
-} threadStruct;
+  void                  (*fnc)(IMU_PNTS_FNC_ARG);
+} IMU_pnts_event;
+typedef struct {
+  IMU_pnts_event        event      [IMU_PNTS_QUEUE_SIZE];
+  atomic_uint           head;
+  atomic_uint           tail;
+} IMU_pnts_queue;
+#endif
 
 // internally defined variables
-static IMU_pnts_config  config     [IMU_MAX_INST]; 
+static IMU_pnts_config *config     [IMU_MAX_INST];
+static IMU_pnts_config  configOwn  [IMU_MAX_INST];
 static IMU_pnts_state   state      [IMU_MAX_INST];
 static IMU_pnts_entry   table      [IMU_MAX_INST][IMU_PNTS_SIZE];
 static uint16_t         numInst    = 0;
 #if IMU_USE_PTHREAD
-static pthread_t        thrd1      [IMU_MAX_INST];
-static pthread_attr_t   thrd1Attr  [IMU_MAX_INST];
-static threadStruct     thrd1Val   [IMU_MAX_INST];
-static pthread_t        thrd2      [IMU_MAX_INST];
-static pthread_attr_t   thrd2Attr  [IMU_MAX_INST];
-static threadStruct     thrd2Val   [IMU_MAX_INST];
+static IMU_pnts_queue   queue      [IMU_MAX_INST];
+static pthread_t        thrd;
+static sem_t            thrdSem;
+static uint8_t          isThrd     = 0;
 #endif
 
 // internally defined functions
-static inline IMU_pnts_enum   update_state (uint16_t id, uint32_t, uint8_t,
+static inline IMU_pnts_enum   update_state (uint16_t id, IMU_time, uint8_t,
                                             IMU_pnts_entry**);
 static inline void            break_hold   (uint16_t id);
 static inline IMU_pnts_entry* break_stable (uint16_t id);
 static inline float calc_std       (float *val1, IMU_TYPE *val2);
 static inline void  apply_alpha    (float *prev, IMU_TYPE *cur, float alpha);
-static inline void  accum_gyro     (float *prev, IMU_TYPE *cur, IMU_TYPE t);
+static inline void  accum_gyro     (float *prev, IMU_TYPE *cur, IMU_time t);
 static inline void  copy_val       (float *val1, IMU_TYPE *val2);
 #if IMU_USE_PTHREAD
-static inline void* fncBreakPntr   (void*);
-static inline void* fncStablePntr  (void*);
+static inline int   start_worker   (void);
+static inline void  push_event     (uint16_t id, uint16_t count,
+                                    IMU_pnts_entry*, void*,
+                                    void (*fnc)(IMU_PNTS_FNC_ARG));
+static void*        run_worker     (void*);
 #endif
 
 
@@ -78,18 +89,18 @@ int IMU_pnts_init(
     return IMU_PNTS_INST_OVERFLOW;
 
   // initialize to known state
-  config[numInst].enable       = 0;
-  config[numInst].isGyro       = 1;
-  config[numInst].isAccl       = 1;
-  config[numInst].isMagn       = 1;
-  config[numInst].tHold        = 10000;
-  config[numInst].tStable      = 25000;
-  config[numInst].gAlpha       = 0.01f;
-  config[numInst].gThresh      = 0.0f;
-  config[numInst].aAlpha       = 0.01f;
-  config[numInst].aThresh      = 0.0f;
-  config[numInst].mAlpha       = 0.01f;
-  config[numInst].mThresh      = 0.0f;
+  configOwn[numInst].enable       = 0;
+  configOwn[numInst].isGyro       = 1;
+  configOwn[numInst].isAccl       = 1;
+  configOwn[numInst].isMagn       = 1;
+  configOwn[numInst].tHold        = 10000;
+  configOwn[numInst].tStable      = 25000;
+  configOwn[numInst].gAlpha       = 0.01f;
+  configOwn[numInst].gThresh      = 0.0f;
+  configOwn[numInst].aAlpha       = 0.01f;
+  configOwn[numInst].aThresh      = 0.0f;
+  configOwn[numInst].mAlpha       = 0.01f;
+  configOwn[numInst].mThresh      = 0.0f;
 
   // initialize the callback fnc
   state[numInst].fncStable     = NULL;
@@ -99,7 +110,8 @@ int IMU_pnts_init(
   
   // pass inst handle and config pointer
   *id   = numInst; 
-  *pntr = &config[*id];
+  config[*id] = &configOwn[*id];
+  *pntr = config[*id];
   numInst++;
 
   // initialize instance state
@@ -123,7 +135,25 @@ int IMU_pnts_getConfig(
     return IMU_PNTS_BAD_INST; 
 
   // pass state and exit (no errors)
-  *pntr = &config[id];
+  *pntr = config[id];
+  return 0;
+}
+
+
+/******************************************************************************
+* point instance at external config structure (owned by caller)
+******************************************************************************/
+
+int IMU_pnts_setConfig(
+  uint16_t                id,
+  IMU_pnts_config          *pntr)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_PNTS_BAD_INST;
+
+  // replace config pointer and exit (no errors)
+  config[id] = pntr;
   return 0;
 }
 
@@ -210,6 +240,12 @@ int IMU_pnts_fncStable(
   if (id >= numInst)
     return IMU_PNTS_BAD_INST;
 
+  // start callback worker (first registered callback)
+  #if IMU_USE_PTHREAD
+  if (fnc != NULL && start_worker())
+    return IMU_PNTS_THRD_FAILURE;
+  #endif
+
   // copy callback function and its pointer
   state[id].fncStable     = fnc;
   state[id].fncStablePntr = fncPntr;
@@ -233,6 +269,12 @@ int IMU_pnts_fncBreak(
   if (id >= numInst)
     return IMU_PNTS_BAD_INST;
 
+  // start callback worker (first registered callback)
+  #if IMU_USE_PTHREAD
+  if (fnc != NULL && start_worker())
+    return IMU_PNTS_THRD_FAILURE;
+  #endif
+
   // copy callback function and its pointer
   state[id].fncBreak      = fnc;
   state[id].fncBreakPntr  = fncPntr;
@@ -258,10 +300,12 @@ int IMU_pnts_reset(
   state[id].numPnts       = 0;
   state[id].curPnts       = 0;
   state[id].index         = 0;
+  state[id].t             = 0;
   state[id].tClock        = 1;
   state[id].gClock        = 1;
   state[id].aClock        = 1;
   state[id].mClock        = 1;
+  state[id].numDrop       = 0;
   state[id].current       = &table[id][0];
 
   // exit function (no errors)
@@ -381,21 +425,23 @@ int IMU_pnts_newGyro(
   *pntr                   = NULL;
 
   // determine whether the function needs to be executed
-  if (!config[id].isGyro || !config[id].enable)
+  if (!config[id]->isGyro || !config[id]->enable)
     return IMU_PNTS_FNC_DISABLED;
 
-  // define internal variables
+  // define internal variables (time extended to the 64-bit base)
   IMU_pnts_entry *entry   = state[id].current;
+  IMU_time tExt           = IMU_time_extend(state[id].t, t);
+  state[id].t             = tExt;
 
   // initialize sensor filter state
   if (state[id].tClock || state[id].gClock) {
     if (state[id].tClock)
-      state[id].tStable   = t;
+      state[id].tStable   = tExt;
     if (state[id].gClock) {
       copy_val(entry->gFltr, g);
       memset(entry->gAccum, 0, 3*sizeof(float));
-      entry->tStart       = t;
-      entry->tEnd         = t;
+      entry->tStart       = tExt;
+      entry->tEnd         = tExt;
     }
     state[id].tClock      = 0;
     state[id].gClock      = 0;
@@ -405,17 +451,17 @@ int IMU_pnts_newGyro(
 
   // calculate sensor mean and deviation
   float std = calc_std(entry->gFltr, g);
-  uint8_t isMove  = std > config[id].gThresh;
+  uint8_t isMove  = std > config[id]->gThresh;
   if (!(isMove && state[id].state == IMU_pnts_enum_stable))
-    apply_alpha(entry->gFltr, g, config[id].gAlpha);
+    apply_alpha(entry->gFltr, g, config[id]->gAlpha);
 
   // update state based on std and elapsed time
-  state[id].state = update_state(id, t, isMove, pntr);
+  state[id].state = update_state(id, tExt, isMove, pntr);
 
   // update accum and counts based on new state
   if (state[id].state == IMU_pnts_enum_move) {
-    accum_gyro(entry->gAccum, g, t - entry->tEnd);
-    entry->tEnd         = t;
+    accum_gyro(entry->gAccum, g, tExt - entry->tEnd);
+    entry->tEnd         = tExt;
   } else if (state[id].state == IMU_pnts_enum_stable)
     entry->gCount++;
   
@@ -437,13 +483,15 @@ int IMU_pnts_newAccl(
   // initialize output to NULL
   *pntr                   = NULL;
 
-  // define internal variables
+  // define internal variables (time extended to the 64-bit base)
   IMU_pnts_entry *entry   = state[id].current;
+  IMU_time tExt           = IMU_time_extend(state[id].t, t);
+  state[id].t             = tExt;
 
   // initialize sensor filter state
   if (state[id].tClock || state[id].aClock) {
     if (state[id].tClock)
-      state[id].tStable   = t;
+      state[id].tStable   = tExt;
     if (state[id].aClock)
       copy_val(entry->aFltr, a);
     state[id].tClock      = 0;
@@ -454,12 +502,12 @@ int IMU_pnts_newAccl(
 
   // calculate sensor mean and deviation
   float std = calc_std(entry->aFltr, a);
-  uint8_t isMove  = std > config[id].aThresh;
+  uint8_t isMove  = std > config[id]->aThresh;
   if (!(isMove && state[id].state == IMU_pnts_enum_stable))
-    apply_alpha(entry->aFltr, a, config[id].aAlpha);
+    apply_alpha(entry->aFltr, a, config[id]->aAlpha);
 
   // update state based on std and elapsed time
-  state[id].state = update_state(id, t, isMove, pntr);
+  state[id].state = update_state(id, tExt, isMove, pntr);
 
   // update counts based on new state
   if (state[id].state == IMU_pnts_enum_stable)
@@ -483,13 +531,15 @@ int IMU_pnts_newMagn(
   // initialize output to NULL
   *pntr                   = NULL;
 
-  // define internal variables
+  // define internal variables (time extended to the 64-bit base)
   IMU_pnts_entry *entry   = state[id].current;
+  IMU_time tExt           = IMU_time_extend(state[id].t, t);
+  state[id].t             = tExt;
 
   // initialize sensor filter state
   if (state[id].tClock || state[id].mClock) {
     if (state[id].tClock)
-      state[id].tStable   = t;
+      state[id].tStable   = tExt;
     if (state[id].mClock)
       copy_val(entry->mFltr, m);
     state[id].tClock      = 0;
@@ -500,12 +550,12 @@ int IMU_pnts_newMagn(
 
   // calculate sensor mean and deviation
   float std = calc_std(entry->mFltr, m);
-  uint8_t isMove  = std > config[id].mThresh;
+  uint8_t isMove  = std > config[id]->mThresh;
   if (!(isMove && state[id].state == IMU_pnts_enum_stable))
-    apply_alpha(entry->mFltr, m, config[id].mAlpha);
+    apply_alpha(entry->mFltr, m, config[id]->mAlpha);
 
   // update state based on std and elapsed time
-  state[id].state = update_state(id, t, isMove, pntr);
+  state[id].state = update_state(id, tExt, isMove, pntr);
 
   // update counts based on new state
   if (state[id].state == IMU_pnts_enum_stable)
@@ -522,7 +572,7 @@ int IMU_pnts_newMagn(
 
 inline IMU_pnts_enum update_state(
   uint16_t                id,
-  uint32_t                t,
+  IMU_time                t,
   uint8_t                 isMove,
   IMU_pnts_entry          **pntr)
 {
@@ -535,12 +585,12 @@ inline IMU_pnts_enum update_state(
   }
 
   // update state based on elapsed stable time
-  if (t - state[id].tStable >= (uint32_t)config[id].tStable) {
+  if (t - state[id].tStable >= (IMU_time)config[id]->tStable) {
     if (state[id].state == IMU_pnts_enum_hold)
       break_hold(id);
     return IMU_pnts_enum_stable;
   }
-  if (t - state[id].tStable >= (uint32_t)config[id].tHold)
+  if (t - state[id].tStable >= (IMU_time)config[id]->tHold)
     return IMU_pnts_enum_hold;
   else
     return IMU_pnts_enum_move;
@@ -554,15 +604,12 @@ inline IMU_pnts_enum update_state(
 inline void break_hold(
   uint16_t                id)
 {
-  // update current points count and launch thread
+  // update current points count and queue callback
   if (state[id].curPnts < state[id].numPnts && state[id].fncStable != NULL) {
     IMU_pnts_entry *entry = state[id].current;
     #if IMU_USE_PTHREAD
-    thrd1Val[id].id       = id;
-    thrd1Val[id].count    = state[id].curPnts;
-    thrd1Val[id].entry    = entry;
-    thrd1Val[id].pntr     = state[id].fncStablePntr;
-    pthread_create(&thrd1[id], &thrd1Attr[id], fncStablePntr, &thrd1Val[id]);
+    push_event(id, state[id].curPnts, entry, state[id].fncStablePntr,
+               state[id].fncStable);
     #else
     state[id].fncStable(state[id].curPnts, entry, state[id].fncStablePntr);
     #endif
@@ -584,16 +631,13 @@ inline IMU_pnts_entry* break_stable(
     state[id].index       = 0;
   state[id].current       = &table[id][state[id].index];
 
-  // update current points count and launch thread
+  // update current points count and queue callback
   if (state[id].curPnts < state[id].numPnts) {
     state[id].curPnts++;
     if (state[id].fncBreak != NULL) {
       #if IMU_USE_PTHREAD
-      thrd2Val[id].id     = id;
-      thrd2Val[id].count  = state[id].curPnts-1;
-      thrd2Val[id].entry  = entry;
-      thrd2Val[id].pntr   = state[id].fncBreakPntr;
-      pthread_create(&thrd2[id], &thrd2Attr[id], fncBreakPntr, &thrd2Val[id]);
+      push_event(id, state[id].curPnts-1, entry, state[id].fncBreakPntr,
+                 state[id].fncBreak);
       #else
       state[id].fncBreak(state[id].curPnts-1, entry, state[id].fncBreakPntr);
       #endif
@@ -605,30 +649,115 @@ inline IMU_pnts_entry* break_stable(
 }
 
 
+#if IMU_USE_PTHREAD
 /******************************************************************************
-* utility function - execute function handle
+* utility function - start persistent callback worker (detached, runs for the
+* life of the process)
 ******************************************************************************/
 
-void* fncStablePntr(
-  void                    *pntr)
+inline int start_worker(void)
 {
-  threadStruct *vals = (threadStruct*)pntr;
-  state[vals->id].fncStable(vals->count, vals->entry, vals->pntr);
-  return NULL;
+  // define local variables
+  pthread_attr_t          attr;
+  int                     status;
+
+  // worker already running
+  if (isThrd)
+    return 0;
+
+  // create wake-up semaphore and detached worker
+  if (sem_init(&thrdSem, 0, 0))
+    return IMU_PNTS_THRD_FAILURE;
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  status = pthread_create(&thrd, &attr, run_worker, NULL);
+  pthread_attr_destroy(&attr);
+  if (status) {
+    sem_destroy(&thrdSem);
+    return IMU_PNTS_THRD_FAILURE;
+  }
+
+  // exit function (no errors)
+  isThrd                  = 1;
+  return 0;
+}
+
+
+/******************************************************************************
+* utility function - copy entry to instance event queue (single producer,
+* never blocks, event dropped and counted given full queue)
+******************************************************************************/
+
+inline void push_event(
+  uint16_t                id,
+  uint16_t                count,
+  IMU_pnts_entry          *entry,
+  void                    *pntr,
+  void                    (*fnc)(IMU_PNTS_FNC_ARG))
+{
+  // check queue overflow
+  IMU_pnts_queue *q       = &queue[id];
+  unsigned head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  unsigned tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+  if (head - tail >= IMU_PNTS_QUEUE_SIZE) {
+    state[id].numDrop++;
+    return;
+  }
+
+  // copy event to queue (entry copied, table slot is reused)
+  IMU_pnts_event *event   = &q->event[head & (IMU_PNTS_QUEUE_SIZE-1)];
+  event->count            = count;
+  event->pntr             = pntr;
+  event->fnc              = fnc;
+  memcpy(&event->entry, entry, sizeof(IMU_pnts_entry));
+
+  // publish event and wake worker
+  atomic_store_explicit(&q->head, head + 1, memory_order_release);
+  sem_post(&thrdSem);
 }
 
 
 /******************************************************************************
-* utility function - execute function handle
+* utility function - callback worker (one semaphore count per queued event,
+* executes each instance's callbacks in queue order)
 ******************************************************************************/
 
-void* fncBreakPntr(
+void* run_worker(
   void                    *pntr)
 {
-  threadStruct *vals = (threadStruct*)pntr;
-  state[vals->id].fncBreak(vals->count, vals->entry, vals->pntr);
+  // define local variables
+  IMU_pnts_queue          *q    = NULL;
+  IMU_pnts_event          *event;
+  unsigned                head  = 0, tail = 0;
+  uint16_t                i, next = 0;
+  (void)pntr;
+
+  // main processing loop
+  while (1) {
+
+    // wait until an event is queued
+    while (sem_wait(&thrdSem) != 0);
+
+    // find instance with pending event (rotate start for fairness)
+    for (i=0; i<IMU_MAX_INST; i++) {
+      q    = &queue[(next + i) % IMU_MAX_INST];
+      tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+      head = atomic_load_explicit(&q->head, memory_order_acquire);
+      if (head != tail)
+        break;
+    }
+    next                  = (next + 1) % IMU_MAX_INST;
+    if (head == tail)
+      continue;
+
+    // execute callback then release queue slot
+    event                 = &q->event[tail & (IMU_PNTS_QUEUE_SIZE-1)];
+    event->fnc(event->count, &event->entry, event->pntr);
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+  }
   return NULL;
 }
+#endif
 
 
 /******************************************************************************
@@ -673,7 +802,7 @@ inline void apply_alpha(
 inline void accum_gyro(
   float                   *prev, 
   IMU_TYPE                *cur, 
-  IMU_TYPE                time)
+  IMU_time                time)
 {
   float time_s            = (float)time * IMU_PNTS_10USEC_TO_SEC;
   prev[0]                += time_s * (float)cur[0];
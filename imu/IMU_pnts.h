@@ -33,9 +33,13 @@ extern "C" {
 #define IMU_PNTS_BAD_INST        -2
 #define IMU_PNTS_BAD_INDEX       -3
 #define IMU_PNTS_FNC_DISABLED    -4
+#define IMU_PNTS_THRD_FAILURE    -5
 
 // define constants
 #define IMU_PNTS_10USEC_TO_SEC   0.00001
+#ifndef IMU_PNTS_QUEUE_SIZE
+#define IMU_PNTS_QUEUE_SIZE      16       // callback events (power of two)
+#endif
 
 // define callback function args
 #define IMU_PNTS_FNC_ARG         uint16_t, IMU_pnts_entry*, void*
@@ -67,7 +71,9 @@ typedef struct {
   uint8_t                gClock;
   uint8_t                aClock;
   uint8_t                mClock;
-  uint32_t               tStable;
+  IMU_time               t;               // last datum time (10usec)
+  IMU_time               tStable;
+  uint32_t               numDrop;         // callback events dropped (full)
   IMU_pnts_entry         *current;
   void                   *fncStablePntr;
   void                   *fncBreakPntr;
@@ -77,8 +83,8 @@ typedef struct {
 
 // define report fo calibration point
 struct IMU_pnts_entry{
-  IMU_TYPE               tStart;
-  IMU_TYPE               tEnd;
+  IMU_time               tStart;
+  IMU_time               tEnd;
   float                  gAccum[3];
   float                  gFltr[3];
   float                  aFltr[3];
@@ -92,6 +98,7 @@ struct IMU_pnts_entry{
 // data structure access function
 int IMU_pnts_init       (uint16_t *id, IMU_pnts_config**);
 int IMU_pnts_getConfig   (uint16_t id, IMU_pnts_config**);
+int IMU_pnts_setConfig   (uint16_t id, IMU_pnts_config*);
 int IMU_pnts_getState    (uint16_t id, IMU_pnts_state**);
 
 // points table access function (requires calib_table_size greater than one)
@@ -28,7 +28,8 @@
 #include "IMU_rect.h"
 
 // internally managed structures
-static IMU_rect_config  config[IMU_MAX_INST];
+static IMU_rect_config *config[IMU_MAX_INST];
+static IMU_rect_config  configOwn[IMU_MAX_INST];
 static uint16_t         numInst = 0;
 
 
@@ -45,26 +46,27 @@ int IMU_rect_init(
     return IMU_RECT_INST_OVERFLOW;
     
   // intialize to known state
-  memset(config[numInst].gBias, 0.0f, sizeof config[numInst].gBias);
-  memset(config[numInst].gMult, 0.0f, sizeof config[numInst].gMult);
-  memset(config[numInst].aBias, 0.0f, sizeof config[numInst].aBias);
-  memset(config[numInst].aMult, 0.0f, sizeof config[numInst].aMult);
-  memset(config[numInst].mBias, 0.0f, sizeof config[numInst].mBias);
-  memset(config[numInst].mMult, 0.0f, sizeof config[numInst].mMult);
-  config[numInst].gMult[0]  = 1.0f;
-  config[numInst].gMult[4]  = 1.0f;
-  config[numInst].gMult[8]  = 1.0f;
-  config[numInst].aMult[0]  = 1.0f;
-  config[numInst].aMult[4]  = 1.0f;
-  config[numInst].aMult[8]  = 1.0f;
-  config[numInst].mMult[0]  = 1.0f;
-  config[numInst].mMult[4]  = 1.0f;
-  config[numInst].mMult[8]  = 1.0f;
-  config[numInst].enable    = 1;
+  memset(configOwn[numInst].gBias, 0.0f, sizeof configOwn[numInst].gBias);
+  memset(configOwn[numInst].gMult, 0.0f, sizeof configOwn[numInst].gMult);
+  memset(configOwn[numInst].aBias, 0.0f, sizeof configOwn[numInst].aBias);
+  memset(configOwn[numInst].aMult, 0.0f, sizeof configOwn[numInst].aMult);
+  memset(configOwn[numInst].mBias, 0.0f, sizeof configOwn[numInst].mBias);
+  memset(configOwn[numInst].mMult, 0.0f, sizeof configOwn[numInst].mMult);
+  configOwn[numInst].gMult[0]  = 1.0f;
+  configOwn[numInst].gMult[4]  = 1.0f;
+  configOwn[numInst].gMult[8]  = 1.0f;
+  configOwn[numInst].aMult[0]  = 1.0f;
+  configOwn[numInst].aMult[4]  = 1.0f;
+  configOwn[numInst].aMult[8]  = 1.0f;
+  configOwn[numInst].mMult[0]  = 1.0f;
+  configOwn[numInst].mMult[4]  = 1.0f;
+  configOwn[numInst].mMult[8]  = 1.0f;
+  configOwn[numInst].enable    = 1;
 
   // pass handle and config pointer
   *id    = numInst; 
-  *pntr  = &config[*id];
+  config[*id] = &configOwn[*id];
+  *pntr  = config[*id];
   numInst++;
   return 0;
 }
@@ -83,7 +85,25 @@ int IMU_rect_getConfig(
     return IMU_RECT_BAD_INST; 
 
   // return state
-  *pntr = &config[id];
+  *pntr = config[id];
+  return 0;
+}
+
+
+/******************************************************************************
+* point instance at external config structure (owned by caller)
+******************************************************************************/
+
+int IMU_rect_setConfig(
+  uint16_t              id,
+  IMU_rect_config        *pntr)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_RECT_BAD_INST;
+
+  // replace config pointer and exit (no errors)
+  config[id] = pntr;
   return 0;
 }
 
@@ -141,17 +161,17 @@ int IMU_rect_gyro(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_RECT_BAD_INST;
-  if (!config[id].enable)
+  if (!config[id]->enable)
     return IMU_RECT_FNC_DISABLED;
 
   // apply bias
-  float *bias  = config[id].gBias;
+  float *bias  = config[id]->gBias;
   float g[3]   = {(float)g_raw[0] + bias[0], 
                   (float)g_raw[1] + bias[1],
                   (float)g_raw[2] + bias[2]};
 
   // apply transform
-  float *mult  = config[id].gMult; 
+  float *mult  = config[id]->gMult; 
   g_out[0]     = (IMU_TYPE)(g[0]*mult[0] + g[1]*mult[1] + g[2]*mult[2]);
   g_out[1]     = (IMU_TYPE)(g[0]*mult[3] + g[1]*mult[4] + g[2]*mult[5]);
   g_out[2]     = (IMU_TYPE)(g[0]*mult[6] + g[1]*mult[7] + g[2]*mult[8]);
@@ -173,17 +193,17 @@ int IMU_rect_accl(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_RECT_BAD_INST;
-  if (!config[id].enable)
+  if (!config[id]->enable)
     return IMU_RECT_FNC_DISABLED;
 
   // apply bias
-  float *bias  = config[id].aBias;
+  float *bias  = config[id]->aBias;
   float a[3]   = {(float)a_raw[0] + bias[0],
                   (float)a_raw[1] + bias[1],
                   (float)a_raw[2] + bias[2]};
 
   // apply transform
-  float *mult  = config[id].aMult; 
+  float *mult  = config[id]->aMult; 
   a_out[0]     = (IMU_TYPE)(a[0]*mult[0] + a[1]*mult[1] + a[2]*mult[2]);
   a_out[1]     = (IMU_TYPE)(a[0]*mult[3] + a[1]*mult[4] + a[2]*mult[5]);
   a_out[2]     = (IMU_TYPE)(a[0]*mult[6] + a[1]*mult[7] + a[2]*mult[8]);
@@ -206,17 +226,17 @@ int IMU_rect_magn(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_RECT_BAD_INST;
-  if (!config[id].enable)
+  if (!config[id]->enable)
     return IMU_RECT_FNC_DISABLED;
 
   // apply bias
-  float *bias  = config[id].mBias;
+  float *bias  = config[id]->mBias;
   float m[3]   = {(float)m_raw[0] + bias[0],
                   (float)m_raw[1] + bias[1],
                   (float)m_raw[2] + bias[2]};
 
   // apply transform
-  float *mult  = config[id].mMult; 
+  float *mult  = config[id]->mMult; 
   m_out[0]     = (IMU_TYPE)(m[0]*mult[0] + m[1]*mult[1] + m[2]*mult[2]);
   m_out[1]     = (IMU_TYPE)(m[0]*mult[3] + m[1]*mult[4] + m[2]*mult[5]);
   m_out[2]     = (IMU_TYPE)(m[0]*mult[6] + m[1]*mult[7] + m[2]*mult[8]);
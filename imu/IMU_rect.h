@@ -52,6 +52,7 @@ typedef struct {
 // data structure access functions
 int IMU_rect_init      (uint16_t *id, IMU_rect_config **config);
 int IMU_rect_getConfig  (uint16_t id, IMU_rect_config **config);
+int IMU_rect_setConfig  (uint16_t id, IMU_rect_config *config);
 
 // raw data correction functions
 int IMU_rect_datum  (uint16_t id, IMU_datum*);
@@ -0,0 +1,410 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Batched kernels are written once (IMU_simd_kern.h) with GCC vector
+ * extensions and compiled per instruction set through target attributes,
+ * so the library builds without -mavx flags. The instruction set is
+ * detected (cpuid) on first use and can be pinned for testing; samples that
+ * do not fill a vector are finished by the scalar IMU_math reference.
+*/
+
+// include statements
+#include "IMU_math.h"
+#include "IMU_simd.h"
+
+// x86 vector extensions (other targets use the scalar reference)
+#if defined(__x86_64__) || defined(__i386__)
+#define IMU_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define IMU_SIMD_X86 0
+#endif
+
+// kernel function table
+typedef struct {
+  uint32_t (*quatMult)      (IMU_simd_quat*, IMU_simd_quat*, IMU_simd_quat*,
+                             uint32_t, uint32_t);
+  uint32_t (*quatMultConj)  (IMU_simd_quat*, IMU_simd_quat*, IMU_simd_quat*,
+                             uint32_t, uint32_t);
+  uint32_t (*rotateForward) (IMU_simd_vect*, IMU_simd_quat*, IMU_simd_vect*,
+                             uint32_t, uint32_t);
+  uint32_t (*rotateReverse) (IMU_simd_vect*, IMU_simd_quat*, IMU_simd_vect*,
+                             uint32_t, uint32_t);
+  uint32_t (*quatToUp)      (IMU_simd_quat*, IMU_simd_vect*,
+                             uint32_t, uint32_t);
+  uint32_t (*quatToFrwd)    (IMU_simd_quat*, IMU_simd_vect*,
+                             uint32_t, uint32_t);
+  uint32_t (*quatToEuler)   (IMU_simd_quat*, IMU_simd_vect*,
+                             uint32_t, uint32_t);
+} IMU_simd_fnc;
+
+// internally defined functions
+static uint32_t ref_quatMult      (IMU_simd_quat*, IMU_simd_quat*,
+                                   IMU_simd_quat*, uint32_t, uint32_t);
+static uint32_t ref_quatMultConj  (IMU_simd_quat*, IMU_simd_quat*,
+                                   IMU_simd_quat*, uint32_t, uint32_t);
+static uint32_t ref_rotateForward (IMU_simd_vect*, IMU_simd_quat*,
+                                   IMU_simd_vect*, uint32_t, uint32_t);
+static uint32_t ref_rotateReverse (IMU_simd_vect*, IMU_simd_quat*,
+                                   IMU_simd_vect*, uint32_t, uint32_t);
+static uint32_t ref_quatToUp      (IMU_simd_quat*, IMU_simd_vect*,
+                                   uint32_t, uint32_t);
+static uint32_t ref_quatToFrwd    (IMU_simd_quat*, IMU_simd_vect*,
+                                   uint32_t, uint32_t);
+static uint32_t ref_quatToEuler   (IMU_simd_quat*, IMU_simd_vect*,
+                                   uint32_t, uint32_t);
+static inline const IMU_simd_fnc* table(void);
+
+// scalar reference table
+static const IMU_simd_fnc fnc_ref = {
+  ref_quatMult,
+  ref_quatMultConj,
+  ref_rotateForward,
+  ref_rotateReverse,
+  ref_quatToUp,
+  ref_quatToFrwd,
+  ref_quatToEuler};
+
+// vectorized tables (one template instance per instruction set)
+#if IMU_SIMD_X86
+#define IMU_SIMD_SFX          sse2
+#define IMU_SIMD_W            4
+#define IMU_SIMD_ATTR         __attribute__((target("sse2")))
+#define IMU_SIMD_SQRT(v)      ((VEC)_mm_sqrt_ps((__m128)(v)))
+#include "IMU_simd_kern.h"
+#undef  IMU_SIMD_SFX
+#undef  IMU_SIMD_W
+#undef  IMU_SIMD_ATTR
+#undef  IMU_SIMD_SQRT
+#define IMU_SIMD_SFX          avx2
+#define IMU_SIMD_W            8
+#define IMU_SIMD_ATTR         __attribute__((target("avx2,fma")))
+#define IMU_SIMD_SQRT(v)      ((VEC)_mm256_sqrt_ps((__m256)(v)))
+#include "IMU_simd_kern.h"
+#undef  IMU_SIMD_SFX
+#undef  IMU_SIMD_W
+#undef  IMU_SIMD_ATTR
+#undef  IMU_SIMD_SQRT
+#define IMU_SIMD_SFX          avx512
+#define IMU_SIMD_W            16
+#define IMU_SIMD_ATTR         __attribute__((target("avx512f")))
+#define IMU_SIMD_SQRT(v)      ((VEC)_mm512_sqrt_ps((__m512)(v)))
+#include "IMU_simd_kern.h"
+#undef  IMU_SIMD_SFX
+#undef  IMU_SIMD_W
+#undef  IMU_SIMD_ATTR
+#undef  IMU_SIMD_SQRT
+#endif
+
+// internally managed structures
+static const IMU_simd_fnc *fnc     = NULL;
+static IMU_simd_isa       isaCur   = IMU_simd_scalar;
+
+
+/******************************************************************************
+* best instruction set supported by the processor (and operating system)
+******************************************************************************/
+
+IMU_simd_isa IMU_simd_bestIsa(void)
+{
+  #if IMU_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return IMU_simd_avx512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    return IMU_simd_avx2;
+  if (__builtin_cpu_supports("sse2"))
+    return IMU_simd_sse2;
+  #endif
+  return IMU_simd_scalar;
+}
+
+
+/******************************************************************************
+* select instruction set (rejects sets not supported by the processor)
+******************************************************************************/
+
+int IMU_simd_setIsa(
+  IMU_simd_isa          isa)
+{
+  // check that the processor supports the requested set
+  if (isa > IMU_simd_bestIsa())
+    return IMU_SIMD_BAD_ISA;
+
+  // select function table
+  switch (isa) {
+    #if IMU_SIMD_X86
+    case IMU_simd_sse2:   fnc = &fnc_sse2;   break;
+    case IMU_simd_avx2:   fnc = &fnc_avx2;   break;
+    case IMU_simd_avx512: fnc = &fnc_avx512; break;
+    #endif
+    default:              fnc = &fnc_ref;    break;
+  }
+  isaCur                = isa;
+
+  // exit (no errors)
+  return 0;
+}
+
+
+/******************************************************************************
+* return selected instruction set
+******************************************************************************/
+
+IMU_simd_isa IMU_simd_getIsa(void)
+{
+  table();
+  return isaCur;
+}
+
+
+/******************************************************************************
+* batched quaternion multiplication
+******************************************************************************/
+
+int IMU_simd_quatMult(
+  IMU_simd_quat         *q1,
+  IMU_simd_quat         *q2,
+  IMU_simd_quat         *out,
+  uint32_t              num)
+{
+  uint32_t i = table()->quatMult(q1, q2, out, 0, num);
+  ref_quatMult(q1, q2, out, i, num);
+  return 0;
+}
+
+
+/******************************************************************************
+* batched quaternion multiplication w/ conjugate
+******************************************************************************/
+
+int IMU_simd_quatMultConj(
+  IMU_simd_quat         *q1,
+  IMU_simd_quat         *q2,
+  IMU_simd_quat         *out,
+  uint32_t              num)
+{
+  uint32_t i = table()->quatMultConj(q1, q2, out, 0, num);
+  ref_quatMultConj(q1, q2, out, i, num);
+  return 0;
+}
+
+
+/******************************************************************************
+* batched vector rotation by quaternion (forward)
+******************************************************************************/
+
+int IMU_simd_rotateForward(
+  IMU_simd_vect         *v,
+  IMU_simd_quat         *q,
+  IMU_simd_vect         *out,
+  uint32_t              num)
+{
+  uint32_t i = table()->rotateForward(v, q, out, 0, num);
+  ref_rotateForward(v, q, out, i, num);
+  return 0;
+}
+
+
+/******************************************************************************
+* batched vector rotation by quaternion (reverse)
+******************************************************************************/
+
+int IMU_simd_rotateReverse(
+  IMU_simd_vect         *v,
+  IMU_simd_quat         *q,
+  IMU_simd_vect         *out,
+  uint32_t              num)
+{
+  uint32_t i = table()->rotateReverse(v, q, out, 0, num);
+  ref_rotateReverse(v, q, out, i, num);
+  return 0;
+}
+
+
+/******************************************************************************
+* batched up component from quaternion
+******************************************************************************/
+
+int IMU_simd_quatToUp(
+  IMU_simd_quat         *q,
+  IMU_simd_vect         *v,
+  uint32_t              num)
+{
+  uint32_t i = table()->quatToUp(q, v, 0, num);
+  ref_quatToUp(q, v, i, num);
+  return 0;
+}
+
+
+/******************************************************************************
+* batched forward component from quaternion
+******************************************************************************/
+
+int IMU_simd_quatToFrwd(
+  IMU_simd_quat         *q,
+  IMU_simd_vect         *v,
+  uint32_t              num)
+{
+  uint32_t i = table()->quatToFrwd(q, v, 0, num);
+  ref_quatToFrwd(q, v, i, num);
+  return 0;
+}
+
+
+/******************************************************************************
+* batched quaternion to Euler angles
+******************************************************************************/
+
+int IMU_simd_quatToEuler(
+  IMU_simd_quat         *q,
+  IMU_simd_vect         *E,
+  uint32_t              num)
+{
+  uint32_t i = table()->quatToEuler(q, E, 0, num);
+  ref_quatToEuler(q, E, i, num);
+  return 0;
+}
+
+
+/******************************************************************************
+* utility function - selected table (best set chosen on first use)
+******************************************************************************/
+
+inline const IMU_simd_fnc* table(void)
+{
+  if (fnc == NULL)
+    IMU_simd_setIsa(IMU_simd_bestIsa());
+  return fnc;
+}
+
+
+/******************************************************************************
+* scalar reference - gather sample, apply IMU_math operator, scatter result
+******************************************************************************/
+
+#define REF_GET4(s, i)     {s->q[0][i], s->q[1][i], s->q[2][i], s->q[3][i]}
+#define REF_GET3(s, i)     {s->v[0][i], s->v[1][i], s->v[2][i]}
+#define REF_PUT4(s, x, i)  {s->q[0][i] = x[0]; s->q[1][i] = x[1]; \
+                            s->q[2][i] = x[2]; s->q[3][i] = x[3];}
+#define REF_PUT3(s, x, i)  {s->v[0][i] = x[0]; s->v[1][i] = x[1]; \
+                            s->v[2][i] = x[2];}
+
+uint32_t ref_quatMult(
+  IMU_simd_quat         *q1,
+  IMU_simd_quat         *q2,
+  IMU_simd_quat         *out,
+  uint32_t              i,
+  uint32_t              num)
+{
+  for (; i<num; i++) {
+    float a[4] = REF_GET4(q1, i), b[4] = REF_GET4(q2, i), c[4];
+    IMU_math_quatMult(a, b, c);
+    REF_PUT4(out, c, i);
+  }
+  return i;
+}
+
+uint32_t ref_quatMultConj(
+  IMU_simd_quat         *q1,
+  IMU_simd_quat         *q2,
+  IMU_simd_quat         *out,
+  uint32_t              i,
+  uint32_t              num)
+{
+  for (; i<num; i++) {
+    float a[4] = REF_GET4(q1, i), b[4] = REF_GET4(q2, i), c[4];
+    IMU_math_quatMultConj(a, b, c);
+    REF_PUT4(out, c, i);
+  }
+  return i;
+}
+
+uint32_t ref_rotateForward(
+  IMU_simd_vect         *v,
+  IMU_simd_quat         *q,
+  IMU_simd_vect         *out,
+  uint32_t              i,
+  uint32_t              num)
+{
+  for (; i<num; i++) {
+    float a[3] = REF_GET3(v, i), b[4] = REF_GET4(q, i), c[3];
+    IMU_math_rotateForward(a, b, c);
+    REF_PUT3(out, c, i);
+  }
+  return i;
+}
+
+uint32_t ref_rotateReverse(
+  IMU_simd_vect         *v,
+  IMU_simd_quat         *q,
+  IMU_simd_vect         *out,
+  uint32_t              i,
+  uint32_t              num)
+{
+  for (; i<num; i++) {
+    float a[3] = REF_GET3(v, i), b[4] = REF_GET4(q, i), c[3];
+    IMU_math_rotateReverse(a, b, c);
+    REF_PUT3(out, c, i);
+  }
+  return i;
+}
+
+uint32_t ref_quatToUp(
+  IMU_simd_quat         *q,
+  IMU_simd_vect         *v,
+  uint32_t              i,
+  uint32_t              num)
+{
+  for (; i<num; i++) {
+    float a[4] = REF_GET4(q, i), c[3];
+    IMU_math_quatToUp(a, c);
+    REF_PUT3(v, c, i);
+  }
+  return i;
+}
+
+uint32_t ref_quatToFrwd(
+  IMU_simd_quat         *q,
+  IMU_simd_vect         *v,
+  uint32_t              i,
+  uint32_t              num)
+{
+  for (; i<num; i++) {
+    float a[4] = REF_GET4(q, i), c[3];
+    IMU_math_quatToFrwd(a, c);
+    REF_PUT3(v, c, i);
+  }
+  return i;
+}
+
+uint32_t ref_quatToEuler(
+  IMU_simd_quat         *q,
+  IMU_simd_vect         *E,
+  uint32_t              i,
+  uint32_t              num)
+{
+  for (; i<num; i++) {
+    float a[4] = REF_GET4(q, i), c[3];
+    IMU_math_quatToEulerFast(a, c);
+    REF_PUT3(E, c, i);
+  }
+  return i;
+}
@@ -0,0 +1,82 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _IMU_SIMD_H
+#define _IMU_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// include statements
+#include <stdint.h>
+
+// define error codes
+#define IMU_SIMD_BAD_ISA           -1
+
+// batch of quaternions (structure of arrays, component i at q[i][n])
+typedef struct {
+  float                 *q[4];           // w, x, y, z component arrays
+} IMU_simd_quat;
+
+// batch of 3x1 vectors (structure of arrays, component i at v[i][n])
+typedef struct {
+  float                 *v[3];           // x, y, z component arrays
+} IMU_simd_vect;
+
+// instruction set used by the batch functions
+typedef enum {
+  IMU_simd_scalar            = 0,       // IMU_math reference
+  IMU_simd_sse2              = 1,       // 4 wide
+  IMU_simd_avx2              = 2,       // 8 wide (w/ fma)
+  IMU_simd_avx512            = 3        // 16 wide
+} IMU_simd_isa;
+
+
+// instruction set selection (best supported chosen on first use)
+int          IMU_simd_setIsa        (IMU_simd_isa isa);
+IMU_simd_isa IMU_simd_getIsa        (void);
+IMU_simd_isa IMU_simd_bestIsa       (void);
+
+// batched quaternion operators (outputs may alias inputs)
+int IMU_simd_quatMult      (IMU_simd_quat *q1, IMU_simd_quat *q2,
+                            IMU_simd_quat *out, uint32_t num);
+int IMU_simd_quatMultConj  (IMU_simd_quat *q1, IMU_simd_quat *q2,
+                            IMU_simd_quat *out, uint32_t num);
+int IMU_simd_rotateForward (IMU_simd_vect *v,  IMU_simd_quat *q,
+                            IMU_simd_vect *out, uint32_t num);
+int IMU_simd_rotateReverse (IMU_simd_vect *v,  IMU_simd_quat *q,
+                            IMU_simd_vect *out, uint32_t num);
+
+// batched conversion from quaternions to pointing vectors
+int IMU_simd_quatToUp      (IMU_simd_quat *q,  IMU_simd_vect *v,
+                            uint32_t num);
+int IMU_simd_quatToFrwd    (IMU_simd_quat *q,  IMU_simd_vect *v,
+                            uint32_t num);
+
+// batched conversion from quaternions to Euler angles (polynomial atan2/asin)
+int IMU_simd_quatToEuler   (IMU_simd_quat *q,  IMU_simd_vect *E,
+                            uint32_t num);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
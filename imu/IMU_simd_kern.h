@@ -0,0 +1,265 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/******************************************************************************
+* batched kernel template - included by IMU_simd.c once per instruction set
+* with IMU_SIMD_SFX (name suffix), IMU_SIMD_W (floats per vector),
+* IMU_SIMD_ATTR (target attribute), and IMU_SIMD_SQRT (square root
+* intrinsic) defined; each kernel processes whole
+* vectors from start and returns the index of the first unprocessed sample
+******************************************************************************/
+
+// kernel naming and vector type (unaligned loads/stores)
+#define KERN_CAT2(a, b)       a##_##b
+#define KERN_CAT(a, b)        KERN_CAT2(a, b)
+#define KERN(name)            KERN_CAT(name, IMU_SIMD_SFX)
+#define VEC                   KERN(vec)
+#define IVEC                  KERN(ivec)
+#define LD(p, i)              (*(const VEC*)&(p)[i])
+#define ST(p, i)              (*(VEC*)&(p)[i])
+#define SEL(m, a, b)          ((VEC)(((IVEC)(a) & (m)) | ((IVEC)(b) & ~(m))))
+typedef float   VEC  __attribute__((vector_size(4*IMU_SIMD_W), aligned(4)));
+typedef int32_t IVEC __attribute__((vector_size(4*IMU_SIMD_W)));
+
+
+/******************************************************************************
+* quaternion multiplication
+******************************************************************************/
+
+IMU_SIMD_ATTR static uint32_t KERN(quatMult)(
+  IMU_simd_quat         *q1,
+  IMU_simd_quat         *q2,
+  IMU_simd_quat         *out,
+  uint32_t              i,
+  uint32_t              num)
+{
+  for (; i + IMU_SIMD_W <= num; i += IMU_SIMD_W) {
+    VEC a0 = LD(q1->q[0], i), a1 = LD(q1->q[1], i);
+    VEC a2 = LD(q1->q[2], i), a3 = LD(q1->q[3], i);
+    VEC b0 = LD(q2->q[0], i), b1 = LD(q2->q[1], i);
+    VEC b2 = LD(q2->q[2], i), b3 = LD(q2->q[3], i);
+    ST(out->q[0], i) = b0*a0 - b1*a1 - b2*a2 - b3*a3;
+    ST(out->q[1], i) = b0*a1 + b1*a0 - b2*a3 + b3*a2;
+    ST(out->q[2], i) = b0*a2 + b1*a3 + b2*a0 - b3*a1;
+    ST(out->q[3], i) = b0*a3 - b1*a2 + b2*a1 + b3*a0;
+  }
+  return i;
+}
+
+
+/******************************************************************************
+* quaternion multiplication w/ conjugate
+******************************************************************************/
+
+IMU_SIMD_ATTR static uint32_t KERN(quatMultConj)(
+  IMU_simd_quat         *q1,
+  IMU_simd_quat         *q2,
+  IMU_simd_quat         *out,
+  uint32_t              i,
+  uint32_t              num)
+{
+  for (; i + IMU_SIMD_W <= num; i += IMU_SIMD_W) {
+    VEC a0 = LD(q1->q[0], i), a1 = LD(q1->q[1], i);
+    VEC a2 = LD(q1->q[2], i), a3 = LD(q1->q[3], i);
+    VEC b0 = LD(q2->q[0], i), b1 = LD(q2->q[1], i);
+    VEC b2 = LD(q2->q[2], i), b3 = LD(q2->q[3], i);
+    ST(out->q[0], i) = b0*a0 + b1*a1 + b2*a2 + b3*a3;
+    ST(out->q[1], i) = b0*a1 - b1*a0 + b2*a3 - b3*a2;
+    ST(out->q[2], i) = b0*a2 - b1*a3 - b2*a0 + b3*a1;
+    ST(out->q[3], i) = b0*a3 + b1*a2 - b2*a1 - b3*a0;
+  }
+  return i;
+}
+
+
+/******************************************************************************
+* rotate vector by quaternion (forward)
+******************************************************************************/
+
+IMU_SIMD_ATTR static uint32_t KERN(rotateForward)(
+  IMU_simd_vect         *v,
+  IMU_simd_quat         *q,
+  IMU_simd_vect         *out,
+  uint32_t              i,
+  uint32_t              num)
+{
+  for (; i + IMU_SIMD_W <= num; i += IMU_SIMD_W) {
+    VEC v0 = LD(v->v[0], i), v1 = LD(v->v[1], i), v2 = LD(v->v[2], i);
+    VEC q0 = LD(q->q[0], i), q1 = LD(q->q[1], i);
+    VEC q2 = LD(q->q[2], i), q3 = LD(q->q[3], i);
+    ST(out->v[0], i) = 2.0f * (v0 * (0.5f - q2*q2 - q3*q3)
+                             + v1 * (q1*q2 - q0*q3)
+                             + v2 * (q1*q3 + q0*q2));
+    ST(out->v[1], i) = 2.0f * (v0 * (q1*q2 + q0*q3)
+                             + v1 * (0.5f - q1*q1 - q3*q3)
+                             + v2 * (q2*q3 - q0*q1));
+    ST(out->v[2], i) = 2.0f * (v0 * (q1*q3 - q0*q2)
+                             + v1 * (q2*q3 + q0*q1)
+                             + v2 * (0.5f - q1*q1 - q2*q2));
+  }
+  return i;
+}
+
+
+/******************************************************************************
+* rotate vector by quaternion (reverse)
+******************************************************************************/
+
+IMU_SIMD_ATTR static uint32_t KERN(rotateReverse)(
+  IMU_simd_vect         *v,
+  IMU_simd_quat         *q,
+  IMU_simd_vect         *out,
+  uint32_t              i,
+  uint32_t              num)
+{
+  for (; i + IMU_SIMD_W <= num; i += IMU_SIMD_W) {
+    VEC v0 = LD(v->v[0], i), v1 = LD(v->v[1], i), v2 = LD(v->v[2], i);
+    VEC q0 = LD(q->q[0], i), q1 = LD(q->q[1], i);
+    VEC q2 = LD(q->q[2], i), q3 = LD(q->q[3], i);
+    ST(out->v[0], i) = 2.0f * (v0 * (0.5f - q2*q2 - q3*q3)
+                             + v1 * (q1*q2 + q0*q3)
+                             + v2 * (q1*q3 - q0*q2));
+    ST(out->v[1], i) = 2.0f * (v0 * (q1*q2 - q0*q3)
+                             + v1 * (0.5f - q1*q1 - q3*q3)
+                             + v2 * (q2*q3 + q0*q1));
+    ST(out->v[2], i) = 2.0f * (v0 * (q1*q3 + q0*q2)
+                             + v1 * (q2*q3 - q0*q1)
+                             + v2 * (0.5f - q1*q1 - q2*q2));
+  }
+  return i;
+}
+
+
+/******************************************************************************
+* get up component from quaternion
+******************************************************************************/
+
+IMU_SIMD_ATTR static uint32_t KERN(quatToUp)(
+  IMU_simd_quat         *q,
+  IMU_simd_vect         *v,
+  uint32_t              i,
+  uint32_t              num)
+{
+  for (; i + IMU_SIMD_W <= num; i += IMU_SIMD_W) {
+    VEC q0 = LD(q->q[0], i), q1 = LD(q->q[1], i);
+    VEC q2 = LD(q->q[2], i), q3 = LD(q->q[3], i);
+    ST(v->v[0], i)   = 2.0f * (q1*q3 + q0*q2);
+    ST(v->v[1], i)   = 2.0f * (q2*q3 - q0*q1);
+    ST(v->v[2], i)   = 2.0f * (0.5f - q1*q1 - q2*q2);
+  }
+  return i;
+}
+
+
+/******************************************************************************
+* get forward component from quaternion
+******************************************************************************/
+
+IMU_SIMD_ATTR static uint32_t KERN(quatToFrwd)(
+  IMU_simd_quat         *q,
+  IMU_simd_vect         *v,
+  uint32_t              i,
+  uint32_t              num)
+{
+  for (; i + IMU_SIMD_W <= num; i += IMU_SIMD_W) {
+    VEC q0 = LD(q->q[0], i), q1 = LD(q->q[1], i);
+    VEC q2 = LD(q->q[2], i), q3 = LD(q->q[3], i);
+    ST(v->v[0], i)   = 2.0f * (0.5f - q2*q2 - q3*q3);
+    ST(v->v[1], i)   = 2.0f * (q1*q2 + q0*q3);
+    ST(v->v[2], i)   = 2.0f * (q1*q3 - q0*q2);
+  }
+  return i;
+}
+
+
+/******************************************************************************
+* arc tangent of y/x (same polynomial and reduction as IMU_math_atan2)
+******************************************************************************/
+
+IMU_SIMD_ATTR static inline VEC KERN(atan2)(
+  VEC                   y,
+  VEC                   x)
+{
+  const IVEC sign       = (IVEC){0} | (int32_t)0x80000000;
+  VEC  ax               = (VEC)((IVEC)x & ~sign);
+  VEC  ay               = (VEC)((IVEC)y & ~sign);
+  IVEC isX              = ax > ay;
+  VEC  mx               = SEL(isX, ax, ay);
+  VEC  a                = SEL(isX, ay, ax);
+  a                     = SEL(mx > 0.0f, a / mx, a);
+  VEC  s                = a * a;
+  VEC  r                = a * ( 0.99997726f + s * (-0.33262347f +
+                                s * ( 0.19354346f + s * (-0.11643287f +
+                                s * ( 0.05265332f + s * (-0.01172120f))))));
+  r                     = SEL(isX, r, 1.57079637f - r);
+  r                     = SEL(x < 0.0f, 3.14159274f - r, r);
+  return (VEC)((IVEC)r | ((IVEC)y & sign));
+}
+
+
+/******************************************************************************
+* convert quaternion to Euler angles
+******************************************************************************/
+
+IMU_SIMD_ATTR static uint32_t KERN(quatToEuler)(
+  IMU_simd_quat         *q,
+  IMU_simd_vect         *E,
+  uint32_t              i,
+  uint32_t              num)
+{
+  for (; i + IMU_SIMD_W <= num; i += IMU_SIMD_W) {
+    VEC q0 = LD(q->q[0], i), q1 = LD(q->q[1], i);
+    VEC q2 = LD(q->q[2], i), q3 = LD(q->q[3], i);
+    const VEC one    = (VEC){0} + 1.0f;
+    VEC sinp         = 2.0f * (q0*q2 - q3*q1);
+    sinp             = SEL(sinp >  1.0f,  one, sinp);
+    sinp             = SEL(sinp < -1.0f, -one, sinp);
+    ST(E->v[2], i)   = KERN(atan2)(2.0f * (q0*q1 + q2*q3),
+                                   1.0f - 2.0f * (q1*q1 + q2*q2));
+    ST(E->v[1], i)   = KERN(atan2)(sinp,
+                                   IMU_SIMD_SQRT((1.0f - sinp) * (1.0f + sinp)));
+    ST(E->v[0], i)   = KERN(atan2)(2.0f * (q0*q3 + q1*q2),
+                                   1.0f - 2.0f * (q2*q2 + q3*q3));
+  }
+  return i;
+}
+
+
+/******************************************************************************
+* function table for this instruction set
+******************************************************************************/
+
+static const IMU_simd_fnc KERN(fnc) = {
+  KERN(quatMult),
+  KERN(quatMultConj),
+  KERN(rotateForward),
+  KERN(rotateReverse),
+  KERN(quatToUp),
+  KERN(quatToFrwd),
+  KERN(quatToEuler)};
+
+// release template macros (next instruction set redefines them)
+#undef KERN_CAT2
+#undef KERN_CAT
+#undef KERN
+#undef VEC
+#undef IVEC
+#undef SEL
+#undef LD
+#undef ST
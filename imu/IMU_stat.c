@@ -23,14 +23,16 @@
 #include "IMU_stat.h"
 
 // internally managed structures
-static IMU_stat_config    config [IMU_MAX_INST]; 
+static IMU_stat_config   *config [IMU_MAX_INST];
+static IMU_stat_config    configOwn[IMU_MAX_INST];
 static IMU_stat_state     state  [IMU_MAX_INST];
 static uint16_t           numInst = 0;
 
 // internal functions definitions
-int IMU_stat_gyro (uint16_t id, uint32_t t, IMU_TYPE *g, IMU_core_FOM*);
+int IMU_stat_gyro (uint16_t id, uint32_t t, float *g, IMU_core_FOM*);
 int IMU_stat_accl (uint16_t id, uint32_t t, IMU_TYPE *a, IMU_core_FOM*);
 int IMU_stat_magn (uint16_t id, uint32_t t, IMU_TYPE *m, IMU_core_FOM*);
+static inline float elapsed(IMU_time *prev, uint32_t t);
 
 
 /******************************************************************************
@@ -46,15 +48,16 @@ int IMU_stat_init(
     return IMU_STAT_INST_OVERFLOW;
 
   // initialize to known state
-  config[numInst].enable     = 1;
-  config[numInst].alpha      = 0.0001f;
+  configOwn[numInst].enable     = 1;
+  configOwn[numInst].alpha      = 0.0001f;
 
   // reset instance
   IMU_stat_reset(*id);
 
   // pass inst handle and config pointer
   *id   = numInst; 
-  *pntr = &config[*id];
+  config[*id] = &configOwn[*id];
+  *pntr = config[*id];
   numInst++;
   
   // exit function
@@ -75,7 +78,25 @@ int IMU_stat_getConfig(
     return IMU_STAT_BAD_INST;
 
   // pass state and exit (no errors)
-  *pntr = &config[id];
+  *pntr = config[id];
+  return 0;
+}
+
+
+/******************************************************************************
+* point instance at external config structure (owned by caller)
+******************************************************************************/
+
+int IMU_stat_setConfig(
+  uint16_t                id,
+  IMU_stat_config          *pntr)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_STAT_BAD_INST;
+
+  // replace config pointer and exit (no errors)
+  config[id] = pntr;
   return 0;
 }
 
@@ -148,13 +169,14 @@ int IMU_stat_datum(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_STAT_BAD_INST; 
-  if (!config[id].enable)
+  if (!config[id]->enable)
     return IMU_STAT_FNC_DISABLED;    
 
   // check sensor type and execute
-  if      (datum->type == IMU_gyro)
-    IMU_stat_gyro(id, datum->t, datum->val, FOM);
-  else if (datum->type == IMU_accl)
+  if      (datum->type == IMU_gyro) {
+    float g[3]            = {datum->val[0], datum->val[1], datum->val[2]};
+    IMU_stat_gyro(id, datum->t, g, FOM);
+  } else if (datum->type == IMU_accl)
     IMU_stat_accl(id, datum->t, datum->val, FOM);
   else if (datum->type == IMU_magn)
     IMU_stat_magn(id, datum->t, datum->val, FOM);
@@ -177,11 +199,12 @@ int IMU_stat_data3(
   // check out-of-bounds condition
   if (id >= numInst)
     return IMU_STAT_BAD_INST; 
-  if (!config[id].enable)
+  if (!config[id]->enable)
     return IMU_STAT_FNC_DISABLED;
 
   // check sensor type and execute
-  IMU_stat_gyro(id, data3->t, data3->g, &FOM[0]);
+  float g[3]              = {data3->g[0], data3->g[1], data3->g[2]};
+  IMU_stat_gyro(id, data3->t, g, &FOM[0]);
   IMU_stat_accl(id, data3->t, data3->a, &FOM[1]);
   IMU_stat_magn(id, data3->t, data3->m, &FOM[2]);
 
@@ -190,6 +213,31 @@ int IMU_stat_data3(
 }
 
 
+/******************************************************************************
+* collect statistics on gyroscope rate (counts, not quantized to IMU_TYPE,
+* e.g. pre-integrated mean rate)
+******************************************************************************/
+
+int IMU_stat_rate(
+  uint16_t                id, 
+  uint32_t                t, 
+  float                   *g,
+  IMU_core_FOM            *FOM)
+{
+  // check out-of-bounds condition
+  if (id >= numInst)
+    return IMU_STAT_BAD_INST; 
+  if (!config[id]->enable)
+    return IMU_STAT_FNC_DISABLED;
+
+  // collect gyroscope statistics
+  IMU_stat_gyro(id, t, g, FOM);
+
+  // exit function (no errors)
+  return 0;
+}
+
+
 /******************************************************************************
 * collect gyroscope statistics
 ******************************************************************************/
@@ -197,13 +245,16 @@ int IMU_stat_data3(
 int IMU_stat_gyro(
   uint16_t                id, 
   uint32_t                t, 
-  IMU_TYPE                *g,
+  float                   *g,
   IMU_core_FOM            *FOM)
 {
   // check FOM valid
   if (!FOM->isValid)
     return IMU_STAT_INVALID_FOM;
 
+  // elapsed time since last gyroscope datum
+  float dt                = elapsed(&state[id].tGyro, t);
+
   // first sensor datum
   if (state[id].gClock) {
     state[id].gBias[0]    = g[0];
@@ -213,8 +264,7 @@ int IMU_stat_gyro(
 
   // nominal condition
   } else {
-    float dt              = (t-state[id].tGyro) * IMU_STAT_10USEC_TO_SEC;
-    float alpha           = dt * config[id].alpha;
+    float alpha           = dt * config[id]->alpha;
     float *gBias          = state[id].gBias;
     float prev            = state[id].gBiasStd;
     state[id].gBiasStd    = (1.0f-alpha)*prev     + alpha*fabs(gBias[0]-g[0]); 
@@ -224,7 +274,6 @@ int IMU_stat_gyro(
   }
 
   // exit function (no errors)
-  state[id].tGyro       = t;
   return 0;
 }
 
@@ -243,16 +292,18 @@ int IMU_stat_accl(
   if (!FOM->isValid)
     return IMU_STAT_INVALID_FOM;
 
+  // elapsed time since last accelerometer datum
+  float dt                = elapsed(&state[id].tAccl, t);
+
   // first sensor datum
-  if (state[id].gClock) {
+  if (state[id].aClock) {
     state[id].aMag        = FOM->FOM.accl.mag;
     state[id].aMagFOM     = FOM->FOM.accl.magFOM;
-    state[id].gClock      = 0;
+    state[id].aClock      = 0;
 
   // nominal condition
   } else {
-    float dt              = (t-state[id].tGyro) * IMU_STAT_10USEC_TO_SEC;
-    float alpha           = dt * config[id].alpha;
+    float alpha           = dt * config[id]->alpha;
     float prevMag         = state[id].aMag;
     float prevStd         = state[id].aMagStd;
     float prevFOM         = state[id].aMagFOM;
@@ -264,7 +315,6 @@ int IMU_stat_accl(
   }
 
   // exit function (no errors)
-  state[id].tGyro       = t;
   return 0;
 }
 
@@ -283,6 +333,9 @@ int IMU_stat_magn(
   if (!FOM->isValid)
     return IMU_STAT_INVALID_FOM;
 
+  // elapsed time since last magnetometer datum
+  float dt                = elapsed(&state[id].tMagn, t);
+
   // first sensor datum
   if (state[id].mClock) {
     state[id].mMag        = FOM->FOM.magn.mag;
@@ -293,8 +346,7 @@ int IMU_stat_magn(
 
   // nominal condition
   } else {
-    float dt              = (t-state[id].tMagn) * IMU_STAT_10USEC_TO_SEC;
-    float alpha           = dt * config[id].alpha;
+    float alpha           = dt * config[id]->alpha;
     float prevMag         = state[id].mMag;
     float prevStd         = state[id].mMagStd;
     float prevFOM         = state[id].mMagFOM;
@@ -306,6 +358,22 @@ int IMU_stat_magn(
   }
 
   // exit function (no errors)
-  state[id].tGyro       = t;
   return 0;
 }
+
+
+/******************************************************************************
+* utility function - extends datum time to the 64-bit time base, returns
+* seconds since the previous datum of the same sensor
+******************************************************************************/
+
+inline float elapsed(
+  IMU_time                *prev,
+  uint32_t                t)
+{
+  IMU_time tExt           = IMU_time_extend(*prev, t);
+  float    dt             = (float)(int64_t)(tExt - *prev) *
+                            IMU_STAT_10USEC_TO_SEC;
+  *prev                   = tExt;
+  return dt;
+}
@@ -61,21 +61,23 @@ typedef struct {
   uint8_t               gClock;
   uint8_t               aClock;
   uint8_t               mClock;
-  uint32_t              tGyro;
-  uint32_t              tAccl;
-  uint32_t              tMagn;
+  IMU_time              tGyro;           // last datum times (10usec)
+  IMU_time              tAccl;
+  IMU_time              tMagn;
 } IMU_stat_state;
 
 
 // data structure access function
 int IMU_stat_init     (uint16_t *id, IMU_stat_config **config);
 int IMU_stat_getConfig (uint16_t id, IMU_stat_config **config);
+int IMU_stat_setConfig (uint16_t id, IMU_stat_config *config);
 int IMU_stat_getState  (uint16_t id, IMU_stat_state  **state);
 
 // general operation functions 
 int IMU_stat_reset     (uint16_t id);
 int IMU_stat_datum     (uint16_t id, IMU_datum*, IMU_core_FOM*, IMU_pnts_enum);
 int IMU_stat_data3     (uint16_t id, IMU_data3*, IMU_core_FOM*, IMU_pnts_enum);
+int IMU_stat_rate      (uint16_t id, uint32_t t, float *g, IMU_core_FOM*);
 
 
 #ifdef __cplusplus
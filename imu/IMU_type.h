@@ -30,6 +30,10 @@ extern "C" {
 // structure definitions
 typedef struct IMU_core_FOM IMU_core_FOM;
 
+// internal time base (10usec ticks), datum timestamps are 32-bit and wrap
+// after ~11.9 hours
+typedef uint64_t IMU_time;
+
 // define global datum enumertations
 typedef enum {
   IMU_sync             = 0,
@@ -97,6 +101,24 @@ typedef struct {
 } IMU_calb_FOM;
 
 
+/******************************************************************************
+* extends a 32-bit datum timestamp to the time base, choosing the epoch that
+* places it nearest the previous time (late datum may precede prev)
+******************************************************************************/
+
+static inline IMU_time IMU_time_extend(
+  IMU_time             prev,
+  uint32_t             t)
+{
+  IMU_time ext         = (prev & ~(IMU_time)0xFFFFFFFF) | t;
+  if (ext + 0x80000000 < prev)
+    ext               += (IMU_time)1 << 32;
+  else if (ext > prev + 0x80000000 && ext >> 32)
+    ext               -= (IMU_time)1 << 32;
+  return ext;
+}
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <math.h>
+#include <pthread.h>
 #include "IMU_engn.h"
 #include "IMU_pnts.h"
 #include "test_utils.h"
@@ -29,9 +30,12 @@
 // define globals
 uint16_t    id          = 0;
 float       curTime     = 0;
+pthread_t   fncThrd;
+int         fncCount    = 0;
 
 // define internal function
 void add_datum(float val[3], float off[3], IMU_sensor);
+void calb_fnc (uint16_t id, IMU_calb_FOM*, void*);
 
 
 /******************************************************************************
@@ -72,6 +76,10 @@ int main(void)
   status = IMU_engn_load(id, "../config/test_calb.json", IMU_engn_calb);
   check_status(status, "IMU_engn_load failure");
 
+  // record thread applying solutions
+  status = IMU_engn_setCalbFnc(id, &calb_fnc, NULL);
+  check_status(status, "IMU_engn_setCalbFnc failure");
+
   // start data queue
   status = IMU_engn_start();
   check_status(status, "IMU_engn_start failure");
@@ -83,10 +91,9 @@ int main(void)
   config.pnts->aAlpha = 1.0;
   config.pnts->mAlpha = 1.0;
 
-  // get handle to config status
-  status = IMU_engn_getConfig(id, IMU_engn_rect, &config);
-  check_status(status, "IMU_engn_getConfig failure");
-  IMU_rect_config *rect   = config.rect;
+  // copy of published rect config (solutions saved by the pipeline)
+  IMU_rect_config rect;
+  config.rect             = &rect;
 
 
   /****************************************************************************
@@ -98,8 +105,14 @@ int main(void)
   float ref1[3]   = {-10.0, -20.0, -30.0};
   status = IMU_engn_calbStart(id, IMU_calb_1pnt_gyro, NULL);
   add_datum(vec1, off1, IMU_gyro);
-  print_vect(rect->gBias);
-  verify_vect(rect->gBias, ref1);
+  IMU_engn_syncConfig(id);
+  IMU_engn_copyConfig(id, IMU_engn_rect, &config);
+  print_vect(rect.gBias);
+  verify_vect(rect.gBias, ref1);
+
+  // solution swapped in by the queue thread (pipeline), not the caller
+  verify_int(fncCount, 1);
+  verify_int(pthread_equal(fncThrd, pthread_self()) != 0, 0);
 
 
   /****************************************************************************
@@ -117,8 +130,10 @@ int main(void)
   add_datum(vec2b, off2, IMU_magn);
   add_datum(vec2c, off2, IMU_magn);
   add_datum(vec2d, off2, IMU_magn);
-  print_vect(rect->mBias);
-  verify_vect(rect->mBias, ref2);
+  IMU_engn_syncConfig(id);
+  IMU_engn_copyConfig(id, IMU_engn_rect, &config);
+  print_vect(rect.mBias);
+  verify_vect(rect.mBias, ref2);
 
 
   /****************************************************************************
@@ -140,8 +155,10 @@ int main(void)
   add_datum(vec3d, off3, IMU_accl);
   add_datum(vec3e, off3, IMU_accl);
   add_datum(vec3f, off3, IMU_accl);
-  print_vect(rect->aBias);
-  verify_vect(rect->aBias, ref3);
+  IMU_engn_syncConfig(id);
+  IMU_engn_copyConfig(id, IMU_engn_rect, &config);
+  print_vect(rect.aBias);
+  verify_vect(rect.aBias, ref3);
 
 
   /****************************************************************************
@@ -197,3 +214,21 @@ void add_datum(
   check_status(status, "IMU_engn_datum failure");
   usleep(2*msg_delay);
 }
+
+
+/******************************************************************************
+* calibration callback (records calling thread, saves solution)
+******************************************************************************/
+
+void calb_fnc(
+  uint16_t                 idCalb,
+  IMU_calb_FOM             *FOM,
+  void                     *pntr)
+{
+  (void)FOM;
+  (void)pntr;
+  fncThrd                  = pthread_self();
+  fncCount++;
+  (void)idCalb;
+  IMU_engn_calbSave(id);
+}
@@ -0,0 +1,182 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "IMU_calb.h"
+#include "test_utils.h"
+
+// define constants
+static const int   num_samp    = 2000;    // samples (random orientations)
+static const float mag         = 250.0;   // field magnitude (counts)
+static const float soft[9]     = {1.10, 0.05, 0.00,
+                                  0.05, 0.90, 0.02,
+                                  0.00, 0.02, 1.00};
+static const float hard[3]     = {30.0, -20.0, 15.0};
+static const int   noise       = 1;       // uniform noise (+/- counts)
+static const float bias_limit  = 1.0;     // max bias error (counts)
+static const float spread_limit= 0.01;    // max corrected magnitude std/mean
+
+// define globals
+uint16_t           id          = 0;
+IMU_calb_config    *config     = NULL;
+IMU_rect_config    rect;
+IMU_core_config    core;
+int                fncCount    = 0;
+
+// define internal functions
+static void calb_fnc    (uint16_t id, IMU_calb_FOM*, void*);
+static void gen_magn    (IMU_TYPE *m);
+static void rect_magn   (IMU_TYPE *m, float *out);
+
+
+/******************************************************************************
+* main function - online magnetometer calibration (hard/soft iron recovered
+* from raw samples w/o stable points)
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  IMU_calb_state     *state;
+  IMU_TYPE           m[3];
+  float              ref[3]    = {-hard[0], -hard[1], -hard[2]};
+  float              out[3], n, sum = 0.0f, sum2 = 0.0f, err = 0.0f;
+  float              mean, std;
+  int                status, i;
+
+  // start datum test
+  printf("starting test_calb_magn...\n");
+
+  // initialize calb instance (identity transform, zero bias)
+  memset(&rect, 0, sizeof(IMU_rect_config));
+  memset(&core, 0, sizeof(IMU_core_config));
+  rect.mMult[0]      = 1.0;
+  rect.mMult[4]      = 1.0;
+  rect.mMult[8]      = 1.0;
+  status = IMU_calb_init(&id, &config);
+  check_status(status, "IMU_calb_init failure");
+  IMU_calb_getState(id, &state);
+  IMU_calb_setStruct(id, &rect, &core);
+  IMU_calb_setFnc(id, &calb_fnc, NULL);
+
+  // samples outside of a calibration are ignored
+  gen_magn(m);
+  verify_int(IMU_calb_magn(id, m), 0);
+  verify_int(state->rlsCount, 0);
+
+  // stream raw samples (no stable points required)
+  status = IMU_calb_start(id, IMU_calb_rls_magn, NULL);
+  verify_int(status, 0);
+  srand(1);
+  for (i=0; i<num_samp; i++) {
+    gen_magn(m);
+    status = IMU_calb_magn(id, m);
+    if (status < 0)
+      check_status(status, "IMU_calb_magn failure");
+  }
+  printf("samples = %u, resid = %0.4f, updates = %d\n", state->rlsCount,
+         state->rlsResid, fncCount);
+  verify_int(fncCount > 0, 1);
+  verify_int(state->rlsResid <= config->mResid, 1);
+
+  // hard iron recovered
+  print_vect(rect.mBias);
+  for (i=0; i<3; i++)
+    err              = fmaxf(err, fabsf(rect.mBias[i] - ref[i]));
+  verify_int(err < bias_limit, 1);
+
+  // soft iron removed (corrected magnitude constant)
+  for (i=0; i<num_samp; i++) {
+    gen_magn(m);
+    rect_magn(m, out);
+    n                = sqrtf(out[0]*out[0] + out[1]*out[1] + out[2]*out[2]);
+    sum             += n;
+    sum2            += n * n;
+  }
+  mean               = sum / num_samp;
+  std                = sqrtf(fmaxf(sum2 / num_samp - mean * mean, 0.0f));
+  printf("mean = %0.2f, std = %0.3f, mMag = %0.2f\n", mean, std, core.mMag);
+  verify_int(std / mean < spread_limit, 1);
+  verify_int(fabsf(core.mMag - mean) / mean < spread_limit, 1);
+
+  // exit program
+  printf("pass: test_calb_magn\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* calibration callback (saves solution)
+******************************************************************************/
+
+void calb_fnc(
+  uint16_t           id,
+  IMU_calb_FOM       *FOM,
+  void               *pntr)
+{
+  (void)FOM;
+  (void)pntr;
+  fncCount++;
+  IMU_calb_save(id);
+}
+
+
+/******************************************************************************
+* raw magnetometer sample (random direction, soft iron, hard iron, noise)
+******************************************************************************/
+
+void gen_magn(
+  IMU_TYPE           *m)
+{
+  float              h[3], n;
+  int                i;
+  do {
+    for (i=0; i<3; i++)
+      h[i]           = 2.0f * rand() / RAND_MAX - 1.0f;
+    n                = sqrtf(h[0]*h[0] + h[1]*h[1] + h[2]*h[2]);
+  } while (n < 0.1f || n > 1.0f);
+  for (i=0; i<3; i++)
+    h[i]            *= mag / n;
+  for (i=0; i<3; i++)
+    m[i]             = (IMU_TYPE)lroundf(soft[3*i]*h[0] + soft[3*i+1]*h[1] +
+                       soft[3*i+2]*h[2] + hard[i] +
+                       rand() % (2*noise+1) - noise);
+}
+
+
+/******************************************************************************
+* apply published magnetometer rectification (out = mMult * (m + mBias))
+******************************************************************************/
+
+void rect_magn(
+  IMU_TYPE           *m,
+  float              *out)
+{
+  float              v[3];
+  int                i;
+  for (i=0; i<3; i++)
+    v[i]             = m[i] + rect.mBias[i];
+  for (i=0; i<3; i++)
+    out[i]           = rect.mMult[3*i]*v[0] + rect.mMult[3*i+1]*v[1] +
+                       rect.mMult[3*i+2]*v[2];
+}
@@ -0,0 +1,153 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "IMU_calb.h"
+#include "test_utils.h"
+
+// define globals
+uint16_t           id          = 0;
+IMU_calb_config    *config     = NULL;
+IMU_rect_config    rect;
+IMU_core_config    core;
+pthread_t          fncThrd;
+int                fncCount    = 0;
+
+// define internal functions
+static void calb_fnc    (uint16_t id, IMU_calb_FOM*, void*);
+static void add_point   (float g[3]);
+static int  wait_poll   (void);
+
+
+/******************************************************************************
+* main function - calibration solver worker (solution swapped in only by the
+* pipeline thread through IMU_calb_poll)
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  float              zero[3]   = {  0.0,   0.0,   0.0};
+  float              vec1[3]   = { 10.0,  20.0,  30.0};
+  float              ref1[3]   = {-10.0, -20.0, -30.0};
+  float              vec2[3]   = { -4.0,   5.0,  -6.0};
+  float              ref2[3]   = {  4.0,  -5.0,   6.0};
+  int                status;
+
+  // start datum test
+  printf("starting test_calb_queue...\n");
+
+  // initialize calb instance (starts worker)
+  memset(&rect, 0, sizeof(IMU_rect_config));
+  memset(&core, 0, sizeof(IMU_core_config));
+  status = IMU_calb_init(&id, &config);
+  check_status(status, "IMU_calb_init failure");
+  IMU_calb_setStruct(id, &rect, &core);
+  IMU_calb_setFnc(id, &calb_fnc, NULL);
+
+  // points outside of a calibration are ignored
+  add_point(vec1);
+  verify_int(wait_poll(), 0);
+
+  // one-point gyro, solution held until polled
+  status = IMU_calb_start(id, IMU_calb_1pnt_gyro, NULL);
+  verify_int(status, 1);
+  add_point(vec1);
+  usleep(msg_delay);
+  print_vect(rect.gBias);
+  verify_vect(rect.gBias, zero);
+  verify_int(fncCount, 0);
+
+  // poll swaps in solution and calls back on the polling thread
+  verify_int(wait_poll(), IMU_CALB_UPDATED);
+  print_vect(rect.gBias);
+  verify_vect(rect.gBias, ref1);
+  verify_int(fncCount, 1);
+  verify_int(pthread_equal(fncThrd, pthread_self()) != 0, 1);
+
+  // completed calibration ignores further points
+  add_point(vec2);
+  verify_int(wait_poll(), 0);
+  verify_int(fncCount, 1);
+
+  // restarted calibration replaces solution
+  IMU_calb_start(id, IMU_calb_1pnt_gyro, NULL);
+  add_point(vec2);
+  verify_int(wait_poll(), IMU_CALB_UPDATED);
+  print_vect(rect.gBias);
+  verify_vect(rect.gBias, ref2);
+  verify_int(fncCount, 2);
+
+  // exit program
+  printf("pass: test_calb_queue\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* calibration callback (records calling thread, saves solution)
+******************************************************************************/
+
+void calb_fnc(
+  uint16_t           id,
+  IMU_calb_FOM       *FOM,
+  void               *pntr)
+{
+  (void)FOM;
+  (void)pntr;
+  fncThrd            = pthread_self();
+  fncCount++;
+  IMU_calb_save(id);
+}
+
+
+/******************************************************************************
+* add stable point (gyroscope only)
+******************************************************************************/
+
+void add_point(
+  float              g[3])
+{
+  IMU_pnts_entry     entry;
+  memset(&entry, 0, sizeof(IMU_pnts_entry));
+  entry.gFltr[0]     = g[0];
+  entry.gFltr[1]     = g[1];
+  entry.gFltr[2]     = g[2];
+  IMU_calb_point(id, &entry);
+}
+
+
+/******************************************************************************
+* poll until a solution is applied (bounded)
+******************************************************************************/
+
+int wait_poll(void)
+{
+  int                i, status = 0;
+  for (i=0; i<20 && status == 0; i++) {
+    usleep(msg_delay);
+    status           = IMU_calb_poll(id);
+  }
+  return status;
+}
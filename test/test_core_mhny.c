@@ -0,0 +1,196 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "IMU_engn.h"
+#include "test_utils.h"
+
+// define globals
+uint16_t           id          = 0;
+IMU_core_config    *config     = NULL;
+
+// internal functions
+static void run_accl     (int (*fnc)(uint16_t, IMU_datum*, IMU_core_FOM*),
+                          float vec[3], int num_iter, float q[4]);
+static void run_data3    (int (*fnc)(uint16_t, IMU_data3*, IMU_core_FOM*),
+                          float g[3], float m[3], int num_iter, float q[4]);
+
+
+/******************************************************************************
+* main function - test of mahony complementary filter backend
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  IMU_core_state     *state;
+  IMU_union_config   engn;
+  uint16_t           idEngn;
+  float              q_ref[4], q[4];
+  int                status;
+
+  // start datum test
+  printf("starting test_core_mhny...\n");
+
+  // initialize core instance (accelerometer only)
+  status = IMU_core_init(&id, &config);
+  check_status(status, "IMU_core_init failure");
+  IMU_core_getState(id, &state);
+  config->isGyro     = 0;
+  config->isMagn     = 0;
+  config->aWeight    = 0.05;
+
+  // 90deg pitch step (same orientation as gradient descent)
+  float vec1[3]      = {   -255,       0,       0};
+  float out1[4]      = { 0.7071,  0.0000,  0.7071,  0.0000};
+  run_accl(IMU_core_datum,     vec1, 500, q_ref);
+  run_accl(IMU_core_mhnyDatum, vec1, 500, q);
+  printf("%0.4f, %0.4f, %0.4f, %0.4f\n", q[0], q[1], q[2], q[3]);
+  verify_quat(q_ref, out1);
+  verify_quat(q, out1);
+
+  // 90deg heading step (synchronized sensors, gyroscope stationary)
+  float gZero[3]     = {      0,       0,       0};
+  float mTurn[3]     = {      0,    -255,       0};
+  config->isGyro     = 1;
+  config->isMagn     = 1;
+  config->mWeight    = 0.05;
+  run_data3(IMU_core_data3,     gZero, mTurn, 500, q_ref);
+  run_data3(IMU_core_mhnyData3, gZero, mTurn, 500, q);
+  printf("%0.4f, %0.4f, %0.4f, %0.4f\n", q[0], q[1], q[2], q[3]);
+  verify_quat(q, q_ref);
+
+  // gyroscope bias integral (level and north, bias on every axis)
+  float gBias[3]     = {     20,     -20,      10};
+  float mNorth[3]    = {    255,       0,       0};
+  float out3[4]      = { 1.0000,  0.0000,  0.0000,  0.0000};
+  config->aWeight    = 0.02;
+  config->mWeight    = 0.02;
+  config->iWeight    = 0.5;
+  run_data3(IMU_core_mhnyData3, gBias, mNorth, 5000, q);
+  printf("%0.4f, %0.4f, %0.4f, %0.4f\n", q[0], q[1], q[2], q[3]);
+  printf("bias: %0.4f, %0.4f, %0.4f\n", state->gBias[0], state->gBias[1],
+         state->gBias[2]);
+  verify_quat(q, out3);
+  for (int i=0; i<3; i++) {
+    if (fabs(state->gBias[i] + gBias[i] * config->gScale) >
+        0.1 * fabs(gBias[i] * config->gScale)) {
+      printf("error: gyro bias estimate failure\n");
+      exit(0);
+    }
+  }
+
+  // engine backend selection (invalid filter rejected on reset)
+  status = IMU_engn_init(IMU_engn_core_only, &idEngn);
+  check_status(status, "IMU_engn_init failure");
+  IMU_engn_getConfig(idEngn, IMU_engn_self, &engn);
+  engn.engn->filter  = IMU_engn_mahony;
+  verify_int(IMU_engn_reset(idEngn), 0);
+  engn.engn->filter  = 2;
+  verify_int(IMU_engn_reset(idEngn), IMU_ENGN_BAD_FILTER);
+
+  // exit program
+  printf("pass: test_core_mhny\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* zero to level then apply accelerometer vector (10msec per datum)
+******************************************************************************/
+
+void run_accl(
+  int                  (*fnc)(uint16_t, IMU_datum*, IMU_core_FOM*),
+  float                vec[3],
+  int                  num_iter,
+  float                q[4])
+{
+  // define local variables
+  IMU_datum            datum;
+  IMU_core_state       *state;
+  int                  status;
+  int                  i;
+
+  // zero orientation to level
+  IMU_core_reset(id);
+  datum.type           = IMU_accl;
+  datum.t              = 0;
+  datum.val[0]         = 0;
+  datum.val[1]         = 0;
+  datum.val[2]         = 255;
+  status               = fnc(id, &datum, NULL);
+  verify_int(status, IMU_core_enum_zeroed_accl);
+
+  // main processing loop
+  datum.val[0]         = vec[0];
+  datum.val[1]         = vec[1];
+  datum.val[2]         = vec[2];
+  for (i=0; i<num_iter; i++) {
+    datum.t           += 1000;
+    status             = fnc(id, &datum, NULL);
+    verify_int(status, IMU_core_enum_normal_op);
+  }
+
+  // pass final orientation
+  IMU_core_getState(id, &state);
+  memcpy(q, state->q, sizeof(state->q));
+}
+
+
+/******************************************************************************
+* zero to level/north then apply gyroscope and magnetometer (10msec per datum)
+******************************************************************************/
+
+void run_data3(
+  int                  (*fnc)(uint16_t, IMU_data3*, IMU_core_FOM*),
+  float                g[3],
+  float                m[3],
+  int                  num_iter,
+  float                q[4])
+{
+  // define local variables
+  IMU_data3            data3 = {0, {0, 0, 0}, {0, 0, 255}, {255, 0, 0}};
+  IMU_core_state       *state;
+  int                  status;
+  int                  i;
+
+  // zero orientation to level and north
+  IMU_core_reset(id);
+  status               = fnc(id, &data3, NULL);
+  verify_int(status, IMU_core_enum_zeroed_both);
+
+  // main processing loop
+  for (i=0; i<3; i++) {
+    data3.g[i]         = g[i];
+    data3.m[i]         = m[i];
+  }
+  for (i=0; i<num_iter; i++) {
+    data3.t           += 1000;
+    status             = fnc(id, &data3, NULL);
+    verify_int(status, IMU_core_enum_normal_op);
+  }
+
+  // pass final orientation
+  IMU_core_getState(id, &state);
+  memcpy(q, state->q, sizeof(state->q));
+}
@@ -0,0 +1,177 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "IMU_core.h"
+#include "test_utils.h"
+
+// define globals
+uint16_t           id          = 0;
+IMU_core_config    *config     = NULL;
+
+// internal functions
+static int   run_accl    (float vec[3], int num_iter, float q[4]);
+static float angle_error (float *q1, float *q2);
+
+
+/******************************************************************************
+* main function - test of decimated accl/magn correction scheduling
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  float              q_ref[4], q[4];
+  int                status, count;
+
+  // start datum test
+  printf("starting test_core_sched...\n");
+
+  // initialize core instance (accelerometer only)
+  status = IMU_core_init(&id, &config);
+  check_status(status, "IMU_core_init failure");
+  config->isGyro     = 0;
+  config->isMagn     = 0;
+  config->aWeight    = 0.005;
+
+  // full rate reference (90deg pitch correction)
+  float vec1[3]      = {   -255,       0,       0};
+  count              = run_accl(vec1, 100, q_ref);
+  printf("%0.4f, %0.4f, %0.4f, %0.4f\n", q_ref[0], q_ref[1], q_ref[2],
+         q_ref[3]);
+  verify_int(count, 100);
+
+  // fixed decimation (every 4th datum w/ 4x gain)
+  config->aDecim     = 4;
+  count              = run_accl(vec1, 100, q);
+  printf("%0.4f, %0.4f, %0.4f, %0.4f\n", q[0], q[1], q[2], q[3]);
+  verify_int(count, 25);
+  verify_quat(q, q_ref);
+
+  // error threshold (aligned vector never triggers a correction)
+  config->aDecim     = 8;
+  config->aErrThresh = 0.01;
+  float vec2[3]      = {      0,       0,     255};
+  count              = run_accl(vec2, 100, q);
+  verify_int(count, 0);
+
+  // error threshold (corrections thin out once converged)
+  config->aErrThresh = 0.0;
+  config->aDecim     = 1;
+  run_accl(vec1, 2000, q_ref);
+  config->aErrThresh = 0.001;
+  config->aDecim     = 8;
+  count              = run_accl(vec1, 2000, q);
+  printf("%0.4f, %0.4f, %0.4f, %0.4f\n", q[0], q[1], q[2], q[3]);
+  printf("threshold mode: %d updates, %0.4f deg from reference\n", count,
+         angle_error(q, q_ref));
+  if (count >= 1000 || angle_error(q, q_ref) > 1.0f) {
+    printf("error: threshold schedule failure\n");
+    exit(0);
+  }
+  verify_quat(q, q_ref);
+
+  // error threshold (default aDecim, gain scaled by the 5 datum skipped)
+  verify_int(config->aSchedMax, 16);
+  float vec3[3]      = {     -9,       0,     255};
+  config->aErrThresh = 0.0;
+  config->aDecim     = 5;
+  count              = run_accl(vec3, 5, q_ref);
+  verify_int(count, 1);
+  config->aErrThresh = 0.003;
+  config->aDecim     = 1;
+  count              = run_accl(vec3, 5, q);
+  printf("%0.4f, %0.4f, %0.4f, %0.4f\n", q[0], q[1], q[2], q[3]);
+  verify_int(count, 1);
+  verify_quat(q, q_ref);
+
+  // exit program
+  printf("pass: test_core_sched\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* zero to level then apply accelerometer vector, returns number of updates
+******************************************************************************/
+
+int run_accl(
+  float                vec[3],
+  int                  num_iter,
+  float                q[4])
+{
+  // define local variables
+  IMU_datum            datum;
+  IMU_core_state       *state;
+  int                  status, count = 0;
+  int                  i;
+
+  // zero orientation to level
+  IMU_core_reset(id);
+  datum.type           = IMU_accl;
+  datum.t              = 0;
+  datum.val[0]         = 0;
+  datum.val[1]         = 0;
+  datum.val[2]         = 255;
+  status               = IMU_core_datum(id, &datum, NULL);
+  verify_int(status, IMU_core_enum_zeroed_accl);
+
+  // main processing loop
+  datum.val[0]         = vec[0];
+  datum.val[1]         = vec[1];
+  datum.val[2]         = vec[2];
+  for (i=0; i<num_iter; i++) {
+    datum.t           += 10;
+    status             = IMU_core_datum(id, &datum, NULL);
+    check_status(status, "IMU_core_datum failure");
+    if (status == IMU_core_enum_normal_op)
+      count++;
+    else if (status != IMU_core_enum_sched_skip)
+      verify_int(status, IMU_core_enum_normal_op);
+  }
+
+  // pass final orientation and update count
+  IMU_core_getState(id, &state);
+  memcpy(q, state->q, sizeof(state->q));
+  return count;
+}
+
+
+/******************************************************************************
+* angle between two orientations (degrees)
+******************************************************************************/
+
+float angle_error(
+  float                *q1,
+  float                *q2)
+{
+  double n1  = sqrt((double)q1[0]*q1[0] + (double)q1[1]*q1[1] +
+                    (double)q1[2]*q1[2] + (double)q1[3]*q1[3]);
+  double n2  = sqrt((double)q2[0]*q2[0] + (double)q2[1]*q2[1] +
+                    (double)q2[2]*q2[2] + (double)q2[3]*q2[3]);
+  double dot = fabs((double)q1[0]*q2[0] + (double)q1[1]*q2[1] +
+                    (double)q1[2]*q2[2] + (double)q1[3]*q2[3]) / (n1*n2);
+  if (dot > 1.0)
+    dot      = 1.0;
+  return (float)(2.0 * acos(dot) * 180.0 / M_PI);
+}
@@ -0,0 +1,160 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "IMU_core.h"
+#include "test_utils.h"
+
+// define globals
+uint16_t           id          = 0;
+IMU_core_config    *config     = NULL;
+
+// internal functions
+static int  add_accl     (uint32_t t, float vec[3]);
+static int  converge     (float vec[3], float ref[4]);
+static void verify_estm  (float ref[4]);
+
+
+/******************************************************************************
+* main function - test of fast-convergence startup mode
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  int                status, i;
+  int                numDef, numFast;
+
+  // start datum test
+  printf("starting test_core_start...\n");
+
+  // initialize core instance (accelerometer only)
+  status = IMU_core_init(&id, &config);
+  check_status(status, "IMU_core_init failure");
+  config->isGyro     = 0;
+  config->isMagn     = 0;
+
+  // zero averages the first zeroNum datum (noise cancels to level)
+  float vec1a[3]     = {     40,     -40,     255};
+  float vec1b[3]     = {    -40,      40,     255};
+  float out1[4]      = { 1.0000,  0.0000,  0.0000,  0.0000};
+  config->zeroNum    = 8;
+  IMU_core_reset(id);
+  for (i=0; i<7; i++) {
+    status = add_accl(i, (i % 2) ? vec1b : vec1a);
+    verify_int(status, IMU_core_enum_zero_accum);
+  }
+  status = add_accl(7, vec1b);
+  verify_int(status, IMU_core_enum_zeroed_accl);
+  verify_estm(out1);
+
+  // default weights (90deg pitch step after zero)
+  float vec2[3]      = {   -255,       0,       0};
+  float out2[4]      = { 0.7071,  0.0000,  0.7071,  0.0000};
+  config->zeroNum    = 1;
+  numDef             = converge(vec2, out2);
+
+  // decaying startup gain (20x relaxing over 2sec)
+  config->startGain  = 20.0;
+  config->startTime  = 2.0;
+  numFast            = converge(vec2, out2);
+  printf("datum to converge: %d (default %d)\n", numFast, numDef);
+  if (numFast <= 0 || numFast * 4 > numDef) {
+    printf("error: startup gain failure\n");
+    exit(0);
+  }
+
+  // gain has relaxed to configured value (same final response)
+  IMU_core_state     *state;
+  IMU_core_getState(id, &state);
+  verify_quat(state->q, out2);
+
+  // exit program
+  printf("pass: test_core_start\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* apply accelerometer datum (10msec ticks), returns core status
+******************************************************************************/
+
+int add_accl(
+  uint32_t             t,
+  float                vec[3])
+{
+  IMU_datum            datum;
+  datum.type           = IMU_accl;
+  datum.t              = t * 1000;
+  datum.val[0]         = vec[0];
+  datum.val[1]         = vec[1];
+  datum.val[2]         = vec[2];
+  return IMU_core_datum(id, &datum, NULL);
+}
+
+
+/******************************************************************************
+* zero to level then step, returns datum until within 1deg of reference
+******************************************************************************/
+
+int converge(
+  float                vec[3],
+  float                ref[4])
+{
+  // define local variables
+  float                level[3] = {0, 0, 255};
+  IMU_core_state       *state;
+  int                  num = -1;
+  int                  i;
+
+  // zero to level
+  IMU_core_reset(id);
+  IMU_core_getState(id, &state);
+  add_accl(0, level);
+
+  // apply step (4sec)
+  for (i=1; i<=400; i++) {
+    add_accl(i, vec);
+    float *q           = state->q;
+    float dot          = fabs(q[0]*ref[0] + q[1]*ref[1] +
+                              q[2]*ref[2] + q[3]*ref[3]);
+    if (num < 0 && dot > cos(0.5 * M_PI / 180.0))
+      num              = i;
+  }
+  return num;
+}
+
+
+/******************************************************************************
+* verify core quaternion
+******************************************************************************/
+
+void verify_estm(
+  float                ref[4])
+{
+  IMU_core_state       *state;
+  IMU_core_getState(id, &state);
+  float *q             = state->q;
+  printf("%0.4f, %0.4f, %0.4f, %0.4f\n", q[0], q[1], q[2], q[3]);
+  verify_quat(q, ref);
+}
@@ -0,0 +1,124 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "IMU_core.h"
+#include "test_utils.h"
+
+// define globals
+uint16_t           id          = 0;
+IMU_core_config    *config     = NULL;
+
+// internal functions
+static void verify_time  (IMU_time val1, IMU_time val2);
+static void run_gyro     (uint32_t t0, int num_datum, float q[4]);
+
+
+/******************************************************************************
+* main function - test of 64-bit time base (timestamp wrap and long uptime)
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  IMU_core_state     *state;
+  float              q[4];
+  int                status;
+
+  // start datum test
+  printf("starting test_core_time...\n");
+
+  // timestamp extension (same epoch, forward wrap, late datum, first datum)
+  verify_time(IMU_time_extend(0x000000000, 0x00000005), 0x000000005);
+  verify_time(IMU_time_extend(0x0FFFFFF00, 0x00000010), 0x100000010);
+  verify_time(IMU_time_extend(0x100000010, 0xFFFFFFF0), 0x0FFFFFFF0);
+  verify_time(IMU_time_extend(0x000000000, 0xF0000000), 0x0F0000000);
+  verify_time(IMU_time_extend(0x2FFFFFFF0, 0x00000005), 0x300000005);
+
+  // initialize core instance (gyroscope only)
+  status = IMU_core_init(&id, &config);
+  check_status(status, "IMU_core_init failure");
+  IMU_core_getState(id, &state);
+  config->isAccl     = 0;
+  config->isMagn     = 0;
+
+  // 1 rad/sec roll for 1 sec at 1kHz, timestamps wrap halfway
+  float out1[4]      = { 0.8776,  0.4794,  0.0000,  0.0000};
+  run_gyro(0xFFFFFFFF - 49999, 1001, q);
+  printf("%0.4f, %0.4f, %0.4f, %0.4f\n", q[0], q[1], q[2], q[3]);
+  verify_quat(q, out1);
+  verify_time(state->t, 0x100000000 + 50000);
+
+  // same rotation after ~11 hours of uptime (no float time quantization)
+  run_gyro(4000000000u, 1001, q);
+  printf("%0.4f, %0.4f, %0.4f, %0.4f\n", q[0], q[1], q[2], q[3]);
+  verify_quat(q, out1);
+
+  // exit program
+  printf("pass: test_core_time\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* verify 64-bit time value
+******************************************************************************/
+
+void verify_time(
+  IMU_time             val1,
+  IMU_time             val2)
+{
+  if (val1 != val2) {
+    printf("error: time results failure\n");
+    exit(0);
+  }
+}
+
+
+/******************************************************************************
+* reset then apply constant roll rate (1000 counts, 10usec ticks of 100)
+******************************************************************************/
+
+void run_gyro(
+  uint32_t             t0,
+  int                  num_datum,
+  float                q[4])
+{
+  // define local variables
+  IMU_datum            datum = {IMU_gyro, t0, {1000, 0, 0}};
+  IMU_core_state       *state;
+  int                  i;
+
+  // main processing loop (first datum only sets the time base)
+  IMU_core_reset(id);
+  for (i=0; i<num_datum; i++) {
+    IMU_core_datum(id, &datum, NULL);
+    datum.t           += 100;
+  }
+
+  // pass final orientation
+  IMU_core_getState(id, &state);
+  q[0]                 = state->q[0];
+  q[1]                 = state->q[1];
+  q[2]                 = state->q[2];
+  q[3]                 = state->q[3];
+}
@@ -0,0 +1,123 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "IMU_engn.h"
+#include "test_utils.h"
+
+// define globals
+uint16_t           id          = 0;
+
+
+/******************************************************************************
+* main function - versioned config publication (setConfig/syncConfig)
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  IMU_union_config   copy;
+  IMU_union_state    state;
+  IMU_core_config    core;
+  IMU_rect_config    rect;
+  IMU_engn_config    engn;
+  IMU_data3          data3     = {1000, {0, 0, 0}, {0, 0, 255}, {200, 0, 0}};
+  float              ref[4]    = {0.0, 1.0, 0.0, 0.0};
+  float              bias[3]   = {1.0, 2.0, 3.0};
+  int                status, i;
+
+  // start datum test
+  printf("starting test_engn_config...\n");
+
+  // initialize engine (rect and core)
+  status = IMU_engn_init(IMU_engn_rect_core, &id);
+  check_status(status, "IMU_engn_init failure");
+  IMU_engn_getState(id, IMU_engn_self, &state);
+
+  // queue thread not running, snapshot published (writer never applies)
+  copy.core          = &core;
+  IMU_engn_copyConfig(id, IMU_engn_core, &copy);
+  core.gScale        = 0.5;
+  status = IMU_engn_setConfig(id, IMU_engn_core, &copy);
+  verify_int(status, 1);
+  verify_int(state.engn->configVersion, 0);
+
+  // applied by the caller feeding the instance
+  status = IMU_engn_syncConfig(id);
+  check_status(status, "IMU_engn_syncConfig failure");
+  printf("version = %d, gScale = %0.2f\n", state.engn->configVersion,
+    state.engn->configCore->gScale);
+  verify_int(state.engn->configVersion, 1);
+  verify_data(state.engn->configCore->gScale, 0.5);
+
+  // subsystem not in engine type
+  status = IMU_engn_setConfig(id, IMU_engn_pnts, &copy);
+  verify_int(status, IMU_ENGN_UNINITIALIZE_SYS);
+  status = IMU_engn_copyConfig(id, IMU_engn_pnts, &copy);
+  verify_int(status, IMU_ENGN_UNINITIALIZE_SYS);
+
+  // engn config keeps subsystem layout, reference seeded from it
+  copy.engn          = &engn;
+  IMU_engn_copyConfig(id, IMU_engn_self, &copy);
+  engn.isRect        = 0;
+  engn.isAng         = 0;
+  IMU_engn_setConfig(id, IMU_engn_self, &copy);
+  IMU_engn_setRef(id, ref);
+  IMU_engn_copyConfig(id, IMU_engn_self, &copy);
+  verify_int(engn.isRect, 1);
+  verify_int(engn.isAng, 0);
+  verify_quat(engn.qRef, ref);
+  IMU_engn_syncConfig(id);
+  verify_int(state.engn->configVersion, 3);
+
+  // start queue thread, snapshots read by the pipeline
+  status = IMU_engn_start();
+  check_status(status, "IMU_engn_start failure");
+  copy.rect          = &rect;
+  IMU_engn_copyConfig(id, IMU_engn_rect, &copy);
+  for (i=0; i<100; i++) {
+    rect.gBias[0]    = bias[0] * i;
+    rect.gBias[1]    = bias[1] * i;
+    rect.gBias[2]    = bias[2] * i;
+    status = IMU_engn_setConfig(id, IMU_engn_rect, &copy);
+    verify_int(status, 4 + i);
+  }
+  status = IMU_engn_syncConfig(id);
+  check_status(status, "IMU_engn_syncConfig failure");
+  print_vect(state.engn->configRect->gBias);
+  verify_vect(state.engn->configRect->gBias, rect.gBias);
+  verify_int(state.engn->configVersion, 103);
+
+  // data3 queued to the pipeline thread (snapshot read from the next datum)
+  rect.gBias[0]      = 0.0;
+  IMU_engn_setConfig(id, IMU_engn_rect, &copy);
+  status = IMU_engn_data3(id, &data3);
+  verify_int(status > 0, 1);
+  usleep(msg_delay);
+  verify_int(state.engn->datumCount, 1);
+  verify_int(state.engn->configVersion, 104);
+  verify_data(state.engn->configRect->gBias[0], 0.0);
+
+  // exit program
+  printf("pass: test_engn_config\n\n");
+  return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "IMU_engn.h"
+#include "IMU_math.h"
+#include "test_utils.h"
+
+// define globals
+uint16_t           id          = 0;
+uint16_t           idCore      = 0;
+uint32_t           curTime     = 0;
+
+// define internal functions
+static void add_data3    (float g[3]);
+static void verify_estm  (IMU_engn_config *config, IMU_engn_estm *estm);
+
+
+/******************************************************************************
+* main function - derived estimates cached per core state version
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  IMU_union_config   config;
+  IMU_union_state    state, core;
+  IMU_engn_estm      e1, e2;
+  float              gyro[3]   = {0.2, -0.1, 0.05};
+  float              ref[4]    = {0.9239, 0.0, 0.3827, 0.0};
+  float              unit[4]   = {1.0, 0.0, 0.0, 0.0};
+  unsigned int       version;
+  int                status;
+
+  // start datum test
+  printf("starting test_engn_estm...\n");
+
+  // initialize engine (core only), every estimate output enabled
+  status = IMU_engn_init(IMU_engn_core_only, &id);
+  check_status(status, "IMU_engn_init failure");
+  IMU_engn_getSysID(id, IMU_engn_core, &idCore);
+  IMU_engn_getConfig(id, IMU_engn_self, &config);
+  IMU_engn_getState(id, IMU_engn_self, &state);
+  IMU_engn_getState(id, IMU_engn_core, &core);
+  config.engn->isTran = 1;
+  config.engn->isRef  = 1;
+  config.engn->isAng  = 1;
+  IMU_engn_reset(id);
+  add_data3(gyro);
+
+  // repeated reads share one derivation
+  IMU_engn_getEstm(id, 0, &e1);
+  IMU_engn_getEstm(id, 0, &e2);
+  verify_int(state.engn->estmCount, 1);
+  verify_int(memcmp(&e1, &e2, sizeof(IMU_engn_estm)), 0);
+  verify_estm(config.engn, &e2);
+
+  // new state version refreshes the cache
+  version            = core.core->version;
+  add_data3(gyro);
+  verify_int(core.core->version == version, 0);
+  IMU_engn_getEstm(id, 0, &e1);
+  IMU_engn_getEstm(id, 0, &e2);
+  print_vect(e2.ang);
+  verify_int(state.engn->estmCount, 2);
+  verify_estm(config.engn, &e2);
+
+  // reference change re-derives q and ang only (published snapshot)
+  IMU_engn_setRef(id, ref);
+  IMU_engn_getConfig(id, IMU_engn_self, &config);
+  IMU_engn_getEstm(id, 0, &e2);
+  print_vect(e2.ang);
+  verify_int(state.engn->estmCount, 2);
+  verify_int(memcmp(e1.qOrg, e2.qOrg, sizeof(e1.qOrg)), 0);
+  verify_estm(config.engn, &e2);
+
+  // reference disabled in place (ang from qOrg)
+  config.engn->isRef  = 0;
+  IMU_engn_getEstm(id, 0, &e2);
+  verify_int(state.engn->estmCount, 2);
+  verify_estm(config.engn, &e2);
+
+  // reset invalidates the cache
+  IMU_engn_reset(id);
+  IMU_engn_getEstm(id, 0, &e2);
+  verify_int(state.engn->estmCount, 3);
+  verify_quat(e2.qOrg, unit);
+
+  // exit program
+  printf("pass: test_engn_estm\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* inject synchronized datum (level, rotating at the given rate)
+******************************************************************************/
+
+void add_data3(
+  float                g[3])
+{
+  // define local variable
+  IMU_data3            data3;
+  int                  status;
+
+  // increment time and inject datum
+  curTime             += 1000;
+  data3.t              = curTime;
+  data3.g[0]           = g[0] / 0.001;
+  data3.g[1]           = g[1] / 0.001;
+  data3.g[2]           = g[2] / 0.001;
+  data3.a[0]           = 20;
+  data3.a[1]           = 0;
+  data3.a[2]           = 255;
+  data3.m[0]           = 200;
+  data3.m[1]           = 0;
+  data3.m[2]           = -80;
+  status               = IMU_engn_data3(id, &data3);
+  check_status(status, "IMU_engn_data3 failure");
+}
+
+
+/******************************************************************************
+* cached estimate matches direct derivation from the core state
+******************************************************************************/
+
+void verify_estm(
+  IMU_engn_config      *config,
+  IMU_engn_estm        *estm)
+{
+  // define local variable
+  float                qOrg[4], q[4], ang[3], tran[3];
+
+  // derive directly from core
+  IMU_core_estmQuat(idCore, 0, qOrg);
+  IMU_core_estmAccl(idCore, 0, tran);
+  IMU_math_quatMultConj(qOrg, config->qRef, q);
+  IMU_math_quatToEulerFast(config->isRef ? q : qOrg, ang);
+
+  // compare enabled outputs
+  verify_quat(estm->qOrg, qOrg);
+  verify_vect(estm->tran, tran);
+  verify_vect(estm->ang,  ang);
+  if (config->isRef)
+    verify_quat(estm->q, q);
+}
@@ -0,0 +1,162 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <math.h>
+#include "IMU_engn.h"
+#include "test_utils.h"
+
+// define globals
+uint16_t           id          = 0;
+uint32_t           curTime     = 0;
+
+// define internal functions
+static void process      (int num_still, int num_move, float ref[4]);
+static void add_datum    (IMU_sensor type, float vec[3]);
+static int  verify_state (int state);
+
+
+/******************************************************************************
+* main function - test of motion-gated fusion
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  IMU_union_config   config;
+  IMU_union_state    engn;
+  int                status, count;
+
+  // start datum test
+  printf("starting test_engn_gate...\n");
+
+  // initialize imu engine (rect, pnts, calb, and core)
+  status = IMU_engn_init(IMU_engn_calb_pnts, &id);
+  check_status(status, "IMU_engn_init failure");
+  status = IMU_engn_load(id, "../config/test_core.json", IMU_engn_core);
+  check_status(status, "IMU_engn_load failure");
+  status = IMU_engn_load(id, "../config/test_pnts.json", IMU_engn_pnts);
+  check_status(status, "IMU_engn_load failure");
+  IMU_engn_getConfig(id, IMU_engn_self, &config);
+  config.engn->tGate  = 10000;
+  status = IMU_engn_start();
+  check_status(status, "IMU_engn_start failure");
+
+  // full rate fusion (1sec still, 0.5sec roll at 0.262 rad/sec)
+  float ref[4]       = { 0.9979,  0.0654,  0.0000,  0.0000};
+  process(100, 50, ref);
+  IMU_engn_getState(id, IMU_engn_self, &engn);
+  verify_int(engn.engn->gateCount, 0);
+
+  // motion-gated fusion (same orientation, core bypassed while stable)
+  config.engn->isGate = 1;
+  process(100, 50, ref);
+  IMU_engn_getState(id, IMU_engn_self, &engn);
+  count              = engn.engn->gateCount;
+  printf("gated datum: %d of 250\n", count);
+  if (count < 100) {
+    printf("error: motion gate failure\n");
+    exit(0);
+  }
+
+  // exit program
+  printf("pass: test_engn_gate\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* stationary gyro/accl period followed by constant roll rate
+******************************************************************************/
+
+void process(
+  int                  num_still,
+  int                  num_move,
+  float                ref[4])
+{
+  // define local variables
+  float                gZero[3] = {  0,   0,   0};
+  float                gRoll[3] = { 67,   0,   0};
+  float                aLevel[3]= {  0,   0, 255};
+  IMU_engn_estm        estm;
+  int                  i;
+
+  // reset engine (datum time restarts from zero)
+  IMU_engn_reset(id);
+  curTime              = 0;
+
+  // stationary period (pnts reaches stable after tStable)
+  for (i=0; i<num_still; i++) {
+    add_datum(IMU_accl, aLevel);
+    add_datum(IMU_gyro, gZero);
+  }
+  verify_state(IMU_pnts_enum_stable);
+
+  // moving period (constant rate returns pnts to stable, not gated)
+  for (i=0; i<num_move; i++)
+    add_datum(IMU_gyro, gRoll);
+
+  // verify quaternion
+  IMU_engn_getEstm(id, 0, &estm);
+  float *q = estm.qOrg;
+  printf("%0.4f, %0.4f, %0.4f, %0.4f\n", q[0], q[1], q[2], q[3]);
+  verify_quat(q, ref);
+}
+
+
+/******************************************************************************
+* inject datum (10msec per datum)
+******************************************************************************/
+
+void add_datum(
+  IMU_sensor           type,
+  float                vec[3])
+{
+  // define local variable
+  IMU_datum            datum;
+  int                  status;
+
+  // increment time and inject datum
+  curTime             += 1000;
+  datum.type           = type;
+  datum.t              = curTime;
+  datum.val[0]         = vec[0];
+  datum.val[1]         = vec[1];
+  datum.val[2]         = vec[2];
+  status               = IMU_engn_datum(id, &datum);
+  check_status(status, "IMU_engn_datum failure");
+  usleep(msg_delay);
+}
+
+
+/******************************************************************************
+* verify pnts state
+******************************************************************************/
+
+int verify_state(
+  int                  state)
+{
+  IMU_union_state      pnts;
+  IMU_engn_getState(id, IMU_engn_pnts, &pnts);
+  verify_int(pnts.pnts->state, state);
+  return 0;
+}
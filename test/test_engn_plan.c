@@ -0,0 +1,160 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "IMU_engn.h"
+#include "test_utils.h"
+
+// define globals
+uint16_t           id          = 0;
+uint32_t           curTime     = 0;
+float              gScale      = 0.001;
+
+// define internal functions
+static void add_gyro     (float g[3], float out[3]);
+
+
+/******************************************************************************
+* main function - compiled pipeline follows published config
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  IMU_union_config   config, rect, core;
+  IMU_engn_config    engnCopy;
+  IMU_rect_config    rectCopy;
+  IMU_core_config    coreCopy;
+  IMU_union_state    state;
+  IMU_engn_sensor    *sensor;
+  float              gyro[3]   = {100.0,  50.0, -20.0};
+  float              ref1[3]   = {0.150,  0.050, -0.020};
+  float              ref2[3]   = {0.100,  0.050, -0.020};
+  float              out[3];
+  int                status;
+
+  // start datum test
+  printf("starting test_engn_plan...\n");
+
+  // initialize engine (rect and core), rect adds gyro bias
+  status = IMU_engn_init(IMU_engn_rect_core, &id);
+  check_status(status, "IMU_engn_init failure");
+  config.engn        = &engnCopy;
+  rect.rect          = &rectCopy;
+  core.core          = &coreCopy;
+  IMU_engn_copyConfig(id, IMU_engn_self, &config);
+  IMU_engn_copyConfig(id, IMU_engn_rect, &rect);
+  IMU_engn_copyConfig(id, IMU_engn_core, &core);
+  IMU_engn_getState(id, IMU_engn_self, &state);
+  core.core->gScale  = gScale;
+  rect.rect->gBias[0] = 50.0;
+  IMU_engn_setConfig(id, IMU_engn_core, &core);
+  IMU_engn_setConfig(id, IMU_engn_rect, &rect);
+  status = IMU_engn_start();
+  check_status(status, "IMU_engn_start failure");
+
+  // rect and core pipeline
+  add_gyro(gyro, out);
+  print_vect(out);
+  verify_vect(out, ref1);
+  verify_int(state.engn->rect, 0);
+
+  // rect disabled, stage dropped (reported disabled)
+  rect.rect->enable  = 0;
+  IMU_engn_setConfig(id, IMU_engn_rect, &rect);
+  IMU_engn_syncConfig(id);
+  add_gyro(gyro, out);
+  print_vect(out);
+  verify_vect(out, ref2);
+  verify_int(state.engn->rect, IMU_RECT_FNC_DISABLED);
+
+  // rect re-enabled
+  rect.rect->enable  = 1;
+  IMU_engn_setConfig(id, IMU_engn_rect, &rect);
+  IMU_engn_syncConfig(id);
+  add_gyro(gyro, out);
+  verify_vect(out, ref1);
+  verify_int(state.engn->rect, 0);
+
+  // engine flags (sensor structure stage added)
+  config.engn->isSensorStruct = 1;
+  IMU_engn_setConfig(id, IMU_engn_self, &config);
+  IMU_engn_syncConfig(id);
+  add_gyro(gyro, out);
+  IMU_engn_getSensor(id, &sensor);
+  verify_int(sensor->gRaw[0], (int)gyro[0]);
+  verify_int(sensor->gRaw[2], (int)gyro[2]);
+  verify_vect(out, ref1);
+
+  // core only pipeline (subsystem layout kept, rect stage dropped)
+  config.engn->isSensorStruct = 0;
+  rect.rect->enable  = 0;
+  IMU_engn_setConfig(id, IMU_engn_self, &config);
+  IMU_engn_setConfig(id, IMU_engn_rect, &rect);
+  IMU_engn_syncConfig(id);
+  add_gyro(gyro, out);
+  print_vect(out);
+  verify_vect(out, ref2);
+
+  // gScale (gate limit and core rate rescaled)
+  core.core->gScale  = 2.0 * gScale;
+  IMU_engn_setConfig(id, IMU_engn_core, &core);
+  IMU_engn_syncConfig(id);
+  add_gyro(gyro, out);
+  verify_data(out[0], 2.0 * ref2[0]);
+
+  // exit program
+  printf("pass: test_engn_plan\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* inject gyroscope datum, returns core rate (rad/sec)
+******************************************************************************/
+
+void add_gyro(
+  float                g[3],
+  float                out[3])
+{
+  // define local variable
+  IMU_datum            datum;
+  IMU_union_state      core;
+  int                  status;
+
+  // increment time and inject datum
+  curTime             += 1000;
+  datum.type           = IMU_gyro;
+  datum.t              = curTime;
+  datum.val[0]         = g[0];
+  datum.val[1]         = g[1];
+  datum.val[2]         = g[2];
+  status               = IMU_engn_datum(id, &datum);
+  check_status(status, "IMU_engn_datum failure");
+  usleep(msg_delay);
+
+  // rate applied by core
+  IMU_engn_getState(id, IMU_engn_core, &core);
+  out[0]               = core.core->gPrev[0];
+  out[1]               = core.core->gPrev[1];
+  out[2]               = core.core->gPrev[2];
+}
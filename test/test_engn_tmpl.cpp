@@ -0,0 +1,194 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <utility>
+#include "IMU_engn.hpp"
+#include "test_utils.h"
+
+// engine internal (synchronous) processing function
+extern "C" int IMU_engn_process(uint16_t id, IMU_datum*);
+
+// define constants
+static const int   num_samp    = 3000;    // datum per stream
+static const int   noise       = 3;       // uniform noise (+/- counts)
+
+// full pipeline w/ every estimate output
+typedef IMU::engn<IMU_TYPE, IMU::stage_rect | IMU::stage_pnts |
+                  IMU::stage_stat | IMU::stage_calb | IMU::stage_FOM |
+                  IMU::stage_tran | IMU::stage_ref  | IMU::stage_ang>
+                  engn_full;
+
+// define internal functions
+static void gen_datum   (int i, IMU_datum *datum);
+static void gen_data3   (int i, IMU_data3 *data3);
+static int  is_same     (IMU_engn_estm *e1, IMU_engn_estm *e2);
+
+
+/******************************************************************************
+* main function - compile-time pipeline matches IMU_engn_process bit for bit
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  IMU_union_config   config;
+  IMU_datum          d1, d2;
+  IMU_data3          d31, d32;
+  IMU_engn_estm      e1, e2;
+  uint16_t           id;
+  float              ref[4]    = {0.9239, 0.0, 0.3827, 0.0};
+  int                status, isSame = 1, i;
+
+  // start datum test
+  printf("starting test_engn_tmpl...\n");
+
+  // C engine (all subsystems, every estimate output)
+  status = IMU_engn_init(IMU_engn_calb_full, &id);
+  verify_int(status, 0);
+  IMU_engn_getConfig(id, IMU_engn_self, &config);
+  config.engn->isFOM         = 1;
+  config.engn->isTran        = 1;
+  config.engn->isRef         = 1;
+  config.engn->isAng         = 1;
+  IMU_engn_setRef(id, ref);
+
+  // template engine (moved into place, copies not allowed)
+  engn_full          tmp;
+  engn_full          tmpl(std::move(tmp));
+  verify_int(tmpl.status(), 0);
+  verify_int(tmp.status(), IMU_ENGN_BAD_INST);
+  tmpl.setRef(ref);
+
+  // identical subsystem config (rect bias, pnts thresholds, FOM weights)
+  IMU_engn_getConfig(id, IMU_engn_core, &config);
+  config.core->isFOM         = 1;
+  config.core->isTran        = 1;
+  config.core->aMag          = 255.0;
+  config.core->aMagThresh    = 128.0;
+  *tmpl.core()               = *config.core;
+  IMU_engn_getConfig(id, IMU_engn_rect, &config);
+  config.rect->gBias[0]      = 3.0;
+  config.rect->aBias[2]      = -4.0;
+  *tmpl.rect()               = *config.rect;
+  IMU_engn_getConfig(id, IMU_engn_pnts, &config);
+  config.pnts->enable        = 1;
+  config.pnts->gThresh       = 20.0 * 20.0;
+  config.pnts->aThresh       = 30.0 * 30.0;
+  config.pnts->mThresh       = 40.0 * 40.0;
+  *tmpl.pnts()               = *config.pnts;
+  IMU_engn_reset(id);
+  tmpl.reset();
+
+  // asynchronous datum stream (engine modifies datum in place)
+  for (i=0; i<num_samp; i++) {
+    gen_datum(i, &d1);
+    d2               = d1;
+    IMU_engn_process(id, &d1);
+    tmpl.process(&d2);
+    IMU_engn_getEstm(id, 0, &e1);
+    tmpl.getEstm(0, &e2);
+    isSame          &= is_same(&e1, &e2);
+  }
+  printf("datum: %0.4f, %0.4f, %0.4f, %0.4f\n", e2.q[0], e2.q[1], e2.q[2],
+         e2.q[3]);
+  verify_int(isSame, 1);
+  verify_int(tmpl.datumCount(), num_samp);
+
+  // synchronized data3 stream
+  for (i=0; i<num_samp/3; i++) {
+    gen_data3(num_samp + i, &d31);
+    d32              = d31;
+    IMU_engn_data3(id, &d31);
+    tmpl.process(&d32);
+    IMU_engn_getEstm(id, 0, &e1);
+    tmpl.getEstm(0, &e2);
+    isSame          &= is_same(&e1, &e2);
+  }
+  printf("data3: %0.4f, %0.4f, %0.4f, %0.4f\n", e2.q[0], e2.q[1], e2.q[2],
+         e2.q[3]);
+  verify_int(isSame, 1);
+
+  // exit program
+  printf("pass: test_engn_tmpl\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* slow tumble w/ noise (gyro, accl, magn in turn, 100Hz per sensor)
+******************************************************************************/
+
+void gen_datum(
+  int                i,
+  IMU_datum          *datum)
+{
+  int                k         = i / 3;
+  float              w         = 0.02f * k;
+  datum->type        = (IMU_sensor)(IMU_gyro + i % 3);
+  datum->t           = 1000 * (k + 1);
+  if (datum->type == IMU_gyro) {
+    datum->val[0]    = (IMU_TYPE)(200.0f * sinf(w));
+    datum->val[1]    = (IMU_TYPE)(100.0f * cosf(w));
+    datum->val[2]    = (IMU_TYPE)(rand() % (2*noise+1) - noise);
+  } else if (datum->type == IMU_accl) {
+    datum->val[0]    = (IMU_TYPE)(255.0f * sinf(w));
+    datum->val[1]    = (IMU_TYPE)(rand() % (2*noise+1) - noise);
+    datum->val[2]    = (IMU_TYPE)(255.0f * cosf(w));
+  } else {
+    datum->val[0]    = (IMU_TYPE)(200.0f * cosf(w));
+    datum->val[1]    = (IMU_TYPE)(150.0f + rand() % (2*noise+1) - noise);
+    datum->val[2]    = (IMU_TYPE)(-80.0f * sinf(w));
+  }
+}
+
+
+/******************************************************************************
+* synchronized sensors from the same trajectory
+******************************************************************************/
+
+void gen_data3(
+  int                i,
+  IMU_data3          *data3)
+{
+  IMU_datum          datum;
+  gen_datum(3*i,   &datum);
+  memcpy(data3->g, datum.val, sizeof(data3->g));
+  gen_datum(3*i+1, &datum);
+  memcpy(data3->a, datum.val, sizeof(data3->a));
+  gen_datum(3*i+2, &datum);
+  memcpy(data3->m, datum.val, sizeof(data3->m));
+  data3->t           = datum.t;
+}
+
+
+/******************************************************************************
+* bitwise comparison of estimates
+******************************************************************************/
+
+int is_same(
+  IMU_engn_estm      *e1,
+  IMU_engn_estm      *e2)
+{
+  return memcmp(e1, e2, sizeof(IMU_engn_estm)) == 0;
+}
@@ -0,0 +1,178 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "test_utils.h"
+#include "IMU_math.h"
+#include "IMU_core.h"
+
+// internal functions
+static void process_gyro   (float gyro[3], float dt, int num_iter,
+                            float q_ref[4]);
+static void process_fused  (float q_init[4], float a[3], float m[3],
+                            int num_iter, float q_ref[4]);
+static void process_core   (IMU_data3 *data3, int num_iter);
+
+
+/******************************************************************************
+* main function - test of single-pass gyro/accl/magn update
+******************************************************************************/
+
+int main(void)
+{
+  // start datum test
+  printf("starting test_estm_fused...\n");
+
+  // test gyroscope integration (no correction weight)
+  float gyro1[3]  = { 0.2618,  0.0000,  0.0000};
+  float ref1[4]   = { 0.7071,  0.7071,  0.0000,  0.0000};
+  process_gyro(gyro1, 0.1, 60, ref1);
+  float gyro2[3]  = { 0.0000,  0.0000,  0.2618};
+  float ref2[4]   = { 0.7071,  0.0000,  0.0000,  0.7071};
+  process_gyro(gyro2, 0.1, 60, ref2);
+
+  // test accelerometer/magnetometer correction (no rotation)
+  float q3[4]     = { 0.9659,  0.2588,  0.0000,  0.0000};
+  float a3[3]     = { 0.0000,  0.0000,  1.0000};
+  float m3[3]     = { 1.0000,  0.0000,  0.0000};
+  float ref3[4]   = { 1.0000,  0.0000,  0.0000,  0.0000};
+  process_fused(q3, a3, m3, 400, ref3);
+  float q4[4]     = { 0.7934,  0.0000,  0.6088,  0.0000};
+  float a4[3]     = {-1.0000,  0.0000,  0.0000};
+  float m4[3]     = { 0.0000,  0.0000,  1.0000};
+  float ref4[4]   = { 0.7071,  0.0000,  0.7071,  0.0000};
+  process_fused(q4, a4, m4, 400, ref4);
+
+  // test core fused option against sequential updates
+  IMU_data3 data3 = {0, {0, 0, 0}, {0, 0, 255}, {255, 0, 0}};
+  process_core(&data3, 1);
+  data3.g[2]      = 50;
+  data3.a[1]      = 180;
+  data3.a[2]      = 180;
+  process_core(&data3, 300);
+
+  // exit program
+  printf("pass: test_estm_fused\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* verify gyroscope integration matches estmGyro (normalized)
+******************************************************************************/
+
+void process_gyro(
+  float                gyro[3],
+  float                dt,
+  int                  num_iter,
+  float                q_ref[4])
+{
+  // main processing loop
+  float                q[4]   = {1.0f, 0.0f, 0.0f, 0.0f};
+  float                a[3]   = {0.0f, 0.0f, 1.0f};
+  float                m[3]   = {1.0f, 0.0f, 0.0f};
+  float                FOM[2];
+  int                  i;
+  for (i=0; i<num_iter; i++)
+    IMU_math_estmFused(q, gyro, dt, a, m, 0.0f, 0.0f, FOM);
+
+  // print and verifiy final quaternion
+  printf("%0.2f, %0.2f, %0.2f, %0.2f\n", q[0], q[1], q[2], q[3]);
+  verify_quat(q, q_ref);
+}
+
+
+/******************************************************************************
+* verify fused correction against reference and sequential updates
+******************************************************************************/
+
+void process_fused(
+  float                q_init[4],
+  float                a[3],
+  float                m[3],
+  int                  num_iter,
+  float                q_ref[4])
+{
+  // define local variables
+  float                q[4], q_seq[4];
+  float                g[3]   = {0.0f, 0.0f, 0.0f};
+  float                FOM[2];
+  int                  i;
+  memcpy(q,     q_init, sizeof(q));
+  memcpy(q_seq, q_init, sizeof(q_seq));
+
+  // main processing loop
+  for (i=0; i<num_iter; i++) {
+    IMU_math_estmFused(q, g, 0.01f, a, m, 0.01f, 0.01f, FOM);
+    IMU_math_estmAccl(q_seq, a, 0.01f, &FOM[0]);
+    IMU_math_estmMagnNorm(q_seq, m, 0.01f, &FOM[1]);
+  }
+
+  // print and verifiy final quaternion
+  printf("%0.2f, %0.2f, %0.2f, %0.2f\n", q[0], q[1], q[2], q[3]);
+  verify_quat(q, q_ref);
+  verify_quat(q, q_seq);
+}
+
+
+/******************************************************************************
+* verify core fused option tracks the sequential data3 update
+******************************************************************************/
+
+void process_core(
+  IMU_data3            *data3,
+  int                  num_iter)
+{
+  // create one fused and one sequential instance
+  static uint16_t      idFused, idSeq;
+  static int           isInit = 0;
+  IMU_core_config      *config;
+  int                  status;
+  if (!isInit) {
+    status = IMU_core_init(&idFused, &config);
+    check_status(status, "IMU_core_init failure");
+    config->isFused    = 1;
+    status = IMU_core_init(&idSeq, &config);
+    check_status(status, "IMU_core_init failure");
+    IMU_core_reset(idFused);
+    IMU_core_reset(idSeq);
+    isInit             = 1;
+  }
+
+  // main processing loop
+  float                q[4], q_seq[4];
+  int                  i;
+  for (i=0; i<num_iter; i++) {
+    data3->t          += 1000;
+    status = IMU_core_data3(idFused, data3, NULL);
+    check_status(status, "IMU_core_data3 failure");
+    status = IMU_core_data3(idSeq,   data3, NULL);
+    check_status(status, "IMU_core_data3 failure");
+  }
+
+  // print and verifiy final quaternion
+  IMU_core_estmQuat(idFused, data3->t, q);
+  IMU_core_estmQuat(idSeq,   data3->t, q_seq);
+  printf("%0.2f, %0.2f, %0.2f, %0.2f\n", q[0], q[1], q[2], q[3]);
+  verify_quat(q, q_seq);
+}
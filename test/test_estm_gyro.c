@@ -27,6 +27,8 @@
 // internal functions
 static void process_rotate (float q[3], float gyro[3], float dt, 
                             int num_iter, float q_ref[4]);
+static void process_coarse (float gyro[3], float dt, int num_iter,
+                            float q_ref[4]);
 
 
 /******************************************************************************
@@ -58,6 +60,14 @@ int main(void)
   float ref3[4]   = { 0.7108,  0.0000,  0.0000,  0.7108};
   process_rotate(q3, gyro3, dt, num_iter, ref3);
 
+  // test exponential map and Runge-Kutta (coarse time step)
+  float gyro4[3]  = { 0.2618,  0.0000,  0.0000};
+  float ref4[4]   = { 0.7071,  0.7071,  0.0000,  0.0000};
+  process_coarse(gyro4, 1.5, 4, ref4);
+  float gyro5[3]  = { 0.0000,  0.1309,  0.1309};
+  float ref5[4]   = { 0.8497,  0.0000,  0.3728,  0.3728};
+  process_coarse(gyro5, 2.0, 3, ref5);
+
   // exit program
   printf("pass: test_estm_gyro\n\n");
   return 0;
@@ -84,3 +94,30 @@ void process_rotate(
   printf("%0.2f, %0.2f, %0.2f, %0.2f\n", q[0], q[1], q[2], q[3]);
   verify_quat(q, q_ref);
 }
+
+
+/******************************************************************************
+* verifies exponential map and Runge-Kutta integrators at coarse time step
+******************************************************************************/
+
+void process_coarse(
+  float                gyro[3],
+  float                dt,
+  int                  num_iter,
+  float                q_ref[4])
+{
+  // main processing loop
+  float                q1[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+  float                q2[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+  int                  i;
+  for (i=0; i<num_iter; i++) {
+    IMU_math_estmGyroExp(q1, gyro, dt);
+    IMU_math_estmGyroRK4(q2, gyro, gyro, dt);
+  }
+
+  // print and verifiy final quaternion
+  printf("%0.2f, %0.2f, %0.2f, %0.2f\n", q1[0], q1[1], q1[2], q1[3]);
+  verify_quat(q1, q_ref);
+  printf("%0.2f, %0.2f, %0.2f, %0.2f\n", q2[0], q2[1], q2[2], q2[3]);
+  verify_quat(q2, q_ref);
+}
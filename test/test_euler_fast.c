@@ -0,0 +1,155 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "IMU_math.h"
+#include "IMU_simd.h"
+#include "test_utils.h"
+
+// define constants
+#define            num_samp      100003      // not a multiple of any width
+static const double euler_tol  = 3e-6;       // polynomial error bound (rad)
+static const double simd_tol   = 1e-6;       // fma contraction differences
+
+// define globals (structure of arrays)
+float              qa[4][num_samp], Ea[3][num_samp];
+
+// internal functions
+static void   test_quat   (float quat[4],  float euler[3]);
+static double angle_diff  (double a, double b);
+
+
+/******************************************************************************
+* main function - accuracy of polynomial quaternion to Euler conversion
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  IMU_simd_quat      q = {{qa[0], qa[1], qa[2], qa[3]}};
+  IMU_simd_vect      E = {{Ea[0], Ea[1], Ea[2]}};
+  IMU_simd_isa       isa;
+  float              a[4], ref[3], out[3];
+  double             err, max = 0.0;
+  int                i, j;
+
+  // start euler test
+  printf("starting test_euler_fast...\n");
+
+  // axis aligned orientations (same values as test_euler)
+  float input1[4]    = {1, 0, 0, 0};
+  float test1[3]     = {0, 0, 0};
+  test_quat(input1, test1);
+  float input2[4]    = {0, 1, 0, 0};
+  float test2[3]     = {0, 0, 180};
+  test_quat(input2, test2);
+  float input4[4]    = {0, 0, 0, 1};
+  float test4[3]     = {180, 0, 0};
+  test_quat(input4, test4);
+  float input6[4]    = {sqrt(0.5), 0, sqrt(0.5), 0};
+  float test6[3]     = {0, 90, 0};
+  test_quat(input6, test6);
+  float input8[4]    = {sqrt(0.5), -sqrt(0.5), 0, 0};
+  float test8[3]     = {0, 0, -90};
+  test_quat(input8, test8);
+  float input10[4]   = {sqrt(0.5), 0, 0, -sqrt(0.5)};
+  float test10[3]    = {-90, 0, 0};
+  test_quat(input10, test10);
+
+  // pitch saturates for unnormalized input
+  float input11[4]   = {1, 0, 0.6, 0};
+  float test11[3]    = {0, 90, 0};
+  test_quat(input11, test11);
+
+  // random unit quaternions vs libm conversion
+  srand(1);
+  for (i=0; i<num_samp; i++) {
+    for (j=0; j<4; j++)
+      a[j]           = (float)(rand() % 2001 - 1000) / 1000.0f;
+    IMU_math_norm4(a);
+    for (j=0; j<4; j++)
+      qa[j][i]       = a[j];
+    IMU_math_quatToEuler(a, ref);
+    IMU_math_quatToEulerFast(a, out);
+    for (j=0; j<3; j++) {
+      err            = angle_diff(out[j], ref[j]);
+      if (err > max)
+        max          = err;
+    }
+  }
+  printf("max error: %0.3g rad\n", max);
+  if (max > euler_tol) {
+    printf("error: euler precision failure\n");
+    exit(0);
+  }
+
+  // batched conversion matches scalar for every supported set (rounding
+  // differences grow as 1/cos(pitch) approaching gimbal lock)
+  for (isa=IMU_simd_scalar; isa<=IMU_simd_bestIsa(); isa++) {
+    verify_int(IMU_simd_setIsa(isa), 0);
+    IMU_simd_quatToEuler(&q, &E, num_samp);
+    for (i=0; i<num_samp; i++) {
+      for (j=0; j<4; j++)
+        a[j]         = qa[j][i];
+      IMU_math_quatToEulerFast(a, ref);
+      for (j=0; j<3; j++) {
+        if (angle_diff(Ea[j][i], ref[j]) > simd_tol / cos(ref[1])) {
+          printf("error: batched euler failure (sample %d)\n", i);
+          exit(0);
+        }
+      }
+    }
+  }
+
+  // exit program
+  printf("pass: test_euler_fast\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* convert and verify against reference (degrees)
+******************************************************************************/
+
+void test_quat(
+  float                input[4],  
+  float                euler[3])
+{
+  float test[3]        = {0, 0, 0};
+  IMU_math_quatToEulerFast(input, test);
+  IMU_math_radToDeg(test, test);
+  printf("%0.3f, %0.3f, %0.3f\n", test[0], test[1], test[2]);
+  verify_vect(test, euler);
+}
+
+
+/******************************************************************************
+* absolute angle difference (wrapped, +/-pi are the same angle)
+******************************************************************************/
+
+double angle_diff(
+  double               a,
+  double               b)
+{
+  double d             = fabs(a - b);
+  return (d > M_PI) ? 2.0 * M_PI - d : d;
+}
@@ -51,8 +51,6 @@ int main(void)
   check_status(status, "IMU_engn_init failure");
   status = IMU_engn_load(id, "../config/test_core.json", IMU_engn_core);
   check_status(status, "IMU_engn_load failure");
-  status = IMU_engn_start();
-  check_status(status, "IMU_engn_start failure");
 
   // enable sensor structure
   status = IMU_engn_getConfig(id, IMU_engn_self, &config);
@@ -67,6 +65,10 @@ int main(void)
   config.core->aMag           = 255.0;
   config.core->aMagThresh     = 128.0;
 
+  // start data queue
+  status = IMU_engn_start();
+  check_status(status, "IMU_engn_start failure");
+
 
   /****************************************************************************
   * testing magnitude error
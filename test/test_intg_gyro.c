@@ -0,0 +1,297 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include "IMU_engn.h"
+#include "IMU_math.h"
+#include "test_utils.h"
+
+// define constants
+static const uint32_t   tick      = 25;        // 4kHz gyro (10usec ticks)
+static const float      cone_amp  = 5.0;       // coning rate amplitude
+static const float      cone_freq = 50.0;      // coning frequency (Hz)
+
+// internal functions
+static void  process_const (uint16_t id, float g[3], int num_iter,
+                            float ref[4]);
+static float process_cone  (uint16_t id, int num_iter, float ref[4]);
+static void  process_engn  (float gyro[3], float dt, int num_iter,
+                            float ref[4], int count);
+static void  cone_rate     (double t, double *g);
+static void  cone_mean     (double t0, double t1, double *g);
+static void  cone_truth    (int num_iter, float *q);
+static float angle_error   (float *q1, float *q2);
+
+
+/******************************************************************************
+* main function - test of gyroscope pre-integration front-end
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  uint16_t           id;
+  IMU_intg_config    *config;
+  int                status;
+
+  // start datum test
+  printf("starting test_intg_gyro...\n");
+
+  // initialize pre-integration instance (8x decimation)
+  status = IMU_intg_init(&id, &config);
+  check_status(status, "IMU_intg_init failure");
+  config->numSamp    = 8;
+
+  // constant rate (90 deg over 6 sec)
+  float gyro1[3]     = { 0.2618,  0.0000,  0.0000};
+  float ref1[4]      = { 0.7071,  0.7071,  0.0000,  0.0000};
+  process_const(id, gyro1, 24000, ref1);
+  float gyro2[3]     = { 0.0000,  0.0000,  0.2618};
+  float ref2[4]      = { 0.7071,  0.0000,  0.0000,  0.7071};
+  process_const(id, gyro2, 24000, ref2);
+
+  // coning motion w/ and w/o compensation
+  float ref3[4];
+  cone_truth(8000, ref3);
+  config->isConing   = 0;
+  float errRaw       = process_cone(id, 8000, ref3);
+  config->isConing   = 1;
+  float errCone      = process_cone(id, 8000, ref3);
+  printf("coning residual: %0.6f deg (uncompensated %0.6f deg)\n",
+         errCone, errRaw);
+  if (errCone > 0.1f * errRaw) {
+    printf("error: coning compensation failure\n");
+    exit(0);
+  }
+
+  // engine pre-integration path (matches test_core_gyro result)
+  float gyro4[3]     = {     67,       0,       0};
+  float ref4[4]      = { 0.7108,  0.7108,  0.0000,  0.0000};
+  process_engn(gyro4, 0.025, 240, ref4, 59);
+
+  // exit program
+  printf("pass: test_intg_gyro\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* integrate constant rate and verify final quaternion
+******************************************************************************/
+
+void process_const(
+  uint16_t             id,
+  float                g[3],
+  int                  num_iter,
+  float                ref[4])
+{
+  // main processing loop
+  float                q[4]   = {1.0f, 0.0f, 0.0f, 0.0f};
+  float                q_in[4];
+  IMU_intg_incr        incr;
+  int                  i;
+  IMU_intg_reset(id);
+  for (i=0; i<=num_iter; i++) {
+    if (IMU_intg_gyro(id, i*tick, g, &incr) == IMU_intg_enum_ready) {
+      memcpy(q_in, q, sizeof(q));
+      IMU_math_quatMult(q_in, incr.dq, q);
+    }
+  }
+
+  // print and verifiy final quaternion
+  printf("%0.4f, %0.4f, %0.4f, %0.4f\n", q[0], q[1], q[2], q[3]);
+  verify_quat(q, ref);
+}
+
+
+/******************************************************************************
+* integrate coning motion and return error against reference (deg)
+******************************************************************************/
+
+float process_cone(
+  uint16_t             id,
+  int                  num_iter,
+  float                ref[4])
+{
+  // main processing loop
+  float                q[4]   = {1.0f, 0.0f, 0.0f, 0.0f};
+  float                q_in[4], g[3];
+  double               g_dbl[3];
+  IMU_intg_incr        incr;
+  int                  i;
+  IMU_intg_reset(id);
+  for (i=0; i<=num_iter; i++) {
+    cone_mean(((double)i - 1.0) * tick * IMU_INTG_10USEC_TO_SEC,
+              ((double)i      ) * tick * IMU_INTG_10USEC_TO_SEC, g_dbl);
+    g[0]               = (float)g_dbl[0];
+    g[1]               = (float)g_dbl[1];
+    g[2]               = (float)g_dbl[2];
+    if (IMU_intg_gyro(id, i*tick, g, &incr) == IMU_intg_enum_ready) {
+      memcpy(q_in, q, sizeof(q));
+      IMU_math_quatMult(q_in, incr.dq, q);
+    }
+  }
+
+  // print and verifiy final quaternion
+  printf("%0.4f, %0.4f, %0.4f, %0.4f\n", q[0], q[1], q[2], q[3]);
+  verify_quat(q, ref);
+  return angle_error(q, ref);
+}
+
+
+/******************************************************************************
+* inject gyroscope data through the engine w/ pre-integration enabled
+******************************************************************************/
+
+void process_engn(
+  float                gyro[3],
+  float                dt,
+  int                  num_iter,
+  float                ref[4],
+  int                  count)
+{
+  // initialize imu engine
+  uint16_t             id;
+  IMU_union_config     config;
+  int                  status;
+  status = IMU_engn_init(IMU_engn_core_only, &id);
+  check_status(status, "IMU_engn_init failure");
+  status = IMU_engn_load(id, "../config/test_core.json", IMU_engn_core);
+  check_status(status, "IMU_engn_load failure");
+  IMU_engn_getConfig(id, IMU_engn_self, &config);
+  config.engn->isIntg  = 1;
+  IMU_engn_getConfig(id, IMU_engn_intg, &config);
+  config.intg->numSamp = 4;
+  status = IMU_engn_start();
+  check_status(status, "IMU_engn_start failure");
+
+  // inject datum
+  IMU_datum            datum;
+  int                  i;
+  datum.type           = IMU_gyro;
+  datum.val[0]         = gyro[0];
+  datum.val[1]         = gyro[1];
+  datum.val[2]         = gyro[2];
+  for (i=0; i<num_iter; i++) {
+    datum.t            = (uint32_t)(i * dt * 100000);
+    status             = IMU_engn_datum(id, &datum);
+    check_status(status, "IMU_engn_datum failure");
+    usleep(msg_delay);
+  }
+  usleep(10*msg_delay);
+
+  // verify quaternion and number of core updates
+  IMU_engn_estm        estm;
+  status = IMU_engn_getEstm(id, 0, &estm);
+  float *q = estm.qOrg;
+  printf("%0.4f, %0.4f, %0.4f, %0.4f\n", q[0], q[1], q[2], q[3]);
+  verify_quat(q, ref);
+  verify_int(status, count);
+}
+
+
+/******************************************************************************
+* coning motion gyroscope rates (rad/sec)
+******************************************************************************/
+
+void cone_rate(
+  double               t,
+  double               *g)
+{
+  g[0]                 = cone_amp * sin(2.0 * M_PI * cone_freq * t);
+  g[1]                 = cone_amp * cos(2.0 * M_PI * cone_freq * t);
+  g[2]                 = 0.0;
+}
+
+
+/******************************************************************************
+* coning motion mean rate over a sample period (ideal rate-integrating gyro)
+******************************************************************************/
+
+void cone_mean(
+  double               t0,
+  double               t1,
+  double               *g)
+{
+  double w             = 2.0 * M_PI * cone_freq;
+  g[0]                 = cone_amp * (cos(w*t0) - cos(w*t1)) / (w*(t1-t0));
+  g[1]                 = cone_amp * (sin(w*t1) - sin(w*t0)) / (w*(t1-t0));
+  g[2]                 = 0.0;
+}
+
+
+/******************************************************************************
+* coning motion reference (double precision, fine step exponential map)
+******************************************************************************/
+
+void cone_truth(
+  int                  num_iter,
+  float                *q_out)
+{
+  // define local variables
+  double               t_end  = num_iter * tick * IMU_INTG_10USEC_TO_SEC;
+  double               dt     = 0.000001;
+  int                  num    = (int)(t_end / dt + 0.5);
+  double               q[4]   = {1.0, 0.0, 0.0, 0.0};
+  double               g[3], dq[4], tmp[4], mag, s;
+  int                  i;
+
+  // main processing loop (midpoint rate over each step)
+  for (i=0; i<num; i++) {
+    cone_rate(((double)i + 0.5) * dt, g);
+    mag                = sqrt(g[0]*g[0] + g[1]*g[1] + g[2]*g[2]);
+    s                  = (mag > 0.0) ? sin(0.5 * dt * mag) / mag : 0.0;
+    dq[0]              = cos(0.5 * dt * mag);
+    dq[1]              = s * g[0];
+    dq[2]              = s * g[1];
+    dq[3]              = s * g[2];
+    tmp[0]             = q[0]*dq[0] - q[1]*dq[1] - q[2]*dq[2] - q[3]*dq[3];
+    tmp[1]             = q[0]*dq[1] + q[1]*dq[0] + q[2]*dq[3] - q[3]*dq[2];
+    tmp[2]             = q[0]*dq[2] - q[1]*dq[3] + q[2]*dq[0] + q[3]*dq[1];
+    tmp[3]             = q[0]*dq[3] + q[1]*dq[2] - q[2]*dq[1] + q[3]*dq[0];
+    memcpy(q, tmp, sizeof(q));
+  }
+  for (i=0; i<4; i++)
+    q_out[i]           = (float)q[i];
+}
+
+
+/******************************************************************************
+* angle between two orientations (degrees)
+******************************************************************************/
+
+float angle_error(
+  float                *q1,
+  float                *q2)
+{
+  double n1  = sqrt((double)q1[0]*q1[0] + (double)q1[1]*q1[1] +
+                    (double)q1[2]*q1[2] + (double)q1[3]*q1[3]);
+  double n2  = sqrt((double)q2[0]*q2[0] + (double)q2[1]*q2[1] +
+                    (double)q2[2]*q2[2] + (double)q2[3]*q2[3]);
+  double dot = fabs((double)q1[0]*q2[0] + (double)q1[1]*q2[1] +
+                    (double)q1[2]*q2[2] + (double)q1[3]*q2[3]) / (n1*n2);
+  if (dot > 1.0)
+    dot      = 1.0;
+  return (float)(2.0 * acos(dot) * 180.0 / M_PI);
+}
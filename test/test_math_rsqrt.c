@@ -0,0 +1,122 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "IMU_math.h"
+#include "test_utils.h"
+
+// define constants
+static const double rsqrt_tol   = 5e-6;       // relative error bound
+static const double norm_tol    = 1e-5;       // unit length bound
+
+// define local functions
+void verify_rel(double val, double ref, double tol);
+
+
+/******************************************************************************
+* main function - accuracy bounds of reciprocal sqrt normalization
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  double             x, err, max = 0.0;
+  float              v[4], q[4];
+  int                i, j;
+
+  // start rsqrt test
+  printf("starting test_math_rsqrt...\n");
+
+  // reciprocal sqrt over twelve decades (dense log sweep)
+  for (x=1e-6; x<1e6; x*=1.0001) {
+    err              = fabs(IMU_math_rsqrt((float)x) * sqrt((float)x) - 1.0);
+    if (err > max)
+      max            = err;
+  }
+  printf("rsqrt max relative error: %0.3g\n", max);
+  verify_rel(max, 0.0, rsqrt_tol);
+
+  // 3x1 normalize returns magnitude (sensor count scale vectors)
+  srand(1);
+  for (i=0; i<10000; i++) {
+    for (j=0; j<3; j++)
+      v[j]           = (float)(rand() % 65535 - 32767);
+    x                = sqrt((double)v[0]*v[0] + (double)v[1]*v[1] +
+                            (double)v[2]*v[2]);
+    verify_rel(IMU_math_norm3(v), x, rsqrt_tol);
+    verify_rel(sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]), 1.0, norm_tol);
+  }
+
+  // 4x1 normalize (quaternion drift after integration)
+  for (i=0; i<10000; i++) {
+    for (j=0; j<4; j++)
+      q[j]           = (float)(rand() % 2001 - 1000) / 1000.0f;
+    x                = sqrt(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]);
+    if (x < 0.01)
+      continue;
+    verify_rel(IMU_math_norm4(q), x, rsqrt_tol);
+    verify_rel(sqrt(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]), 1.0,
+               norm_tol);
+  }
+
+  // 4x1 normalize leaves near zero vectors untouched
+  float zero[4]      = {1e-4, 0.0, 0.0, 0.0};
+  IMU_math_norm4(zero);
+  verify_rel(zero[0], 1e-4, rsqrt_tol);
+
+  // up/forward to quaternion stays unit length (rsqrt branches)
+  float u[3]         = { 0.3897, -0.3685,  0.9004};
+  float f[3]         = {-0.9311, -0.1225, -0.2369};
+  float up[3], out[3];
+  IMU_math_upFrwdToQuat(u, f, q);
+  verify_rel(sqrt(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]), 1.0,
+             norm_tol);
+  IMU_math_upToQuat(u, q);
+  verify_rel(sqrt(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]), 1.0,
+             norm_tol);
+  IMU_math_quatToUp(q, up);
+  x                  = sqrt(u[0]*u[0] + u[1]*u[1] + u[2]*u[2]);
+  for (j=0; j<3; j++)
+    out[j]           = u[j] / x;
+  verify_vect(up, out);
+
+  // exit program
+  printf("pass: test_math_rsqrt\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* verify relative (or absolute when reference is zero) error
+******************************************************************************/
+
+void verify_rel(
+  double               val,
+  double               ref,
+  double               tol)
+{
+  double err           = (ref == 0.0) ? fabs(val) : fabs(val / ref - 1.0);
+  if (err > tol) {
+    printf("error: rsqrt precision failure (%0.3g)\n", err);
+    exit(0);
+  }
+}
@@ -0,0 +1,197 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "IMU_pnts.h"
+#include "test_utils.h"
+
+// define constants
+static const int   num_fill    = 6;       // cycles within queue size
+static const int   num_flood   = 20;      // cycles beyond queue size
+static const int   fnc_delay   = 1000;    // slow callback (usec)
+
+// define globals
+uint16_t           id          = 0;
+IMU_pnts_config    *config     = NULL;
+uint32_t           curTime     = 0;
+volatile int       fncCount    = 0;
+int                isOrdered   = 1;
+
+// define internal functions
+static void stable_fnc  (uint16_t count, IMU_pnts_entry*, void*);
+static void break_fnc   (uint16_t count, IMU_pnts_entry*, void*);
+static void verify_fnc  (int type, uint16_t count, IMU_pnts_entry*);
+static void run_cycles  (int num_cycle);
+static void add_datum   (int k, uint32_t dt);
+static void wait_fnc    (int num_fnc);
+
+
+/******************************************************************************
+* main function - callback worker and event queue (entries copied, in order,
+* data path never blocks on a slow callback)
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  IMU_pnts_state     *state;
+  int                status;
+
+  // start datum test
+  printf("starting test_pnts_queue...\n");
+
+  // initialize pnts instance (gyroscope only, any change is motion)
+  status = IMU_pnts_init(&id, &config);
+  check_status(status, "IMU_pnts_init failure");
+  IMU_pnts_getState(id, &state);
+  config->enable     = 1;
+  config->isAccl     = 0;
+  config->isMagn     = 0;
+  config->gAlpha     = 1.0;
+
+  // register stable and break callbacks (starts worker)
+  status = IMU_pnts_fncStable(id, &stable_fnc, NULL);
+  check_status(status, "IMU_pnts_fncStable failure");
+  status = IMU_pnts_fncBreak(id, &break_fnc, NULL);
+  check_status(status, "IMU_pnts_fncBreak failure");
+
+  // queue holds all events, every callback delivered in order
+  run_cycles(num_fill);
+  wait_fnc(2 * num_fill);
+  printf("delivered = %d, dropped = %u\n", fncCount, state->numDrop);
+  verify_int(fncCount, 2 * num_fill);
+  verify_int(state->numDrop, 0);
+  verify_int(isOrdered, 1);
+
+  // queue overflow, events dropped and counted (never blocks)
+  run_cycles(num_flood);
+  wait_fnc(2 * num_flood - state->numDrop);
+  printf("delivered = %d, dropped = %u\n", fncCount, state->numDrop);
+  verify_int(fncCount + state->numDrop, 2 * num_flood);
+  verify_int(state->numDrop > 0, 1);
+  verify_int(fncCount >= IMU_PNTS_QUEUE_SIZE, 1);
+
+  // exit program
+  printf("pass: test_pnts_queue\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* callback functions (slow consumer)
+******************************************************************************/
+
+void stable_fnc(
+  uint16_t           count,
+  IMU_pnts_entry     *entry,
+  void               *pntr)
+{
+  (void)pntr;
+  verify_fnc(0, count, entry);
+  usleep(fnc_delay);
+}
+
+void break_fnc(
+  uint16_t           count,
+  IMU_pnts_entry     *entry,
+  void               *pntr)
+{
+  (void)pntr;
+  verify_fnc(1, count, entry);
+  usleep(fnc_delay);
+}
+
+
+/******************************************************************************
+* verify event entry matches its cycle (table slot since overwritten)
+******************************************************************************/
+
+void verify_fnc(
+  int                type,
+  uint16_t           count,
+  IMU_pnts_entry     *entry)
+{
+  // entry value encodes its cycle
+  float ref[3]       = {count + 1, 2 * (count + 1), 3 * (count + 1)};
+  verify_vect(entry->gFltr, ref);
+
+  // stable/break pairs in count order (given no dropped events)
+  static int         prev = -1;
+  int                cur  = 2 * count + type;
+  if (cur <= prev && cur != 0)
+    isOrdered        = 0;
+  prev               = cur;
+  fncCount++;
+}
+
+
+/******************************************************************************
+* hold, stable, then break for each cycle (no delay between datum)
+******************************************************************************/
+
+void run_cycles(
+  int                num_cycle)
+{
+  // reset callback count and restart point collection
+  int                k;
+  fncCount           = 0;
+  IMU_pnts_reset(id);
+  IMU_pnts_start(id, num_cycle);
+
+  // move, hold (0.15 sec), stable (0.30 sec), then break on next cycle
+  add_datum(1, 0);
+  for (k=1; k<=num_cycle; k++) {
+    add_datum(k, 1000);
+    add_datum(k, 15000);
+    add_datum(k, 15000);
+    add_datum(k+1, 1000);
+  }
+}
+
+
+/******************************************************************************
+* inject gyroscope datum
+******************************************************************************/
+
+void add_datum(
+  int                k,
+  uint32_t           dt)
+{
+  IMU_pnts_entry     *entry;
+  IMU_TYPE           g[3] = {k, 2 * k, 3 * k};
+  curTime           += dt;
+  IMU_pnts_newGyro(id, curTime, g, &entry);
+}
+
+
+/******************************************************************************
+* wait for callbacks to complete (bounded)
+******************************************************************************/
+
+void wait_fnc(
+  int                num_fnc)
+{
+  int                i;
+  for (i=0; i<1000 && fncCount < num_fnc; i++)
+    usleep(msg_delay);
+  usleep(10 * fnc_delay);
+}
@@ -0,0 +1,160 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "IMU_math.h"
+#include "test_utils.h"
+
+// define constants
+static const int    num_samp    = 10000;
+static const float  dcm_tol     = 1e-5;       // matrix vs quaternion bound
+
+// define local functions
+void random_quat   (float *q);
+void verify_close  (float *val, float *ref, int num);
+void ref_estmAccl  (float *q, float *a, float alpha);
+
+
+/******************************************************************************
+* main function - rotation matrix helpers match quaternion helpers
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  float              q[4], R[9], v[3], ref[3], out[3], I[9];
+  float              qRef[4], a[3], e[3], eRef[3], FOM, FOMRef;
+  int                i, j, k;
+
+  // start dcm test
+  printf("starting test_quat_dcm...\n");
+
+  // matrix columns and products match quaternion functions
+  srand(1);
+  for (i=0; i<num_samp; i++) {
+    random_quat(q);
+    IMU_math_quatToDCM(q, R);
+    verify_close(IMU_math_dcmToUp(R, out),   IMU_math_quatToUp(q, ref),   3);
+    verify_close(IMU_math_dcmToFrwd(R, out), IMU_math_quatToFrwd(q, ref), 3);
+    for (j=0; j<3; j++)
+      v[j]           = (float)(rand() % 2001 - 1000) / 1000.0f;
+    IMU_math_dcmRotateForward(v, R, out);
+    verify_close(out, IMU_math_rotateForward(v, q, ref), 3);
+    IMU_math_dcmRotateReverse(v, R, out);
+    verify_close(out, IMU_math_rotateReverse(v, q, ref), 3);
+
+    // orthonormal (R * R' = I)
+    for (j=0; j<3; j++)
+      for (k=0; k<3; k++)
+        I[3*j+k]     = R[3*j]*R[3*k] + R[3*j+1]*R[3*k+1] + R[3*j+2]*R[3*k+2];
+    float eye[9]     = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+    verify_close(I, eye, 9);
+  }
+
+  // cached matrix update matches the explicit quaternion model
+  for (i=0; i<num_samp; i++) {
+    random_quat(q);
+    random_quat(a);
+    memcpy(qRef, q, sizeof(q));
+    IMU_math_estmAcclDCM(q, IMU_math_quatToDCM(q, R), a, 0.05, &FOM);
+    ref_estmAccl(qRef, a, 0.05);
+    verify_close(q, qRef, 4);
+  }
+
+  // matrix and quaternion entry points are interchangeable
+  for (i=0; i<num_samp; i++) {
+    random_quat(q);
+    random_quat(v);
+    memcpy(qRef, q, sizeof(q));
+    IMU_math_quatToDCM(q, R);
+    IMU_math_mhnyMagnDCM(q, R, v, 0.05, e, &FOM);
+    IMU_math_mhnyMagn(qRef, v, 0.05, eRef, &FOMRef);
+    verify_close(q, qRef, 4);
+    verify_close(e, eRef, 3);
+    verify_close(&FOM, &FOMRef, 1);
+  }
+
+  // exit program
+  printf("pass: test_quat_dcm\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* random unit quaternion (unit 3x1 when used as vector)
+******************************************************************************/
+
+void random_quat(
+  float                *q)
+{
+  int                  j;
+  do {
+    for (j=0; j<4; j++)
+      q[j]             = (float)(rand() % 2001 - 1000) / 1000.0f;
+  } while (q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3] < 0.01f);
+  IMU_math_norm4(q);
+}
+
+
+/******************************************************************************
+* verify element-wise agreement
+******************************************************************************/
+
+void verify_close(
+  float                *val,
+  float                *ref,
+  int                  num)
+{
+  int                  i;
+  for (i=0; i<num; i++) {
+    if (fabsf(val[i] - ref[i]) > dcm_tol) {
+      printf("error: dcm mismatch (%f vs %f)\n", val[i], ref[i]);
+      exit(0);
+    }
+  }
+}
+
+
+/******************************************************************************
+* gradient descent accelerometer update with the model written out in q
+******************************************************************************/
+
+void ref_estmAccl(
+  float                *q,
+  float                *a,
+  float                alpha)
+{
+  float two_q[4]       = {2.0f*q[0], 2.0f*q[1], 2.0f*q[2], 2.0f*q[3]};
+  float f_1            = two_q[1]*q[3] - two_q[0]*q[2] - a[0];
+  float f_2            = two_q[0]*q[1] + two_q[2]*q[3] - a[1];
+  float f_3            = 1.0f - two_q[1]*q[1] - two_q[2]*q[2] - a[2];
+  float g[4]           = {two_q[1]*f_2 - two_q[2]*f_1,
+                          two_q[3]*f_1 + two_q[0]*f_2 - 2*two_q[1]*f_3,
+                          two_q[3]*f_2 - 2*two_q[2]*f_3 - two_q[0]*f_1,
+                          two_q[1]*f_1 + two_q[2]*f_2};
+  int                  i;
+  IMU_math_norm4(g);
+  for (i=0; i<4; i++)
+    q[i]              -= alpha * g[i];
+  IMU_math_norm4(q);
+}
@@ -0,0 +1,173 @@
+/*
+ * This file is part of quaternion-based displayIMU C/C++/QT code base
+ * (https://github.com/ssymeonidis/displayIMU.git)
+ * Copyright (c) 2018 Simeon Symeonidis (formerly Sensor Management Real
+ * Time (SMRT) Processing Solutions)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// include statements
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "IMU_math.h"
+#include "IMU_simd.h"
+#include "test_utils.h"
+
+// define constants
+#define            num_samp      1003        // not a multiple of any width
+static const float simd_tol    = 1e-5;       // fma contraction differences
+
+// define globals (structure of arrays)
+float              qa[4][num_samp], qb[4][num_samp], qc[4][num_samp];
+float              va[3][num_samp], vc[3][num_samp];
+IMU_simd_quat      q1          = {{qa[0], qa[1], qa[2], qa[3]}};
+IMU_simd_quat      q2          = {{qb[0], qb[1], qb[2], qb[3]}};
+IMU_simd_quat      qOut        = {{qc[0], qc[1], qc[2], qc[3]}};
+IMU_simd_vect      v1          = {{va[0], va[1], va[2]}};
+IMU_simd_vect      vOut        = {{vc[0], vc[1], vc[2]}};
+
+// define local functions
+void verify_quat_n (int i, float ref[4]);
+void verify_vect_n (int i, float ref[3]);
+
+
+/******************************************************************************
+* main function - batched quaternion math vs IMU_math scalar reference
+******************************************************************************/
+
+int main(void)
+{
+  // define local variables
+  const char         *name[] = {"scalar", "sse2", "avx2", "avx512"};
+  IMU_simd_isa       best, isa;
+  float              a[4], b[4], v[3], ref[4];
+  int                i, j;
+
+  // start simd test
+  printf("starting test_simd_math...\n");
+
+  // random unit quaternions and vectors (sensor count scale)
+  srand(1);
+  for (i=0; i<num_samp; i++) {
+    for (j=0; j<4; j++) {
+      qa[j][i]       = (float)(rand() % 2001 - 1000) / 1000.0f;
+      qb[j][i]       = (float)(rand() % 2001 - 1000) / 1000.0f;
+    }
+    for (j=0; j<3; j++)
+      va[j][i]       = (float)(rand() % 2001 - 1000) / 4.0f;
+    for (j=0; j<4; j++) {a[j] = qa[j][i]; b[j] = qb[j][i];}
+    IMU_math_norm4(a);
+    IMU_math_norm4(b);
+    for (j=0; j<4; j++) {qa[j][i] = a[j]; qb[j][i] = b[j];}
+  }
+
+  // reject instruction set beyond processor support
+  best               = IMU_simd_bestIsa();
+  verify_int(IMU_simd_setIsa(IMU_simd_avx512 + 1), IMU_SIMD_BAD_ISA);
+  printf("best instruction set: %s\n", name[best]);
+
+  // every supported instruction set matches the scalar reference
+  for (isa=IMU_simd_scalar; isa<=best; isa++) {
+    verify_int(IMU_simd_setIsa(isa), 0);
+    verify_int(IMU_simd_getIsa(), isa);
+
+    // quaternion multiply (and conjugate)
+    IMU_simd_quatMult(&q1, &q2, &qOut, num_samp);
+    for (i=0; i<num_samp; i++) {
+      for (j=0; j<4; j++) {a[j] = qa[j][i]; b[j] = qb[j][i];}
+      verify_quat_n(i, IMU_math_quatMult(a, b, ref));
+    }
+    IMU_simd_quatMultConj(&q1, &q2, &qOut, num_samp);
+    for (i=0; i<num_samp; i++) {
+      for (j=0; j<4; j++) {a[j] = qa[j][i]; b[j] = qb[j][i];}
+      verify_quat_n(i, IMU_math_quatMultConj(a, b, ref));
+    }
+
+    // vector rotation (forward and reverse)
+    IMU_simd_rotateForward(&v1, &q1, &vOut, num_samp);
+    for (i=0; i<num_samp; i++) {
+      for (j=0; j<4; j++) a[j] = qa[j][i];
+      for (j=0; j<3; j++) v[j] = va[j][i];
+      verify_vect_n(i, IMU_math_rotateForward(v, a, ref));
+    }
+    IMU_simd_rotateReverse(&v1, &q1, &vOut, num_samp);
+    for (i=0; i<num_samp; i++) {
+      for (j=0; j<4; j++) a[j] = qa[j][i];
+      for (j=0; j<3; j++) v[j] = va[j][i];
+      verify_vect_n(i, IMU_math_rotateReverse(v, a, ref));
+    }
+
+    // up and forward pointing vectors
+    IMU_simd_quatToUp(&q1, &vOut, num_samp);
+    for (i=0; i<num_samp; i++) {
+      for (j=0; j<4; j++) a[j] = qa[j][i];
+      verify_vect_n(i, IMU_math_quatToUp(a, ref));
+    }
+    IMU_simd_quatToFrwd(&q1, &vOut, num_samp);
+    for (i=0; i<num_samp; i++) {
+      for (j=0; j<4; j++) a[j] = qa[j][i];
+      verify_vect_n(i, IMU_math_quatToFrwd(a, ref));
+    }
+
+    // output aliasing an input (in place multiply)
+    memcpy(qc, qa, sizeof(qc));
+    IMU_simd_quatMult(&qOut, &q2, &qOut, num_samp);
+    for (i=0; i<num_samp; i++) {
+      for (j=0; j<4; j++) {a[j] = qa[j][i]; b[j] = qb[j][i];}
+      verify_quat_n(i, IMU_math_quatMult(a, b, ref));
+    }
+    printf("%s matches scalar reference\n", name[isa]);
+  }
+
+  // exit program
+  printf("pass: test_simd_math\n\n");
+  return 0;
+}
+
+
+/******************************************************************************
+* verify batched quaternion output against reference
+******************************************************************************/
+
+void verify_quat_n(
+  int                  i,
+  float                ref[4])
+{
+  for (int j=0; j<4; j++) {
+    if (fabs(qc[j][i] - ref[j]) > simd_tol) {
+      printf("error: quat results failure (sample %d)\n", i);
+      exit(0);
+    }
+  }
+}
+
+
+/******************************************************************************
+* verify batched vector output against reference (relative to magnitude)
+******************************************************************************/
+
+void verify_vect_n(
+  int                  i,
+  float                ref[3])
+{
+  float mag            = sqrtf(ref[0]*ref[0] + ref[1]*ref[1] + ref[2]*ref[2]);
+  for (int j=0; j<3; j++) {
+    if (fabs(vc[j][i] - ref[j]) > simd_tol * (1.0f + mag)) {
+      printf("error: vect results failure (sample %d)\n", i);
+      exit(0);
+    }
+  }
+}